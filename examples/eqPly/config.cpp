@@ -296,10 +296,13 @@ const Model* Config::getModel( const eq::uint128_t& modelID )
             return _models[ i ];
     }
     
+    const co::base::Clock clock;
     _modelDist.push_back( new ModelDist );
     Model* model = _modelDist.back()->mapModel( getClient(), modelID );
     EQASSERT( model );
     _models.push_back( model );
+    EQINFO << "Mapped model " << modelID << " in " << clock.getTimef()
+           << " ms" << std::endl;
 
     return model;
 }
@@ -120,6 +120,9 @@ namespace eqPly
 
         virtual ChangeType getChangeType() const { return DELTA; }
 
+        /** All data is overwritten, coalesce superseded versions on sync. */
+        virtual bool isLastWriterWins() const { return true; }
+
         /** The changed parts of the data since the last pack(). */
         enum DirtyBits
         {
@@ -123,6 +123,54 @@ mesh::VertexBufferRoot* VertexBufferDist::mapModel( co::LocalNodePtr node,
         return 0;
     }
 
+    // Map the tree breadth-first, using one batch of requests per level
+    std::vector< VertexBufferDist* > level( 1, this );
+    while( !level.empty( ))
+    {
+        std::vector< VertexBufferDist* > next;
+        co::Objects objects;
+        co::ObjectVersions versions;
+
+        for( std::vector< VertexBufferDist* >::const_iterator i =
+                 level.begin(); i != level.end(); ++i )
+        {
+            VertexBufferDist* dist = *i;
+            if( !dist->_left || !dist->_right )
+                continue;
+
+            objects.push_back( dist->_left );
+            objects.push_back( dist->_right );
+            versions.push_back( co::ObjectVersion( dist->_leftID,
+                                                   co::VERSION_OLDEST ));
+            versions.push_back( co::ObjectVersion( dist->_rightID,
+                                                   co::VERSION_OLDEST ));
+            next.push_back( dist );
+        }
+
+        if( !node->mapObjects( objects, versions ))
+        {
+            EQWARN << "Mapping of model failed" << endl;
+            return 0;
+        }
+
+        level.clear();
+        for( std::vector< VertexBufferDist* >::const_iterator i =
+                 next.begin(); i != next.end(); ++i )
+        {
+            VertexBufferDist* dist = *i;
+            mesh::VertexBufferNode* treeNode = static_cast< 
+                mesh::VertexBufferNode* >( const_cast< 
+                    mesh::VertexBufferBase* >( dist->_node ));
+
+            treeNode->_left = const_cast< mesh::VertexBufferBase* >(
+                dist->_left->_node );
+            treeNode->_right = const_cast< mesh::VertexBufferBase* >(
+                dist->_right->_node );
+            level.push_back( dist->_left );
+            level.push_back( dist->_right );
+        }
+    }
+
     return const_cast< mesh::VertexBufferRoot* >( _root );
 }
 
@@ -179,10 +227,9 @@ void VertexBufferDist::applyInstanceData( co::DataIStream& is )
     mesh::VertexBufferNode* node = 0;
     mesh::VertexBufferBase* base = 0;
 
-    co::base::UUID leftID, rightID;
-    is >> _isRoot >> leftID >> rightID;
+    is >> _isRoot >> _leftID >> _rightID;
 
-    if( leftID != co::base::UUID::ZERO && rightID != co::base::UUID::ZERO )
+    if( _leftID != co::base::UUID::ZERO && _rightID != co::base::UUID::ZERO )
     {
         if( _isRoot )
         {
@@ -201,18 +248,10 @@ void VertexBufferDist::applyInstanceData( co::DataIStream& is )
             node = new mesh::VertexBufferNode;
         }
 
+        // the children are mapped by mapModel()
         base   = node;
         _left  = new VertexBufferDist( _root, 0 );
         _right = new VertexBufferDist( _root, 0 );
-        co::LocalNodePtr localNode = getLocalNode();
-        const uint32_t sync1 = localNode->mapObjectNB( _left, leftID );
-        const uint32_t sync2 = localNode->mapObjectNB( _right, rightID );
-
-        EQCHECK( localNode->mapObjectSync( sync1 ));
-        EQCHECK( localNode->mapObjectSync( sync2 ));
-
-        node->_left  = const_cast< mesh::VertexBufferBase* >( _left->_node );
-        node->_right = const_cast< mesh::VertexBufferBase* >( _right->_node );
     }
     else
     {
@@ -66,6 +66,8 @@ namespace eqPly
 
         VertexBufferDist* _left;
         VertexBufferDist* _right;
+        co::base::UUID _leftID;  //!< set by applyInstanceData, not mapped yet
+        co::base::UUID _rightID; //!< set by applyInstanceData, not mapped yet
     };
 }
 
@@ -27,6 +27,9 @@
 #include "exception.h"
 
 #include <co/base/global.h>
+#include <co/base/scopedMutex.h>
+
+#include <algorithm>
 
 namespace co
 {
@@ -36,12 +39,16 @@ Barrier::Barrier( NodePtr master, const uint32_t height )
         : _masterID( master->getNodeID( ))
         , _height( height )
         , _master( master )
+        , _topology( TOPOLOGY_FLAT )
+        , _fanOut( 4 )
 {
     EQASSERT( _masterID != NodeID::ZERO );
     EQINFO << "New barrier of height " << _height << std::endl;
 }
 
 Barrier::Barrier()
+        : _topology( TOPOLOGY_FLAT )
+        , _fanOut( 4 )
 {
     EQINFO << "Barrier instantiated" << std::endl;
 }
@@ -55,25 +62,25 @@ Barrier::~Barrier()
 //---------------------------------------------------------------------------
 void Barrier::getInstanceData( DataOStream& os )
 {
-    os << _height << _masterID;
+    os << _height << _masterID << _topology << _fanOut << _nodes;
     _leaveNotify = 0;
 }
 
 void Barrier::applyInstanceData( DataIStream& is )
 {
-    is >> _height >> _masterID;
+    is >> _height >> _masterID >> _topology >> _fanOut >> _nodes;
     _leaveNotify = 0;
 }
 
 void Barrier::pack( DataOStream& os )
 {
-    os << _height;
+    os << _height << _topology << _fanOut << _nodes;
     _leaveNotify = 0;
 }
 
 void Barrier::unpack( DataIStream& is )
 {
-    is >> _height;
+    is >> _height >> _topology >> _fanOut >> _nodes;
     _leaveNotify = 0;
 }
 
@@ -88,6 +95,10 @@ void Barrier::attach( const base::UUID& id, const uint32_t instanceID )
                      CmdFunc( this, &Barrier::_cmdEnter ), queue );
     registerCommand( CMD_BARRIER_ENTER_REPLY, 
                      CmdFunc( this, &Barrier::_cmdEnterReply ), queue );
+    registerCommand( CMD_BARRIER_TREE_ENTER,
+                     CmdFunc( this, &Barrier::_cmdTreeEnter ), queue );
+    registerCommand( CMD_BARRIER_TREE_LEAVE,
+                     CmdFunc( this, &Barrier::_cmdTreeLeave ), queue );
 }
 
 void Barrier::enter( const uint32_t timeout )
@@ -98,6 +109,12 @@ void Barrier::enter( const uint32_t timeout )
     if( _height == 1 ) // trivial ;)
         return;
 
+    if( _isTree( ))
+    {
+        _enterTree( timeout );
+        return;
+    }
+
     if( !_master )
     {
         LocalNodePtr localNode = getLocalNode();
@@ -285,4 +302,187 @@ bool Barrier::_cmdEnterReply( Command& command )
     
     return true;
 }
+
+//---------------------------------------------------------------------------
+// Tree topology
+//---------------------------------------------------------------------------
+bool Barrier::_isTree() const
+{
+    return _topology == TOPOLOGY_TREE && _fanOut > 0 &&
+           _nodes.size() == _height;
+}
+
+void Barrier::_updateTree()
+{
+    // only the application thread writes the tree
+    if( _tree->version == getVersion( ))
+        return;
+
+    // build the tree before publishing it to the command thread
+    Tree tree;
+    _buildTree( tree );
+
+    base::ScopedMutex< base::SpinLock > mutex( _tree );
+    _tree.data = tree;
+}
+
+void Barrier::_buildTree( Tree& tree )
+{
+    tree.version = getVersion();
+
+    // The unique participant nodes, in the same order on all nodes
+    std::vector< NodeID > nodes = _nodes;
+    std::sort( nodes.begin(), nodes.end( ));
+    std::vector< uint32_t > counts;
+    std::vector< NodeID >::iterator last = nodes.begin();
+    for( std::vector< NodeID >::const_iterator i = nodes.begin();
+         i != nodes.end(); ++i )
+    {
+        if( counts.empty() || *i != *( last - 1 ))
+        {
+            *last++ = *i;
+            counts.push_back( 1 );
+        }
+        else
+            ++counts.back();
+    }
+    nodes.erase( last, nodes.end( ));
+
+    // The barrier master is the root, if it participates
+    std::vector< NodeID >::iterator i = std::find( nodes.begin(), nodes.end(),
+                                                   _masterID );
+    if( i != nodes.end( ))
+    {
+        const size_t index = i - nodes.begin();
+        std::swap( nodes[ 0 ], nodes[ index ] );
+        std::swap( counts[ 0 ], counts[ index ] );
+    }
+
+    const NodeID& nodeID = getLocalNode()->getNodeID();
+    i = std::find( nodes.begin(), nodes.end(), nodeID );
+    EQASSERTINFO( i != nodes.end(), "Node " << nodeID <<
+                  " does not participate in barrier " << getID( ));
+    if( i == nodes.end( ))
+        return;
+
+    // Children of node n are fanOut * n + 1 ... fanOut * ( n + 1 )
+    const size_t self = i - nodes.begin();
+    std::vector< size_t > subtree( 1, self );
+    while( !subtree.empty( ))
+    {
+        const size_t n = subtree.back();
+        subtree.pop_back();
+        tree.height += counts[ n ];
+
+        const size_t first = _fanOut * n + 1;
+        const size_t end = std::min( first + _fanOut, nodes.size( ));
+        for( size_t child = first; child < end; ++child )
+            subtree.push_back( child );
+    }
+
+    if( self > 0 )
+        tree.parent = getLocalNode()->connect( nodes[ (self - 1)/_fanOut ]);
+}
+
+void Barrier::_enterTree( const uint32_t timeout )
+{
+    _updateTree();
+    EQASSERT( _tree->height > 0 );
+    if( _tree->height == 0 )
+        return;
+
+    EQLOG( LOG_BARRIER ) << "enter barrier tree " << getID() << " v"
+                         << getVersion() << ", subtree height "
+                         << _tree->height << std::endl;
+
+    const uint32_t leaveVal = _leaveNotify.get() + 1;
+
+    BarrierTreeEnterPacket packet( getVersion(), 1 );
+    send( getLocalNode(), packet );
+
+    if( timeout == EQ_TIMEOUT_INDEFINITE )
+        _leaveNotify.waitEQ( leaveVal );
+    else if( !_leaveNotify.timedWaitEQ( leaveVal, timeout ))
+        throw Exception( Exception::TIMEOUT_BARRIER );
+
+    EQLOG( LOG_BARRIER ) << "left barrier tree " << getID() << " v"
+                         << getVersion() << std::endl;
+}
+
+bool Barrier::_cmdTreeEnter( Command& command )
+{
+    EQ_TS_THREAD( _thread );
+    BarrierTreeEnterPacket* packet =
+        command.getModifiable< BarrierTreeEnterPacket >();
+    if( packet->handled )
+        return true;
+    packet->handled = true;
+
+    const uint128_t version = packet->version;
+    NodePtr node = command.getNode();
+    if( node->isLocal( )) // drop requests of older, timed out versions
+        _treeRequests.erase( _treeRequests.begin(),
+                             _treeRequests.lower_bound( version ));
+
+    TreeRequest& request = _treeRequests[ version ];
+    request.count += packet->count;
+    if( !node->isLocal( ))
+        request.children.push_back( node );
+
+    Tree tree;
+    {
+        base::ScopedMutex< base::SpinLock > mutex( _tree );
+        tree = _tree.data;
+    }
+
+    EQLOG( LOG_BARRIER ) << "enter barrier tree v" << version << ", has "
+                         << request.count << " of " << tree.height
+                         << std::endl;
+
+    // The tree is updated before the local participants enter, and the
+    // subtree can't be complete without them.
+    if( version != tree.version || request.count < tree.height )
+        return true;
+
+    EQASSERT( request.count == tree.height );
+    if( !tree.parent ) // root
+    {
+        EQLOG( LOG_BARRIER ) << "Barrier reached" << std::endl;
+        _leaveTree( version );
+        return true;
+    }
+
+    BarrierTreeEnterPacket parentPacket( version, request.count );
+    send( tree.parent, parentPacket );
+    return true;
+}
+
+bool Barrier::_cmdTreeLeave( Command& command )
+{
+    EQ_TS_THREAD( _thread );
+    const BarrierTreeLeavePacket* packet =
+        command.get< BarrierTreeLeavePacket >();
+
+    _leaveTree( packet->version );
+    return true;
+}
+
+void Barrier::_leaveTree( const uint128_t& version )
+{
+    std::map< uint128_t, TreeRequest >::iterator i =
+        _treeRequests.find( version );
+    if( i == _treeRequests.end( )) // timed out
+        return;
+
+    const Nodes& children = i->second.children;
+    for( Nodes::const_iterator j = children.begin(); j != children.end(); ++j )
+    {
+        BarrierTreeLeavePacket packet( version );
+        send( *j, packet );
+    }
+    _treeRequests.erase( i );
+
+    if( version == getVersion( ))
+        ++_leaveNotify;
+}
 }
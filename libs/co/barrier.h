@@ -21,17 +21,36 @@
 
 #include <co/object.h>   // base class
 #include <co/types.h>
-#include <co/base/monitor.h> // member
+#include <co/base/lockable.h> // member
+#include <co/base/monitor.h>  // member
+#include <co/base/spinLock.h> // member
 
 #include <map>
+#include <vector>
 
 namespace co
 {
     struct BarrierEnterReplyPacket;
-    /** A networked, versioned barrier. */
+    /**
+     * A networked, versioned barrier.
+     *
+     * By default, all participants send their enter request to the master
+     * node, which notifies all participants once the barrier is reached. For
+     * barriers with many participating nodes, a tree topology can be used. The
+     * nodes of the participants are then arranged in a tree, and each node
+     * only communicates with its parent and children. This distributes the
+     * message load and reduces the master's work from O(N) to O(fan-out).
+     */
     class Barrier : public Object
     {
     public:
+        /** The algorithm used to synchronize the participants. */
+        enum Topology
+        {
+            TOPOLOGY_FLAT, //!< All participants notify the master node
+            TOPOLOGY_TREE  //!< Participant nodes form a tree with the master
+        };
+
         /** 
          * Construct a new barrier.
          *
@@ -58,14 +77,43 @@ namespace co
          * same version on all nodes entering the barrier.
          */
         //@{
-        /** Set the number of participants in the barrier. */
-        void setHeight( const uint32_t height ) { _height = height; }
+        /**
+         * Set the number of participants in the barrier.
+         *
+         * Clears the participating nodes set using increase( const NodeID& ).
+         */
+        void setHeight( const uint32_t height )
+            { _height = height; _nodes.clear(); }
 
         /** Add one participant to the barrier. */
         void increase() { ++_height; }
 
+        /**
+         * Add one participant entering the barrier on the given node.
+         *
+         * The tree topology is only used if the nodes of all participants are
+         * known, i.e., if all participants were added using this method.
+         */
+        void increase( const NodeID& nodeID )
+            { ++_height; _nodes.push_back( nodeID ); }
+
         /** @return the number of participants. */
         uint32_t getHeight() const { return _height; }
+
+        /**
+         * Set the algorithm used to synchronize the participants.
+         *
+         * @param topology the barrier topology.
+         * @param fanOut the maximum number of children per node in the tree.
+         */
+        void setTopology( const Topology topology, const uint32_t fanOut = 4 )
+            { _topology = topology; _fanOut = fanOut; }
+
+        /** @return the algorithm used to synchronize the participants. */
+        Topology getTopology() const { return _topology; }
+
+        /** @return the maximum number of children per node in the tree. */
+        uint32_t getFanOut() const { return _fanOut; }
         //@}
 
         /** @name Operations */
@@ -101,6 +149,40 @@ namespace co
         /** The local, connected instantiation of the master node. */
         NodePtr _master;
 
+        /** The synchronization algorithm. */
+        Topology _topology;
+
+        /** The maximum number of children of a tree node. */
+        uint32_t _fanOut;
+
+        /** The nodes of the participants, if known. */
+        std::vector< NodeID > _nodes;
+
+        /** The tree state of the local node for one version. */
+        struct Tree
+        {
+            Tree() : height( 0 ) {}
+            uint128_t version; //!< the barrier version of the tree
+            uint32_t height; //!< participants in the local subtree
+            NodePtr parent; //!< the parent, invalid on the root node
+        };
+
+        /**
+         * The tree of the current version, written by the application thread
+         * and read by the command thread.
+         */
+        base::Lockable< Tree, base::SpinLock > _tree;
+
+        struct TreeRequest
+        {
+            TreeRequest() : count( 0 ) {}
+            uint32_t count; //!< entered participants in the local subtree
+            Nodes children; //!< the children which have entered
+        };
+
+        /** Subtree enter requests, index per version. */
+        std::map< uint128_t, TreeRequest > _treeRequests;
+
         struct Request
         {
             Request() 
@@ -122,9 +204,17 @@ namespace co
         void _cleanup( const uint64_t time );
         void _sendNotify( const uint128_t& version, NodePtr node );
 
+        bool _isTree() const;
+        void _updateTree();
+        void _buildTree( Tree& tree );
+        void _enterTree( const uint32_t timeout );
+        void _leaveTree( const uint128_t& version );
+
         /* The command handlers. */
         bool _cmdEnter( Command& command );
         bool _cmdEnterReply( Command& command );
+        bool _cmdTreeEnter( Command& command );
+        bool _cmdTreeLeave( Command& command );
 
         EQ_TS_VAR( _thread );
     };
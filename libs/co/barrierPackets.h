@@ -51,6 +51,33 @@ namespace co
         const uint128_t version;
     };
 
+    struct BarrierTreeEnterPacket : public ObjectPacket
+    {
+        BarrierTreeEnterPacket( const uint128_t& version_,
+                                const uint32_t count_ )
+                : version( version_ )
+                , count( count_ )
+                , handled( false )
+            {
+                command = CMD_BARRIER_TREE_ENTER;
+                size    = sizeof( BarrierTreeEnterPacket );
+            }
+        const uint128_t version;
+        const uint32_t count; //!< the number of participants entered
+        bool handled;
+    };
+
+    struct BarrierTreeLeavePacket : public ObjectPacket
+    {
+        BarrierTreeLeavePacket( const uint128_t& version_ )
+                : version( version_ )
+            {
+                command = CMD_BARRIER_TREE_LEAVE;
+                size    = sizeof( BarrierTreeLeavePacket );
+            }
+        const uint128_t version;
+    };
+
     inline std::ostream& operator << ( std::ostream& os, 
                                        const BarrierEnterPacket* packet )
     {
@@ -23,11 +23,15 @@
 #  define EQ_ALIGN8( var )  __declspec (align (8)) var;
 /** Declare and align a variable to a 16-byte boundary. */
 #  define EQ_ALIGN16( var ) __declspec (align (16)) var;
+/** Align a struct or class to a 64-byte cache line boundary. */
+#  define EQ_ALIGN_CACHELINE __declspec (align (64))
 #else
 /** Declare and align a variable to a 8-byte boundary. */
 #  define EQ_ALIGN8( var )  var __attribute__ ((aligned (8)));
 /** Declare and align a variable to a 16-byte boundary. */
 #  define EQ_ALIGN16( var ) var __attribute__ ((aligned (16)));
+/** Align a struct or class to a 64-byte cache line boundary. */
+#  define EQ_ALIGN_CACHELINE __attribute__ ((aligned (64)))
 #endif
 
 #ifdef __GNUC__
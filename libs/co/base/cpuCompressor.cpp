@@ -94,6 +94,7 @@ uint32_t CPUCompressor::chooseCompressor( const uint32_t tokenType,
 {
     uint32_t name = EQ_COMPRESSOR_NONE;
     float ratio = 1.0f;
+    float speed = 0.0f;
     float minDiffQuality = 1.0f;
 
     PluginRegistry& registry = Global::getPluginRegistry();
@@ -134,11 +135,15 @@ uint32_t CPUCompressor::chooseCompressor( const uint32_t tokenType,
             
             const float diffQuality = info.quality - minQuality;
             if( ratio >= infoRatio && diffQuality <= minDiffQuality &&
-                info.quality >= minQuality )
+                info.quality >= minQuality &&
+                // prefer the faster one of equivalent compressors
+                ( ratio > infoRatio || diffQuality < minDiffQuality ||
+                  speed <= info.speed ))
             {
                 minDiffQuality = diffQuality;
                 name = info.name;
                 ratio = infoRatio;
+                speed = info.speed;
             }
         }
     }
@@ -29,6 +29,7 @@ set(COBASE_PUBLIC_HEADERS
     log.h
     memoryMap.h
     monitor.h
+    mpmcQueue.h
     mtQueue.h
     nonCopyable.h
     omp.h
@@ -0,0 +1,338 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef COBASE_MPMCQUEUE_H
+#define COBASE_MPMCQUEUE_H
+
+#include <co/base/atomic.h>       // member
+#include <co/base/condition.h>    // member
+#include <co/base/debug.h>        // used in inline method
+#include <co/base/lock.h>         // member
+#include <co/base/nonCopyable.h>  // base class
+
+#include <deque>
+#include <vector>
+
+namespace co
+{
+namespace base
+{
+    /**
+     * A thread-safe, lock-free queue for multiple readers and writers.
+     *
+     * The elements are stored in a ring buffer of fixed capacity, which is
+     * accessed using only atomic operations. Pushing to a full queue and
+     * popping from an empty queue blocks. The blocking operations wait on a
+     * condition, which is only signalled if a thread is waiting. This keeps
+     * the system call overhead out of the common case, like a futex does.
+     *
+     * Current implementation constraints:
+     * <ul>
+     *   <li>Fixed maximum size, rounded up to the next power of two</li>
+     *   <li>pushFront() is not lock-free</li>
+     *   <li>Not copyable</li>
+     * </ul>
+     */
+    template< typename T > class MPMCQueue : public NonCopyable
+    {
+    public:
+        /**
+         * Construct a new queue.
+         *
+         * @param capacity the minimum number of elements held by the queue.
+         * @version 1.1.5
+         */
+        explicit MPMCQueue( const int32_t capacity )
+                : _cells( _getSize( capacity ))
+                , _mask( int32_t( _cells.size( )) - 1 )
+                , _readPos( 0 )
+                , _writePos( 0 )
+                , _nFront( 0 )
+                , _nReaders( 0 )
+                , _nWriters( 0 )
+                , _readSignal( 0 )
+                , _writeSignal( 0 )
+            {
+                for( int32_t i = 0; i <= _mask; ++i )
+                    _cells[i].sequence = i;
+            }
+
+        /** Destruct this queue. @version 1.1.5 */
+        ~MPMCQueue() {}
+
+        /**
+         * @return true if the queue is empty, false otherwise. Not exact if
+         *         the queue is modified concurrently.
+         * @version 1.1.5
+         */
+        bool isEmpty() const { return getSize() == 0; }
+
+        /**
+         * @return the number of elements in the queue. Not exact if the queue
+         *         is modified concurrently.
+         * @version 1.1.5
+         */
+        size_t getSize() const
+            {
+                const int32_t size = _distance( _readPos, _writePos );
+                return size_t( size < 0 ? 0 : size ) + size_t( _nFront );
+            }
+
+        /**
+         * @return the maximum number of elements held by the queue.
+         * @version 1.1.5
+         */
+        size_t getCapacity() const { return _cells.size(); }
+
+        /**
+         * Push a new element to the back of the queue.
+         *
+         * @param element the element to add.
+         * @return true if the element was placed, false if the queue is full
+         * @version 1.1.5
+         */
+        bool tryPush( const T& element )
+            {
+                if( !_push( element ))
+                    return false;
+                _wakeup( _nReaders, _readSignal );
+                return true;
+            }
+
+        /**
+         * Push a new element to the back of the queue, blocks while the queue
+         * is full.
+         * @version 1.1.5
+         */
+        void push( const T& element )
+            {
+                if( !_push( element ))
+                {
+                    _cond.lock();
+                    ++_nWriters;
+                    while( true )
+                    {
+                        _writeSignal = 0;
+                        if( _push( element ))
+                            break;
+                        _cond.wait();
+                    }
+                    --_nWriters;
+                    _cond.unlock();
+                }
+                _wakeup( _nReaders, _readSignal );
+            }
+
+        /**
+         * Push a new element to the front of the queue.
+         *
+         * Elements pushed to the front are popped before all elements pushed
+         * to the back. Uses a lock, and is therefore not lock-free.
+         * @version 1.1.5
+         */
+        void pushFront( const T& element )
+            {
+                _frontLock.set();
+                _front.push_front( element );
+                ++_nFront;
+                _frontLock.unset();
+                _wakeup( _nReaders, _readSignal );
+            }
+
+        /**
+         * Retrieve and pop the front element from the queue.
+         *
+         * @param result the front value or unmodified
+         * @return true if an element was placed in result, false if the queue
+         *         is empty.
+         * @version 1.1.5
+         */
+        bool tryPop( T& result )
+            {
+                if( !_pop( result ))
+                    return false;
+                _wakeup( _nWriters, _writeSignal );
+                return true;
+            }
+
+        /**
+         * Retrieve and pop the front element from the queue, may block.
+         * @version 1.1.5
+         */
+        T pop()
+            {
+                T element;
+                EQCHECK( timedPop( EQ_TIMEOUT_INDEFINITE, element ));
+                return element;
+            }
+
+        /**
+         * Retrieve and pop the front element from the queue.
+         *
+         * @param timeout the timeout in milliseconds.
+         * @param element the element returned.
+         * @return true if an element was popped, false on timeout.
+         * @version 1.1.5
+         */
+        bool timedPop( const uint32_t timeout, T& element )
+            {
+                if( !_pop( element ))
+                {
+                    _cond.lock();
+                    ++_nReaders;
+                    while( true )
+                    {
+                        _readSignal = 0;
+                        if( _pop( element ))
+                            break;
+                        if( !_cond.timedWait( timeout ))
+                        {
+                            --_nReaders;
+                            _cond.unlock();
+                            return false;
+                        }
+                    }
+                    --_nReaders;
+                    _cond.unlock();
+                }
+                _wakeup( _nWriters, _writeSignal );
+                return true;
+            }
+
+    private:
+        struct Cell
+        {
+            a_int32_t sequence; //!< position of the next write or read
+            T data;
+        };
+
+        std::vector< Cell > _cells;
+        const int32_t _mask;
+
+        a_int32_t _readPos;
+        a_int32_t _writePos;
+
+        std::deque< T > _front; //!< elements pushed to the front
+        a_int32_t _nFront;
+        Lock _frontLock;
+
+        a_int32_t _nReaders; //!< number of threads waiting for data
+        a_int32_t _nWriters; //!< number of threads waiting for space
+        a_int32_t _readSignal;  //!< readers have been woken up
+        a_int32_t _writeSignal; //!< writers have been woken up
+        Condition _cond;
+
+        static size_t _getSize( const int32_t capacity )
+            {
+                EQASSERT( capacity > 0 );
+                size_t size = 1;
+                while( size < size_t( capacity ))
+                    size <<= 1;
+                return size;
+            }
+
+        /** @return to - from, with wrap-around of the positions. */
+        static int32_t _distance( const int32_t from, const int32_t to )
+            { return int32_t( uint32_t( to ) - uint32_t( from )); }
+
+        static int32_t _advance( const int32_t pos, const int32_t n )
+            { return int32_t( uint32_t( pos ) + uint32_t( n )); }
+
+        bool _push( const T& element )
+            {
+                int32_t pos = _writePos;
+                Cell* cell;
+                while( true )
+                {
+                    cell = &_cells[ pos & _mask ];
+                    const int32_t distance = _distance( pos, cell->sequence );
+                    if( distance == 0 )
+                    {
+                        if( _writePos.compareAndSwap( pos, _advance( pos, 1 )))
+                            break;
+                    }
+                    else if( distance < 0 ) // cell not yet read
+                        return false;
+                    pos = _writePos;
+                }
+
+                cell->data = element;
+                memoryBarrier(); // publish data before sequence
+                cell->sequence = _advance( pos, 1 );
+                return true;
+            }
+
+        bool _pop( T& element )
+            {
+                if( _nFront > 0 && _popFront( element ))
+                    return true;
+
+                int32_t pos = _readPos;
+                Cell* cell;
+                while( true )
+                {
+                    cell = &_cells[ pos & _mask ];
+                    const int32_t distance = _distance( _advance( pos, 1 ),
+                                                        cell->sequence );
+                    if( distance == 0 )
+                    {
+                        if( _readPos.compareAndSwap( pos, _advance( pos, 1 )))
+                            break;
+                    }
+                    else if( distance < 0 ) // cell not yet written
+                        return false;
+                    pos = _readPos;
+                }
+
+                element = cell->data;
+                memoryBarrier(); // read data before releasing the cell
+                cell->sequence = _advance( pos, _mask + 1 );
+                return true;
+            }
+
+        bool _popFront( T& element )
+            {
+                _frontLock.set();
+                if( _front.empty( ))
+                {
+                    _frontLock.unset();
+                    return false;
+                }
+                element = _front.front();
+                _front.pop_front();
+                --_nFront;
+                _frontLock.unset();
+                return true;
+            }
+
+        /**
+         * Wake up waiting threads. The signal flag is cleared by the waiting
+         * threads before they re-check the queue, which limits the wakeups to
+         * one per wait.
+         */
+        void _wakeup( const a_int32_t& waiters, a_int32_t& signal )
+            {
+                if( waiters <= 0 || !signal.compareAndSwap( 0, 1 ))
+                    return;
+
+                _cond.lock();
+                _cond.broadcast();
+                _cond.unlock();
+            }
+    };
+}
+}
+#endif // COBASE_MPMCQUEUE_H
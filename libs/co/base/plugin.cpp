@@ -70,6 +70,15 @@ bool Plugin::init( const std::string& libraryName )
     
     upload = ( Upload_t )
         ( _dso.getFunctionPointer( "EqCompressorUpload" ));
+
+    startDownload = ( StartDownload_t )
+        ( _dso.getFunctionPointer( "EqCompressorStartDownload" ));
+
+    finishDownload = ( FinishDownload_t )
+        ( _dso.getFunctionPointer( "EqCompressorFinishDownload" ));
+
+    deleteGLObjects = ( DeleteGLObjects_t )
+        ( _dso.getFunctionPointer( "EqCompressorDeleteGLObjects" ));
     
     const bool foundBase = newDecompressor && newCompressor &&
         deleteCompressor && deleteDecompressor && getInfo && getNumCompressors;
@@ -101,6 +110,15 @@ bool Plugin::init( const std::string& libraryName )
         info.outputTokenSize = 0;
         getInfo( i, &info );
 
+        if(( info.capabilities & EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD ) &&
+            ( !startDownload || !finishDownload ))
+        {
+            EQWARN << "Compressor 0x" << std::hex << info.name << std::dec
+                   << " in " << libraryName << " claims async download "
+                   << "support, but does not implement it" << std::endl;
+            info.capabilities &= ~EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD;
+        }
+
         if( !( info.capabilities & EQ_COMPRESSOR_TRANSFER ))
         {
             if( info.outputTokenType == EQ_COMPRESSOR_DATATYPE_NONE )
@@ -142,7 +160,12 @@ void Plugin::exit()
     getNumResults = 0;
     getNumCompressors = 0;
     getResult = 0;
-
+    isCompatible = 0;
+    download = 0;
+    upload = 0;
+    startDownload = 0;
+    finishDownload = 0;
+    deleteGLObjects = 0;
 }
 
 void Plugin::initChildren()
@@ -58,6 +58,15 @@ namespace base
                                       const GLEWContext*, const uint64_t*,
                                       const unsigned, const uint64_t,
                                       uint64_t*, void** );
+        typedef void ( *StartDownload_t )( void* const, const unsigned,
+                                           const GLEWContext*, const uint64_t*,
+                                           const unsigned, const uint64_t );
+        typedef void ( *FinishDownload_t )( void* const, const unsigned,
+                                            const GLEWContext*,
+                                            const uint64_t*, const uint64_t,
+                                            uint64_t*, void** );
+        typedef void ( *DeleteGLObjects_t )( void* const, const unsigned,
+                                             const GLEWContext* );
         typedef void ( *Upload_t )( void* const, const unsigned, 
                                     const GLEWContext*, const void*,
                                     const uint64_t*,
@@ -111,6 +120,15 @@ namespace base
         /** Upload pixel data. */
         Upload_t  upload;
 
+        /** Start an asynchronous pixel data download (optional). */
+        StartDownload_t startDownload;
+
+        /** Finish an asynchronous pixel data download (optional). */
+        FinishDownload_t finishDownload;
+
+        /** Delete the OpenGL objects of a transfer instance (optional). */
+        DeleteGLObjects_t deleteGLObjects;
+
         /** @return true if name is found in the plugin. */
         bool implementsType( const uint32_t name ) const;
 
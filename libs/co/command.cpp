@@ -18,16 +18,21 @@
 #include "command.h"
 
 #include "node.h"
+#include "payloadReceiver.h"
 
 namespace co
 {
 
-Command::Command( base::a_int32_t& freeCounter ) 
+Command::Command( FreeList& freeList, Packet* data, const uint64_t dataSize )
         : _packet( 0 )
-        , _data( 0 )
-        , _dataSize( 0 )
-        , _refCountMaster( 0 )
-        , _freeCount( freeCounter )
+        , _data( data )
+        , _dataSize( dataSize )
+        , _slabData( data )
+        , _master( 0 )
+        , _nextFree( 0 )
+        , _payload( 0 )
+        , _payloadReceiver( 0 )
+        , _freeList( freeList )
         , _func( 0, 0 )
 {}
 
@@ -39,64 +44,91 @@ Command::~Command()
 
 void Command::retain()
 {
-    //EQ_TS_THREAD( _writeThread );
-    if( ++_refCount == 1 ) // first reference
+    _refCount += 2;
+    if( _master )
     {
-        EQASSERT( _refCount == 1 ); // ought to be single-threaded in recv
-        EQASSERT( _freeCount > 0 );
-        --_freeCount;
+        _master->_refCount += 2;
+        EQASSERT( _master->_refCount >= _refCount - 1 );
     }
+}
 
-    if( _refCountMaster )
+void Command::release() 
+{
+    if( _master ) // do it before self - otherwise race!
     {
-        if( ++( *_refCountMaster ) == 1 )
-            --_freeCount;
-        EQASSERT( *_refCountMaster >= _refCount );
+        EQASSERT( _master->_refCount > 1 );
+        if( ( _master->_refCount -= 2 ) == 0 ) // last reference
+            _master->_release();
     }
+
+    EQASSERT( _refCount > 1 );
+    if( ( _refCount -= 2 ) == 0 ) // last reference
+        _release();
 }
 
-void Command::release() 
+void Command::releaseCache_()
+{
+    EQASSERT( _refCount & 1 );
+    if( --_refCount == 0 )
+        _release();
+}
+
+void Command::_release()
 {
-    if( _refCountMaster ) // do it before self - otherwise race!
+    if( _payload )
     {
-        EQASSERT( *_refCountMaster != 0 );
-        if( --( *_refCountMaster ) == 0 ) // last reference
-            ++_freeCount;
+        _payloadReceiver->releasePayload( _payload );
+        _payload = 0;
+        _payloadReceiver = 0;
     }
+    _freeList.push( this );
+}
 
-    EQASSERT( _refCount != 0 );
-    if( --_refCount == 0 ) // last reference
-        ++_freeCount;
+void Command::setPayload_( PayloadReceiver* receiver, base::Bufferb* payload )
+{
+    EQASSERT( !_payload );
+    EQASSERT( !_master );
+    _payload = payload;
+    _payloadReceiver = receiver;
 }
 
-size_t Command::alloc_( NodePtr node, LocalNodePtr localNode,
-                        const uint64_t size )
+int64_t Command::alloc_( NodePtr node, LocalNodePtr localNode,
+                         const uint64_t size )
 {
     EQ_TS_THREAD( _writeThread );
     EQASSERT( _refCount == 0 );
     EQASSERTINFO( !_func.isValid(), *this );
 
-    size_t allocated = 0;
+    int64_t allocated = 0;
     if( !_data )
     {
         _dataSize = EQ_MAX( Packet::minSize, size );
         _data = static_cast< Packet* >( malloc( _dataSize ));
         allocated = _dataSize;
     }
-    else if( size > _dataSize )
+    else if( size > _dataSize || 
+             // shrink big allocations reused for much smaller packets
+             ( _data != _slabData && _dataSize > EQ_1MB &&
+               _dataSize > ( size << 3 )))
     {
-        allocated =  size - _dataSize;
-        _dataSize = EQ_MAX( Packet::minSize, size );
-        free( _data );
+        const uint64_t dataSize = EQ_MAX( Packet::minSize, size );
+        if( _data != _slabData )
+        {
+            allocated -= _dataSize;
+            free( _data );
+        }
+        allocated += dataSize;
+        _dataSize = dataSize;
         _data = static_cast< Packet* >( malloc( _dataSize ));
     }
 
     _node = node;
     _localNode = localNode;
-    _refCountMaster = 0;
+    _master = 0;
     _func.clear();
     _packet = _data;
     _packet->size = size;
+    _refCount = 1;
 
     return allocated;
 }
@@ -110,8 +142,9 @@ void Command::clone_( Command& from )
     _node = from._node;
     _localNode = from._localNode;
     _packet = from._packet;
+    _refCount = 1;
 
-    _refCountMaster = &from._refCount;
+    _master = &from;
 }
 
 void Command::_free()
@@ -120,15 +153,15 @@ void Command::_free()
     EQASSERT( _refCount == 0 );
     EQASSERT( !_func.isValid( ));
 
-    if( _data )
+    if( _data != _slabData )
         free( _data );
 
-    _data = 0;
+    _data = _slabData;
     _dataSize = 0;
     _packet = 0;
     _node = 0;
     _localNode = 0;
-    _refCountMaster = 0;
+    _master = 0;
 }        
 
 bool Command::operator()()
@@ -159,8 +192,8 @@ std::ostream& operator << ( std::ostream& os, const Command& command )
                 os << packet;
         }
 
-        os << ", " << command.getNode() << ", r" << command._refCount << " >"
-           << base::enableFlush;
+        os << ", " << command.getNode() << ", r"
+           << ( command._refCount >> 1 ) << " >" << base::enableFlush;
     }
     else
         os << "command< empty >";
@@ -21,11 +21,13 @@
 #include <co/api.h>
 #include <co/localNode.h> // NodePtr members
 
-#include <co/base/atomic.h> // member
-#include <co/base/refPtr.h> // NodePtr
+#include <co/base/atomic.h>    // member
+#include <co/base/buffer.h>    // Bufferb
+#include <co/base/refPtr.h>    // NodePtr
 
 namespace co
 {    
+    class PayloadReceiver;
     struct Packet;
 
     /**
@@ -38,6 +40,9 @@ namespace co
     class Command 
     {
     public:
+        /** @internal The unused commands of a CommandCache. */
+        typedef CommandCache::FreeList FreeList;
+
         /** @name Data Access */
         //@{
         template< class P > P* getModifiable()
@@ -55,13 +60,17 @@ namespace co
         bool isValid() const { return ( _packet!=0 ); }
         uint64_t getAllocationSize() const { return _dataSize; }
 
+        /** @return the payload received by a PayloadReceiver, or 0. */
+        base::Bufferb* getPayload()
+            { return _master ? _master->_payload : _payload; }
+
         void setDispatchFunction( const Dispatcher::Func& func )
             { EQASSERT( !_func.isValid( )); _func = func; }
         //@}
 
         /** @name Usage tracking. */
         //@{
-        bool isFree() const { return ( _refCount==0 ); }
+        bool isFree() const { return ( _refCount < 2 ); }
         CO_API void retain();
         CO_API void release();
         //@}
@@ -69,12 +78,26 @@ namespace co
         /** Invoke and clear the command function of a dispatched command. */
         CO_API bool operator()();
 
-        explicit Command( base::a_int32_t& freeCounter ); //!< @internal
+        /**
+         * @internal
+         * Construct a new command.
+         *
+         * @param freeList the free list receiving the command when it is released.
+         * @param data preallocated packet memory owned by the caller, or 0.
+         * @param dataSize the size of the preallocated packet memory.
+         */
+        Command( FreeList& freeList, Packet* data, const uint64_t dataSize );
         ~Command(); //!< @internal
 
-        /** @internal @return the number of newly allocated bytes. */
-        size_t alloc_( NodePtr node, LocalNodePtr localNode,
-                       const uint64_t size );
+        /**
+         * @internal
+         * Initialize the command for a new packet.
+         *
+         * The command is held by the cache until releaseCache_() is called.
+         * @return the change of the allocation size in bytes.
+         */
+        int64_t alloc_( NodePtr node, LocalNodePtr localNode,
+                        const uint64_t size );
 
         /** 
          * @internal Clone the from command into this command.
@@ -82,16 +105,31 @@ namespace co
          * The command will share all data but the dispatch function. The
          * command's allocation size will be 0 and it will never delete the
          * shared data. The command will (de)reference the from command on each
-         * retain/release.
+         * retain/release. The from command may belong to another cache.
          */
         void clone_( Command& from );
 
+        /**
+         * @internal
+         * Attach a payload, released using the given receiver together with
+         * the command.
+         */
+        void setPayload_( PayloadReceiver* receiver, base::Bufferb* payload );
+
+        /**
+         * @internal Release the cache reference set by alloc_() or clone_().
+         *
+         * Puts the command into its free list if it is not retained.
+         */
+        void releaseCache_();
+
     private:
         Command& operator = ( Command& rhs ); // disable assignment
         Command( const Command& from );       // disable copy
         Command();                            // disable default ctor
 
         void _free();
+        void _release();
 
         NodePtr       _node;      //!< The node sending the packet
         LocalNodePtr  _localNode; //!< The node receiving the packet
@@ -99,12 +137,20 @@ namespace co
 
         Packet*  _data;     //!< Our allocated data
         uint64_t _dataSize; //!< The size of the allocation
+        Packet* const _slabData; //!< Preallocated data, not owned
+
+        Command* _master; //!< The cloned command, or 0
+        Command* _nextFree; //!< The next command in the free list
+
+        base::Bufferb* _payload; //!< Payload received separately, or 0
+        PayloadReceiver* _payloadReceiver; //!< The owner of _payload
 
-        base::a_int32_t* _refCountMaster;
+        /** Twice the number of references, plus one while held by the cache */
         base::a_int32_t  _refCount;
-        base::a_int32_t& _freeCount;
+        FreeList& _freeList;
 
         Dispatcher::Func _func;
+        friend class CommandCache::FreeList;
         friend CO_API std::ostream& operator << (std::ostream&, const Command&);
 
         EQ_TS_VAR( _writeThread );
@@ -20,38 +20,23 @@
 #include "command.h"
 #include "node.h"
 
-#define COMPACT
-//#define PROFILE
-// 31300 hits, 35 misses, 297640 lookups, 126976b allocated in 31 packets
-// 31300 hits, 35 misses, 49228 lookups, 135168b allocated in 34 packets
+#include <new>
 
 namespace co
 {
 namespace
 {
-// minimum number of free packets, at least 2
-static const int32_t _minFree[2] = { 200, 20 };
-static const uint32_t _freeShift = 1; // 'size >> shift' packets can be free
-
-
-#ifdef PROFILE
-static base::a_int32_t _hits;
-static base::a_int32_t _misses;
-static base::a_int32_t _lookups;
-static base::a_int32_t _allocs;
-static base::a_int32_t _frees;
-#endif
+/** The minimum number of commands in a new slab. */
+static const uint32_t _minSlabSize = 16;
 }
 
 CommandCache::CommandCache()
+        : _hits( 0 )
+        , _misses( 0 )
+        , _bytes( 0 )
 {
     for( size_t i = 0; i < CACHE_ALL; ++i )
-    {
-        _cache[i].push_back( new Command( _free[i] ));
-        _position[i] = _cache[i].begin();
-        _free[i] = 1;
-        _maxFree[i] = _minFree[i];
-    }
+        _size[i] = 0;
 }
 
 CommandCache::~CommandCache()
@@ -59,144 +44,141 @@ CommandCache::~CommandCache()
     flush();
 
     for( size_t i = 0; i < CACHE_ALL; ++i )
-    {
-        EQASSERT( _cache[i].size() == 1 );
-        EQASSERT( _cache[i].front()->isFree( ));
-
-        delete _cache[i].front();
-        _cache[i].clear();
-    }
+        EQASSERT( _slabs[i].empty( ));
 }
 
 void CommandCache::flush()
 {
-    for( size_t i = 0; i < CACHE_ALL; ++i )
+    for( std::vector< Command* >::const_iterator i = _pending.begin();
+         i != _pending.end(); ++i )
     {
-        Data& cache = _cache[i];
-        EQASSERTINFO( size_t( _free[i] ) == cache.size(),
-                      _free[i] << " != " << cache.size() );
+        (*i)->releaseCache_();
+    }
+    _pending.clear();
 
-        for( DataCIter j = cache.begin(); j != cache.end(); ++j )
+    for( size_t i = 0; i < CACHE_ALL; ++i )
+    {
+        uint32_t nFree = 0;
+        while( Command* command = _freeList[i].pop( ))
         {
-            Command* command = *j;
             EQASSERT( command->isFree( ));
-            delete command;
+            ++nFree;
         }
+        EQASSERTINFO( nFree == _size[i], nFree << " != " << _size[i] );
 
-        cache.clear();
-        cache.push_back( new Command( _free[i] ));
-        _free[i] = 1;
-        _maxFree[i] = _minFree[i];
-        _position[i] = _cache[i].begin();
+        Slabs& slabs = _slabs[i];
+        for( SlabsCIter j = slabs.begin(); j != slabs.end(); ++j )
+        {
+            const Slab& slab = *j;
+            for( uint32_t k = 0; k < slab.size; ++k )
+                slab.commands[k].~Command();
+            free( slab.commands );
+            free( slab.data );
+        }
+        slabs.clear();
+        _size[i] = 0;
     }
+    _bytes = 0;
 }
 
-void CommandCache::_compact( const Cache which )
+void CommandCache::FreeList::push( Command* command )
 {
-#ifdef COMPACT
-    EQ_TS_THREAD( _thread );
-
-    base::a_int32_t& current = _free[ which ];
-    int32_t& maxFree = _maxFree[ which ];
-    if( current <= maxFree )
-        return;
+    for( ;; )
+    {
+        void* head = _head;
+        command->_nextFree = static_cast< Command* >( head );
+        if( base::Atomic< void* >::compareAndSwap( &_head, head, command ))
+            return;
+    }
+}
 
-    const int32_t target = maxFree >> 1;
-    EQASSERT( target > 0 );
-    Data& cache = _cache[ which ];
-    for( Data::iterator i = cache.begin(); i != cache.end(); )
+Command* CommandCache::FreeList::pop()
+{
+    if( !_local )
     {
-        const Command* cmd = *i;
-        if( cmd->isFree( ))
+        // take all commands released since the last refill at once
+        for( ;; )
         {
-            EQASSERT( current > 0 );
-            i = cache.erase( i );
-            delete cmd;
-
-#  ifdef PROFILE
-            ++_frees;
-#  endif
-            if( --current <= target )
+            void* head = _head;
+            if( !head )
+                return 0;
+            if( base::Atomic< void* >::compareAndSwap( &_head, head, 0 ))
+            {
+                _local = static_cast< Command* >( head );
                 break;
+            }
         }
-        else
-            ++i;
     }
 
-    const int32_t num = int32_t( cache.size() >> _freeShift );
-    maxFree = EQ_MAX( _minFree[ which ] , num );
-    _position[ which ] = cache.begin();
-#endif // COMPACT
+    Command* command = _local;
+    _local = command->_nextFree;
+    command->_nextFree = 0;
+    return command;
 }
 
-Command& CommandCache::_newCommand( const Cache which )
+void CommandCache::_releasePending()
 {
-    EQ_TS_THREAD( _thread );
+    // The last command is not reused, its packet may still be in use
+    if( _pending.size() < 2 )
+        return;
 
-    Data& cache = _cache[ which ];
-    const uint32_t cacheSize = uint32_t( cache.size( ));
-    base::a_int32_t& freeCounter = _free[ which ];
-    EQASSERTINFO( size_t( freeCounter ) <= cacheSize,
-                  freeCounter << " > " << cacheSize );
+    Command* last = _pending.back();
+    _pending.pop_back();
 
-    if( freeCounter > 0 )
+    for( std::vector< Command* >::const_iterator i = _pending.begin();
+         i != _pending.end(); ++i )
     {
-        EQASSERT( cacheSize > 0 );
-
-        const DataCIter end = _position[ which ];
-        DataCIter& i = _position[ which ];
+        (*i)->releaseCache_();
+    }
+    _pending.clear();
+    _pending.push_back( last );
+}
 
-        for( ++i; i != end; ++i )
-        {
-            if( i == cache.end( ))
-                i = cache.begin();
-#ifdef PROFILE
-            ++_lookups;
-#endif
-            Command* command = *i;
-            if( command->isFree( ))
-            {
-#ifdef PROFILE
-                const long hits = ++_hits;
-                if( (hits%1000) == 0 )
-                {
-                    for( size_t j = 0; j < CACHE_ALL; ++j )
-                    {
-                        size_t size = 0;
-                        const Data& cmds = _cache[ j ];
-                        for( DataCIter k=cmds.begin(); k != cmds.end(); ++k)
-                            size += (*k)->getAllocationSize();
-
-                        EQINFO << _hits << "/" << _hits + _misses << " hits, "
-                               << _lookups << " lookups, " << _free[j] << " of "
-                               << cmds.size() << " packets free, " << _allocs
-                               << " allocs, " << _frees << " frees, " 
-                               << size / 1024 << "KB" << std::endl;
-                    }
-                }
-#endif
-                return *command;
-            }
-        }
+void CommandCache::_addSlab( const Cache which )
+{
+    Slab slab;
+    slab.size = EQ_MAX( _minSlabSize, _size[ which ] );
+    slab.commands = static_cast< Command* >(
+        malloc( slab.size * sizeof( Command )));
+
+    // small commands use packet memory from the slab
+    const uint64_t dataSize = ( which == CACHE_SMALL ) ? Packet::minSize : 0;
+    slab.data = dataSize ?
+        static_cast< uint8_t* >( malloc( slab.size * dataSize )) : 0;
+
+    FreeList& freeList = _freeList[ which ];
+    for( uint32_t i = 0; i < slab.size; ++i )
+    {
+        Packet* data = dataSize ?
+            reinterpret_cast< Packet* >( slab.data + i * dataSize ) : 0;
+        Command* command = new( slab.commands + i )
+            Command( freeList, data, dataSize );
+        freeList.push( command );
     }
-#ifdef PROFILE
-    ++_misses;
-#endif
-    
-    const uint32_t add = (cacheSize >> 3) + 1;
-    for( size_t j = 0; j < add; ++j )
-        cache.push_back( new Command( freeCounter ));
 
-    freeCounter += add;
-    const int32_t num = int32_t( cache.size() >> _freeShift );
-    _maxFree[ which ] = EQ_MAX( _minFree[ which ], num );
-    _position[ which ] = cache.begin();
+    _slabs[ which ].push_back( slab );
+    _size[ which ] += slab.size;
+    _bytes += slab.size * ( sizeof( Command ) + dataSize );
+}
 
-#ifdef PROFILE
-    _allocs += add;
-#endif
+Command& CommandCache::_newCommand( const Cache which )
+{
+    EQ_TS_THREAD( _thread );
 
-    return *( cache.back( ));
+    FreeList& freeList = _freeList[ which ];
+    Command* command = freeList.pop();
+    if( command )
+        ++_hits;
+    else
+    {
+        ++_misses;
+        _addSlab( which );
+        command = freeList.pop();
+        EQASSERT( command );
+    }
+
+    _pending.push_back( command );
+    return *command;
 }
 
 Command& CommandCache::alloc( NodePtr node, LocalNodePtr localNode, 
@@ -207,10 +189,10 @@ Command& CommandCache::alloc( NodePtr node, LocalNodePtr localNode,
                   "Out-of-sync network stream: packet size " << size << "?" );
 
     const Cache which = (size > Packet::minSize) ? CACHE_BIG : CACHE_SMALL;
-
-    _compact( which );
+    _releasePending();
     Command& command = _newCommand( which );
-    command.alloc_( node, localNode, size );
+
+    _bytes += command.alloc_( node, localNode, size );
     return command;
 }
 
@@ -227,18 +209,23 @@ Command& CommandCache::clone( Command& from )
 
 std::ostream& operator << ( std::ostream& os, const CommandCache& cache )
 {
-    const CommandCache::Data& commands =
-        cache._cache[ CommandCache::CACHE_SMALL ];
+    const CommandCache::Slabs& slabs =
+        cache._slabs[ CommandCache::CACHE_SMALL ];
     os << base::disableFlush << "Cache has "
-       << commands.size() - cache._free[ CommandCache::CACHE_SMALL ]
-       << " used small packets:" << std::endl
+       << cache._size[ CommandCache::CACHE_SMALL ]
+       << " small packets, " << cache._hits << " hits, " << cache._misses
+       << " misses, " << cache._bytes << " bytes:" << std::endl
        << base::indent << base::disableHeader;
 
-    for( CommandCache::DataCIter i = commands.begin(); i != commands.end(); ++i)
+    for( CommandCache::SlabsCIter i = slabs.begin(); i != slabs.end(); ++i )
     {
-        const Command* command = *i;
-        if( !command->isFree( ))
-            os << *command << std::endl;
+        const CommandCache::Slab& slab = *i;
+        for( uint32_t j = 0; j < slab.size; ++j )
+        {
+            const Command& command = slab.commands[j];
+            if( !command.isFree( ))
+                os << command << std::endl;
+        }
     }
     os << base::enableHeader << base::exdent << base::enableFlush ;
     return os;
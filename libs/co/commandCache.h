@@ -20,8 +20,7 @@
 
 #include <co/types.h>
 #include <co/api.h>
-#include <co/base/atomic.h> // member
-#include <co/base/thread.h> // thread-safety checks
+#include <co/base/thread.h>    // thread-safety checks
 
 namespace co
 {
@@ -32,10 +31,41 @@ namespace co
      *
      * Commands are retained and released whenever they are not directly
      * processed, e.g., when pushed to another thread using a CommandQueue.
+     *
+     * Commands are allocated in slabs for small and big packets. Small
+     * commands use packet memory from their slab. Released commands are put
+     * into a lock-free free list from any thread, from which alloc() takes
+     * them in constant time. A command which was not retained is reused after
+     * the next alloc(). When no command is free, alloc() adds a new slab, so
+     * the receiving thread never waits for a command to be released.
      */
     class CommandCache
     {
     public:
+        /**
+         * @internal
+         * The unused commands of one size class.
+         *
+         * An unbounded lock-free stack linking the commands themselves.
+         * Commands are pushed from any thread, but only the thread owning the
+         * cache pops them, which avoids the ABA problem.
+         */
+        class FreeList
+        {
+        public:
+            FreeList() : _head( 0 ), _local( 0 ) {}
+
+            /** Add a released command. Thread-safe. */
+            void push( Command* command );
+
+            /** @return an unused command, or 0 if none is available. */
+            Command* pop();
+
+        private:
+            void* _head;     //!< Commands pushed by any thread
+            Command* _local; //!< Commands taken from _head by the owner
+        };
+
         CO_API CommandCache();
         CO_API ~CommandCache();
 
@@ -49,6 +79,15 @@ namespace co
         /** Flush all allocated commands. */
         void flush();
 
+        /** @return the number of allocations using a free command. */
+        uint64_t getHits() const { return _hits; }
+
+        /** @return the number of allocations needing a new slab. */
+        uint64_t getMisses() const { return _misses; }
+
+        /** @return the number of bytes allocated for commands and packets. */
+        uint64_t getAllocatedBytes() const { return _bytes; }
+
     private:
         enum Cache
         {
@@ -57,22 +96,34 @@ namespace co
             CACHE_ALL
         };
 
-        typedef std::vector< Command* > Data;
-        typedef Data::const_iterator DataCIter;
+        /** A contiguous allocation of commands and their packet memory. */
+        struct Slab
+        {
+            Command* commands;
+            uint8_t* data;
+            uint32_t size;
+        };
+        typedef std::vector< Slab > Slabs;
+        typedef Slabs::const_iterator SlabsCIter;
+
+        /** The slabs of each cache. */
+        Slabs _slabs[ CACHE_ALL ];
 
-        /** The caches. */
-        Data _cache[ CACHE_ALL ];
+        /** The number of commands in each cache. */
+        uint32_t _size[ CACHE_ALL ];
 
-        /** Last lookup position in each cache. */
-        DataCIter _position[ CACHE_ALL ];
+        /** The unused commands of each cache. */
+        FreeList _freeList[ CACHE_ALL ];
 
-        /** The current number of free items in each cache */
-        base::a_int32_t _free[ CACHE_ALL ];
+        /** Commands allocated and cloned since the last alloc(). */
+        std::vector< Command* > _pending;
 
-        /** The maximum number of free items in each cache */
-        int32_t _maxFree[ CACHE_ALL ];
+        uint64_t _hits;
+        uint64_t _misses;
+        uint64_t _bytes;
 
-        void _compact( const Cache which );
+        void _releasePending();
+        void _addSlab( const Cache which );
         Command& _newCommand( const Cache which );
 
         friend std::ostream& operator << ( std::ostream&, const CommandCache& );
@@ -21,9 +21,19 @@
 #include "exception.h"
 #include "node.h"
 
+#include <co/base/scopedMutex.h>
+
 namespace co
 {
+namespace
+{
+/** The number of commands queued lock-free, see _overflow for the rest. */
+static const int32_t _capacity = 16384;
+}
+
 CommandQueue::CommandQueue()
+        : _commands( _capacity )
+        , _nOverflow( 0 )
 {
 }
 
@@ -38,10 +48,12 @@ void CommandQueue::flush()
         EQWARN << "Flushing non-empty command queue" << std::endl;
 
     Command* command( 0 );
-    while( _commands.tryPop( command ))
+    while( _tryPop( command ))
     {
+        if( !command ) // wakeup
+            continue;
+
         EQWARN << *command << std::endl;
-        EQASSERT( command );
         command->release();
     }
 }
@@ -50,7 +62,30 @@ void CommandQueue::push( Command& command )
 {
     EQASSERT( command.isValid( ));
     command.retain();
-    _commands.push( &command );
+    _push( &command );
+}
+
+void CommandQueue::_push( Command* command )
+{
+    // Lock-free unless the ring is full. Once commands overflow, all commands
+    // are queued behind them until the ring has caught up.
+    if( _nOverflow == 0 && _commands.tryPush( command ))
+        return;
+
+    base::ScopedMutex<> mutex( _overflowLock );
+    _overflow.push_back( command );
+    ++_nOverflow;
+    _refill(); // all readers might have popped the ring in the meantime
+}
+
+void CommandQueue::_refill()
+{
+    // _overflowLock is set
+    while( !_overflow.empty() && _commands.tryPush( _overflow.front( )))
+    {
+        _overflow.pop_front();
+        --_nOverflow;
+    }
 }
 
 void CommandQueue::pushFront( Command& command )
@@ -68,6 +103,11 @@ Command* CommandQueue::pop( const uint32_t timeout )
     if( !_commands.timedPop( timeout, command ))
         throw Exception( Exception::TIMEOUT_COMMANDQUEUE );
 
+    if( _nOverflow > 0 )
+    {
+        base::ScopedMutex<> mutex( _overflowLock );
+        _refill();
+    }
     return command;
 }
 
@@ -75,9 +115,22 @@ Command* CommandQueue::tryPop()
 {
     EQ_TS_THREAD( _thread );
     Command* command = 0;
-    _commands.tryPop( command );
+    _tryPop( command );
     return command;
 }
 
+bool CommandQueue::_tryPop( Command*& command )
+{
+    bool popped = _commands.tryPop( command );
+    if( _nOverflow > 0 )
+    {
+        base::ScopedMutex<> mutex( _overflowLock );
+        _refill();
+        if( !popped ) // ring was empty while refilling
+            popped = _commands.tryPop( command );
+    }
+    return popped;
+}
+
 }
 
@@ -19,17 +19,24 @@
 #define CO_COMMANDQUEUE_H
 
 #include <co/api.h>
+#include <co/base/atomic.h>
 #include <co/base/lock.h>
-#include <co/base/mtQueue.h>
+#include <co/base/mpmcQueue.h>
 #include <co/base/nonCopyable.h>
 #include <co/base/thread.h>
 
+#include <deque>
+
 namespace co
 {
     class Command;
 
     /**
      * A CommandQueue is a thread-safe queue for command packets.
+     *
+     * Commands are queued in a lock-free ring buffer. Pushing never blocks:
+     * when the ring is full, commands are queued in order in a locked overflow
+     * list, which is moved into the ring as the commands are popped.
      */
     class CommandQueue : public base::NonCopyable
     {
@@ -48,7 +55,7 @@ namespace co
         CO_API virtual void pushFront( Command& packet );
 
         /** Wake up the command queue, pop() will return 0. */
-        virtual void wakeup() { _commands.push( static_cast< Command* >( 0 )); }
+        virtual void wakeup() { _push( 0 ); }
 
         /** 
          * Pop a command from the queue.
@@ -75,19 +82,29 @@ namespace co
          * @return <code>true</code> if the command queue is empty,
          *         <code>false</code> if not. 
          */
-        bool isEmpty() const { return _commands.isEmpty(); }
+        bool isEmpty() const { return getSize() == 0; }
 
         /** Flush all cached commands. */
         CO_API void flush();
 
         /** @return the size of the queue. */
-        size_t getSize() const { return _commands.getSize(); }
+        size_t getSize() const
+            { return _commands.getSize() + size_t( _nOverflow ); }
 
         EQ_TS_VAR( _thread );
 
     private:
-        /** Thread-safe command queue. */
-        base::MTQueue< Command* >  _commands;
+        /** Thread-safe, lock-free command queue. */
+        base::MPMCQueue< Command* >  _commands;
+
+        /** Commands queued while the ring was full, in push order. */
+        std::deque< Command* > _overflow;
+        base::a_int32_t _nOverflow;
+        base::Lock _overflowLock;
+
+        CO_API void _push( Command* command );
+        bool _tryPop( Command*& command );
+        void _refill();
     };
 }
 
@@ -58,6 +58,8 @@ namespace co
         CMD_NODE_OBJECT_PUSH,
         CMD_NODE_PING,
         CMD_NODE_PING_REPLY,
+        CMD_NODE_MAP_OBJECTS,
+        CMD_NODE_RESTORE_INSTANCES,
         CMD_NODE_CUSTOM = 40  // some buffer for binary-compatible patches
     };
 
@@ -76,6 +78,8 @@ namespace co
     {
         CMD_BARRIER_ENTER = CMD_OBJECT_CUSTOM,
         CMD_BARRIER_ENTER_REPLY,
+        CMD_BARRIER_TREE_ENTER,
+        CMD_BARRIER_TREE_LEAVE,
         CMD_BARRIER_CUSTOM = 20 // some buffer for binary-compatible patches
     };
 
@@ -0,0 +1,333 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorLZ.h"
+
+#include <co/base/omp.h>
+#include <cstring>
+
+/*
+ * Each chunk is a sequence of tokens in the LZ4 block format:
+ *   token: literal length (high nibble), match length - 4 (low nibble)
+ *   [literal length - 15 as 255-byte runs] if the high nibble is 15
+ *   literals
+ *   offset of the match (2 bytes, little endian)
+ *   [match length - 19 as 255-byte runs] if the low nibble is 15
+ * The last token of a chunk has only literals.
+ */
+namespace co
+{
+namespace plugin
+{
+namespace
+{
+static void _getInfo( EqCompressorInfo* const info )
+{
+    info->version      = EQ_COMPRESSOR_VERSION;
+    info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;
+    info->quality      = 1.f;
+    info->ratio        = .5f;
+    info->speed        = .5f;
+    info->name         = EQ_COMPRESSOR_LZ_BYTE;
+    info->tokenType    = EQ_COMPRESSOR_DATATYPE_BYTE;
+}
+
+static bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions( EQ_COMPRESSOR_LZ_BYTE, _getInfo,
+                               CompressorLZ::getNewCompressor,
+                               CompressorLZ::getNewDecompressor,
+                               CompressorLZ::decompress, 0 ));
+    return true;
+}
+
+static bool _initialized = _register();
+
+static const uint64_t _minMatch = 4;
+static const uint64_t _maxOffset = 65535;
+static const uint64_t _lastLiterals = 5;  // matches end before the last bytes
+static const uint64_t _matchLimit = 12;   // matches start before the last bytes
+static const uint64_t _chunkSize = 65536; // minimum size for parallel chunks
+#define HASH_LOG 14
+
+inline uint32_t _read32( const uint8_t* const ptr )
+{
+    uint32_t value;
+    memcpy( &value, ptr, sizeof( value ));
+    return value;
+}
+
+inline uint32_t _hash( const uint32_t sequence )
+{
+    return ( sequence * 2654435761u ) >> ( 32 - HASH_LOG );
+}
+
+inline void _writeLength( uint64_t length, uint8_t*& out )
+{
+    for( ; length >= 255; length -= 255 )
+        *out++ = 255;
+    *out++ = uint8_t( length );
+}
+
+inline uint64_t _readLength( const uint8_t*& in )
+{
+    uint64_t length = 0;
+    uint8_t value;
+    do
+    {
+        value = *in++;
+        length += value;
+    }
+    while( value == 255 );
+    return length;
+}
+
+inline void _writeLiterals( const uint8_t* const literals,
+                            const uint64_t nLiterals,
+                            const uint64_t matchLength, uint8_t*& out )
+{
+    const uint64_t matchToken = matchLength < 15 ? matchLength : 15;
+    if( nLiterals < 15 )
+        *out++ = uint8_t(( nLiterals << 4 ) | matchToken );
+    else
+    {
+        *out++ = uint8_t( 0xf0 | matchToken );
+        _writeLength( nLiterals - 15, out );
+    }
+
+    memcpy( out, literals, nLiterals );
+    out += nLiterals;
+}
+
+/** @return the number of equal bytes starting at the two positions. */
+inline uint64_t _countEqual( const uint8_t* in, const uint8_t* ref,
+                             const uint8_t* const end )
+{
+    const uint8_t* const start = in;
+    while( in + sizeof( uint64_t ) <= end )
+    {
+        uint64_t a, b;
+        memcpy( &a, in, sizeof( a ));
+        memcpy( &b, ref, sizeof( b ));
+        if( a != b )
+            break;
+        in += sizeof( uint64_t );
+        ref += sizeof( uint64_t );
+    }
+    while( in < end && *in == *ref )
+    {
+        ++in;
+        ++ref;
+    }
+    return in - start;
+}
+
+uint64_t _compressChunk( const uint8_t* const in, const uint64_t size,
+                         uint8_t* out )
+{
+    uint8_t* const start = out;
+    const uint8_t* const end = in + size;
+    const uint8_t* anchor = in; // start of the pending literals
+
+    if( size > _matchLimit )
+    {
+        uint32_t table[ 1 << HASH_LOG ]; // position of the last occurence
+        memset( table, 0, sizeof( table ));
+
+        const uint8_t* const matchLimit = end - _matchLimit;
+        const uint8_t* const matchEnd = end - _lastLiterals;
+        const uint8_t* ip = in + 1;
+
+        while( ip < matchLimit )
+        {
+            const uint32_t sequence = _read32( ip );
+            const uint32_t hash = _hash( sequence );
+            const uint8_t* ref = in + table[ hash ];
+            table[ hash ] = uint32_t( ip - in );
+
+            if( uint64_t( ip - ref ) > _maxOffset || _read32( ref ) != sequence )
+            {
+                // skip faster over incompressible data
+                ip += 1 + (( ip - anchor ) >> 6 );
+                continue;
+            }
+
+            while( ip > anchor && ref > in && ip[-1] == ref[-1] )
+            {
+                --ip;
+                --ref;
+            }
+
+            const uint64_t length = _minMatch +
+                _countEqual( ip + _minMatch, ref + _minMatch, matchEnd );
+            const uint64_t offset = ip - ref;
+
+            _writeLiterals( anchor, ip - anchor, length - _minMatch, out );
+            *out++ = uint8_t( offset );
+            *out++ = uint8_t( offset >> 8 );
+            if( length - _minMatch >= 15 )
+                _writeLength( length - _minMatch - 15, out );
+
+            ip += length;
+            anchor = ip;
+            if( ip < matchLimit )
+                table[ _hash( _read32( ip - 2 )) ] = uint32_t( ip - 2 - in );
+        }
+    }
+
+    _writeLiterals( anchor, end - anchor, 0, out );
+    return out - start;
+}
+
+void _decompressChunk( const uint8_t* in, const uint64_t inSize, uint8_t* out,
+                       const uint64_t outSize )
+{
+    const uint8_t* const inEnd = in + inSize;
+    const uint8_t* const outEnd = out + outSize;
+
+    while( true )
+    {
+        const uint8_t token = *in++;
+        uint64_t length = token >> 4;
+        if( length == 15 )
+            length += _readLength( in );
+
+        EQASSERT( out + length <= outEnd );
+        memcpy( out, in, length );
+        out += length;
+        in += length;
+
+        if( in >= inEnd )
+            break;
+
+        const uint64_t offset = uint64_t( in[0] ) | ( uint64_t( in[1] ) << 8 );
+        in += 2;
+
+        length = token & 0xf;
+        if( length == 15 )
+            length += _readLength( in );
+        length += _minMatch;
+
+        const uint8_t* ref = out - offset;
+        EQASSERT( offset > 0 );
+        EQASSERT( out + length <= outEnd );
+        if( offset >= length )
+        {
+            memcpy( out, ref, length );
+            out += length;
+        }
+        else // overlapping repetition
+        {
+            for( uint64_t i = 0; i < length; ++i )
+                *out++ = *ref++;
+        }
+    }
+
+    EQASSERT( in == inEnd );
+    EQASSERTINFO( out == outEnd, outEnd - out );
+}
+
+unsigned _setupResults( const eq_uint64_t inSize,
+                        Compressor::ResultVector& results )
+{
+    // determine number of chunks and set up output data structure
+#ifdef CO_USE_OPENMP
+    const unsigned cpuChunks = co::base::OMP::getNThreads() * 4;
+    const uint64_t sizeChunks = inSize / _chunkSize;
+    const unsigned minChunks = unsigned( sizeChunks > 1 ? sizeChunks : 1 );
+    const unsigned nChunks = minChunks < cpuChunks ? minChunks : cpuChunks;
+#else
+    const unsigned nChunks = 1;
+#endif
+
+    while( results.size() < nChunks )
+        results.push_back( new Compressor::Result );
+
+    // The worst case is a single literal run over the whole chunk
+    const eq_uint64_t chunkSize = inSize / nChunks + 1;
+    const eq_uint64_t maxChunkSize = chunkSize + chunkSize / 255 + 16;
+    for( size_t i = 0; i < nChunks; ++i )
+        results[i]->reserve( maxChunkSize );
+
+    EQVERB << "Compressing " << inSize << " bytes in " << nChunks << " chunks"
+           << std::endl;
+    return nChunks;
+}
+
+inline void _getChunk( const ssize_t i, const unsigned nChunks,
+                       const eq_uint64_t size, eq_uint64_t& startIndex,
+                       eq_uint64_t& nextIndex )
+{
+    const float width = static_cast< float >( size ) /
+                        static_cast< float >( nChunks );
+
+    startIndex = static_cast< eq_uint64_t >( i * width );
+    if( i == static_cast< ssize_t >( nChunks - 1 ))
+        nextIndex = size;
+    else
+        nextIndex = static_cast< eq_uint64_t >(( i + 1 ) * width );
+}
+}
+
+void CompressorLZ::compress( const void* const inData,
+                             const eq_uint64_t nPixels, const bool useAlpha )
+{
+    _nResults = _setupResults( nPixels, _results );
+    const uint8_t* const data = reinterpret_cast< const uint8_t* >( inData );
+
+#ifdef CO_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for( ssize_t i = 0; i < static_cast< ssize_t >( _nResults ); ++i )
+    {
+        eq_uint64_t startIndex, nextIndex;
+        _getChunk( i, _nResults, nPixels, startIndex, nextIndex );
+
+        Result* result = _results[i];
+        result->setSize( _compressChunk( &data[ startIndex ],
+                                         nextIndex - startIndex,
+                                         result->getData( )));
+#ifndef CO_AGGRESSIVE_CACHING
+        result->pack();
+#endif
+    }
+}
+
+void CompressorLZ::decompress( const void* const* inData,
+                               const eq_uint64_t* const inSizes,
+                               const unsigned nInputs, void* const outData,
+                               const eq_uint64_t nPixels, const bool useAlpha )
+{
+    const uint8_t* const* in = reinterpret_cast< const uint8_t* const* >(
+                                   inData );
+    uint8_t* const out = reinterpret_cast< uint8_t* >( outData );
+
+#ifdef CO_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for( ssize_t i = 0; i < static_cast< ssize_t >( nInputs ); ++i )
+    {
+        eq_uint64_t startIndex, nextIndex;
+        _getChunk( i, nInputs, nPixels, startIndex, nextIndex );
+
+        _decompressChunk( in[i], inSizes[i], &out[ startIndex ],
+                          nextIndex - startIndex );
+    }
+}
+
+}
+}
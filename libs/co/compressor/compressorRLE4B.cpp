@@ -18,6 +18,12 @@
 
 #include "compressorRLE4B.h"
 
+#if defined( __GNUC__ ) && defined( __SSE2__ )
+#  include <immintrin.h>
+#elif defined( _MSC_VER )
+#  include <emmintrin.h>
+#endif
+
 namespace
 {
 static const uint8_t _rleMarker = 0x42; // just a random number
@@ -50,6 +56,24 @@ REGISTER_ENGINE( CompressorDiffRLE4B, DIFF_RGBA_UINT_8_8_8_8_REV,   \
 REGISTER_ENGINE( CompressorDiffRLE4B, DIFF_BGRA_UINT_8_8_8_8_REV, \
                  BGRA_UINT_8_8_8_8_REV, 1., .5, 1.1, true );
 
+REGISTER_ENGINE( CompressorRLE4BSIMD, SIMD_RGBA, RGBA, 1., 0.59, 1.5, true );
+REGISTER_ENGINE( CompressorRLE4BSIMD, SIMD_BGRA, BGRA, 1., 0.59, 1.5, true );
+REGISTER_ENGINE( CompressorRLE4BSIMD, SIMD_RGBA_UINT_8_8_8_8_REV, \
+                 RGBA_UINT_8_8_8_8_REV, 1., 0.59, 1.5, true );
+REGISTER_ENGINE( CompressorRLE4BSIMD, SIMD_BGRA_UINT_8_8_8_8_REV, \
+                 BGRA_UINT_8_8_8_8_REV, 1., 0.59, 1.5, true );
+REGISTER_ENGINE( CompressorRLE4BSIMD, SIMD_DEPTH_UNSIGNED_INT, \
+                 DEPTH_UNSIGNED_INT, 1., 0.59, 1.5, false );
+
+REGISTER_ENGINE( CompressorDiffRLE4BSIMD, SIMD_DIFF_RGBA, RGBA, \
+                 1., .5, 1.6, true );
+REGISTER_ENGINE( CompressorDiffRLE4BSIMD, SIMD_DIFF_BGRA, BGRA, \
+                 1., .5, 1.6, true );
+REGISTER_ENGINE( CompressorDiffRLE4BSIMD, SIMD_DIFF_RGBA_UINT_8_8_8_8_REV, \
+                 RGBA_UINT_8_8_8_8_REV, 1., .5, 1.6, true );
+REGISTER_ENGINE( CompressorDiffRLE4BSIMD, SIMD_DIFF_BGRA_UINT_8_8_8_8_REV, \
+                 BGRA_UINT_8_8_8_8_REV, 1., .5, 1.6, true );
+
 class NoSwizzle
 {
 public:
@@ -167,6 +191,225 @@ public:
     }
 };  
 
+// SIMD run detection: finds the number of pixels identical to the last pixel.
+// Swizzling only permutes the bits of a pixel, so runs of identical pixels
+// are runs of identical tokens for all channels.
+#if defined( __GNUC__ ) && defined( __SSE2__ )
+#  define CO_RLE_SSE2
+#  if defined( __clang__ ) || __GNUC__ > 4 || \
+      ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 )
+#    define CO_RLE_AVX2
+#  endif
+#elif defined( _MSC_VER ) && ( defined( _M_X64 ) || _M_IX86_FP >= 2 )
+#  define CO_RLE_SSE2
+#endif
+
+static uint64_t _scanRun( const uint32_t* const pixels, uint64_t i,
+                          const uint64_t nPixels, const uint32_t value,
+                          const uint32_t mask )
+{
+    for( ; i < nPixels; ++i )
+        if( (( pixels[i] ^ value ) & mask ) != 0 )
+            return i;
+    return nPixels;
+}
+
+#ifdef CO_RLE_SSE2
+static uint64_t _scanRunSSE2( const uint32_t* const pixels,
+                              const uint64_t nPixels, const uint32_t value,
+                              const uint32_t mask )
+{
+    const __m128i masks = _mm_set1_epi32( int( mask ));
+    const __m128i values = _mm_set1_epi32( int( value & mask ));
+
+    uint64_t i = 0;
+    for( ; i + 4 <= nPixels; i += 4 )
+    {
+        const __m128i in = _mm_and_si128( masks, _mm_loadu_si128(
+                               reinterpret_cast< const __m128i* >( pixels+i )));
+        if( _mm_movemask_epi8( _mm_cmpeq_epi32( in, values )) != 0xffff )
+            break;
+    }
+    return _scanRun( pixels, i, nPixels, value, mask );
+}
+#endif
+
+#ifdef CO_RLE_AVX2
+__attribute__(( target( "avx2" )))
+static uint64_t _scanRunAVX2( const uint32_t* const pixels,
+                              const uint64_t nPixels, const uint32_t value,
+                              const uint32_t mask )
+{
+    const __m256i masks = _mm256_set1_epi32( int( mask ));
+    const __m256i values = _mm256_set1_epi32( int( value & mask ));
+
+    uint64_t i = 0;
+    for( ; i + 8 <= nPixels; i += 8 )
+    {
+        const __m256i in = _mm256_and_si256( masks, _mm256_loadu_si256(
+                               reinterpret_cast< const __m256i* >( pixels+i )));
+        if( _mm256_movemask_epi8( _mm256_cmpeq_epi32( in, values )) != -1 )
+            break;
+    }
+    return _scanRun( pixels, i, nPixels, value, mask );
+}
+#endif
+
+static uint64_t _scanRunScalar( const uint32_t* const pixels,
+                                const uint64_t nPixels, const uint32_t value,
+                                const uint32_t mask )
+{
+    return _scanRun( pixels, 0, nPixels, value, mask );
+}
+
+typedef uint64_t (*ScanRun_t)( const uint32_t* const, const uint64_t,
+                               const uint32_t, const uint32_t );
+
+static ScanRun_t _chooseScanRun()
+{
+#ifdef CO_RLE_AVX2
+    __builtin_cpu_init(); // called during static initialization
+    if( __builtin_cpu_supports( "avx2" ))
+        return _scanRunAVX2;
+#endif
+#ifdef CO_RLE_SSE2
+    return _scanRunSSE2;
+#else
+    return _scanRunScalar;
+#endif
+}
+static const ScanRun_t _scanRunSIMD = _chooseScanRun();
+
+/** Extend the run of the last token, same output as n _compressToken(). */
+template< typename T >
+static inline void _extendToken( const T last, T& numLast, const uint64_t n,
+                                 T*& out )
+{
+    const uint64_t max = std::numeric_limits< T >::max();
+    uint64_t total = numLast + n;
+    while( total > max )
+    {
+        _write( last, T( max ), out );
+        total -= max;
+    }
+    numLast = T( total );
+}
+#define EXTEND( name ) \
+    _extendToken( name ## Last, name ## Same, run, name ## Out )
+
+template< typename swizzleFunc, typename alphaFunc >
+static inline void _compressSIMD( const void* const input,
+                                  const uint64_t nPixels,
+                                  co::plugin::Compressor::Result** results )
+{
+    if( nPixels == 0 )
+    {
+        results[0]->setSize( 0 );
+        results[1]->setSize( 0 );
+        results[2]->setSize( 0 );
+        results[3]->setSize( 0 );
+        return;
+    }
+
+    const uint32_t* const pixels = reinterpret_cast< const uint32_t* >( input );
+    const uint32_t mask = alphaFunc::use() ? 0xffffffffu : 0x00ffffffu;
+
+    uint8_t* oneOut(   results[ 0 ]->getData( )); 
+    uint8_t* twoOut(   results[ 1 ]->getData( ));
+    uint8_t* threeOut( results[ 2 ]->getData( ));
+    uint8_t* fourOut(  results[ 3 ]->getData( ));
+
+    uint8_t oneLast(0), twoLast(0), threeLast(0), fourLast(0);
+    if( alphaFunc::use( ))
+        swizzleFunc::swizzle( *pixels, oneLast, twoLast, threeLast, fourLast );
+    else
+        swizzleFunc::swizzle( *pixels, oneLast, twoLast, threeLast );
+
+    uint8_t oneSame( 1 ), twoSame( 1 ), threeSame( 1 ), fourSame( 1 );
+    uint8_t one(0), two(0), three(0), four(0);
+
+    uint64_t i = 1;
+    while( i < nPixels )
+    {
+        if( (( pixels[i] ^ pixels[i-1] ) & mask ) == 0 )
+        {
+            const uint64_t run = _scanRunSIMD( pixels + i, nPixels - i,
+                                               pixels[i-1], mask );
+            EXTEND( one );
+            EXTEND( two );
+            EXTEND( three );
+            if( alphaFunc::use( ))
+                EXTEND( four );
+            i += run;
+            continue;
+        }
+
+        if( alphaFunc::use( ))
+        {
+            swizzleFunc::swizzle( pixels[i], one, two, three, four );
+            COMPRESS( one );
+            COMPRESS( two );
+            COMPRESS( three );
+            COMPRESS( four );
+        }
+        else
+        {
+            swizzleFunc::swizzle( pixels[i], one, two, three );
+            COMPRESS( one );
+            COMPRESS( two );
+            COMPRESS( three );
+        }
+        ++i;
+    }
+
+    WRITE_OUTPUT( one );
+    WRITE_OUTPUT( two );
+    WRITE_OUTPUT( three );
+    WRITE_OUTPUT( four );
+
+    results[0]->setSize( oneOut   - results[0]->getData( ));
+    results[1]->setSize( twoOut   - results[1]->getData( ));
+    results[2]->setSize( threeOut - results[2]->getData( ));
+    results[3]->setSize( fourOut  - results[3]->getData( ));
+#ifndef CO_AGGRESSIVE_CACHING
+    results[0]->pack();
+    results[1]->pack();
+    results[2]->pack();
+    results[3]->pack();
+#endif
+}
+
+template< typename swizzleFunc, typename alphaFunc >
+static inline unsigned _compressSIMD( const void* const inData,
+                                      const eq_uint64_t nPixels,
+                                co::plugin::Compressor::ResultVector& results )
+{
+    const uint64_t size = nPixels * sizeof( uint32_t );
+    const unsigned nChunks = _setupResults( 4, size, results );
+
+    const uint64_t nElems = nPixels * 4;
+    const float width = static_cast< float >( nElems ) /  
+                        static_cast< float >( nChunks );
+
+    const uint8_t* const data = reinterpret_cast< const uint8_t* >( inData );
+    
+#ifdef CO_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for( ssize_t i = 0; i < static_cast< ssize_t >( nChunks ) ; i += 4 )
+    {
+        const uint64_t startIndex = static_cast< uint64_t >( i/4 * width ) * 4;
+        const uint64_t nextIndex = 
+            static_cast< uint64_t >(( i/4 + 1 ) * width ) * 4;
+        const uint64_t chunkSize = ( nextIndex - startIndex ) / 4;
+
+        _compressSIMD< swizzleFunc, alphaFunc >( &data[ startIndex ],
+                                                 chunkSize, &results[i] );
+    }
+
+    return nChunks;
+}
+
 }
 
 void CompressorRLE4B::compress( const void* const inData, 
@@ -189,6 +432,26 @@ void CompressorRLE4B::compress( const void* const inData,
                             inData, nPixels, _results );
 }
 
+void CompressorRLE4BSIMD::compress( const void* const inData, 
+                                    const eq_uint64_t nPixels,
+                                    const bool useAlpha, const bool swizzle )
+{
+    if( useAlpha )
+        if( swizzle )
+            _nResults = _compressSIMD< SwizzleUInt32, UseAlpha >(
+                            inData, nPixels, _results );
+        else
+            _nResults = _compressSIMD< NoSwizzle, UseAlpha >(
+                            inData, nPixels, _results );
+    else
+        if( swizzle )
+            _nResults = _compressSIMD< SwizzleUInt24, NoAlpha >(
+                            inData, nPixels, _results );
+        else
+            _nResults = _compressSIMD< NoSwizzle, NoAlpha >(
+                            inData, nPixels, _results );
+}
+
 void CompressorRLE4B::decompress( const void* const* inData, 
                                   const eq_uint64_t* const inSizes, 
                                   const unsigned numInputs,
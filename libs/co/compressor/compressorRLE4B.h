@@ -73,6 +73,53 @@ public:
                             const eq_uint64_t nPixels, const bool useAlpha );
 };    
 
+/**
+ * RLE compressor for four 1-byte tokens detecting pixel runs using SIMD.
+ *
+ * Produces the same output as CompressorRLE4B, resp. CompressorDiffRLE4B
+ * when swizzling. Runs of identical pixels are found with SSE2 or AVX2 vector
+ * compares, selected at runtime based on the CPU capabilities.
+ */
+class CompressorRLE4BSIMD : public CompressorRLE4B
+{
+public:
+    CompressorRLE4BSIMD() : CompressorRLE4B() {}
+    virtual ~CompressorRLE4BSIMD() {}
+
+    static void* getNewCompressor( const unsigned name )
+        { return new co::plugin::CompressorRLE4BSIMD; }
+
+    virtual void compress( const void* const inData, const eq_uint64_t nPixels, 
+                           const bool useAlpha )
+        { compress( inData, nPixels, useAlpha, false ); }
+
+protected:
+    void compress( const void* const inData, const eq_uint64_t nPixels, 
+                   const bool useAlpha, const bool swizzle );
+};
+
+/** SIMD run detection variant of CompressorDiffRLE4B. */
+class CompressorDiffRLE4BSIMD : public CompressorRLE4BSIMD
+{
+public:
+    CompressorDiffRLE4BSIMD() : CompressorRLE4BSIMD() {}
+    virtual ~CompressorDiffRLE4BSIMD() {}
+
+    static void* getNewCompressor( const unsigned name )
+        { return new co::plugin::CompressorDiffRLE4BSIMD; }
+    
+    virtual void compress( const void* const inData, const eq_uint64_t nPixels, 
+                           const bool useAlpha )
+        { CompressorRLE4BSIMD::compress( inData, nPixels, useAlpha, true ); }
+
+    static void decompress( const void* const* inData, 
+                            const eq_uint64_t* const inSizes, 
+                            const unsigned nInputs, void* const outData, 
+                            const eq_uint64_t nPixels, const bool useAlpha )
+        { CompressorDiffRLE4B::decompress( inData, inSizes, nInputs, outData,
+                                           nPixels, useAlpha ); }
+};
+
 }
 }
 #endif // CO_PLUGIN_COMPRESSORRLE4B
@@ -355,6 +355,98 @@ bool Connection::send( const void* buffer, const uint64_t bytes,
     return true;
 }
 
+bool Connection::send( const iovec* buffers, const size_t count,
+                       const bool isLocked )
+{
+    // copy the buffers, they are advanced on partial writes
+    iovec* vec = static_cast< iovec* >( alloca( count * sizeof( iovec )));
+    size_t nBuffers = 0;
+    uint64_t bytes = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+        if( buffers[i].iov_len == 0 )
+            continue;
+        vec[ nBuffers++ ] = buffers[i];
+        bytes += buffers[i].iov_len;
+    }
+
+    EQASSERT( bytes > 0 );
+    if( bytes == 0 )
+        return true;
+
+    base::ScopedMutex<> mutex( isLocked ? 0 : &_sendLock );
+
+    uint64_t bytesLeft = bytes;
+    while( bytesLeft )
+    {
+        try
+        {
+            int64_t wrote = this->writev( vec, nBuffers );
+            if( wrote == -1 ) // error
+            {
+                EQERROR << "Error during write after " << bytes - bytesLeft 
+                        << " bytes, closing connection" << std::endl;
+                close();
+                return false;
+            }
+            else if( wrote == 0 )
+                EQINFO << "Zero bytes write" << std::endl;
+
+            bytesLeft -= wrote;
+
+            // skip written buffers
+            while( wrote > 0 )
+            {
+                const uint64_t size = vec->iov_len;
+                if( uint64_t( wrote ) < size ) // partial buffer write
+                {
+                    vec->iov_base = static_cast< uint8_t* >( vec->iov_base ) +
+                                    wrote;
+                    vec->iov_len = size - wrote;
+                    break;
+                }
+                wrote -= size;
+                ++vec;
+                --nBuffers;
+            }
+        }
+        catch( const co::Exception& e )
+        {
+            EQERROR << e.what() << " after " << bytes - bytesLeft 
+                    << " bytes, closing connection" << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t Connection::writev( const iovec* buffers, const size_t count )
+{
+    EQASSERT( count > 0 );
+
+    // gather small buffers to avoid one write per buffer
+    uint64_t size = 0;
+    size_t nBuffers = 0;
+    while( nBuffers < count &&
+           size + buffers[ nBuffers ].iov_len <= EQ_ASSEMBLE_THRESHOLD )
+    {
+        size += buffers[ nBuffers ].iov_len;
+        ++nBuffers;
+    }
+
+    if( nBuffers < 2 )
+        return write( buffers[0].iov_base, buffers[0].iov_len );
+
+    uint8_t* ptr = _gatherBuffer.reset( size );
+    for( size_t i = 0; i < nBuffers; ++i )
+    {
+        memcpy( ptr, buffers[i].iov_base, buffers[i].iov_len );
+        ptr += buffers[i].iov_len;
+    }
+    return write( _gatherBuffer.getData(), size );
+}
+
 bool Connection::send( Packet& packet, const void* data,
                        const uint64_t dataSize )
 {
@@ -372,14 +464,13 @@ bool Connection::send( Packet& packet, const void* data,
     const uint64_t size        = headerSize + dataSize;
     if( size > EQ_ASSEMBLE_THRESHOLD )
     {
-        // OPT: lock the connection and use two send() to avoid big memcpy
+        // OPT: use a vectored send to avoid big memcpy
         packet.size = size;
 
-        lockSend();
-        const bool ret = ( send( &packet, headerSize, true ) &&
-                           send( data,    dataSize,   true ));
-        unlockSend();
-        return ret;
+        const iovec buffers[2] = {
+            { &packet, size_t( headerSize ) },
+            { const_cast< void* >( data ), size_t( dataSize ) }};
+        return send( buffers, 2 );
     }
     // else
 
@@ -428,25 +519,19 @@ bool Connection::send( const Connections& connections, Packet& packet,
 
     if( size > EQ_ASSEMBLE_THRESHOLD )
     {
-        // OPT: lock the connection and use two send() to avoid big memcpy
+        // OPT: use a vectored send to avoid big memcpy
         packet.size = size;
+        const iovec buffers[2] = {
+            { &packet, size_t( headerSize ) },
+            { const_cast< void* >( data ), size_t( dataSize ) }};
         bool success = true;
 
         for( Connections::const_iterator i= connections.begin(); 
              i<connections.end(); ++i )
         {        
             ConnectionPtr connection = *i;
-
-            if( !isLocked )
-                connection->lockSend();
-
-            if( !connection->send( &packet, headerSize, true ) ||
-                !connection->send( data, dataSize, true ))
-            {
+            if( !connection->send( buffers, 2, isLocked ))
                 success = false;
-            }
-            if( !isLocked )
-                connection->unlockSend();    
         }
         return success;
     }
@@ -477,11 +562,21 @@ bool Connection::send( const Connections& connections, Packet& packet,
         return true;
 
     packet.size -= 8;
-    const uint64_t headerSize = packet.size;
+    const size_t nBuffers = 1 + 2 * nItems;
+    iovec* buffers = static_cast< iovec* >(
+        alloca( nBuffers * sizeof( iovec )));
+
+    buffers[0].iov_base = &packet;
+    buffers[0].iov_len = size_t( packet.size );
     for( size_t i = 0; i < nItems; ++i )
     {
         EQASSERT( sizes[i] > 0 );
         packet.size += sizes[ i ] + sizeof( uint64_t );
+
+        buffers[ 2*i + 1 ].iov_base = const_cast< uint64_t* >( &sizes[i] );
+        buffers[ 2*i + 1 ].iov_len = sizeof( uint64_t );
+        buffers[ 2*i + 2 ].iov_base = const_cast< void* >( items[i] );
+        buffers[ 2*i + 2 ].iov_len = size_t( sizes[i] );
     }
 
     bool success = true;
@@ -489,19 +584,8 @@ bool Connection::send( const Connections& connections, Packet& packet,
          i < connections.end(); ++i )
     {        
         ConnectionPtr connection = *i;
-        connection->lockSend();
-            
-        if( !connection->send( &packet, headerSize, true ))
+        if( !connection->send( buffers, nBuffers ))
             success = false;
-
-        for( size_t j = 0; j < nItems; ++j )
-            if( !connection->send( &sizes[j], sizeof(uint64_t), true ) ||
-                !connection->send( items[j], sizes[j], true ))
-            {
-                success = false;
-            }
-
-        connection->unlockSend();
     }
     return success;
 }
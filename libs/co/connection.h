@@ -23,6 +23,7 @@
 #include <co/types.h>                 // Connections type
 #include <co/api.h>
 
+#include <co/base/buffer.h>       // member
 #include <co/base/refPtr.h>
 #include <co/base/referenced.h>   // base class
 #include <co/base/lock.h>
@@ -36,6 +37,7 @@
 #  include <malloc.h>
 #else
 #  define EQ_DEFAULT_PORT (4242 + getuid())
+#  include <sys/uio.h>
 #endif
 
 namespace co
@@ -43,6 +45,17 @@ namespace co
     class ConnectionDescription;
     class ConnectionListener;
 
+#ifdef _WIN32
+    /** A buffer description for vectored send operations. */
+    struct iovec
+    {
+        void*  iov_base; //!< The start of the buffer
+        size_t iov_len;  //!< The size of the buffer in bytes
+    };
+#else
+    using ::iovec;
+#endif
+
     /**
      * An interface definition for communication between hosts.
      *
@@ -259,6 +272,21 @@ namespace co
         CO_API bool send( const void* buffer, const uint64_t bytes, 
                           const bool isLocked = false );
 
+        /** 
+         * Send multiple buffers using the connection.
+         *
+         * The buffers are sent atomically and in order, using as few write
+         * operations as the connection implementation allows.
+         * 
+         * @param buffers the buffers containing the message.
+         * @param count the number of buffers.
+         * @param isLocked true if the connection is locked externally.
+         * @return true if all data has been sent, false if not.
+         * @sa writev()
+         */
+        CO_API bool send( const iovec* buffers, const size_t count,
+                          const bool isLocked = false );
+
         /** Lock the connection, no other thread can send data. */
         void lockSend() const   { _sendLock.set(); }
         /** Unlock the connection. */
@@ -369,6 +397,18 @@ namespace co
          */
         virtual int64_t write( const void* buffer, const uint64_t bytes ) = 0;
 
+        /** 
+         * Write multiple buffers to the connection.
+         *
+         * The default implementation gathers small leading buffers into one
+         * write(). It may write only a part of the given data.
+         *
+         * @param buffers the buffers containing the message.
+         * @param count the number of buffers.
+         * @return the number of bytes written, or -1 upon error.
+         */
+        virtual int64_t writev( const iovec* buffers, const size_t count );
+
         /** @internal Finish all pending send operations. */
         virtual void finish() { EQUNIMPLEMENTED; }
         //@}
@@ -408,6 +448,9 @@ namespace co
         void*         _aioBuffer;
         uint64_t      _aioBytes;
 
+        /** Gathers small buffers in writev(), protected by the send lock. */
+        base::Bufferb _gatherBuffer;
+
         /** The listeners on state changes */
         std::vector< ConnectionListener* > _listeners;
     };
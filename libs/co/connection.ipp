@@ -28,14 +28,13 @@ bool Connection::send( Packet &packet, const std::vector<T>& data )
     const uint64_t size        = headerSize + dataSize;
     if( size > EQ_ASSEMBLE_THRESHOLD )
     {
-        // OPT: lock the connection and use two send() to avoid big memcpy
+        // OPT: use a vectored send to avoid big memcpy
         packet.size = size;
 
-        lockSend();
-        const bool ret = ( send( &packet,  headerSize, true ) &&
-                           send( &data[0], dataSize,   true ));
-        unlockSend();
-        return ret;
+        const iovec buffers[2] = {
+            { &packet, size_t( headerSize ) },
+            { const_cast< T* >( &data[0] ), dataSize }};
+        return send( buffers, 2 );
     }
     // else
 
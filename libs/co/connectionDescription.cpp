@@ -77,6 +77,8 @@ ConnectionDescription::ConnectionDescription( const char* data )
         : type( CONNECTIONTYPE_TCPIP )
         , bandwidth( 0 )
         , port( 0 )
+        , fecGroupSize( 0 )
+        , fecRepairs( 1 )
         , _filename( "default" )
 {
     std::string string( data );
@@ -107,7 +109,7 @@ void ConnectionDescription::serialize( std::ostream& os ) const
 {
     os << type << SEPARATOR << bandwidth << SEPARATOR << _hostname  << SEPARATOR
        << _interface << SEPARATOR << port << SEPARATOR << _filename
-       << SEPARATOR;
+       << SEPARATOR << fecGroupSize << SEPARATOR << fecRepairs << SEPARATOR;
 }
 
 bool ConnectionDescription::fromString( std::string& data )
@@ -198,6 +200,22 @@ bool ConnectionDescription::fromString( std::string& data )
 
         _filename = data.substr( 0, nextPos );
         data = data.substr( nextPos + 1 );
+
+        nextPos = data.find( SEPARATOR );
+        if( nextPos == std::string::npos )
+            goto error;
+
+        const std::string fecGroupStr = data.substr( 0, nextPos );
+        data = data.substr( nextPos + 1 );
+        fecGroupSize = atoi( fecGroupStr.c_str( ));
+
+        nextPos = data.find( SEPARATOR );
+        if( nextPos == std::string::npos )
+            goto error;
+
+        const std::string fecRepairStr = data.substr( 0, nextPos );
+        data = data.substr( nextPos + 1 );
+        fecRepairs = atoi( fecRepairStr.c_str( ));
     }
     return true;
 
@@ -275,6 +293,10 @@ std::ostream& operator << ( std::ostream& os,
     if( desc.bandwidth != 0 )
         os << "bandwidth     " << desc.bandwidth << std::endl;
 
+    if( desc.fecGroupSize != 0 )
+        os << "fec_group_size " << desc.fecGroupSize << std::endl
+           << "fec_repairs   " << desc.fecRepairs << std::endl;
+
     os << base::exdent << "}" << base::enableHeader << base::enableFlush
        << std::endl;
     return os;
@@ -284,7 +306,8 @@ bool ConnectionDescription::operator == ( const ConnectionDescription& rhs )
     const
 {
     return type == rhs.type && bandwidth == rhs.bandwidth &&
-           port == rhs.port && _hostname == rhs._hostname &&
+           port == rhs.port && fecGroupSize == rhs.fecGroupSize &&
+           fecRepairs == rhs.fecRepairs && _hostname == rhs._hostname &&
            _interface == rhs._interface && _filename == rhs._filename;
 }
 
@@ -39,6 +39,8 @@ namespace co
                 : type( CONNECTIONTYPE_TCPIP )
                 , bandwidth( 0 )
                 , port( 0 )
+                , fecGroupSize( 0 )
+                , fecRepairs( 1 )
                 , _filename( "default" )
             {}
 
@@ -60,6 +62,15 @@ namespace co
         /** The listening port (TCPIP, SDP, IB, MCIP, RDMA). */
         uint16_t port;
 
+        /**
+         * The number of data datagrams protected by forward error correction
+         * (RSP), up to 64. 0 disables forward error correction.
+         */
+        uint16_t fecGroupSize;
+
+        /** The number of repair datagrams sent for each FEC group (RSP). */
+        uint16_t fecRepairs;
+
         /** @return this description as a string. */
         CO_API std::string toString() const;
         CO_API void serialize( std::ostream& os ) const;
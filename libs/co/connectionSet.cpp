@@ -20,6 +20,7 @@
 #include "connection.h"
 #include "node.h"
 #include "eventConnection.h"
+#include "global.h"
 
 #include <co/base/os.h>
 #include <co/base/scopedMutex.h>
@@ -38,6 +39,7 @@
 #  define SELECT_ERROR   -1
 #  define MAX_CONNECTIONS EQ_100KB  // Arbitrary
 #endif
+#define MAX_EPOLL_EVENTS 1024 // max ready connections per epoll_wait()
 
 namespace co
 {
@@ -45,6 +47,10 @@ namespace co
 ConnectionSet::ConnectionSet()
 #ifdef _WIN32
         : _thread( 0 ),
+#elif defined Linux
+        : _epollFD( -1 )
+        , _epollNext( 0 )
+        , _epollReady( 0 ),
 #else
         :
 #endif
@@ -56,6 +62,16 @@ ConnectionSet::ConnectionSet()
     // connection set is waiting in a select, the select is interrupted using
     // this connection.
     EQCHECK( _selfConnection->connect( ));
+
+#ifdef Linux
+    if( Global::getIAttribute( Global::IATTR_CONNECTIONSET_EPOLL ))
+    {
+        _epollFD = epoll_create( MAX_EPOLL_EVENTS );
+        if( _epollFD < 0 )
+            EQWARN << "epoll_create failed, using poll(): " << base::sysError
+                   << std::endl;
+    }
+#endif
 }
 
 ConnectionSet::~ConnectionSet()
@@ -65,6 +81,12 @@ ConnectionSet::~ConnectionSet()
     _connection = 0;
     _selfConnection->close();
     _selfConnection = 0;
+
+#ifdef Linux
+    if( _epollFD >= 0 )
+        ::close( _epollFD );
+    _epollFD = -1;
+#endif
 }
 
 #ifdef _WIN32
@@ -285,7 +307,12 @@ ConnectionSet::Event ConnectionSet::select( const uint32_t timeout )
 #else
         const int pollTimeout = timeout == EQ_TIMEOUT_INDEFINITE ?
                                 -1 : int( timeout );
+#  ifdef Linux
+        const int ret = _epollFD >= 0 ? _epollWait( pollTimeout ) :
+                        poll( _fdSet.getData(), _fdSet.getSize(), pollTimeout );
+#  else
         const int ret = poll( _fdSet.getData(), _fdSet.getSize(), pollTimeout );
+#  endif
 #endif
         switch( ret )
         {
@@ -367,6 +394,11 @@ ConnectionSet::Event ConnectionSet::_getSelectResult( const uint32_t index )
 #else // _WIN32
 ConnectionSet::Event ConnectionSet::_getSelectResult( const uint32_t )
 {
+#ifdef Linux
+    if( _epollFD >= 0 )
+        return _getEpollResult();
+#endif
+
     for( size_t i = 0; i < _fdSet.getSize(); ++i )
     {
         const pollfd& pollFD = _fdSet[i];
@@ -408,10 +440,151 @@ ConnectionSet::Event ConnectionSet::_getSelectResult( const uint32_t )
 }
 #endif // else not _WIN32
 
+#ifdef Linux
+int ConnectionSet::_epollWait( const int timeout )
+{
+    // Hand out the remaining ready connections of the last wakeup before
+    // asking the kernel again. Events are level-triggered, so a connection
+    // with data left after its packet was read is simply reported again.
+    if( _epollNext < _epollReady )
+        return _epollReady - _epollNext;
+
+    _epollNext = 0;
+    _epollReady = 0;
+
+    const int ret = epoll_wait( _epollFD, _epollEvents.getData(),
+                                int( _epollEvents.getSize( )), timeout );
+    if( ret > 0 )
+        _epollReady = ret;
+    return ret;
+}
+
+ConnectionSet::Event ConnectionSet::_getEpollResult()
+{
+    while( _epollNext < _epollReady )
+    {
+        const epoll_event& event = _epollEvents[ _epollNext++ ];
+        FDConnections::const_iterator i =
+            _epollConnections.find( event.data.fd );
+        if( i == _epollConnections.end( )) // removed since epoll_wait
+            continue;
+
+        _connection = i->second;
+        EQASSERT( _connection.isValid( ));
+
+        EQVERB << "Got event on connection @" << (void*)_connection.get()
+               << std::endl;
+
+        const uint32_t events = event.events;
+        if( events & EPOLLERR )
+        {
+            EQINFO << "Error during epoll_wait(): " << base::sysError
+                   << std::endl;
+            return EVENT_ERROR;
+        }
+
+        if( events & EPOLLHUP ) // disconnect happened
+            return EVENT_DISCONNECT;
+
+        if( events & EPOLLIN || events & EPOLLPRI )
+            return EVENT_DATA;
+
+        EQERROR << "Unhandled epoll event(s): " << events << std::endl;
+        ::abort();
+    }
+    return EVENT_NONE;
+}
+
+bool ConnectionSet::_setupEpollSet()
+{
+    // pending events might reference removed connections
+    _epollNext = 0;
+    _epollReady = 0;
+
+    FDConnections connections;
+    const int selfFD = _selfConnection->getNotifier();
+    EQASSERT( selfFD > 0 );
+    connections[ selfFD ] = _selfConnection.get();
+
+    _mutex.set();
+    for( Connections::const_iterator i = _connections.begin();
+         i != _connections.end(); ++i )
+    {
+        ConnectionPtr connection = *i;
+        const int fd = connection->getNotifier();
+
+        if( fd <= 0 )
+        {
+            EQINFO << "Cannot select connection " << connection
+                   << ", connection " << typeid( *connection.get( )).name() 
+                   << " does not use a file descriptor" << std::endl;
+            _connection = connection;
+            _mutex.unset();
+            _dirty = true;
+            return false;
+        }
+
+        EQVERB << "Listening on " << typeid( *connection.get( )).name() 
+               << " @" << (void*)connection.get() << std::endl;
+        connections.insert( std::make_pair( fd, connection.get( )));
+    }
+    _mutex.unset();
+
+    // Only apply the difference to the kernel interest set. Closed fd's are
+    // removed by the kernel, so failures during removal are ignored.
+    for( FDConnections::const_iterator i = _epollConnections.begin();
+         i != _epollConnections.end(); ++i )
+    {
+        if( connections.find( i->first ) == connections.end( ))
+            epoll_ctl( _epollFD, EPOLL_CTL_DEL, i->first, 0 );
+    }
+
+    for( FDConnections::const_iterator i = connections.begin();
+         i != connections.end(); ++i )
+    {
+        FDConnections::const_iterator j = _epollConnections.find( i->first );
+        if( j != _epollConnections.end() && j->second == i->second )
+            continue; // unchanged
+
+        epoll_event event;
+        memset( &event, 0, sizeof( event ));
+        event.events = EPOLLIN; // | EPOLLPRI;
+        event.data.fd = i->first;
+
+        // A known fd with a new connection was closed and reused in between
+        if( j != _epollConnections.end() &&
+            epoll_ctl( _epollFD, EPOLL_CTL_MOD, i->first, &event ) == 0 )
+        {
+            continue;
+        }
+        if( epoll_ctl( _epollFD, EPOLL_CTL_ADD, i->first, &event ) == 0 ||
+            errno == EEXIST )
+        {
+            continue;
+        }
+
+        EQWARN << "Cannot add fd " << i->first << " to epoll set: "
+               << base::sysError << std::endl;
+        _connection = i->second;
+        _epollConnections.clear();
+        _dirty = true;
+        return false;
+    }
+
+    _epollConnections.swap( connections );
+    _epollEvents.reset( EQ_MIN( _epollConnections.size(), MAX_EPOLL_EVENTS ));
+    return true;
+}
+#endif // Linux
+
 bool ConnectionSet::_setupFDSet()
 {
     if( !_dirty )
     {
+#ifdef Linux
+        if( _epollFD >= 0 )
+            return true;
+#endif
 #ifndef _WIN32
         // TODO: verify that poll() really modifies _fdSet, and remove the copy
         // if it doesn't. The man page seems to hint that poll changes fds.
@@ -421,6 +594,10 @@ bool ConnectionSet::_setupFDSet()
     }
 
     _dirty = false;
+#ifdef Linux
+    if( _epollFD >= 0 )
+        return _setupEpollSet();
+#endif
     _fdSet.setSize( 0 );
     _fdSetResult.setSize( 0 );
 
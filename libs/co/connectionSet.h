@@ -27,6 +27,10 @@
 #ifndef _WIN32
 #  include <poll.h>
 #endif
+#ifdef Linux
+#  include <sys/epoll.h>
+#  include <co/base/stdExt.h> // member
+#endif
 
 namespace co
 {
@@ -36,7 +40,10 @@ namespace co
     /**
      * A set of connections. 
      *
-     * From the set, a connection with pending events can be selected.
+     * From the set, a connection with pending events can be selected. On
+     * Linux, the set uses epoll by default, which keeps a persistent interest
+     * set and returns all ready connections of one wakeup on consecutive
+     * select() calls. See Global::IATTR_CONNECTIONSET_EPOLL.
      */
     class ConnectionSet : public ConnectionListener
     {
@@ -131,6 +138,25 @@ namespace co
 #endif
         base::Buffer< Result > _fdSetResult;
 
+#ifdef Linux
+        typedef stde::hash_map< int, Connection* > FDConnections;
+
+        /** The epoll instance, or -1 if poll() is used. */
+        int _epollFD;
+
+        /** The connections currently registered with the epoll instance. */
+        FDConnections _epollConnections;
+
+        /** The ready events of the last epoll_wait(). */
+        base::Buffer< epoll_event > _epollEvents;
+        int _epollNext;  //!< Next ready event to return from _epollEvents
+        int _epollReady; //!< Number of ready events in _epollEvents
+
+        bool _setupEpollSet();
+        int _epollWait( const int timeout );
+        Event _getEpollResult();
+#endif
+
         /** The connection to reset a running select, see constructor. */
         base::RefPtr< EventConnection > _selfConnection;
 
@@ -18,6 +18,7 @@
 
 #include "dataIStream.h"
 
+#include "decompressorPool.h"
 #include "log.h"
 #include "node.h"
 
@@ -129,34 +130,13 @@ const uint8_t* DataIStream::_decompress( const void* data, const uint32_t name,
     if( name == EQ_COMPRESSOR_NONE )
         return src;
 
-    EQASSERT( name > EQ_COMPRESSOR_NONE );
 #ifndef CO_AGGRESSIVE_CACHING
     _data.clear();
 #endif
     _data.reset( dataSize );
 
-    if ( !_decompressor->isValid( name ) )
-        _decompressor->initDecompressor( name );
-
-    uint64_t outDim[2] = { 0, dataSize };
-    uint64_t* chunkSizes = static_cast< uint64_t* >( 
-                                alloca( nChunks * sizeof( uint64_t )));
-    void** chunks = static_cast< void ** >( 
-                                alloca( nChunks * sizeof( void* )));
-    
-    for( uint32_t i = 0; i < nChunks; ++i )
-    {
-        const uint64_t size = *reinterpret_cast< const uint64_t* >( src );
-        chunkSizes[ i ] = size;
-        src += sizeof( uint64_t );
-
-        // The plugin API uses non-const source buffers for in-place operations
-        chunks[ i ] = const_cast< uint8_t* >( src );
-        src += size;
-    }
-
-    _decompressor->decompress( chunks, chunkSizes, nChunks, 
-                               _data.getData(), outDim );
+    DecompressorPool::decompress( *_decompressor, _data.getData(), data, name,
+                                  nChunks, dataSize );
     return _data.getData();
 }
 
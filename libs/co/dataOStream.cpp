@@ -41,6 +41,7 @@ base::a_int32_t nBytesIn;
 base::a_int32_t nBytesOut;
 CO_API base::a_int32_t nBytesSaved;
 CO_API base::a_int32_t nBytesSent;
+base::a_int32_t nBytesReferenced;
 base::a_int32_t compressionTime;
 #endif
 
@@ -48,6 +49,7 @@ DataOStream::DataOStream()
         : _compressorState( STATE_UNCOMPRESSED )
         , _bufferStart( 0 )
         , _dataSize( 0 )
+        , _referencedSize( 0 )
         , _compressor( new base::CPUCompressor )
         , _enabled( false )
         , _dataSent( false )
@@ -74,6 +76,7 @@ void DataOStream::_enable()
     EQASSERT( _save || !_connections.empty( ));
     _compressorState = STATE_UNCOMPRESSED;
     _bufferStart = 0;
+    _referencedSize = 0;
     _dataSent    = false;
     _enabled     = true;
     _buffer.setSize( 0 );
@@ -136,7 +139,7 @@ bool DataOStream::_disable()
 
     if( _dataSent )
     {
-        _dataSize = _buffer.getSize();
+        _dataSize = _buffer.getSize() + _referencedSize;
         if( !_connections.empty( ))
         {
             void* ptr = _buffer.getData() + _bufferStart;
@@ -205,11 +208,42 @@ void DataOStream::write( const void* data, uint64_t size )
         EQWARN << *this << std::endl;
 #endif    
 
+    const int32_t referenceSize =
+        Global::getIAttribute( Global::IATTR_OBJECT_REFERENCE_SIZE );
+    if( !_save && referenceSize > 0 && size >= uint64_t( referenceSize ))
+    {
+        _writeReference( data, size );
+        return;
+    }
+
     if( _buffer.getSize() - _bufferStart > Global::getObjectBufferSize( ))
         _flush();
     _buffer.append( static_cast< const uint8_t* >( data ), size );
 }
 
+void DataOStream::_writeReference( const void* data, const uint64_t size )
+{
+    EQASSERT( !_save );
+    if( _buffer.getSize() > _bufferStart ) // keep the order of the data
+        _flush();
+
+    if( !_connections.empty( ))
+    {
+        // OPT: compress or send from the caller's memory, the packet header
+        // is gathered with the data by the vectored send
+        void* ptr = const_cast< void* >( data );
+        _compressorState = STATE_UNCOMPRESSED;
+        _compress( ptr, size, STATE_PARTIAL );
+        sendData( ptr, size, false );
+        _compressorState = STATE_UNCOMPRESSED;
+    }
+    _dataSent = true;
+    _referencedSize += size;
+#ifdef EQ_INSTRUMENT_DATAOSTREAM
+    nBytesReferenced += size;
+#endif
+}
+
 void DataOStream::_flush()
 {
     EQASSERT( _enabled );
@@ -334,13 +368,15 @@ std::ostream& operator << ( std::ostream& os,
 #ifdef EQ_INSTRUMENT_DATAOSTREAM
        << "compressed " << nBytesIn << " -> " << nBytesOut << " of " << nBytes
        << " in " << compressionTime/1000 << "ms, saved " << nBytesSaved
-       << " of " << nBytesSent << " brutto sent";
+       << " of " << nBytesSent << " brutto sent, " << nBytesReferenced
+       << " not copied";
 
     nBytes = 0;
     nBytesIn = 0;
     nBytesOut = 0;
     nBytesSaved = 0;
     nBytesSent = 0;
+    nBytesReferenced = 0;
     compressionTime = 0;
 #else
        << "@" << (void*)&dataOStream;
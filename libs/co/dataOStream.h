@@ -62,6 +62,9 @@ namespace DataStreamTest
 
         /** @return if data was sent since the last enable() */
         bool hasSentData() const { return _dataSent; }
+
+        /** @return the uncompressed size of the data sent until disable(). */
+        uint64_t getDataSize() const { return _dataSize; }
         //@}
 
         /** @name Data output */
@@ -74,7 +77,14 @@ namespace DataStreamTest
         template< typename T >
         DataOStream& operator << ( const std::vector< T >& value );
 
-        /** Write a number of bytes from data into the stream. */
+        /**
+         * Write a number of bytes from data into the stream.
+         *
+         * Unless the stream saves its data, writes of at least
+         * Global::IATTR_OBJECT_REFERENCE_SIZE bytes are not copied. The
+         * buffered data is flushed, and the given data is sent directly from
+         * the caller's memory before this method returns.
+         */
         CO_API void write( const void* data, uint64_t size );
 
         /**
@@ -146,6 +156,9 @@ namespace DataStreamTest
         /** The uncompressed size of a completely compressed buffer. */
         uint64_t _dataSize;
 
+        /** The number of bytes sent without copying them into the buffer. */
+        uint64_t _referencedSize;
+
         /** Locked connections to the receivers, if _enabled */
         Connections _connections;
         friend class DataStreamTest::Sender;
@@ -170,6 +183,9 @@ namespace DataStreamTest
         /** Reset after sending a buffer. */
         void _resetBuffer();
 
+        /** Flush the buffer, then send the data without copying it. */
+        void _writeReference( const void* data, const uint64_t size );
+
         /** Write a vector of trivial data. */
         template< typename T > 
         DataOStream& _writeFlatVector( const std::vector< T >& value )
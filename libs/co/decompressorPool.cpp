@@ -0,0 +1,145 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "decompressorPool.h"
+
+#include "global.h"
+#include "log.h"
+
+#include "base/cpuCompressor.h" // internal header
+#include <co/base/lock.h>
+#include <co/base/scopedMutex.h>
+#include <co/base/thread.h>
+#include <co/plugins/compressor.h>
+
+namespace co
+{
+namespace
+{
+base::Lock _lock;
+DecompressorPool* _instance = 0;
+}
+
+class DecompressorPool::Thread : public base::Thread
+{
+public:
+    Thread( base::MTQueue< Task* >& tasks ) : _tasks( tasks ) {}
+
+protected:
+    virtual bool init()
+        {
+            setName( "Decompressor" );
+            return true;
+        }
+
+    virtual void run()
+        {
+            while( true )
+            {
+                Task* task = _tasks.pop();
+                if( !task ) // exit
+                    return;
+
+                decompress( _decompressor, task->output, task->data,
+                            task->compressor, task->nChunks, task->size );
+                task->done = true;
+            }
+        }
+
+private:
+    base::MTQueue< Task* >& _tasks;
+    base::CPUCompressor _decompressor;
+};
+
+DecompressorPool::DecompressorPool( const size_t nThreads )
+{
+    EQLOG( LOG_OBJECTS ) << "Starting " << nThreads << " decompressor threads"
+                         << std::endl;
+    for( size_t i = 0; i < nThreads; ++i )
+    {
+        Thread* thread = new Thread( _tasks );
+        EQCHECK( thread->start( ));
+        _threads.push_back( thread );
+    }
+}
+
+DecompressorPool::~DecompressorPool()
+{
+    for( size_t i = 0; i < _threads.size(); ++i )
+        _tasks.push( 0 );
+
+    for( std::vector< Thread* >::const_iterator i = _threads.begin();
+         i != _threads.end(); ++i )
+    {
+        Thread* thread = *i;
+        thread->join();
+        delete thread;
+    }
+}
+
+DecompressorPool* DecompressorPool::getInstance()
+{
+    const int32_t nThreads =
+        Global::getIAttribute( Global::IATTR_OBJECT_DECOMPRESSOR_THREADS );
+    if( nThreads <= 0 )
+        return 0;
+
+    base::ScopedMutex<> mutex( _lock );
+    if( !_instance )
+        _instance = new DecompressorPool( nThreads );
+    return _instance;
+}
+
+void DecompressorPool::exit()
+{
+    base::ScopedMutex<> mutex( _lock );
+    delete _instance;
+    _instance = 0;
+}
+
+void DecompressorPool::decompress( base::CPUCompressor& decompressor,
+                                   uint8_t* output, const void* data,
+                                   const uint32_t compressor,
+                                   const uint32_t nChunks, const uint64_t size )
+{
+    EQASSERT( compressor > EQ_COMPRESSOR_NONE );
+
+    if ( !decompressor.isValid( compressor ))
+        decompressor.initDecompressor( compressor );
+
+    uint64_t outDim[2] = { 0, size };
+    uint64_t* chunkSizes = static_cast< uint64_t* >(
+                                alloca( nChunks * sizeof( uint64_t )));
+    void** chunks = static_cast< void ** >(
+                                alloca( nChunks * sizeof( void* )));
+    const uint8_t* src = reinterpret_cast< const uint8_t* >( data );
+
+    for( uint32_t i = 0; i < nChunks; ++i )
+    {
+        const uint64_t chunkSize = *reinterpret_cast< const uint64_t* >( src );
+        chunkSizes[ i ] = chunkSize;
+        src += sizeof( uint64_t );
+
+        // The plugin API uses non-const source buffers for in-place operations
+        chunks[ i ] = const_cast< uint8_t* >( src );
+        src += chunkSize;
+    }
+
+    decompressor.decompress( chunks, chunkSizes, nChunks, output, outDim );
+}
+
+}
@@ -0,0 +1,89 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CO_DECOMPRESSORPOOL_H
+#define CO_DECOMPRESSORPOOL_H
+
+#include <co/types.h>
+#include <co/base/monitor.h>  // member
+#include <co/base/mtQueue.h>  // member
+
+namespace co
+{
+    /**
+     * @internal
+     * A process-wide set of threads decompressing data stream buffers.
+     *
+     * Used by the ObjectDataIStream to decompress the packets of an object
+     * version concurrently, while the application deserializes the packets
+     * which are already decompressed. The number of threads is set by
+     * Global::IATTR_OBJECT_DECOMPRESSOR_THREADS when the pool is first used.
+     */
+    class DecompressorPool
+    {
+    public:
+        /** One compressed buffer, decompressed by one pool thread. */
+        struct Task
+        {
+            Task( const void* data_, const uint32_t compressor_,
+                  const uint32_t nChunks_, const uint64_t size_,
+                  uint8_t* output_ )
+                    : data( data_ ), compressor( compressor_ )
+                    , nChunks( nChunks_ ), size( size_ ), output( output_ )
+                    , done( false ) {}
+
+            const void* const data;    //!< The compressed chunks
+            const uint32_t compressor; //!< The compressor name
+            const uint32_t nChunks;    //!< The number of compressed chunks
+            const uint64_t size;       //!< The uncompressed size
+            uint8_t* const output;     //!< Receives size decompressed bytes
+
+            base::Monitor< bool > done; //!< Set when output is complete
+        };
+
+        /** @return the pool, or 0 if parallel decompression is disabled. */
+        static DecompressorPool* getInstance();
+
+        /** Stop and delete the pool threads. Called by co::exit(). */
+        static void exit();
+
+        /** Queue a task. The task's done monitor is set when finished. */
+        void push( Task* task ) { _tasks.push( task ); }
+
+        /**
+         * Decompress a data stream buffer.
+         *
+         * The buffer contains nChunks chunks, each preceded by its 8-byte
+         * size, as sent by the DataOStream. The output has to be allocated
+         * for size bytes by the caller.
+         */
+        static void decompress( base::CPUCompressor& decompressor,
+                                uint8_t* output, const void* data,
+                                const uint32_t compressor,
+                                const uint32_t nChunks, const uint64_t size );
+
+    private:
+        DecompressorPool( const size_t nThreads );
+        ~DecompressorPool();
+
+        class Thread;
+        std::vector< Thread* > _threads;
+        base::MTQueue< Task* > _tasks;
+    };
+}
+
+#endif // CO_DECOMPRESSORPOOL_H
@@ -31,12 +31,15 @@ namespace co
 
 typedef CommandFunc<DeltaMasterCM> CmdFunc;
         
-DeltaMasterCM::DeltaMasterCM( Object* object )
+DeltaMasterCM::DeltaMasterCM( Object* object, const bool lazy )
         : FullMasterCM( object )
 #pragma warning(push)
 #pragma warning(disable : 4355)
         , _deltaData( this )
 #pragma warning(pop)
+        , _lazy( lazy )
+        , _baseSize( 0 )
+        , _deltaSize( 0 )
 {}
 
 DeltaMasterCM::~DeltaMasterCM()
@@ -56,37 +59,40 @@ uint128_t DeltaMasterCM::commit( const uint32_t incarnation )
 
     if( _object->isDirty( ))
     {
-        if( !_slaves->empty( ))
+        if( _lazy && !_slaves->empty( ))
+            _commitLazy();
+        else
         {
-            _deltaData.reset();
-            _deltaData.enableCommit( _version + 1, *_slaves );
-            _object->pack( _deltaData );
-            _deltaData.disable();
-        }
-
-        if( _slaves->empty() || _deltaData.hasSentData( ))
-        {
-            // save instance data
-            InstanceData* instanceData = _newInstanceData();
-
-            instanceData->os.enableCommit( _version + 1, Nodes( ));
-            _object->getInstanceData( instanceData->os );
-            instanceData->os.disable();
+            if( !_slaves->empty( ))
+            {
+                _deltaData.reset();
+                _deltaData.enableCommit( _version + 1, *_slaves );
+                _object->pack( _deltaData );
+                _deltaData.disable();
+            }
 
-            if( _deltaData.hasSentData() || instanceData->os.hasSentData( ))
+            if( _slaves->empty() || _deltaData.hasSentData( ))
             {
-                ++_version;
-                EQASSERT( _version != VERSION_NONE );
+                // save instance data
+                InstanceData* instanceData = _newInstanceData();
+                _commitInstanceData( instanceData );
 
-                _addInstanceData( instanceData );
-            }
-            else
-                _releaseInstanceData( instanceData );
+                if( _deltaData.hasSentData() ||
+                    instanceData->os.hasSentData( ))
+                {
+                    ++_version;
+                    EQASSERT( _version != VERSION_NONE );
+
+                    _addInstanceData( instanceData );
+                }
+                else
+                    _releaseInstanceData( instanceData );
 
 #if 0
-            EQLOG( LOG_OBJECTS ) << "Committed v" << _version << " " 
-                                 << *_object << std::endl;
+                EQLOG( LOG_OBJECTS ) << "Committed v" << _version << " " 
+                                     << *_object << std::endl;
 #endif
+            }
         }
     }
 
@@ -94,4 +100,67 @@ uint128_t DeltaMasterCM::commit( const uint32_t incarnation )
     return _version;
 }
 
+void DeltaMasterCM::push( const uint128_t& groupID, const uint128_t& typeID,
+                          const Nodes& nodes )
+{
+    if( !_lazy || _deltaSize == 0 )
+    {
+        FullMasterCM::push( groupID, typeID, nodes );
+        return;
+    }
+
+    // the head version is only saved as a delta, push the current data
+    Mutex mutex( _slaves );
+    InstanceData* instanceData = _newInstanceData();
+    instanceData->os.enableCommit( _version, Nodes( ));
+    _object->getInstanceData( instanceData->os );
+    instanceData->os.disable();
+    instanceData->os.push( nodes, _object->getID(), groupID, typeID );
+    _releaseInstanceData( instanceData );
+}
+
+void DeltaMasterCM::_commitLazy()
+{
+    InstanceData* data = _newInstanceData();
+    if( !data->delta )
+        data->delta = new DeltaData( this );
+
+    DeltaData& delta = *data->delta;
+    delta.reset();
+    delta.enableSave();
+    delta.enableCommit( _version + 1, *_slaves );
+    _object->pack( delta );
+    delta.disable();
+
+    if( !delta.hasSentData( ))
+    {
+        _releaseInstanceData( data );
+        return;
+    }
+
+    _deltaSize += delta.getDataSize();
+    if( _deltaSize > _baseSize ) // replaying deltas costs more than a version
+        _commitInstanceData( data );
+    else
+    {
+        data->lazy = true;
+        data->os.enableCommit( _version + 1, Nodes( ));
+        data->os.disable();
+    }
+
+    ++_version;
+    EQASSERT( _version != VERSION_NONE );
+    _addInstanceData( data );
+}
+
+void DeltaMasterCM::_commitInstanceData( InstanceData* data )
+{
+    data->os.enableCommit( _version + 1, Nodes( ));
+    _object->getInstanceData( data->os );
+    data->os.disable();
+
+    _baseSize = data->os.getDataSize();
+    _deltaSize = 0;
+}
+
 }
@@ -28,15 +28,21 @@ namespace co
     /** 
      * An object change manager handling full versions and deltas for the master
      * instance.
+     *
+     * In lazy mode, a commit with slaves only saves the delta. New slaves are
+     * mapped using the last full version and the following deltas. A full
+     * version is created when the saved deltas outgrow it.
      * @internal
      */
     class DeltaMasterCM : public FullMasterCM
     {
     public:
-        DeltaMasterCM( Object* object );
+        DeltaMasterCM( Object* object, const bool lazy );
         virtual ~DeltaMasterCM();
 
         virtual uint128_t commit( const uint32_t incarnation );
+        virtual void push( const uint128_t& groupID, const uint128_t& typeID,
+                           const Nodes& nodes );
 
     private:
         /* The command handlers. */
@@ -44,6 +50,18 @@ namespace co
 
         typedef ObjectDeltaDataOStream DeltaData;
         DeltaData _deltaData;
+
+        /** Create instance data only on demand. */
+        const bool _lazy;
+
+        /** The size of the last full version. */
+        uint64_t _baseSize;
+
+        /** The size of the deltas saved since the last full version. */
+        uint64_t _deltaSize;
+
+        void _commitLazy();
+        void _commitInstanceData( InstanceData* data );
     };
 }
 
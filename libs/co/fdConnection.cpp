@@ -26,8 +26,13 @@
 #include <co/base/os.h>
 
 #include <errno.h>
+#include <limits.h>
 #include <poll.h>
 
+#ifndef IOV_MAX
+#  define IOV_MAX 16 // POSIX minimum
+#endif
+
 namespace co
 {
 FDConnection::FDConnection()
@@ -108,22 +113,53 @@ int64_t FDConnection::write( const void* buffer, const uint64_t bytes )
 
     if( bytesWritten == 0 || errno == EWOULDBLOCK || errno == EAGAIN )
     {
-        struct pollfd fds[1];
-        fds[0].fd = _writeFD;
-        fds[0].events = POLLOUT;
-        const int res = poll( fds, 1, _getTimeOut( ));
-        if (res < 0)
-        {
-            EQWARN << "Write error : " << strerror( errno ) << std::endl;
+        if( !_waitWritable( ))
             return -1;
-        }
+        bytesWritten = ::write( _writeFD, buffer, bytes );
+    }
 
-        if( res == 0)
-            throw Exception( Exception::TIMEOUT_WRITE );
+    return _getWriteResult( bytesWritten );
+}
 
-        bytesWritten = ::write( _writeFD, buffer, bytes );
+int64_t FDConnection::writev( const iovec* buffers, const size_t count )
+{
+    if( _state != STATE_CONNECTED || _writeFD < 1 )
+        return -1;
+
+    const int nBuffers = int( EQ_MIN( count, size_t( IOV_MAX )));
+    ssize_t bytesWritten = ::writev( _writeFD, buffers, nBuffers );
+    if( bytesWritten > 0 )
+        return bytesWritten;
+
+    if( bytesWritten == 0 || errno == EWOULDBLOCK || errno == EAGAIN )
+    {
+        if( !_waitWritable( ))
+            return -1;
+        bytesWritten = ::writev( _writeFD, buffers, nBuffers );
+    }
+
+    return _getWriteResult( bytesWritten );
+}
+
+bool FDConnection::_waitWritable()
+{
+    struct pollfd fds[1];
+    fds[0].fd = _writeFD;
+    fds[0].events = POLLOUT;
+    const int res = poll( fds, 1, _getTimeOut( ));
+    if (res < 0)
+    {
+        EQWARN << "Write error : " << strerror( errno ) << std::endl;
+        return false;
     }
 
+    if( res == 0)
+        throw Exception( Exception::TIMEOUT_WRITE );
+    return true;
+}
+
+int64_t FDConnection::_getWriteResult( const ssize_t bytesWritten )
+{
     if( bytesWritten > 0 )
         return bytesWritten;
 
@@ -40,6 +40,7 @@ namespace co
         virtual int64_t readSync( void* buffer, const uint64_t bytes,
                                   const bool ignored );
         virtual int64_t write( const void* buffer, const uint64_t bytes );
+        virtual int64_t writev( const iovec* buffers, const size_t count );
 
         int   _readFD;     //!< The read file descriptor.
         int   _writeFD;    //!< The write file descriptor.
@@ -49,6 +50,8 @@ namespace co
 
     private:
         int _getTimeOut();
+        bool _waitWritable();
+        int64_t _getWriteResult( const ssize_t bytesWritten );
 
     };
 
@@ -33,6 +33,7 @@ set(CO_PUBLIC_HEADERS
     object.h
     objectVersion.h
     packets.h
+    payloadReceiver.h
     queueMaster.h
     queueSlave.h
     serializable.h
@@ -43,10 +44,12 @@ set(CO_PUBLIC_HEADERS
 set(CO_HEADERS 
     barrierPackets.h
     dataIStreamQueue.h
+    decompressorPool.h
     dataOStream.ipp
     deltaMasterCM.h
     eventConnection.h
     fullMasterCM.h
+    instanceStore.h
     masterCM.h
     nodePackets.h
     nullCM.h
@@ -58,6 +61,7 @@ set(CO_HEADERS
     objectSlaveDataOStream.h
     pipeConnection.h
     pgmConnection.h
+    receiverPoolThread.h
     rspConnection.h
     socketConnection.h
     staticMasterCM.h
@@ -77,6 +81,7 @@ set(CO_SOURCES
     connectionSet.cpp
     dataIStream.cpp
     dataIStreamQueue.cpp
+    decompressorPool.cpp
     dataOStream.cpp
     deltaMasterCM.cpp
     dispatcher.cpp
@@ -85,6 +90,7 @@ set(CO_SOURCES
     global.cpp
     init.cpp
     instanceCache.cpp
+    instanceStore.cpp
     localNode.cpp
     masterCM.cpp
     mcipConnection.cpp
@@ -103,6 +109,7 @@ set(CO_SOURCES
     pipeConnection.cpp
     queueMaster.cpp
     queueSlave.cpp
+    receiverPoolThread.cpp
     socketConnection.cpp
     staticMasterCM.cpp
     staticSlaveCM.cpp
@@ -114,6 +121,7 @@ set(CO_SOURCES
   
 set(CO_COMPRESSOR_HEADERS
     compressor/compressor.h
+    compressor/compressorLZ.h
     compressor/compressorRLE4B.h
     compressor/compressorRLE4BU.h
     compressor/compressorRLE4HF.h
@@ -125,6 +133,7 @@ set(CO_COMPRESSOR_HEADERS
   
 set(CO_COMPRESSOR_SOURCES
     compressor/compressor.cpp
+    compressor/compressorLZ.cpp
     compressor/compressorRLE.ipp
     compressor/compressorRLE4B.cpp
     compressor/compressorRLE4BU.cpp
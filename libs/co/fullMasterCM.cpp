@@ -70,7 +70,8 @@ void FullMasterCM::sendInstanceData( Nodes& nodes )
         return;
 
     InstanceData* data = _instanceDatas.back();
-    data->os.sendInstanceData( nodes );
+    if( !data->lazy )
+        data->os.sendInstanceData( nodes );
 }
 
 void FullMasterCM::init()
@@ -143,31 +144,42 @@ void FullMasterCM::_obsolete()
         if( data->commitCount >= (_commitCount - _nVersions))
             break;
 
+        // A full version is the base of the following lazy versions. It is
+        // dropped together with them once a newer full version exists and
+        // the last lazy version is obsolete.
+        size_t nDatas = 1;
+        while( nDatas < _instanceDatas.size() && _instanceDatas[nDatas]->lazy )
+            ++nDatas;
+        if( nDatas == _instanceDatas.size( ))
+            break;
+        if( _instanceDatas[nDatas-1]->commitCount >= _commitCount - _nVersions )
+            break;
+
+        for( size_t i = 0; i < nDatas; ++i )
+        {
+            data = _instanceDatas.front();
 #ifdef EQ_INSTRUMENT
-        _bytesBuffered -= data->os.getSaveBuffer().getSize();
-        EQINFO << _bytesBuffered << " bytes used" << std::endl;
+            _bytesBuffered -= data->os.getSaveBuffer().getSize();
+            EQINFO << _bytesBuffered << " bytes used" << std::endl;
 #endif
 #if 0
-        EQINFO
-            << "Remove v" << data->os.getVersion() << " c" << data->commitCount
-            << "@" << _commitCount << "/" << _nVersions << " from "
-            << base::className( _object ) << " " << ObjectVersion( _object )
-            << std::endl;
+            EQINFO
+                << "Remove v" << data->os.getVersion() << " c"
+                << data->commitCount << "@" << _commitCount << "/"
+                << _nVersions << " from " << base::className( _object )
+                << " " << ObjectVersion( _object ) << std::endl;
 #endif
-        _releaseInstanceData( data );
-        _instanceDatas.pop_front();
+            _releaseInstanceData( data );
+            _instanceDatas.pop_front();
+        }
     }
     _checkConsistency();
 }
 
-void FullMasterCM::addSlave( Command& command, NodeMapObjectReplyPacket& reply )
+void FullMasterCM::addSlave( NodePtr node, const NodeMapObjectPacket* packet,
+                             NodeMapObjectReplyPacket& reply )
 {
     EQ_TS_THREAD( _cmdThread );
-    EQASSERT( command->type == PACKETTYPE_CO_NODE );
-    EQASSERT( command->command == CMD_NODE_MAP_OBJECT );
-
-    NodePtr node = command.getNode();
-    const NodeMapObjectPacket* packet = command.get< NodeMapObjectPacket >();
     const uint128_t requested  = packet->requestedVersion;
     const uint32_t instanceID = packet->instanceID;
 
@@ -237,11 +249,34 @@ void FullMasterCM::addSlave( Command& command, NodeMapObjectReplyPacket& reply )
     while( i != _instanceDatas.end() && (*i)->os.getVersion() < start )
         ++i;
 
+    // Lazy versions are sent as the previous full version followed by the
+    // deltas. The slave applies them up to reply.version in applyMapData().
+    if( start == reply.version && i != _instanceDatas.end( ))
+    {
+        while( (*i)->lazy )
+        {
+            EQASSERT( i != _instanceDatas.begin( ));
+            --i;
+        }
+    }
+
+    // deltas are unicast, send all data in order over the same connection
+    bool useMulticast = true;
+    for( InstanceDataDeque::const_iterator j = i;
+         j != _instanceDatas.end() && (*j)->os.getVersion() <= end; ++j )
+    {
+        if( (*j)->lazy )
+            useMulticast = false;
+    }
+
     for( ; i != _instanceDatas.end() && (*i)->os.getVersion() <= end; ++i )
     {
         InstanceData* data = *i;
         EQASSERT( data );
-        data->os.sendMapData( node, instanceID );
+        if( data->lazy )
+            data->delta->sendMapData( node, instanceID );
+        else
+            data->os.sendMapData( node, instanceID, useMulticast );
 
 #ifdef EQ_INSTRUMENT_MULTICAST
         ++_miss;
@@ -272,7 +307,7 @@ void FullMasterCM::_checkConsistency() const
         EQASSERT( data->os.getVersion() != VERSION_NONE );
         EQASSERTINFO( data->os.getVersion() == version,
                       data->os.getVersion() << " != " << version );
-        if( data != _instanceDatas.front( ))
+        if( data != _instanceDatas.front() && !data->lazy )
         {
             EQASSERTINFO( data->commitCount + _nVersions >= _commitCount,
                           data->commitCount << ", " << _commitCount << " [" <<
@@ -299,6 +334,7 @@ FullMasterCM::InstanceData* FullMasterCM::_newInstanceData()
     }
 
     instanceData->commitCount = _commitCount;
+    instanceData->lazy = false;
     instanceData->os.reset();
     instanceData->os.enableSave();
     return instanceData;
@@ -19,6 +19,7 @@
 #define CO_FULLMASTERCM_H
 
 #include "masterCM.h"        // base class
+#include "objectDeltaDataOStream.h"    // member
 #include "objectInstanceDataOStream.h" // member
 
 #include <deque>
@@ -49,7 +50,8 @@ namespace co
         virtual uint32_t getAutoObsolete() const { return _nVersions; }
         //@}
 
-        virtual void addSlave( Command& command,
+        virtual void addSlave( NodePtr node,
+                               const NodeMapObjectPacket* packet,
                                NodeMapObjectReplyPacket& reply );
 
         /** Speculatively send instance data to all nodes. */
@@ -59,10 +61,13 @@ namespace co
         struct InstanceData
         {
             InstanceData( const MasterCM* cm ) 
-                    : os( cm ), commitCount( 0 ) {}
+                    : os( cm ), delta( 0 ), commitCount( 0 ), lazy( false ) {}
+            ~InstanceData() { delete delta; }
 
             ObjectInstanceDataOStream os;
+            ObjectDeltaDataOStream* delta; //!< saved delta of a lazy version
             uint32_t commitCount;
+            bool lazy; //!< only the delta to the previous version is saved
         };
         
         InstanceData* _newInstanceData();
@@ -48,10 +48,17 @@ static uint32_t _getObjectBufferSize()
     return 60000;
 }
 
+static std::string _getInstanceCachePath()
+{
+    const char* env = getenv( "CO_INSTANCE_CACHE_PATH" );
+    return env ? env : std::string();
+}
+
 std::string _programName;
 std::string _workDir;
 uint16_t    _defaultPort = 0;
 uint32_t    _objectBufferSize = _getObjectBufferSize();
+std::string _instanceCachePath = _getInstanceCachePath();
 int32_t     _iAttributes[Global::IATTR_ALL] =
 {
     100,   // INSTANCE_CACHE_SIZE
@@ -76,6 +83,14 @@ int32_t     _iAttributes[Global::IATTR_ALL] =
     2,      // QUEUE_MAX_SIZE
     8,      // RDMA_RING_BUFFER_SIZE_MB
     5000,   // RDMA_RESOLVE_TIMEOUT_MS
+    1,      // CONNECTIONSET_EPOLL
+    0,      // NODE_RECEIVER_THREADS
+    65536,  // NODE_PAYLOAD_RECEIVE_SIZE
+    2,      // RSP_NACK_DELAY
+    0,      // RSP_DROP_RATE
+    65536,  // OBJECT_REFERENCE_SIZE
+    4,      // OBJECT_DECOMPRESSOR_THREADS
+    1024,   // INSTANCE_CACHE_STORE_SIZE
 };
 }
 
@@ -162,6 +177,15 @@ uint32_t Global::getObjectBufferSize()
     return  _objectBufferSize;
 }
 
+void Global::setInstanceCachePath( const std::string& path )
+{
+    _instanceCachePath = path;
+}
+const std::string& Global::getInstanceCachePath()
+{
+    return _instanceCachePath;
+}
+
 void Global::setIAttribute( const IAttribute attr, const int32_t value )
 {
     _iAttributes[ attr ] = value;
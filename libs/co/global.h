@@ -76,6 +76,25 @@ namespace co
         /** @return the minimum buffer size for Object serialization. */
         CO_API static uint32_t getObjectBufferSize();
 
+        /**
+         * Set the directory of the persistent instance cache.
+         *
+         * If set, the newest complete instance data of mapped objects is saved
+         * in this directory, and reused when mapping the same object version
+         * from the same master after a restart of the local node. The default
+         * is the value of the environment variable CO_INSTANCE_CACHE_PATH.
+         * An empty path disables the persistent instance cache. Only local
+         * nodes created afterwards use the new setting. The least recently
+         * used files are removed when the cache exceeds
+         * IATTR_INSTANCE_CACHE_STORE_SIZE megabytes.
+         *
+         * @param path the existing directory used to store the instance data.
+         */
+        CO_API static void setInstanceCachePath( const std::string& path );
+
+        /** @return the directory of the persistent instance cache. */
+        CO_API static const std::string& getInstanceCachePath();
+
         /** 
          * Set the global variables.
          *
@@ -116,6 +135,14 @@ namespace co
             IATTR_QUEUE_MAX_SIZE,        //!< @internal (tile) queue max size
             IATTR_RDMA_RING_BUFFER_SIZE_MB, //!< @internal send/receiver buffer
             IATTR_RDMA_RESOLVE_TIMEOUT_MS, //!< @internal address resolution
+            IATTR_CONNECTIONSET_EPOLL,   //!< @internal use epoll on Linux
+            IATTR_NODE_RECEIVER_THREADS, //!< @internal receiver pool size
+            IATTR_NODE_PAYLOAD_RECEIVE_SIZE, //!< @internal PayloadReceiver min
+            IATTR_RSP_NACK_DELAY,        //!< @internal max nack holdoff in ms
+            IATTR_RSP_DROP_RATE,         //!< @internal read loss in permille
+            IATTR_OBJECT_REFERENCE_SIZE, //!< @internal min unbuffered write
+            IATTR_OBJECT_DECOMPRESSOR_THREADS, //!< @internal parallel decomp.
+            IATTR_INSTANCE_CACHE_STORE_SIZE, //!< @internal max disk size in MB
             IATTR_ALL
         };
 
@@ -17,6 +17,7 @@
 
 #include "init.h"
 
+#include "decompressorPool.h"
 #include "global.h"
 #include "node.h"
 #include "socketConnection.h"
@@ -77,6 +78,7 @@ bool exit()
     if( --_initialized > 0 ) // not last
         return true;
     EQASSERT( _initialized == 0 );
+    DecompressorPool::exit();
 
 #ifdef _WIN32
     if( WSACleanup() != 0 )
@@ -18,6 +18,8 @@
 #include "instanceCache.h"
 
 #include "command.h"
+#include "commandCache.h"
+#include "instanceStore.h"
 #include "objectDataIStream.h"
 #include "objectVersion.h"
 
@@ -44,9 +46,12 @@ base::a_int32_t nUnusedRelease;
 
 const InstanceCache::Data InstanceCache::Data::NONE;
 
-InstanceCache::InstanceCache( const uint64_t maxSize )
+InstanceCache::InstanceCache( const uint64_t maxSize,
+                              const std::string& path,
+                              const uint64_t maxStoreSize )
         : _maxSize( maxSize )
         , _size( 0 )
+        , _store( path.empty() ? 0 : new InstanceStore( path, maxStoreSize ))
 {}
 
 InstanceCache::~InstanceCache()
@@ -59,6 +64,7 @@ InstanceCache::~InstanceCache()
 
     _items->clear();
     _size = 0;
+    delete _store;
 }
 
 InstanceCache::Data::Data() 
@@ -167,7 +173,11 @@ bool InstanceCache::add( const ObjectVersion& rev, const uint32_t instanceID,
     stream->addDataPacket( command );
     
     if( stream->isReady( ))
+    {
         _size += stream->getDataSize();
+        if( _store )
+            _store->save( rev.identifier, nodeID, instanceID, *stream );
+    }
 
     _releaseItems( 1 );
     _releaseItems( 0 );
@@ -181,6 +191,54 @@ bool InstanceCache::add( const ObjectVersion& rev, const uint32_t instanceID,
     return true;
 }
 
+StoredInstance* InstanceCache::load( const base::UUID& id )
+{
+    if( !_store )
+        return 0;
+    {
+        base::ScopedMutex<> mutex( _items );
+        if( _items->find( id ) != _items->end( ))
+            return 0;
+    }
+
+    StoredInstance* data = new StoredInstance;
+    if( _store->map( id, *data ))
+        return data;
+
+    delete data;
+    return 0;
+}
+
+bool InstanceCache::restore( const StoredInstance& data, NodePtr node,
+                             LocalNodePtr localNode, CommandCache& cache )
+{
+    {
+        base::ScopedMutex<> mutex( _items );
+        if( _items->find( data.id ) != _items->end( ))
+            return false;
+    }
+
+    const StoredInstance::Packets& packets = data.packets;
+    for( StoredInstance::Packets::const_iterator i = packets.begin();
+         i != packets.end(); ++i )
+    {
+        const ObjectInstancePacket* packet = *i;
+        Command& command = cache.alloc( node, localNode, packet->size );
+        memcpy( command.getModifiable< Packet >(), packet, packet->size );
+
+        const ObjectVersion rev( data.id, packet->version );
+        if( !add( rev, data.masterInstanceID, command, 0 ))
+            return false;
+    }
+    return !packets.empty();
+}
+
+void InstanceCache::flush()
+{
+    if( _store )
+        _store->flush();
+}
+
 void InstanceCache::remove( const NodeID& nodeID )
 {
     std::vector< base::uint128_t > keys;
@@ -31,12 +31,25 @@
 
 namespace co
 {
+    class CommandCache;
+    class InstanceStore;
+    struct StoredInstance;
+
     /** @internal A thread-safe cache for object instance data. */
     class InstanceCache
     {
     public:
-        /** Construct a new instance cache. */
-        CO_API InstanceCache( const uint64_t maxSize = EQ_100MB );
+        /**
+         * Construct a new instance cache.
+         *
+         * @param maxSize the maximum size of the cached data in memory.
+         * @param path the directory of the persistent backing store, or an
+         *             empty string to disable the persistent store.
+         * @param maxStoreSize the maximum size of the persistent store.
+         */
+        CO_API InstanceCache( const uint64_t maxSize = EQ_100MB,
+                              const std::string& path = std::string(),
+                              const uint64_t maxStoreSize = 1024 * EQ_1MB );
 
         /** Destruct this instance cache. */
         CO_API ~InstanceCache();
@@ -53,6 +66,39 @@ namespace co
         CO_API bool add( const ObjectVersion& rev, const uint32_t instanceID, 
                   Command& command, const uint32_t usage = 0 );
 
+        /**
+         * Load the instance data of an object from the persistent store.
+         *
+         * Nothing is loaded if the object already has cached data or no valid
+         * data is stored. The data is mapped and validated in the calling
+         * thread, which should not be the receiver thread.
+         *
+         * @param id the identifier of the object.
+         * @return the loaded data, to be restored and deleted by the caller,
+         *         or 0.
+         */
+        StoredInstance* load( const base::UUID& id );
+
+        /**
+         * Add instance data loaded from the persistent store to the cache.
+         *
+         * Must be called from the receiver thread.
+         *
+         * @param data the loaded instance data.
+         * @param node the node holding the master instance of the object.
+         * @param localNode the local node.
+         * @param cache the cache to allocate the instance data commands.
+         * @return true if data was restored, false otherwise.
+         */
+        bool restore( const StoredInstance& data, NodePtr node,
+                      LocalNodePtr localNode, CommandCache& cache );
+
+        /** Wait until the persistent store has written all queued data. */
+        void flush();
+
+        /** @return true if the instance data is saved persistently. */
+        bool isPersistent() const { return _store != 0; }
+
         /** Remove all items from the given node. */
         void remove( const NodeID& node );
 
@@ -135,6 +181,8 @@ namespace co
 
         const base::Clock _clock;  //!< Clock for item expiration
 
+        InstanceStore* const _store; //!< persistent backing store, or 0
+
         void _releaseItems( const uint32_t minUsage );
         void _releaseStreams( InstanceCache::Item& item );
         void _releaseStreams( InstanceCache::Item& item, 
@@ -0,0 +1,407 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com> 
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *  
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "instanceStore.h"
+
+#include "command.h"
+#include "commands.h"
+#include "log.h"
+#include "objectDataIStream.h"
+
+#include <co/base/debug.h>
+#include <co/base/file.h>
+#include <co/base/os.h>
+#include <co/base/scopedMutex.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace co
+{
+namespace
+{
+/** 'coIStor2', changes with the file format. */
+static const uint64_t _magic = 0x636F4953746F7232ull;
+
+/** The file header, followed by the 8-byte aligned packets. */
+struct Header
+{
+    uint64_t magic;
+    base::uint128_t id;
+    base::uint128_t version;
+    NodeID masterNodeID; //!< the node which sent the data
+    uint64_t size;      //!< number of bytes following the header
+    uint64_t checksum;  //!< FNV-1a hash of the bytes following the header
+    uint32_t masterInstanceID;
+    uint32_t nPackets;
+};
+
+uint64_t _getAlignedSize( const uint64_t size )
+{
+    return ( size + 7 ) & ~uint64_t( 7 );
+}
+
+/** A file found in the store directory, for the initial LRU order. */
+struct StoredFile
+{
+    time_t time;
+    base::uint128_t id;
+    base::uint128_t version;
+    uint64_t size;
+
+    bool operator < ( const StoredFile& rhs ) const { return time < rhs.time; }
+};
+
+uint64_t _hash( const uint8_t* data, const uint64_t size,
+                uint64_t hash = 0xcbf29ce484222325ull )
+{
+    for( uint64_t i = 0; i < size; ++i )
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+}
+
+InstanceStore::InstanceStore( const std::string& path,
+                              const uint64_t maxSize )
+        : _path( path )
+        , _maxSize( maxSize )
+        , _size( 0 )
+        , _used( 0 )
+        , _warned( false )
+        , _nPending( 0 )
+        , _writer( this )
+{
+    EQINFO << "Using persistent instance cache in " << path << ", "
+           << maxSize / EQ_1MB << " MB" << std::endl;
+    _scan();
+    EQCHECK( _writer.start( ));
+}
+
+InstanceStore::~InstanceStore()
+{
+    _saveQueue.push( 0 );
+    EQCHECK( _writer.join( ));
+}
+
+std::string InstanceStore::_getFilename( const base::UUID& id ) const
+{
+    std::ostringstream name;
+    name << _path << "/co." << std::hex << id.high() << '.' << id.low()
+         << ".instance";
+    return name.str();
+}
+
+void InstanceStore::_scan()
+{
+    // files of earlier runs are evicted first, oldest first
+    const base::Strings names = base::searchDirectory( _path,
+                                                       "co.*.instance" );
+    std::vector< StoredFile > files;
+    for( base::StringsCIter i = names.begin(); i != names.end(); ++i )
+    {
+        const std::string filename = _path + "/" + *i;
+        struct stat info;
+        Header header;
+        std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary);
+        file.read( reinterpret_cast< char* >( &header ), sizeof( header ));
+        if( !file || ::stat( filename.c_str(), &info ) != 0 ||
+            header.magic != _magic || filename != _getFilename( header.id ))
+        {
+            continue;
+        }
+
+        StoredFile stored;
+        stored.time = info.st_mtime;
+        stored.id = header.id;
+        stored.version = header.version;
+        stored.size = info.st_size;
+        files.push_back( stored );
+    }
+    std::sort( files.begin(), files.end( ));
+
+    for( std::vector< StoredFile >::const_iterator i = files.begin();
+         i != files.end(); ++i )
+    {
+        Item& item = _items[ i->id ];
+        item.version = i->version;
+        item.size = i->size;
+        item.used = ++_used;
+        _size += i->size;
+    }
+    _evict();
+}
+
+bool InstanceStore::save( const base::UUID& id, const NodeID& masterNodeID,
+                          const uint32_t masterInstanceID,
+                          const ObjectDataIStream& stream )
+{
+    EQASSERT( stream.isReady( ));
+    const uint128_t& version = stream.getVersion();
+    const CommandDeque& commands = stream.getCommands();
+    EQASSERT( !commands.empty( ));
+    {
+        base::ScopedMutex<> mutex( _lock );
+        ItemHash::const_iterator i = _items.find( id );
+        if( i != _items.end() && i->second.version >= version )
+            return false;
+        _items[ id ].version = version;
+    }
+
+    SaveRequest* request = new SaveRequest;
+    request->id = id;
+    request->masterNodeID = masterNodeID;
+    request->masterInstanceID = masterInstanceID;
+    request->version = version;
+    for( CommandDequeCIter i = commands.begin(); i != commands.end(); ++i )
+    {
+        Command* command = *i;
+        command->retain();
+        request->commands.push_back( command );
+    }
+
+    ++_nPending;
+    _saveQueue.push( request );
+    return true;
+}
+
+void InstanceStore::flush()
+{
+    _nPending.waitEQ( 0 );
+}
+
+void InstanceStore::Writer::run()
+{
+    while( SaveRequest* request = _store->_saveQueue.pop( ))
+    {
+        _store->_write( *request );
+
+        for( std::vector< Command* >::const_iterator i =
+                 request->commands.begin(); i != request->commands.end(); ++i )
+        {
+            (*i)->release();
+        }
+        delete request;
+        --_store->_nPending;
+    }
+}
+
+void InstanceStore::_write( const SaveRequest& request )
+{
+    const std::vector< Command* >& commands = request.commands;
+
+    Header header;
+    header.magic = _magic;
+    header.id = request.id;
+    header.version = request.version;
+    header.masterNodeID = request.masterNodeID;
+    header.size = 0;
+    header.checksum = 0xcbf29ce484222325ull;
+    header.masterInstanceID = request.masterInstanceID;
+    header.nPackets = uint32_t( commands.size( ));
+
+    const uint64_t zero = 0;
+    for( std::vector< Command* >::const_iterator i = commands.begin();
+         i != commands.end(); ++i )
+    {
+        const Packet* packet = (*i)->get< Packet >();
+        const uint64_t padding = _getAlignedSize( packet->size ) - packet->size;
+        header.checksum = _hash( reinterpret_cast< const uint8_t* >( packet ),
+                                 packet->size, header.checksum );
+        header.checksum = _hash( reinterpret_cast< const uint8_t* >( &zero ),
+                                 padding, header.checksum );
+        header.size += packet->size + padding;
+    }
+
+    const uint64_t size = sizeof( header ) + header.size;
+    const std::string filename = _getFilename( request.id );
+    bool written = false;
+    if( size <= _maxSize )
+    {
+        // write to a temporary file and rename, so readers never see partial
+        // data
+        const std::string tmpName = filename + ".tmp";
+        std::ofstream file( tmpName.c_str(), std::ios::out|std::ios::binary );
+        file.write( reinterpret_cast< const char* >( &header ),
+                    sizeof( header ));
+        for( std::vector< Command* >::const_iterator i = commands.begin();
+             i != commands.end(); ++i )
+        {
+            const Packet* packet = (*i)->get< Packet >();
+            const uint64_t padding = _getAlignedSize( packet->size ) -
+                                     packet->size;
+            file.write( reinterpret_cast< const char* >( packet ),
+                        std::streamsize( packet->size ));
+            file.write( reinterpret_cast< const char* >( &zero ),
+                        std::streamsize( padding ));
+        }
+        file.close();
+
+#ifdef _WIN32 // rename does not replace an existing file
+        written = file && MoveFileEx( tmpName.c_str(), filename.c_str(),
+                                      MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+        written = file && ::rename( tmpName.c_str(), filename.c_str( )) == 0;
+#endif
+        if( !written )
+        {
+            ::remove( tmpName.c_str( ));
+            if( !_warned )
+                EQWARN << "Can't write persistent instance cache file "
+                       << filename << std::endl;
+            _warned = true;
+        }
+    }
+
+    base::ScopedMutex<> mutex( _lock );
+    Item& item = _items[ request.id ]; // might have been evicted meanwhile
+    _size -= item.size;
+    if( !written )
+    {
+        // the old file, if any, is outdated
+        ::remove( filename.c_str( ));
+        _items.erase( request.id );
+        return;
+    }
+
+    if( item.version < request.version )
+        item.version = request.version;
+    item.size = size;
+    item.used = ++_used;
+    _size += size;
+    EQLOG( LOG_OBJECTS ) << "Saved v" << request.version << " of object "
+                         << request.id << ", " << header.size << " bytes"
+                         << std::endl;
+    _evict();
+}
+
+void InstanceStore::_evict()
+{
+    while( _size > _maxSize )
+    {
+        ItemHash::iterator lru = _items.end();
+        for( ItemHash::iterator i = _items.begin(); i != _items.end(); ++i )
+        {
+            // skip files not written yet
+            if( i->second.size > 0 &&
+                ( lru == _items.end() || i->second.used < lru->second.used ))
+            {
+                lru = i;
+            }
+        }
+        EQASSERT( lru != _items.end( ));
+        if( lru == _items.end( ))
+            return;
+
+        const base::UUID id = lru->first;
+        EQLOG( LOG_OBJECTS ) << "Evicting object " << id << " from persistent "
+                             << "instance cache" << std::endl;
+        ::remove( _getFilename( id ).c_str( ));
+        _size -= lru->second.size;
+        _items.erase( lru );
+    }
+}
+
+bool InstanceStore::map( const base::UUID& id, StoredInstance& data )
+{
+    const std::string filename = _getFilename( id );
+    struct stat info;
+    if( ::stat( filename.c_str(), &info ) != 0 )
+        return false;
+
+    const uint8_t* ptr = static_cast< const uint8_t* >(
+        data.file.map( filename ));
+    if( !ptr )
+        return false;
+
+    const size_t size = data.file.getSize();
+    const Header* header = reinterpret_cast< const Header* >( ptr );
+    const uint8_t* payload = ptr + sizeof( Header );
+    bool valid = size >= sizeof( Header ) && header->magic == _magic &&
+                 header->id == id &&
+                 header->size == size - sizeof( Header ) &&
+                 header->checksum == _hash( payload, header->size );
+
+    // validate the packet sequence
+    StoredInstance::Packets& packets = data.packets;
+    for( uint64_t offset = 0; valid && offset < header->size; )
+    {
+        const uint64_t remaining = header->size - offset;
+        if( remaining < sizeof( ObjectDataPacket ))
+        {
+            valid = false;
+            break;
+        }
+
+        const ObjectInstancePacket* packet =
+            reinterpret_cast< const ObjectInstancePacket* >( payload + offset );
+        const bool last = offset + _getAlignedSize( packet->size ) >=
+                          header->size;
+
+        valid = packet->size >= sizeof( ObjectDataPacket ) &&
+                _getAlignedSize( packet->size ) <= remaining &&
+                packet->command == CMD_OBJECT_INSTANCE &&
+                packet->version == header->version &&
+                packet->sequence == packets.size() &&
+                bool( packet->last ) == last;
+
+        packets.push_back( packet );
+        offset += _getAlignedSize( packet->size );
+    }
+
+    base::ScopedMutex<> mutex( _lock );
+    if( !valid || packets.size() != header->nPackets )
+    {
+        EQWARN << "Removing invalid persistent instance cache file "
+               << filename << std::endl;
+        packets.clear();
+        data.file.unmap();
+        ::remove( filename.c_str( ));
+
+        ItemHash::iterator i = _items.find( id );
+        if( i != _items.end() && i->second.size > 0 )
+        {
+            _size -= i->second.size;
+            _items.erase( i );
+        }
+        return false;
+    }
+
+    data.id = id;
+    data.masterNodeID = header->masterNodeID;
+    data.masterInstanceID = header->masterInstanceID;
+
+    Item& item = _items[ id ];
+    if( item.size == 0 ) // not known yet
+    {
+        item.version = header->version;
+        item.size = size;
+        _size += size;
+    }
+    item.used = ++_used;
+
+    EQLOG( LOG_OBJECTS ) << "Mapped v" << header->version << " of object " << id
+                         << ", " << header->size << " bytes" << std::endl;
+    return true;
+}
+
+}
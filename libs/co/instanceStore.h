@@ -0,0 +1,160 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com> 
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *  
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CO_INSTANCESTORE_H
+#define CO_INSTANCESTORE_H
+
+#include "objectPackets.h"     // used inline
+#include "types.h"
+
+#include <co/base/lock.h>        // member
+#include <co/base/memoryMap.h>   // member
+#include <co/base/monitor.h>     // member
+#include <co/base/mtQueue.h>     // member
+#include <co/base/nonCopyable.h> // base class
+#include <co/base/stdExt.h>      // member
+#include <co/base/thread.h>      // base class
+#include <co/base/uuid.h>        // member
+
+#include <vector>
+
+namespace co
+{
+    /** @internal The mapped instance data of one object. */
+    struct StoredInstance : public base::NonCopyable
+    {
+        StoredInstance() : masterInstanceID( EQ_INSTANCE_INVALID ) {}
+
+        typedef std::vector< const ObjectInstancePacket* > Packets;
+
+        base::UUID id;             //!< the object identifier
+        NodeID masterNodeID;       //!< the master node which sent the data
+        uint32_t masterInstanceID; //!< the instance ID of the master object
+        base::MemoryMap file;      //!< the mapped file
+        Packets packets;           //!< the packets, pointing into file
+    };
+    typedef std::vector< StoredInstance* > StoredInstances;
+
+    /**
+     * @internal A persistent backing store for the instance cache.
+     *
+     * The newest complete instance data of each object is written to one file
+     * per object in the store directory, keyed by the object identifier and
+     * version. Files are written by a worker thread. Reading memory-maps the
+     * file and validates its header, the checksum of the packet data and the
+     * packet sequence. The least recently used files are removed when the
+     * store outgrows its maximum size.
+     */
+    class InstanceStore : public base::NonCopyable
+    {
+    public:
+        /**
+         * Construct a new instance store using the given directory.
+         *
+         * @param path the directory of the store.
+         * @param maxSize the maximum size of all files in the store.
+         */
+        InstanceStore( const std::string& path, const uint64_t maxSize );
+
+        /** Destruct this instance store after writing all queued data. */
+        ~InstanceStore();
+
+        /**
+         * Queue a complete instance data stream for saving, unless the store
+         * has the same or a newer version of the object.
+         *
+         * The data is retained until the worker thread has written it.
+         *
+         * @param id the object identifier.
+         * @param masterNodeID the node of the master object.
+         * @param masterInstanceID the instance ID of the master object.
+         * @param stream the ready instance data stream.
+         * @return true if the data was queued, false otherwise.
+         */
+        bool save( const base::UUID& id, const NodeID& masterNodeID,
+                   const uint32_t masterInstanceID,
+                   const ObjectDataIStream& stream );
+
+        /** Wait until all queued data has been written. */
+        void flush();
+
+        /**
+         * Map and validate the stored instance data of an object.
+         *
+         * Invalid files are removed from the store. The packets point into the
+         * mapped file and are valid until the data is destroyed.
+         *
+         * @param id the object identifier.
+         * @param data return value for the mapped data.
+         * @return true if valid data was mapped, false otherwise.
+         */
+        bool map( const base::UUID& id, StoredInstance& data );
+
+        /** @return the size of all files in the store. */
+        uint64_t getSize() const { return _size; }
+
+    private:
+        const std::string _path;
+        const uint64_t _maxSize;
+
+        /** A stored file. */
+        struct Item
+        {
+            Item() : size( 0 ), used( 0 ) {}
+            uint128_t version; //!< the saved or queued version
+            uint64_t size;     //!< the file size, 0 until written
+            uint64_t used;     //!< the last use, for LRU eviction
+        };
+        typedef stde::hash_map< base::uint128_t, Item > ItemHash;
+
+        ItemHash _items; //!< stored files, by _lock
+        uint64_t _size;  //!< the size of all files, by _lock
+        uint64_t _used;  //!< the use counter, by _lock
+        base::Lock _lock;
+        bool _warned; //!< a write error has been reported
+
+        /** Data queued by save(). */
+        struct SaveRequest
+        {
+            base::UUID id;
+            NodeID masterNodeID;
+            uint32_t masterInstanceID;
+            uint128_t version;
+            std::vector< Command* > commands; //!< retained data packets
+        };
+
+        base::MTQueue< SaveRequest* > _saveQueue;
+        base::Monitor< uint32_t > _nPending; //!< queued save requests
+
+        class Writer : public base::Thread
+        {
+        public:
+            Writer( InstanceStore* store ) : _store( store ) {}
+            virtual bool init() { setName( "InstanceStore" ); return true; }
+            virtual void run();
+
+        private:
+            InstanceStore* const _store;
+        } _writer;
+
+        std::string _getFilename( const base::UUID& id ) const;
+        void _scan();
+        void _write( const SaveRequest& request );
+        void _evict();
+    };
+}
+#endif //CO_INSTANCESTORE_H
@@ -26,7 +26,9 @@
 #include "nodePackets.h"
 #include "object.h"
 #include "objectStore.h"
+#include "payloadReceiver.h"
 #include "pipeConnection.h"
+#include "receiverPoolThread.h"
 
 #include <co/base/log.h>
 #include <co/base/requestHandler.h>
@@ -89,6 +91,7 @@ LocalNode::~LocalNode( )
     EQASSERT( _incoming.isEmpty( ));
     EQASSERT( _connectionNodes.empty( ));
     EQASSERT( _pendingCommands.empty( ));
+    EQASSERT( _receiverPool.empty( ));
     EQASSERT( _nodes->empty( ));
     EQASSERT( !hasPendingRequests( ));
 
@@ -209,6 +212,7 @@ bool LocalNode::listen()
     
     EQVERB << base::className( this ) << " start command and receiver thread "
            << std::endl;
+    _startReceiverPool();
     _receiverThread->start();
 
     EQINFO << *this << std::endl;
@@ -293,7 +297,15 @@ void LocalNode::_removeConnection( ConnectionPtr connection )
 {
     EQASSERT( connection.isValid( ));
 
-    _incoming.removeConnection( connection );
+    if( !_incoming.removeConnection( connection ))
+    {
+        for( std::vector< ReceiverPoolThread* >::const_iterator i =
+                 _receiverPool.begin(); i != _receiverPool.end(); ++i )
+        {
+            if( (*i)->removeConnection( connection ))
+                break;
+        }
+    }
 
     void* buffer( 0 );
     uint64_t bytes( 0 );
@@ -572,6 +584,30 @@ bool LocalNode::mapObjectSync( const uint32_t requestID )
     return _objectStore->mapObjectSync( requestID );
 }
 
+bool LocalNode::mapObjects( const Objects& objects,
+                            const ObjectVersions& versions )
+{
+    return mapObjectsSync( mapObjectsNB( objects, versions ));
+}
+
+std::vector< uint32_t > LocalNode::mapObjectsNB( const Objects& objects,
+                                             const ObjectVersions& versions )
+{
+    return _objectStore->mapObjectsNB( objects, versions );
+}
+
+bool LocalNode::mapObjectsSync( const std::vector< uint32_t >& requestIDs )
+{
+    bool mapped = true;
+    for( std::vector< uint32_t >::const_iterator i = requestIDs.begin();
+         i != requestIDs.end(); ++i )
+    {
+        if( !_objectStore->mapObjectSync( *i ))
+            mapped = false;
+    }
+    return mapped;
+}
+
 void LocalNode::unmapObject( Object* object )
 {
     _objectStore->unmapObject( object );
@@ -830,6 +866,9 @@ void LocalNode::_runReceiverThread()
     while( _state == STATE_LISTENING )
     {
         const ConnectionSet::Event result = _incoming.select();
+        if( !_receiverPool.empty( ))
+            _handlePoolData();
+
         switch( result )
         {
             case ConnectionSet::EVENT_CONNECT:
@@ -883,6 +922,8 @@ void LocalNode::_runReceiverThread()
             nErrors = 0;
     }
 
+    _stopReceiverPool();
+
     if( !_pendingCommands.empty( ))
         EQWARN << _pendingCommands.size() 
                << " commands pending while leaving command thread" << std::endl;
@@ -899,6 +940,15 @@ void LocalNode::_runReceiverThread()
     _pendingCommands.clear();
     _commandCache.flush();
 
+    for( std::vector< ReceiverPoolThread* >::const_iterator i =
+             _receiverPool.begin(); i != _receiverPool.end(); ++i )
+    {
+        ReceiverPoolThread* thread = *i;
+        thread->flush();
+        delete thread;
+    }
+    _receiverPool.clear();
+
     EQINFO << "Leaving receiver thread of " << base::className( this )
            << std::endl;
 }
@@ -920,8 +970,11 @@ void LocalNode::_handleConnect()
 void LocalNode::_handleDisconnect()
 {
     while( _handleData( )) ; // read remaining data off connection
+    _disconnect( _incoming.getConnection( ));
+}
 
-    ConnectionPtr connection = _incoming.getConnection();
+void LocalNode::_disconnect( ConnectionPtr connection )
+{
     ConnectionNodeHash::iterator i = _connectionNodes.find( connection );
 
     if( i != _connectionNodes.end( ))
@@ -981,6 +1034,113 @@ void LocalNode::_handleDisconnect()
     EQINFO << "connection used " << connection->getRefCount() << std::endl;
 }
 
+//----------------------------------------------------------------------
+// receiver pool
+//----------------------------------------------------------------------
+void LocalNode::_startReceiverPool()
+{
+    EQASSERT( _receiverPool.empty( ));
+    const int32_t nThreads =
+        Global::getIAttribute( Global::IATTR_NODE_RECEIVER_THREADS );
+
+    for( int32_t i = 0; i < nThreads; ++i )
+    {
+        ReceiverPoolThread* thread = new ReceiverPoolThread( this );
+        EQCHECK( thread->start( ));
+        _receiverPool.push_back( thread );
+    }
+}
+
+void LocalNode::_stopReceiverPool()
+{
+    EQASSERT( _inReceiverThread( ));
+
+    Connections connections;
+    for( std::vector< ReceiverPoolThread* >::const_iterator i =
+             _receiverPool.begin(); i != _receiverPool.end(); ++i )
+    {
+        (*i)->stop( connections );
+    }
+
+    // Not dispatched, like any data arriving after the stop command
+    PoolData data;
+    while( _poolData.tryPop( data ))
+    {
+        if( data.first )
+            data.first->release();
+        else
+            connections.push_back( data.second );
+    }
+
+    // Hand connections back to the connection set for _cleanup()
+    for( Connections::const_iterator i = connections.begin();
+         i != connections.end(); ++i )
+    {
+        ConnectionPtr connection = *i;
+        if( !connection->isClosed( ))
+        {
+            _incoming.addConnection( connection );
+            continue;
+        }
+
+        ConnectionNodeHash::iterator j = _connectionNodes.find( connection );
+        if( j != _connectionNodes.end( ))
+        {
+            NodePtr node = j->second;
+            node->_state    = STATE_CLOSED;
+            node->_outgoing = 0;
+            _connectionNodes.erase( j );
+
+            base::ScopedMutex< base::SpinLock > mutex( _nodes );
+            _nodes->erase( node->_id );
+        }
+        _removeConnection( connection );
+    }
+}
+
+void LocalNode::_addToReceiverPool( ConnectionPtr connection, NodePtr node )
+{
+    EQASSERT( _inReceiverThread( ));
+    if( _receiverPool.empty() ||
+        connection->getDescription()->type >= CONNECTIONTYPE_MULTICAST )
+    {
+        return;
+    }
+
+    // A connection is always read by the same thread to keep packet order
+    const size_t hash = base::hashRefPtr< Connection >()( connection );
+    ReceiverPoolThread* thread = _receiverPool[ hash % _receiverPool.size() ];
+
+    _incoming.removeConnection( connection );
+    thread->addConnection( connection, node );
+}
+
+void LocalNode::_pushPoolData( Command* command, ConnectionPtr connection )
+{
+    _poolData.push( PoolData( command, connection ));
+    _incoming.interrupt();
+}
+
+void LocalNode::_handlePoolData()
+{
+    EQASSERT( _inReceiverThread( ));
+
+    PoolData data;
+    while( _poolData.tryPop( data ))
+    {
+        if( !data.first )
+        {
+            _disconnect( data.second );
+            continue;
+        }
+
+        Command& command = *data.first;
+        command.getNode()->_lastReceive = getTime64();
+        _dispatchCommand( command );
+        command.release();
+    }
+}
+
 bool LocalNode::_handleData()
 {
     ConnectionPtr connection = _incoming.getConnection();
@@ -1024,39 +1184,135 @@ bool LocalNode::_handleData()
     if( node )
         node->_lastReceive = getTime64();
 
-    Command& command = _commandCache.alloc( node, this, size );
-    uint8_t* ptr = reinterpret_cast< uint8_t* >(
-        command.getModifiable< Packet >()) + sizeof( uint64_t );
-
-    connection->recvNB( ptr, size - sizeof( uint64_t ));
-    const bool gotData = connection->recvSync( 0, 0 );
-
-    EQASSERT( gotData );
-    EQASSERT( command.isValid( ));
-    EQASSERT( command.isFree( ));
+    Command* command = _readCommand( connection, node, size, _commandCache );
+    EQASSERT( command );
 
     // start next receive
     connection->recvNB( sizePtr, sizeof( uint64_t ));
 
-    if( !gotData )
+    if( !command )
     {
-        EQERROR << "Incomplete packet read: " << command << std::endl;
+        EQERROR << "Incomplete packet read on " << connection->getDescription()
+                << std::endl;
         return false;
     }
 
+    EQASSERT( command->isValid( ));
+    EQASSERT( command->isFree( ));
+
     // This is one of the initial packets during the connection handshake, at
     // this point the remote node is not yet available.
     EQASSERTINFO( node.isValid() ||
-                 ( command->type == PACKETTYPE_CO_NODE &&
-                  ( command->command == CMD_NODE_CONNECT  || 
-                    command->command == CMD_NODE_CONNECT_REPLY ||
-                    command->command == CMD_NODE_ID )),
-                  command << " connection " << connection );
+                 ( (*command)->type == PACKETTYPE_CO_NODE &&
+                  ( (*command)->command == CMD_NODE_CONNECT  || 
+                    (*command)->command == CMD_NODE_CONNECT_REPLY ||
+                    (*command)->command == CMD_NODE_ID )),
+                  *command << " connection " << connection );
 
-    _dispatchCommand( command );
+    _dispatchCommand( *command );
     return true;
 }
 
+Command* LocalNode::_readCommand( ConnectionPtr connection, NodePtr node,
+                                  const uint64_t size, CommandCache& cache )
+{
+    Packet header;
+    header.size = size;
+    uint64_t offset = sizeof( uint64_t ); // bytes read so far
+    uint64_t headerSize = size;
+    PayloadReceiver* receiver = 0;
+
+    bool hasReceivers = false;
+    if( size >= uint64_t( Global::getIAttribute(
+                              Global::IATTR_NODE_PAYLOAD_RECEIVE_SIZE )))
+    {
+        base::ScopedMutex< base::SpinLock > mutex( _payloadReceivers );
+        hasReceivers = !_payloadReceivers->empty();
+    }
+
+    if( hasReceivers )
+    {
+        // read type and command to find the payload receiver
+        connection->recvNB( reinterpret_cast< uint8_t* >( &header ) + offset,
+                            sizeof( Packet ) - offset );
+        if( !connection->recvSync( 0, 0 ))
+            return 0;
+        offset = sizeof( Packet );
+
+        receiver = _getPayloadReceiver( header );
+        if( receiver )
+        {
+            headerSize = receiver->getHeaderSize();
+            EQASSERTINFO( headerSize >= sizeof( Packet ) && headerSize < size,
+                          headerSize << " for " << size << " byte packet" );
+        }
+    }
+
+    Command& command = cache.alloc( node, this, headerSize );
+    uint8_t* ptr = reinterpret_cast< uint8_t* >(
+        command.getModifiable< Packet >( ));
+
+    memcpy( ptr + sizeof( uint64_t ),
+            reinterpret_cast< uint8_t* >( &header ) + sizeof( uint64_t ),
+            offset - sizeof( uint64_t ));
+    if( headerSize > offset )
+    {
+        connection->recvNB( ptr + offset, headerSize - offset );
+        if( !connection->recvSync( 0, 0 ))
+            return 0;
+    }
+
+    if( headerSize == size )
+        return &command;
+
+    // receive payload into receiver memory
+    Packet* packet = command.getModifiable< Packet >();
+    packet->size = size;
+
+    const uint64_t payloadSize = size - headerSize;
+    base::Bufferb* payload = receiver->allocPayload( packet, payloadSize );
+    if( payload )
+    {
+        // released with the command, also if the receive fails
+        EQASSERT( payload->getSize() == payloadSize );
+        command.setPayload_( receiver, payload );
+        connection->recvNB( payload->getData(), payloadSize );
+        return connection->recvSync( 0, 0 ) ? &command : 0;
+    }
+
+    // no memory from receiver, read full packet into a command
+    Command& full = cache.alloc( node, this, size );
+    uint8_t* fullPtr = reinterpret_cast< uint8_t* >(
+        full.getModifiable< Packet >( ));
+
+    memcpy( fullPtr + sizeof( uint64_t ), ptr + sizeof( uint64_t ),
+            headerSize - sizeof( uint64_t ));
+    connection->recvNB( fullPtr + headerSize, payloadSize );
+    return connection->recvSync( 0, 0 ) ? &full : 0;
+}
+
+void LocalNode::registerPayloadReceiver( const uint32_t type,
+                                         const uint32_t command,
+                                         PayloadReceiver* receiver )
+{
+    const uint64_t key = ( uint64_t( type ) << 32 ) | command;
+    base::ScopedMutex< base::SpinLock > mutex( _payloadReceivers );
+
+    if( receiver )
+        ( *_payloadReceivers )[ key ] = receiver;
+    else
+        _payloadReceivers->erase( key );
+}
+
+PayloadReceiver* LocalNode::_getPayloadReceiver( const Packet& packet )
+{
+    const uint64_t key = ( uint64_t( packet.type ) << 32 ) | packet.command;
+    base::ScopedMutex< base::SpinLock > mutex( _payloadReceivers );
+
+    PayloadReceivers::const_iterator i = _payloadReceivers->find( key );
+    return i == _payloadReceivers->end() ? 0 : i->second;
+}
+
 Command& LocalNode::allocCommand( const uint64_t size )
 {
     EQASSERT( _inReceiverThread( ));
@@ -1242,6 +1498,7 @@ bool LocalNode::_cmdConnect( Command& command )
     reply.nodeType  = getType();
 
     connection->send( reply, serialize( ));    
+    _addToReceiverPool( connection, remoteNode );
     return true;
 }
 
@@ -1318,6 +1575,7 @@ bool LocalNode::_cmdConnectReply( Command& command )
     remoteNode->send( ack );
 
     _connectMulticast( remoteNode );
+    _addToReceiverPool( connection, remoteNode );
     return true;
 }
 
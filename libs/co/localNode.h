@@ -32,12 +32,15 @@
 #include <co/base/clock.h>          // member
 #include <co/base/hash.h>           // member
 #include <co/base/lockable.h>       // member
+#include <co/base/mtQueue.h>        // member
 #include <co/base/spinLock.h>       // member
 #include <co/base/types.h>          // member
 
 namespace co
 {
     class ObjectStore;
+    class PayloadReceiver;
+    class ReceiverPoolThread;
 
     /** 
      * Specialization of a local node.
@@ -224,6 +227,10 @@ namespace co
          * If the requested version is newer than the head version, mapObject()
          * will block until the requested version is available.
          *
+         * Objects of type Object::LAZY_DELTA are mapped using the last full
+         * version before the requested version and the deltas up to the
+         * requested version. Newer versions are queued and applied by sync().
+         *
          * Mapping an object is a potentially time-consuming operation. Using
          * mapObjectNB() and mapObjectSync() to asynchronously map multiple
          * objects in parallel improves performance of this operation.
@@ -257,6 +264,36 @@ namespace co
         /** Finalize the mapping of a distributed object. */
         CO_API bool mapObjectSync( const uint32_t requestID );
 
+        /**
+         * Map multiple distributed objects.
+         *
+         * The master nodes of all objects are looked up using one batch of
+         * requests per connected node, and one map request is sent to each
+         * master node. The instance data of all objects is streamed back
+         * without further round trips. This is considerably faster than
+         * mapping each object individually when mapping many objects.
+         *
+         * @param objects the objects.
+         * @param versions the master object identifiers and initial versions.
+         * @return true if all objects were mapped, false otherwise.
+         * @sa mapObject()
+         */
+        CO_API bool mapObjects( const Objects& objects,
+                                const ObjectVersions& versions );
+
+        /**
+         * Start mapping multiple distributed objects.
+         *
+         * @return the request identifiers, one per object, to be finalized
+         *         using mapObjectSync() or mapObjectsSync().
+         * @sa mapObjects()
+         */
+        CO_API std::vector< uint32_t > mapObjectsNB( const Objects& objects,
+                                              const ObjectVersions& versions );
+
+        /** Finalize the mapping of multiple distributed objects. */
+        CO_API bool mapObjectsSync( const std::vector< uint32_t >& requestIDs );
+
         /** 
          * Unmap a mapped object.
          * 
@@ -354,6 +391,22 @@ namespace co
         /** @internal Allocate a local command from the receiver thread. */
         CO_API Command& allocCommand( const uint64_t size );
 
+        /**
+         * @internal
+         * Register a receiver for the payload of big packets.
+         *
+         * Thread-safe, but the receiver may still be used by a receiver
+         * thread when the (de)registration returns.
+         *
+         * @param type the packet type.
+         * @param command the packet command.
+         * @param receiver the payload receiver, or 0 to deregister.
+         * @sa PayloadReceiver
+         */
+        CO_API void registerPayloadReceiver( const uint32_t type,
+                                             const uint32_t command,
+                                             PayloadReceiver* receiver );
+
         /** 
          * Dispatches a packet to the registered command queue.
          * 
@@ -428,6 +481,10 @@ namespace co
         /** The connection set of all connections from/to this node. */
         ConnectionSet _incoming;
 
+        /** The payload receivers, indexed by packet type and command. */
+        typedef stde::hash_map< uint64_t, PayloadReceiver* > PayloadReceivers;
+        base::Lockable< PayloadReceivers, base::SpinLock > _payloadReceivers;
+
         /** The process-global clock. */
         base::Clock _clock;
     
@@ -450,6 +507,13 @@ namespace co
         };
         ReceiverThread* _receiverThread;
 
+        /** Threads reading established unicast connections, may be empty. */
+        std::vector< ReceiverPoolThread* > _receiverPool;
+
+        /** Packets read by the pool, or a disconnect if the command is 0. */
+        typedef std::pair< Command*, ConnectionPtr > PoolData;
+        base::MTQueue< PoolData > _poolData;
+
         bool _connectSelf();
         void _connectMulticast( NodePtr node );
 
@@ -470,9 +534,20 @@ namespace co
         void   _handleConnect();
         void   _handleDisconnect();
         bool   _handleData();
+        void   _disconnect( ConnectionPtr connection );
+        Command* _readCommand( ConnectionPtr connection, NodePtr node,
+                               const uint64_t size, CommandCache& cache );
+        PayloadReceiver* _getPayloadReceiver( const Packet& packet );
+
+        void _startReceiverPool();
+        void _stopReceiverPool();
+        void _addToReceiverPool( ConnectionPtr connection, NodePtr node );
+        void _pushPoolData( Command* command, ConnectionPtr connection );
+        void _handlePoolData();
         //@}
 
         friend class ObjectStore;
+        friend class ReceiverPoolThread;
         template< typename T > void
         _registerCommand( const uint32_t command, const CommandFunc< T >& func,
                           CommandQueue* destinationQueue )
@@ -315,6 +315,30 @@ namespace co
         bool useCache;
     };
 
+    struct NodeMapObjectsPacket : public NodePacket
+    {
+        NodeMapObjectsPacket()
+                : nObjects( 0 )
+            {
+                command = CMD_NODE_MAP_OBJECTS;
+                size    = sizeof( NodeMapObjectsPacket );
+            }
+
+        uint64_t nObjects;
+        EQ_ALIGN8( uint8_t data[8] ); // nObjects NodeMapObjectPackets
+    };
+
+    struct NodeRestoreInstancesPacket : public NodePacket
+    {
+        NodeRestoreInstancesPacket()
+            {
+                command = CMD_NODE_RESTORE_INSTANCES;
+                size    = sizeof( NodeRestoreInstancesPacket );
+            }
+
+        uint32_t requestID; // request data are the loaded StoredInstances
+    };
+
     struct NodeUnmapObjectPacket : public NodePacket
     {
         NodeUnmapObjectPacket()
@@ -217,7 +217,16 @@ void Object::setupChangeManager( const Object::ChangeType type,
         case Object::DELTA:
             EQASSERT( _localNode );
             if( master )
-                _setChangeManager( new DeltaMasterCM( this ));
+                _setChangeManager( new DeltaMasterCM( this, false ));
+            else
+                _setChangeManager( new VersionedSlaveCM( this,
+                                                         masterInstanceID ));
+            break;
+
+        case Object::LAZY_DELTA:
+            EQASSERT( _localNode );
+            if( master )
+                _setChangeManager( new DeltaMasterCM( this, true ));
             else
                 _setChangeManager( new VersionedSlaveCM( this,
                                                          masterInstanceID ));
@@ -259,9 +268,10 @@ bool Object::isMaster() const
     return _cm->isMaster();
 }
 
-void Object::addSlave( Command& command, NodeMapObjectReplyPacket& reply )
+void Object::addSlave( NodePtr node, const NodeMapObjectPacket* packet,
+                       NodeMapObjectReplyPacket& reply )
 {
-    _cm->addSlave( command, reply );
+    _cm->addSlave( node, packet, reply );
 }
 
 void Object::removeSlave( NodePtr node )
@@ -312,6 +322,11 @@ uint128_t Object::getVersion() const
     return _cm->getVersion();
 }
 
+uint64_t Object::getSkippedVersions() const
+{
+    return _cm->getSkippedVersions();
+}
+
 void Object::notifyNewHeadVersion( const uint128_t& version )
 { 
     EQASSERTINFO( getVersion() == VERSION_NONE || 
@@ -26,6 +26,7 @@
 namespace co
 {
     class ObjectCM;
+    struct NodeMapObjectPacket;
     struct NodeMapObjectReplyPacket;
 
 #  define CO_COMMIT_NEXT EQ_UNDEFINED_UINT32 //!< the next commit incarnation
@@ -48,6 +49,7 @@ namespace co
             INSTANCE,          //!< use only instance data
             DELTA,             //!< use pack/unpack delta
             UNBUFFERED,        //!< versioned, but don't retain versions
+            LAZY_DELTA         //!< use deltas, instance data on demand
         };
 
         /** Construct a new distributed object. */
@@ -230,6 +232,12 @@ namespace co
         /** @return the currently synchronized version. */
         CO_API uint128_t getVersion() const;
 
+        /**
+         * @return the number of versions skipped by coalescing during sync().
+         * @sa getDeltaDirty()
+         */
+        CO_API uint64_t getSkippedVersions() const;
+
         /** 
          * Notification that a new head version was received by a slave object.
          *
@@ -287,6 +295,20 @@ namespace co
          * @param is the input data stream.
          */
         virtual void unpack( DataIStream& is ) { applyInstanceData( is ); }
+
+        /**
+         * Get the parts of the object changed by a delta, without consuming it.
+         *
+         * Slave instances use this to coalesce queued versions during sync():
+         * a delta is skipped if all its dirty bits are changed again by a
+         * newer version applied in the same sync. The default implementation
+         * returns false, which applies all versions.
+         *
+         * @param is the input data stream of the delta.
+         * @param dirty return value for the dirty bits of the delta.
+         * @return true if the delta may be coalesced, false otherwise.
+         */
+        virtual bool getDeltaDirty( DataIStream&, uint64_t& ) { return false; }
         //@}
 
         /** @name Packet Transmission */
@@ -348,7 +370,8 @@ namespace co
         NodePtr getMasterNode();
 
         /** @internal */
-        void addSlave( Command& command, NodeMapObjectReplyPacket& reply );
+        void addSlave( NodePtr node, const NodeMapObjectPacket* packet,
+                       NodeMapObjectReplyPacket& reply );
         CO_API void removeSlave( NodePtr node ); //!< @internal
         CO_API void removeSlaves( NodePtr node ); //!< @internal
         void setMasterNode( NodePtr node ); //!< @internal
@@ -29,6 +29,7 @@
 
 namespace co
 {
+    struct NodeMapObjectPacket;
     struct NodeMapObjectReplyPacket;
 
     /**
@@ -90,6 +91,9 @@ namespace co
 
         /** @return the current version. */
         virtual uint128_t getVersion() const = 0;
+
+        /** @return the number of versions skipped during sync. */
+        virtual uint64_t getSkippedVersions() const { return 0; }
         //@}
 
         /** @return if this object keeps instance data buffers. */
@@ -110,11 +114,13 @@ namespace co
         /** 
          * Add a subscribed slave to the managed object.
          * 
-         * @param command the subscribe command initiating the add.
+         * @param node the node of the slave.
+         * @param packet the map request initiating the add.
          * @param reply the reply packet.
          * @return the first version the slave has to use from its cache.
          */
-        virtual void addSlave(Command& command, NodeMapObjectReplyPacket& reply)
+        virtual void addSlave( NodePtr node, const NodeMapObjectPacket* packet,
+                               NodeMapObjectReplyPacket& reply )
             { EQUNIMPLEMENTED; }
 
         /** 
@@ -23,10 +23,14 @@
 
 #include <co/plugins/compressor.h>
 
+#include <limits>
+
 namespace co
 {
 ObjectDataIStream::ObjectDataIStream()
         : _usedCommand( 0 )
+        , _usedTask( 0 )
+        , _decompressing( false )
 {
     _reset();
 }
@@ -40,6 +44,8 @@ ObjectDataIStream::ObjectDataIStream( const ObjectDataIStream& from )
         : DataIStream( from )
         , _commands( from._commands )
         , _usedCommand( 0 )
+        , _usedTask( 0 )
+        , _decompressing( false )
         , _version( from._version )
 {
     for( CommandDequeCIter i = _commands.begin(); i != _commands.end(); ++i )
@@ -57,6 +63,23 @@ void ObjectDataIStream::reset()
 
 void ObjectDataIStream::_reset()
 {
+    // wait for pending decompressions, they read the packets released below
+    if( _usedTask )
+        _tasks.push_front( _usedTask );
+    _usedTask = 0;
+    while( !_tasks.empty( ))
+    {
+        DecompressorPool::Task* task = _tasks.front();
+        if( task )
+        {
+            task->done.waitEQ( true );
+            delete task;
+        }
+        _tasks.pop_front();
+    }
+    _decompressed.clear();
+    _decompressing = false;
+
     if( _usedCommand )
     {
         _usedCommand->release();
@@ -101,13 +124,14 @@ void ObjectDataIStream::addDataPacket( Command& command )
 
 bool ObjectDataIStream::hasInstanceData() const
 {
-    if( _commands.empty( ))
+    if( !_usedCommand && _commands.empty( ))
     {
         EQUNREACHABLE;
         return false;
     }
 
-    const Command* command = _commands.front();
+    // all packets of a stream have the same command
+    const Command* command = _usedCommand ? _usedCommand : _commands.front();
     return( (*command)->command == CMD_OBJECT_INSTANCE );
 }
 
@@ -136,6 +160,12 @@ uint128_t ObjectDataIStream::getPendingVersion() const
 
 const Command* ObjectDataIStream::getNextCommand()
 {
+    if( _usedTask )
+    {
+        _usedTask->done.waitEQ( true );
+        delete _usedTask;
+        _usedTask = 0;
+    }
     if( _usedCommand )
         _usedCommand->release();
 
@@ -145,13 +175,105 @@ const Command* ObjectDataIStream::getNextCommand()
     {
         _usedCommand = _commands.front();
         _commands.pop_front();
+        if( !_tasks.empty( ))
+        {
+            _usedTask = _tasks.front();
+            _tasks.pop_front();
+        }
     }
     return _usedCommand;
 }
 
+namespace
+{
+const void* _getChunkData( const Command* command )
+{
+    switch( (*command)->command )
+    {
+      case CMD_OBJECT_INSTANCE:
+        return command->get< ObjectInstancePacket >()->data;
+      case CMD_OBJECT_DELTA:
+        return command->get< ObjectDeltaPacket >()->data;
+      case CMD_OBJECT_SLAVE_DELTA:
+        return command->get< ObjectSlaveDeltaPacket >()->data;
+    }
+    EQASSERTINFO( false, "Unknown object data packet " << *command );
+    return 0;
+}
+}
+
+void ObjectDataIStream::_startDecompression()
+{
+    EQASSERT( _tasks.empty( ));
+    EQASSERT( !_usedTask );
+    _decompressing = true;
+    if( _commands.size() < 2 || !isReady( ))
+        return;
+
+    DecompressorPool* pool = DecompressorPool::getInstance();
+    if( !pool )
+        return;
+
+    // The next packet with data is decompressed by the caller, concurrently
+    // to the following packets decompressed by the pool. All packets are
+    // decompressed into one buffer, at offsets computed up front.
+    std::vector< uint64_t > offsets;
+    offsets.reserve( _commands.size( ));
+
+    bool first = true;
+    uint64_t size = 0;
+    for( CommandDequeCIter i = _commands.begin(); i != _commands.end(); ++i )
+    {
+        const ObjectDataPacket* packet = (*i)->get< ObjectDataPacket >();
+        if( first || packet->dataSize == 0 ||
+            packet->compressorName == EQ_COMPRESSOR_NONE )
+        {
+            first = first && packet->dataSize == 0;
+            offsets.push_back( std::numeric_limits< uint64_t >::max( ));
+            continue;
+        }
+        offsets.push_back( size );
+        size += packet->dataSize;
+    }
+
+    if( size == 0 )
+        return;
+
+    _decompressed.reset( size );
+    uint8_t* const output = _decompressed.getData();
+    size_t index = 0;
+    for( CommandDequeCIter i = _commands.begin(); i != _commands.end();
+         ++i, ++index )
+    {
+        const uint64_t offset = offsets[ index ];
+        if( offset == std::numeric_limits< uint64_t >::max( ))
+        {
+            _tasks.push_back( 0 );
+            continue;
+        }
+
+        const Command* command = *i;
+        const ObjectDataPacket* packet = command->get< ObjectDataPacket >();
+        DecompressorPool::Task* task = new DecompressorPool::Task(
+            _getChunkData( command ), packet->compressorName, packet->nChunks,
+            packet->dataSize, output + offset );
+        _tasks.push_back( task );
+        pool->push( task );
+    }
+}
+
 bool ObjectDataIStream::getNextBuffer( uint32_t* compressor, uint32_t* nChunks,
                                        const void** chunkData, uint64_t* size )
 {
+    // Start when the reader moves past the first buffer with data, so that
+    // peeking at the start of a stream, e.g., by Object::getDeltaDirty, does
+    // not decompress the whole stream.
+    if( !_decompressing && _usedCommand &&
+        _usedCommand->get< ObjectDataPacket >()->dataSize > 0 )
+    {
+        _startDecompression();
+    }
+
     const Command* command = getNextCommand();
     if( !command )
         return false;
@@ -165,21 +287,18 @@ bool ObjectDataIStream::getNextBuffer( uint32_t* compressor, uint32_t* nChunks,
         return getNextBuffer( compressor, nChunks, chunkData, size );
 
     *size = packet->dataSize;
-    *compressor = packet->compressorName;
-    *nChunks = packet->nChunks;
-    *size = packet->dataSize;
-    switch( packet->command )
+    if( _usedTask ) // decompressed by the DecompressorPool
     {
-      case CMD_OBJECT_INSTANCE:
-        *chunkData = command->get< ObjectInstancePacket >()->data;
-        break;
-      case CMD_OBJECT_DELTA:
-        *chunkData = command->get< ObjectDeltaPacket >()->data;
-        break;
-      case CMD_OBJECT_SLAVE_DELTA:
-        *chunkData = command->get< ObjectSlaveDeltaPacket >()->data;
-        break;
+        _usedTask->done.waitEQ( true );
+        *compressor = EQ_COMPRESSOR_NONE;
+        *nChunks = 1;
+        *chunkData = _usedTask->output;
+        return true;
     }
+
+    *compressor = packet->compressorName;
+    *nChunks = packet->nChunks;
+    *chunkData = _getChunkData( command );
     return true;
 }
 
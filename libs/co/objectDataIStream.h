@@ -19,7 +19,9 @@
 #define CO_OBJECTDATAISTREAM_H
 
 #include <co/dataIStream.h>   // base class
+#include "decompressorPool.h" // nested type
 #include <co/version.h>       // enum
+#include <co/base/buffer.h>       // member
 #include <co/base/monitor.h>      // member
 #include <co/base/thread.h>       // member
 
@@ -50,6 +52,9 @@ namespace co
 
         bool hasInstanceData() const;
 
+        /** @return the data packets of a stream which has not been read. */
+        const CommandDeque& getCommands() const { return _commands; }
+
     protected:
         const Command* getNextCommand();
         virtual bool getNextBuffer( uint32_t* compressor, uint32_t* nChunks,
@@ -61,12 +66,27 @@ namespace co
 
         Command* _usedCommand; //!< Currently used buffer
 
+        /** Pending decompression of the packets in _commands, or 0. */
+        std::deque< DecompressorPool::Task* > _tasks;
+
+        /** The decompression of the currently used buffer, or 0. */
+        DecompressorPool::Task* _usedTask;
+
+        /** The output of all _tasks, each at its own offset. */
+        base::Bufferb _decompressed;
+
+        /** _startDecompression() was called for the current data. */
+        bool _decompressing;
+
         /** The object version associated with this input stream. */
         base::Monitor< uint128_t > _version;
 
         void _setReady() { _version = getPendingVersion(); }
         void _reset();
 
+        /** Start decompressing all packets after the next in parallel. */
+        void _startDecompression();
+
         EQ_TS_VAR( _thread );
     };
 }
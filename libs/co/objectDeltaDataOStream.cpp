@@ -18,6 +18,7 @@
 
 #include "objectDeltaDataOStream.h"
 
+#include "node.h"
 #include "object.h"
 #include "objectCM.h"
 #include "objectPackets.h"
@@ -26,6 +27,7 @@ namespace co
 {
 ObjectDeltaDataOStream::ObjectDeltaDataOStream( const ObjectCM* cm )
         : ObjectDataOStream( cm )
+        , _instanceID( EQ_INSTANCE_NONE )
 {}
 
 ObjectDeltaDataOStream::~ObjectDeltaDataOStream()
@@ -35,7 +37,18 @@ void ObjectDeltaDataOStream::sendData( const void* buffer, const uint64_t size,
                                        const bool last )
 {
     ObjectDeltaPacket packet;
+    packet.instanceID = _instanceID;
     ObjectDataOStream::sendData( packet, buffer, size, last );
 }
 
+void ObjectDeltaDataOStream::sendMapData( NodePtr node,
+                                          const uint32_t instanceID )
+{
+    _instanceID = instanceID;
+    _setupConnection( node, false /* useMulticast */ );
+    _resend();
+    _clearConnections();
+    _instanceID = EQ_INSTANCE_NONE;
+}
+
 }
@@ -30,9 +30,15 @@ namespace co
         ObjectDeltaDataOStream( const ObjectCM* cm );
         virtual ~ObjectDeltaDataOStream();
 
+        /** Resend the saved delta to one object instance on the node. */
+        void sendMapData( NodePtr node, const uint32_t instanceID );
+
     protected:
         virtual void sendData( const void* buffer, const uint64_t size,
                                const bool last );
+
+    private:
+        uint32_t _instanceID;
     };
 }
 #endif //CO_OBJECTDELTADATAOSTREAM_H
@@ -50,8 +50,9 @@ namespace co
         /** Send-on-register instance data to all receivers. */
         void sendInstanceData( const Nodes& receivers );
 
-        /** Send mapping data to the node, using multicast if available. */
-        void sendMapData( NodePtr node, const uint32_t instanceID );
+        /** Send mapping data to the node, using multicast if requested. */
+        void sendMapData( NodePtr node, const uint32_t instanceID,
+                          const bool useMulticast );
 
     protected:
         virtual void sendData( const void* buffer, const uint64_t size,
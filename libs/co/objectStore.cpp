@@ -24,6 +24,7 @@
 #include "connectionDescription.h"
 #include "global.h"
 #include "instanceCache.h"
+#include "instanceStore.h"
 #include "log.h"
 #include "nodePackets.h"
 #include "objectCM.h"
@@ -32,6 +33,9 @@
 
 #include <co/base/scopedMutex.h>
 
+#include <map>
+#include <new>
+
 //#define DEBUG_DISPATCH
 #ifdef DEBUG_DISPATCH
 #  include <set>
@@ -45,7 +49,11 @@ ObjectStore::ObjectStore( LocalNode* localNode )
         : _localNode( localNode )
         , _instanceIDs( std::numeric_limits< long >::min( )) 
         , _instanceCache( new InstanceCache( Global::getIAttribute( 
-                              Global::IATTR_INSTANCE_CACHE_SIZE ) * EQ_1MB ) )
+                              Global::IATTR_INSTANCE_CACHE_SIZE ) * EQ_1MB,
+                                             Global::getInstanceCachePath(),
+                                             uint64_t( Global::getIAttribute(
+                              Global::IATTR_INSTANCE_CACHE_STORE_SIZE )) *
+                                             EQ_1MB ))
 {
     EQASSERT( localNode );
     CommandQueue* queue = localNode->getCommandThreadQueue();
@@ -64,6 +72,10 @@ ObjectStore::ObjectStore( LocalNode* localNode )
         CmdFunc( this, &ObjectStore::_cmdDeregisterObject ), queue );
     localNode->_registerCommand( CMD_NODE_MAP_OBJECT,
         CmdFunc( this, &ObjectStore::_cmdMapObject ), queue );
+    localNode->_registerCommand( CMD_NODE_MAP_OBJECTS,
+        CmdFunc( this, &ObjectStore::_cmdMapObjects ), queue );
+    localNode->_registerCommand( CMD_NODE_RESTORE_INSTANCES,
+        CmdFunc( this, &ObjectStore::_cmdRestoreInstances ), 0 );
     localNode->_registerCommand( CMD_NODE_MAP_OBJECT_SUCCESS,
         CmdFunc( this, &ObjectStore::_cmdMapObjectSuccess ), 0 );
     localNode->_registerCommand( CMD_NODE_MAP_OBJECT_REPLY,
@@ -93,13 +105,17 @@ ObjectStore::~ObjectStore()
     EQVERB << "Delete ObjectStore @" << (void*)this << std::endl;
     
 #ifndef NDEBUG
-    if( !_objects->empty( ))
+    for( size_t k = 0; k < CO_OBJECTS_SHARDS; ++k )
     {
-        EQWARN << _objects->size() << " attached objects in destructor"
+        const ObjectsHash& objectsHash = _objects[k].data;
+        if( objectsHash.empty( ))
+            continue;
+
+        EQWARN << objectsHash.size() << " attached objects in destructor"
                << std::endl;
         
-        for( ObjectsHash::const_iterator i = _objects->begin();
-             i != _objects->end(); ++i )
+        for( ObjectsHash::const_iterator i = objectsHash.begin();
+             i != objectsHash.end(); ++i )
         {
             const Objects& objects = i->second;
             EQWARN << "  " << objects.size() << " objects with id " 
@@ -121,13 +137,43 @@ ObjectStore::~ObjectStore()
    _instanceCache = 0;
 }
 
+void* ObjectStore::operator new( size_t size )
+{
+    // plain new does not honor the cache line alignment of the shards
+#ifdef _WIN32
+    void* ptr = _aligned_malloc( size, 64 );
+#else
+    void* ptr = 0;
+    if( posix_memalign( &ptr, 64, size ) != 0 )
+        ptr = 0;
+#endif
+    if( !ptr )
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void ObjectStore::operator delete( void* ptr )
+{
+#ifdef _WIN32
+    _aligned_free( ptr );
+#else
+    free( ptr );
+#endif
+}
+
 void ObjectStore::clear( )
 {
-    EQASSERT( _objects->empty( ));
+#ifndef NDEBUG
+    for( size_t i = 0; i < CO_OBJECTS_SHARDS; ++i )
+        EQASSERT( _objects[i]->empty( ));
+#endif
     expireInstanceData( 0 );
     EQASSERT( !_instanceCache || _instanceCache->isEmpty( ));
+    if( _instanceCache ) // release the data queued for the persistent store
+        _instanceCache->flush();
 
-    _objects->clear();
+    for( size_t i = 0; i < CO_OBJECTS_SHARDS; ++i )
+        _objects[i]->clear();
     _sendQueue.clear();
 }
 
@@ -204,6 +250,50 @@ NodeID ObjectStore::_findMasterNodeID( const base::UUID& identifier )
     return base::UUID::ZERO;
 }
 
+void ObjectStore::_findMasterNodeIDs( const std::vector< base::UUID >& ids,
+                                      NodeIDHash& masterNodeIDs )
+{
+    EQ_TS_NOT_THREAD( _commandThread );
+
+    Nodes nodes;
+    _localNode->getNodes( nodes );
+
+    std::vector< base::UUID > pending = ids;
+    std::vector< base::UUID > missing;
+    std::vector< uint32_t > requests;
+
+    for( Nodes::iterator i = nodes.begin();
+         i != nodes.end() && !pending.empty(); ++i )
+    {
+        NodePtr node = *i;
+        EQLOG( LOG_OBJECTS ) << "Finding " << pending.size() << " objects on "
+                             << node << std::endl;
+
+        requests.clear();
+        for( std::vector< base::UUID >::const_iterator j = pending.begin();
+             j != pending.end(); ++j )
+        {
+            NodeFindMasterNodeIDPacket packet;
+            packet.requestID = _localNode->registerRequest();
+            packet.identifier = *j;
+            node->send( packet );
+            requests.push_back( packet.requestID );
+        }
+
+        missing.clear();
+        for( size_t j = 0; j < pending.size(); ++j )
+        {
+            NodeID masterNodeID = base::UUID::ZERO;
+            _localNode->waitRequest( requests[j], masterNodeID );
+            if( masterNodeID == base::UUID::ZERO )
+                missing.push_back( pending[j] );
+            else
+                masterNodeIDs[ pending[j] ] = masterNodeID;
+        }
+        pending.swap( missing );
+    }
+}
+
 //---------------------------------------------------------------------------
 // object mapping
 //---------------------------------------------------------------------------
@@ -251,9 +341,10 @@ void ObjectStore::_attachObject( Object* object, const base::UUID& id,
 
     object->attach( id, instanceID );
 
+    LockableObjects& objectsHash = _getObjects( id );
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
-        Objects& objects = _objects.data[ id ];
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        Objects& objects = objectsHash.data[ id ];
         EQASSERTINFO( !object->isMaster() || objects.empty(),
             "Attaching master " << *object << ", " << objects.size() <<
             " attached objects with same ID, first is: " << *objects[0] );
@@ -292,11 +383,12 @@ void ObjectStore::swapObject( Object* oldObject, Object* newObject )
 
     EQLOG( LOG_OBJECTS ) << "Swap " << base::className( oldObject ) <<std::endl;
     const base::UUID& id = oldObject->getID();
+    LockableObjects& objectsHash = _getObjects( id );
 
-    base::ScopedMutex< base::SpinLock > mutex( _objects );
-    ObjectsHash::iterator i = _objects->find( id );
-    EQASSERT( i != _objects->end( ));
-    if( i == _objects->end( ))
+    base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+    ObjectsHash::iterator i = objectsHash->find( id );
+    EQASSERT( i != objectsHash->end( ));
+    if( i == objectsHash->end( ))
         return;
 
     Objects& objects = i->second;
@@ -319,19 +411,20 @@ void ObjectStore::_detachObject( Object* object )
         return;
 
     const base::UUID& id = object->getID();
+    LockableObjects& objectsHash = _getObjects( id );
 
-    EQASSERT( _objects->find( id ) != _objects->end( ));
+    EQASSERT( objectsHash->find( id ) != objectsHash->end( ));
     EQLOG( LOG_OBJECTS ) << "Detach " << *object << std::endl;
 
-    Objects& objects = _objects.data[ id ];
+    Objects& objects = objectsHash.data[ id ];
     Objects::iterator i = find( objects.begin(),objects.end(), object );
     EQASSERT( i != objects.end( ));
 
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
         objects.erase( i );
         if( objects.empty( ))
-            _objects->erase( id );
+            objectsHash->erase( id );
     }
 
     EQASSERT( object->getInstanceID() != EQ_INSTANCE_INVALID );
@@ -376,7 +469,94 @@ uint32_t ObjectStore::mapObjectNB( Object* object, const base::UUID& id,
         return EQ_UNDEFINED_UINT32;
     }
 
+    NodeIDHash masterNodeIDs;
+    masterNodeIDs[ id ] = master->getNodeID();
+    _restoreInstances( masterNodeIDs );
+
     NodeMapObjectPacket packet;
+    _initMapPacket( packet, object, id, version );
+    master->send( packet );
+    return packet.requestID;
+}
+
+std::vector< uint32_t > ObjectStore::mapObjectsNB( const Objects& objects,
+                                              const ObjectVersions& versions )
+{
+    EQ_TS_NOT_THREAD( _commandThread );
+    EQ_TS_NOT_THREAD( _receiverThread );
+    EQASSERT( objects.size() == versions.size( ));
+    EQASSERT( !_localNode->inCommandThread( ));
+
+    const size_t nObjects = EQ_MIN( objects.size(), versions.size( ));
+    std::vector< uint32_t > requests( nObjects, EQ_UNDEFINED_UINT32 );
+    std::vector< base::UUID > ids;
+    for( size_t i = 0; i < nObjects; ++i )
+    {
+        Object* object = objects[i];
+        const base::UUID& id = versions[i].identifier;
+        EQASSERT( object );
+        EQASSERT( !object->isAttached( ));
+        EQASSERT( !object->isMaster( ));
+        EQASSERTINFO( id.isGenerated(), id );
+
+        object->notifyAttach();
+        if( id.isGenerated( ))
+            ids.push_back( id );
+    }
+    stde::usort( ids );
+
+    NodeIDHash masterNodeIDs;
+    _findMasterNodeIDs( ids, masterNodeIDs );
+    _restoreInstances( masterNodeIDs );
+
+    // group the map requests by master node
+    typedef std::map< NodeID, std::vector< NodeMapObjectPacket > > Batches;
+    Batches batches;
+    std::map< NodeID, NodePtr > masters;
+    for( size_t i = 0; i < nObjects; ++i )
+    {
+        const base::UUID& id = versions[i].identifier;
+        NodeIDHash::const_iterator j = masterNodeIDs.find( id );
+        if( j == masterNodeIDs.end( ))
+        {
+            EQWARN << "Can't find master node for object id " << id
+                   << std::endl;
+            continue;
+        }
+
+        const NodeID& masterNodeID = j->second;
+        if( masters.find( masterNodeID ) == masters.end( ))
+            masters[ masterNodeID ] = _localNode->connect( masterNodeID );
+
+        NodePtr master = masters[ masterNodeID ];
+        if( !master || !master->isConnected( ))
+        {
+            EQWARN << "Mapping of object " << id << " failed, invalid master "
+                   << "node" << std::endl;
+            continue;
+        }
+
+        std::vector< NodeMapObjectPacket >& packets = batches[ masterNodeID ];
+        packets.push_back( NodeMapObjectPacket( ));
+        _initMapPacket( packets.back(), objects[i], id, versions[i].version );
+        requests[i] = packets.back().requestID;
+    }
+
+    for( Batches::const_iterator i = batches.begin(); i != batches.end(); ++i)
+    {
+        const std::vector< NodeMapObjectPacket >& packets = i->second;
+        NodeMapObjectsPacket packet;
+        packet.nObjects = packets.size();
+        masters[ i->first ]->send( packet, &packets.front(),
+                               packets.size() * sizeof( NodeMapObjectPacket ));
+    }
+    return requests;
+}
+
+void ObjectStore::_initMapPacket( NodeMapObjectPacket& packet, Object* object,
+                                  const base::UUID& id,
+                                  const uint128_t& version )
+{
     packet.requestID        = _localNode->registerRequest( object );
     packet.objectID         = id;
     packet.requestedVersion = version;
@@ -398,8 +578,48 @@ uint32_t ObjectStore::mapObjectNB( Object* object, const base::UUID& id,
                                  << packet.maxCachedVersion << std::endl;
         }
     }
-    master->send( packet );
-    return packet.requestID;
+}
+
+void ObjectStore::_restoreInstances( const NodeIDHash& masterNodeIDs )
+{
+    EQ_TS_NOT_THREAD( _receiverThread );
+    if( !_instanceCache || !_instanceCache->isPersistent( ))
+        return;
+
+    // map and validate the stored data in this thread
+    StoredInstances datas;
+    for( NodeIDHash::const_iterator i = masterNodeIDs.begin();
+         i != masterNodeIDs.end(); ++i )
+    {
+        StoredInstance* data = _instanceCache->load( i->first );
+        if( !data )
+            continue;
+
+        // instance IDs are reused by a restarted master, its node ID is not
+        if( data->masterNodeID != i->second )
+        {
+            EQLOG( LOG_OBJECTS ) << "Ignoring stored instance data of object "
+                                 << i->first << " from old master node "
+                                 << data->masterNodeID << std::endl;
+            delete data;
+            continue;
+        }
+        datas.push_back( data );
+    }
+    if( datas.empty( ))
+        return;
+
+    // add the data of all objects to the cache in one receiver thread command
+    NodeRestoreInstancesPacket packet;
+    packet.requestID = _localNode->registerRequest( &datas );
+    _localNode->send( packet );
+    _localNode->waitRequest( packet.requestID );
+
+    for( StoredInstances::const_iterator i = datas.begin(); i != datas.end();
+         ++i )
+    {
+        delete *i;
+    }
 }
 
 bool ObjectStore::mapObjectSync( const uint32_t requestID )
@@ -584,10 +804,11 @@ bool ObjectStore::dispatchObjectCommand( Command& command )
     const ObjectPacket* packet = command.get< ObjectPacket >();
     const base::UUID& id = packet->objectID;
     const uint32_t instanceID = packet->instanceID;
+    LockableObjects& objectsHash = _getObjects( id );
 
-    ObjectsHash::const_iterator i = _objects->find( id );
+    ObjectsHash::const_iterator i = objectsHash->find( id );
 
-    if( i == _objects->end( ))
+    if( i == objectsHash->end( ))
         // When the instance ID is set to none, we only care about the packet
         // when we have an object of the given ID (multicast)
         return ( instanceID == EQ_INSTANCE_NONE );
@@ -632,13 +853,14 @@ bool ObjectStore::_cmdFindMasterNodeID( Command& command )
 
     const base::UUID& id = packet->identifier;
     EQASSERT( id.isGenerated() );
+    LockableObjects& objectsHash = _getObjects( id );
 
     NodeFindMasterNodeIDReplyPacket reply( packet );
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
-        ObjectsHash::const_iterator i = _objects->find( id );
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        ObjectsHash::const_iterator i = objectsHash->find( id );
 
-        if( i != _objects->end( ))
+        if( i != objectsHash->end( ))
         {
             const Objects& objects = i->second;
             EQASSERTINFO( !objects.empty(), packet );
@@ -699,8 +921,9 @@ bool ObjectStore::_cmdDetachObject( Command& command )
     EQLOG( LOG_OBJECTS ) << "Cmd detach object " << packet << std::endl;
 
     const base::UUID& id = packet->objectID;
-    ObjectsHash::const_iterator i = _objects->find( id );
-    if( i != _objects->end( ))
+    LockableObjects& objectsHash = _getObjects( id );
+    ObjectsHash::const_iterator i = objectsHash->find( id );
+    if( i != objectsHash->end( ))
     {
         const Objects& objects = i->second;
 
@@ -775,13 +998,33 @@ bool ObjectStore::_cmdMapObject( Command& command )
     const NodeMapObjectPacket* packet = command.get< NodeMapObjectPacket >();
     EQLOG( LOG_OBJECTS ) << "Cmd map object " << packet << std::endl;
 
-    NodePtr node = command.getNode();
+    _mapObject( command.getNode(), packet );
+    return true;
+}
+
+bool ObjectStore::_cmdMapObjects( Command& command )
+{
+    EQ_TS_THREAD( _commandThread );
+    const NodeMapObjectsPacket* packet = command.get< NodeMapObjectsPacket >();
+    EQLOG( LOG_OBJECTS ) << "Cmd map " << packet->nObjects << " objects"
+                         << std::endl;
+
+    const NodeMapObjectPacket* requests =
+        reinterpret_cast< const NodeMapObjectPacket* >( packet->data );
+    for( uint64_t i = 0; i < packet->nObjects; ++i )
+        _mapObject( command.getNode(), &requests[i] );
+    return true;
+}
+
+void ObjectStore::_mapObject( NodePtr node, const NodeMapObjectPacket* packet )
+{
     const base::UUID& id = packet->objectID;
+    LockableObjects& objectsHash = _getObjects( id );
     Object* master = 0;
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
-        ObjectsHash::const_iterator i = _objects->find( id );
-        if( i != _objects->end( ))
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        ObjectsHash::const_iterator i = objectsHash->find( id );
+        if( i != objectsHash->end( ))
         {
             const Objects& objects = i->second;
 
@@ -815,7 +1058,7 @@ bool ObjectStore::_cmdMapObject( Command& command )
         if( !node->multicast( successPacket ))
             node->send( successPacket );
         
-        master->addSlave( command, reply );
+        master->addSlave( node, packet, reply );
         reply.result = true;
     }
     else
@@ -823,6 +1066,32 @@ bool ObjectStore::_cmdMapObject( Command& command )
 
     if( !node->multicast( reply ))
         node->send( reply );
+}
+
+bool ObjectStore::_cmdRestoreInstances( Command& command )
+{
+    EQ_TS_THREAD( _receiverThread );
+    const NodeRestoreInstancesPacket* packet =
+        command.get< NodeRestoreInstancesPacket >();
+    const StoredInstances* datas = static_cast< const StoredInstances* >(
+        _localNode->getRequestData( packet->requestID ));
+    EQASSERT( datas );
+
+    for( StoredInstances::const_iterator i = datas->begin();
+         i != datas->end(); ++i )
+    {
+        const StoredInstance* data = *i;
+        NodePtr master = _localNode->getNode( data->masterNodeID );
+        if( _instanceCache && master.isValid( ) &&
+            _instanceCache->restore( *data, master, _localNode,
+                                     _localNode->_commandCache ))
+        {
+            EQLOG( LOG_OBJECTS ) << "Restored instance data of object "
+                                 << data->id << std::endl;
+        }
+    }
+
+    _localNode->serveRequest( packet->requestID );
     return true;
 }
 
@@ -913,11 +1182,12 @@ bool ObjectStore::_cmdUnsubscribeObject( Command& command )
 
     NodePtr node = command.getNode();
     const base::UUID& id = packet->objectID;
+    LockableObjects& objectsHash = _getObjects( id );
 
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
-        ObjectsHash::const_iterator i = _objects->find( id );
-        if( i != _objects->end( ))
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        ObjectsHash::const_iterator i = objectsHash->find( id );
+        if( i != objectsHash->end( ))
         {
             const Objects& objects = i->second;
 
@@ -950,14 +1220,16 @@ bool ObjectStore::_cmdUnmapObject( Command& command )
     if( _instanceCache )
         _instanceCache->erase( packet->objectID );
 
-    ObjectsHash::iterator i = _objects->find( packet->objectID );
-    if( i == _objects->end( )) // nothing to do
+    LockableObjects& objectsHash = _getObjects( packet->objectID );
+
+    ObjectsHash::iterator i = objectsHash->find( packet->objectID );
+    if( i == objectsHash->end( )) // nothing to do
         return true;
 
     const Objects objects = i->second;
     {
-        base::ScopedMutex< base::SpinLock > mutex( _objects );
-        _objects->erase( i );
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        objectsHash->erase( i );
     }
 
     for( Objects::const_iterator j = objects.begin(); j != objects.end(); ++j )
@@ -1051,12 +1323,17 @@ bool ObjectStore::_cmdRemoveNode( Command& command )
 
     EQLOG( LOG_OBJECTS ) << "Cmd  object  " << packet << std::endl;
 
-    base::ScopedMutex< base::SpinLock > mutex( _objects );
-    for ( ObjectsHashCIter i = _objects->begin(); i != _objects->end(); ++i )
+    for( size_t k = 0; k < CO_OBJECTS_SHARDS; ++k )
     {
-        const Objects& objects = i->second;
-        for( ObjectsCIter j = objects.begin(); j != objects.end(); ++j )
-            (*j)->removeSlaves( packet->node );
+        LockableObjects& objectsHash = _objects[k];
+        base::ScopedMutex< base::SpinLock > mutex( objectsHash );
+        for( ObjectsHashCIter i = objectsHash->begin();
+             i != objectsHash->end(); ++i )
+        {
+            const Objects& objects = i->second;
+            for( ObjectsCIter j = objects.begin(); j != objects.end(); ++j )
+                (*j)->removeSlaves( packet->node );
+        }
     }
 
     if( packet->requestID != EQ_UNDEFINED_UINT32 )
@@ -22,15 +22,19 @@
 #include <co/dispatcher.h>    // base class
 #include <co/version.h>       // enum
 
+#include <co/base/compiler.h>  // EQ_ALIGN_CACHELINE
 #include <co/base/lockable.h>  // member
 #include <co/base/spinLock.h>  // member
 #include <co/base/stdExt.h>    // member
 
 #include "dataIStreamQueue.h"  // member
 
+#define CO_OBJECTS_SHARDS 16 //!< number of object registry shards
+
 namespace co
 {
     class InstanceCache;
+    struct NodeMapObjectPacket;
 
     /** An object store manages Object mapping for a LocalNode. */
     class ObjectStore : public Dispatcher
@@ -42,6 +46,10 @@ namespace co
         /** Destruct this ObjectStore. */
         virtual ~ObjectStore();
 
+        /** Allocate an ObjectStore aligned to a cache line. */
+        static void* operator new( size_t size );
+        static void operator delete( void* ptr ); //!< @internal
+
         /** Remove all objects and clear all caches. */
         void clear();
 
@@ -96,6 +104,10 @@ namespace co
         /** Convenience wrapper for mapObjectNB(). */
         uint32_t mapObjectNB( Object* object, const ObjectVersion& v );
 
+        /** Start mapping multiple distributed objects. */
+        std::vector< uint32_t > mapObjectsNB( const Objects& objects,
+                                              const ObjectVersions& versions );
+
         /** 
          * Unmap a mapped object.
          * 
@@ -181,12 +193,24 @@ namespace co
         typedef stde::hash_map< base::uint128_t, Objects > ObjectsHash;
         typedef ObjectsHash::const_iterator ObjectsHashCIter;
 
-        /** All registered and mapped objects. 
+        /**
+         * A shard of the object registry, aligned to its own cache line. The
+         * alignment requires the ObjectStore allocation operators.
+         */
+        struct EQ_ALIGN_CACHELINE LockableObjects
+            : public base::Lockable< ObjectsHash, base::SpinLock >
+        {};
+
+        /** All registered and mapped objects, sharded by identifier.
          *   - write locked only in receiver thread
-         *   - read unlocked in receiver thread 
-         *   - read locked in all other threads
+         *   - read unlocked in receiver thread
+         *   - read locked in all other threads, on the identifier's shard
          */
-        base::Lockable< ObjectsHash, base::SpinLock > _objects;
+        LockableObjects _objects[ CO_OBJECTS_SHARDS ];
+
+        /** @return the shard of the object registry for an identifier. */
+        LockableObjects& _getObjects( const base::UUID& id )
+            { return _objects[ id.low() % CO_OBJECTS_SHARDS ]; }
 
         struct SendQueueItem
         {
@@ -209,9 +233,25 @@ namespace co
          *         found for the identifier.
          */
         NodeID _findMasterNodeID( const base::UUID& id );
+
+        typedef stde::hash_map< base::uint128_t, NodeID > NodeIDHash;
+
+        /**
+         * Find the master node ids for multiple identifiers.
+         *
+         * The requests to each node are sent in one batch, i.e., the number
+         * of round trips is independent of the number of identifiers.
+         */
+        void _findMasterNodeIDs( const std::vector< base::UUID >& ids,
+                                 NodeIDHash& masterNodeIDs );
  
         NodePtr _connectMaster( const base::UUID& id );
 
+        void _initMapPacket( NodeMapObjectPacket& packet, Object* object,
+                             const base::UUID& id, const uint128_t& version );
+        void _restoreInstances( const NodeIDHash& masterNodeIDs );
+        void _mapObject( NodePtr node, const NodeMapObjectPacket* packet );
+
         void _attachObject( Object* object, const base::UUID& id, 
                             const uint32_t instanceID );
         void _detachObject( Object* object );
@@ -222,6 +262,8 @@ namespace co
         bool _cmdAttachObject( Command& command );
         bool _cmdDetachObject( Command& command );
         bool _cmdMapObject( Command& command );
+        bool _cmdMapObjects( Command& command );
+        bool _cmdRestoreInstances( Command& command );
         bool _cmdMapObjectSuccess( Command& command );
         bool _cmdMapObjectReply( Command& command );
         bool _cmdUnmapObject( Command& command );
@@ -0,0 +1,78 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CO_PAYLOADRECEIVER_H
+#define CO_PAYLOADRECEIVER_H
+
+#include <co/types.h>
+#include <co/base/buffer.h> // Bufferb
+
+namespace co
+{
+    struct Packet;
+
+    /**
+     * @internal
+     * An interface to receive the payload of big packets into application
+     * memory.
+     *
+     * A payload receiver is registered with a LocalNode for a packet type and
+     * command. For received packets bigger than
+     * Global::IATTR_NODE_PAYLOAD_RECEIVE_SIZE, the receiver thread reads the
+     * packet header into the command and the remaining payload directly into
+     * the memory provided by the receiver, instead of copying the whole packet
+     * into the command. The command handler accesses the payload using
+     * Command::getPayload().
+     *
+     * @sa LocalNode::registerPayloadReceiver()
+     */
+    class PayloadReceiver
+    {
+    public:
+        virtual ~PayloadReceiver() {}
+
+        /**
+         * @return the size of the packet header, which is received into the
+         *         command. Must be at least sizeof( Packet ).
+         */
+        virtual uint64_t getHeaderSize() const = 0;
+
+        /**
+         * Provide the memory for the payload of a received packet.
+         *
+         * Called from a receiver thread.
+         *
+         * @param packet the received packet header.
+         * @param size the size of the payload in bytes.
+         * @return a buffer of the given size receiving the payload, or 0 to
+         *         receive the full packet into the command.
+         */
+        virtual base::Bufferb* allocPayload( const Packet* packet,
+                                             const uint64_t size ) = 0;
+
+        /**
+         * Release a payload returned by allocPayload().
+         *
+         * Called from any thread when the last reference to the command is
+         * released, including commands which are dropped without being
+         * dispatched or whose payload was not received completely. The
+         * receiver has to stay valid until all its payloads are released.
+         */
+        virtual void releasePayload( base::Bufferb* payload ) = 0;
+    };
+}
+
+#endif // CO_PAYLOADRECEIVER_H
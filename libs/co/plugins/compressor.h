@@ -150,6 +150,13 @@
  *      EQ_COMPRESSOR_AG_RTT_JPEG_MQ,
  *      EQ_COMPRESSOR_AG_RTT_JPEG_LQ
  *
+ * Version 4
+ *  - Added asynchronous download:
+ *    - Added optional functions: EqCompressorStartDownload,
+ *      EqCompressorFinishDownload
+ *    - Added capability EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD
+ *  - Added optional function EqCompressorDeleteGLObjects
+ *
  * Version 2
  *  - Added EQ_COMPRESSOR_DIFF_RLE_565 to type name registry
  *  - Added EQ_COMPRESSOR_DIFF_RLE_10A2 to type name registry
@@ -184,13 +191,15 @@ typedef unsigned long long eq_uint64_t;
 /** @name Compressor Plugin API Versioning */
 /*@{*/
 /** The version of the Compressor API described by this header. */
-#define EQ_COMPRESSOR_VERSION 3
+#define EQ_COMPRESSOR_VERSION 4
 /** At least version 1 of the Compressor API is described by this header. */
 #define EQ_COMPRESSOR_VERSION_1 1
 /**At least version 2 of the Compressor API is described by this header.*/
 #define EQ_COMPRESSOR_VERSION_2 1
 /**At least version 3 of the Compressor API is described by this header.*/
 #define EQ_COMPRESSOR_VERSION_3 1
+/**At least version 4 of the Compressor API is described by this header.*/
+#define EQ_COMPRESSOR_VERSION_4 1
 /*@}*/
 
 #include <co/plugins/compressorTokens.h>
@@ -282,6 +291,16 @@ extern "C" {
      * the frame buffer as the source or destination for its operations.
      */
     #define EQ_COMPRESSOR_USE_FRAMEBUFFER 0x40
+
+    /**
+     * Capability to download asynchronously.
+     * If set, the transfer engine implements EqCompressorStartDownload and
+     * EqCompressorFinishDownload. The download may be split into two
+     * operations, which allows the GPU to transfer the data while the
+     * application continues to issue OpenGL commands.
+     * @version 4
+     */
+    #define EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD 0x100
     /*@}*/
 
     /** @name DSO information interface. */
@@ -578,6 +597,76 @@ extern "C" {
                                              eq_uint64_t        outDims[4],
                                              void**             out );
 
+    /**
+     * Start transferring frame buffer data into main memory.
+     *
+     * Only called for transfer engines declaring
+     * EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD. The parameters are the same as for
+     * EqCompressorDownload(). The function should initiate the transfer and
+     * return as soon as possible. EqCompressorFinishDownload() is called later
+     * with the same compressor instance and the same OpenGL context current,
+     * but other OpenGL commands may be issued in between.
+     *
+     * @param compressor the compressor instance.
+     * @param name the type name of the compressor.
+     * @param glewContext the initialized GLEW context describing corresponding
+     *                    to the current OpenGL context.
+     * @param inDims the dimensions of the input data (x, w, y, h).
+     * @param source texture name to if EQ_COMPRESSOR_USE_TEXTURE_2D or
+     *               EQ_COMPRESSOR_USE_TEXTURE_RECT is set.
+     * @param flags capability flags for the compression.
+     * @version 4
+     */
+    EQ_PLUGIN_API void EqCompressorStartDownload( void* const        compressor,
+                                                  const unsigned     name,
+                                                  const GLEWContext* glewContext,
+                                                  const eq_uint64_t  inDims[4],
+                                                  const unsigned     source,
+                                                  const eq_uint64_t  flags );
+
+    /**
+     * Finish transferring frame buffer data into main memory.
+     *
+     * Completes the transfer started by the last EqCompressorStartDownload()
+     * on the same compressor instance. The output parameters have the same
+     * semantics as for EqCompressorDownload().
+     *
+     * @param compressor the compressor instance.
+     * @param name the type name of the compressor.
+     * @param glewContext the initialized GLEW context describing corresponding
+     *                    to the current OpenGL context.
+     * @param inDims the dimensions of the input data (x, w, y, h).
+     * @param flags capability flags for the compression.
+     * @param outDims the dimensions of the output data.
+     * @param out the pointer to the output data.
+     * @version 4
+     */
+    EQ_PLUGIN_API void EqCompressorFinishDownload( void* const        compressor,
+                                                   const unsigned     name,
+                                                   const GLEWContext* glewContext,
+                                                   const eq_uint64_t  inDims[4],
+                                                   const eq_uint64_t  flags,
+                                                   eq_uint64_t        outDims[4],
+                                                   void**             out );
+
+    /**
+     * Delete the OpenGL objects of a transfer engine instance.
+     *
+     * Called before the instance is deleted, with the OpenGL context of the
+     * last download current. Transfer engines keeping OpenGL objects across
+     * downloads, e.g., for EqCompressorStartDownload(), have to implement this
+     * function, since the instance is not deleted with a current context.
+     *
+     * @param compressor the compressor instance.
+     * @param name the type name of the compressor.
+     * @param glewContext the initialized GLEW context describing corresponding
+     *                    to the current OpenGL context.
+     * @version 4
+     */
+    EQ_PLUGIN_API void EqCompressorDeleteGLObjects( void* const        compressor,
+                                                    const unsigned     name,
+                                                    const GLEWContext* glewContext );
+
     /**
      * Transfer data from main memory into GPU memory.
      * 
@@ -111,6 +111,26 @@
 #define EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT                        0x27u
 /** RLE Compression of unsigned tokens. */
 #define EQ_COMPRESSOR_RLE_DIFF_UNSIGNED                             0x28u
+/** SIMD RLE Compression of RGBA bytes tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_RGBA                                 0x29u
+/** SIMD RLE Compression of BGRA bytes tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_BGRA                                 0x2au
+/** SIMD RLE Compression of RGBA UINT_8_8_8_8_REV tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_RGBA_UINT_8_8_8_8_REV                0x2bu
+/** SIMD RLE Compression of BGRA UINT_8_8_8_8_REV tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_BGRA_UINT_8_8_8_8_REV                0x2cu
+/** SIMD RLE Compression of depth unsigned int tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_DEPTH_UNSIGNED_INT                   0x2du
+/** SIMD Differential RLE Compression of RGBA bytes tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA                            0x2eu
+/** SIMD Differential RLE Compression of BGRA bytes tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA                            0x2fu
+/** SIMD Differential RLE Compression of RGBA UINT_8_8_8_8_REV tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA_UINT_8_8_8_8_REV           0x30u
+/** SIMD Differential RLE Compression of BGRA UINT_8_8_8_8_REV tokens. */
+#define EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA_UINT_8_8_8_8_REV           0x31u
+/** LZ Compression of 1-byte tokens. */
+#define EQ_COMPRESSOR_LZ_BYTE                                       0x32u
 
 // Equalizer GPU<->CPU transfer plugins
 /* Transfer data from internal RGBA to external RGBA format with a data type
@@ -0,0 +1,236 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "receiverPoolThread.h"
+
+#include "command.h"
+#include "connection.h"
+#include "connectionDescription.h"
+#include "localNode.h"
+
+#include <co/base/scopedMutex.h>
+
+namespace co
+{
+
+ReceiverPoolThread::ReceiverPoolThread( LocalNode* localNode )
+        : _localNode( localNode )
+        , _reading( 0 )
+        , _state( STATE_RUNNING )
+        , _running( false )
+{}
+
+ReceiverPoolThread::~ReceiverPoolThread()
+{
+    EQASSERT( !isRunning( ));
+    EQASSERT( _connectionNodes.empty( ));
+}
+
+bool ReceiverPoolThread::init()
+{
+    setName( std::string( "RcvPool " ) + base::className( _localNode ));
+    _running = true;
+    return true;
+}
+
+void ReceiverPoolThread::addConnection( ConnectionPtr connection, NodePtr node )
+{
+    base::ScopedMutex<> mutex( _lock );
+    EQASSERT( _connectionNodes.find( connection ) == _connectionNodes.end( ));
+
+    _connectionNodes[ connection ] = node;
+    _connections.addConnection( connection );
+}
+
+bool ReceiverPoolThread::removeConnection( ConnectionPtr connection )
+{
+    {
+        base::ScopedMutex<> mutex( _lock );
+        ConnectionNodeHash::iterator i = _connectionNodes.find( connection );
+        if( i == _connectionNodes.end( ))
+            return false;
+
+        _connectionNodes.erase( i );
+        _connections.removeConnection( connection );
+    }
+
+    // A packet read started before the removal completes first
+    _reading.waitNE( connection.get( ));
+    return true;
+}
+
+void ReceiverPoolThread::stop( Connections& connections )
+{
+    _running = false;
+    _connections.interrupt();
+    _state.waitEQ( STATE_STOPPED );
+
+    base::ScopedMutex<> mutex( _lock );
+    for( ConnectionNodeHash::const_iterator i = _connectionNodes.begin();
+         i != _connectionNodes.end(); ++i )
+    {
+        connections.push_back( i->first );
+    }
+    _connectionNodes.clear();
+    _connections.clear();
+}
+
+void ReceiverPoolThread::flush()
+{
+    _state = STATE_FLUSH;
+    join();
+}
+
+void ReceiverPoolThread::run()
+{
+    int nErrors = 0;
+    while( _running )
+    {
+        const ConnectionSet::Event result = _connections.select();
+        switch( result )
+        {
+            case ConnectionSet::EVENT_DATA:
+                _handleData();
+                break;
+
+            case ConnectionSet::EVENT_DISCONNECT:
+            case ConnectionSet::EVENT_INVALID_HANDLE:
+                // Let the receiver thread handle it, it owns the node state
+                _handleDisconnect();
+                break;
+
+            case ConnectionSet::EVENT_ERROR:
+                ++nErrors;
+                EQWARN << "Connection error during select" << std::endl;
+                if( nErrors > 100 )
+                {
+                    EQWARN << "Too many errors in a row, capping connection"
+                           << std::endl;
+                    _handleDisconnect();
+                }
+                break;
+
+            case ConnectionSet::EVENT_INTERRUPT: // stop or set modified
+            case ConnectionSet::EVENT_TIMEOUT:
+                break;
+
+            case ConnectionSet::EVENT_SELECT_ERROR:
+                EQWARN << "Error during select" << std::endl;
+                break;
+
+            default:
+                EQUNIMPLEMENTED;
+        }
+        if( result != ConnectionSet::EVENT_ERROR &&
+            result != ConnectionSet::EVENT_SELECT_ERROR )
+        {
+            nErrors = 0;
+        }
+    }
+
+    // commands are freed by the thread which allocated them
+    _state = STATE_STOPPED;
+    _state.waitEQ( STATE_FLUSH );
+    _commandCache.flush();
+}
+
+void ReceiverPoolThread::_handleDisconnect()
+{
+    while( _handleData( )) ; // read remaining data off connection
+
+    ConnectionPtr connection;
+    {
+        base::ScopedMutex<> mutex( _lock );
+        connection = _connections.getConnection();
+    }
+    if( !connection || !removeConnection( connection ))
+        return; // removed by receiver thread in the meantime
+
+    _localNode->_pushPoolData( 0, connection );
+}
+
+bool ReceiverPoolThread::_handleData()
+{
+    ConnectionPtr connection;
+    NodePtr node;
+    {
+        base::ScopedMutex<> mutex( _lock );
+        connection = _connections.getConnection();
+        if( !connection )
+            return false;
+
+        ConnectionNodeHash::const_iterator i =
+            _connectionNodes.find( connection );
+        if( i == _connectionNodes.end( )) // removed by receiver thread
+            return false;
+        node = i->second;
+        _reading = connection.get();
+    }
+
+    const bool result = _readPacket( connection, node );
+    _reading = 0;
+    return result;
+}
+
+bool ReceiverPoolThread::_readPacket( ConnectionPtr connection, NodePtr node )
+{
+    void* sizePtr( 0 );
+    uint64_t bytes( 0 );
+    const bool gotSize = connection->recvSync( &sizePtr, &bytes, false );
+
+    if( !gotSize ) // Some systems signal data on dead connections.
+    {
+        connection->recvNB( sizePtr, sizeof( uint64_t ));
+        return false;
+    }
+
+    EQASSERT( sizePtr );
+    const uint64_t size = *reinterpret_cast< uint64_t* >( sizePtr );
+    if( bytes == 0 ) // fluke signal
+    {
+        EQWARN << "Erronous network event on " << connection->getDescription()
+               << std::endl;
+        _connections.setDirty();
+        return false;
+    }
+
+    EQASSERT( size );
+    EQASSERTINFO( bytes == sizeof( uint64_t ), bytes );
+    EQASSERT( size > sizeof( size ));
+
+    Command* command = _localNode->_readCommand( connection, node, size,
+                                                 _commandCache );
+    EQASSERT( command );
+
+    // start next receive
+    connection->recvNB( sizePtr, sizeof( uint64_t ));
+
+    if( !command )
+    {
+        EQERROR << "Incomplete packet read on " << connection->getDescription()
+                << std::endl;
+        return false;
+    }
+
+    EQASSERT( command->isValid( ));
+    EQASSERT( command->isFree( ));
+
+    command->retain(); // released by receiver thread after dispatch
+    _localNode->_pushPoolData( command, connection );
+    return true;
+}
+
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CO_RECEIVERPOOLTHREAD_H
+#define CO_RECEIVERPOOLTHREAD_H
+
+#include <co/commandCache.h>  // member
+#include <co/connectionSet.h> // member
+#include <co/types.h>
+#include <co/base/hash.h>     // member
+#include <co/base/lock.h>     // member
+#include <co/base/monitor.h>  // member
+#include <co/base/thread.h>   // base class
+
+namespace co
+{
+    /**
+     * @internal
+     * A thread reading packets from a subset of the connections of a LocalNode.
+     *
+     * Established unicast connections are handed to one pool thread, which
+     * reads complete packets into its own CommandCache and passes them to the
+     * receiver thread of the local node for dispatch. Since each connection is
+     * read by exactly one thread, the packet order per connection is preserved.
+     */
+    class ReceiverPoolThread : public base::Thread
+    {
+    public:
+        ReceiverPoolThread( LocalNode* localNode );
+        virtual ~ReceiverPoolThread();
+
+        /** Start reading from the given connection of the given node. */
+        void addConnection( ConnectionPtr connection, NodePtr node );
+
+        /**
+         * Stop reading from the given connection.
+         *
+         * When this method returns, the connection is no longer read.
+         * @return true if the connection was handled by this thread.
+         */
+        bool removeConnection( ConnectionPtr connection );
+
+        /** Stop reading and return all remaining connections. */
+        void stop( Connections& connections );
+
+        /**
+         * Flush the commands allocated by this thread and exit it.
+         *
+         * Has to be called after stop(), once all commands are released.
+         */
+        void flush();
+
+    protected:
+        virtual bool init();
+        virtual void run();
+
+    private:
+        LocalNode* const _localNode;
+
+        /** The connections read by this thread. */
+        ConnectionSet _connections;
+
+        /** The node for each connection. */
+        typedef base::RefPtrHash< Connection, NodePtr > ConnectionNodeHash;
+        ConnectionNodeHash _connectionNodes;
+
+        /** Protects _connectionNodes. */
+        base::Lock _lock;
+
+        /** The connection currently read, set while holding _lock. */
+        base::Monitor< const Connection* > _reading;
+
+        /** The command 'allocator' of this thread. */
+        CommandCache _commandCache;
+
+        enum State
+        {
+            STATE_RUNNING,
+            STATE_STOPPED,
+            STATE_FLUSH
+        };
+        base::Monitor< State > _state;
+        bool _running;
+
+        bool _handleData();
+        bool _readPacket( ConnectionPtr connection, NodePtr node );
+        void _handleDisconnect();
+    };
+}
+
+#endif // CO_RECEIVERPOOLTHREAD_H
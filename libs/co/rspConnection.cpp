@@ -59,12 +59,34 @@ base::a_int32_t nAcksAccepted;
 base::a_int32_t nNAcksSend;
 base::a_int32_t nNAcksRead;
 base::a_int32_t nNAcksResend;
+base::a_int32_t nRepairsSend;
+base::a_int32_t nRepairsRead;
+base::a_int32_t nRecovered;
 
 float writeWaitTime = 0.f;
 base::Clock instrumentClock;
 #endif
 
 static uint16_t _numBuffers = 0;
+
+static void _xor( void* to, const void* from, const size_t size )
+{
+    uint8_t* out = reinterpret_cast< uint8_t* >( to );
+    const uint8_t* in = reinterpret_cast< const uint8_t* >( from );
+    size_t i = 0;
+
+    // OPT: eight bytes at a time, memcpy since parity strides are unaligned
+    for( ; i + 8 <= size; i += 8 )
+    {
+        uint64_t a, b;
+        memcpy( &a, out + i, 8 );
+        memcpy( &b, in + i, 8 );
+        a ^= b;
+        memcpy( out + i, &a, 8 );
+    }
+    for( ; i < size; ++i )
+        out[i] ^= in[i];
+}
 }
 
 RSPConnection::RSPConnection()
@@ -89,6 +111,14 @@ RSPConnection::RSPConnection()
         , _readBuffer( 0 )
         , _readBufferPos( 0 )
         , _sequence( 0 )
+        , _lossSequence( 0 )
+        , _nackTime( 0 )
+        , _fecGroupSize( 0 )
+        , _fecRepairs( 0 )
+        , _fecCount( 0 )
+        , _fecSent( 0 )
+        , _fecStart( 0 )
+        , _fecBuffer( _mtu )
 {
     _buildNewID();
     _description->type = CONNECTIONTYPE_RSP;
@@ -104,6 +134,7 @@ RSPConnection::RSPConnection()
     }
 
     EQASSERT( sizeof( DatagramNack ) <= size_t( _mtu ));
+    EQASSERT( sizeof( DatagramRepair ) >= sizeof( DatagramData ));
     EQLOG( LOG_RSP ) << "New RSP connection, " << _buffers.size()
                      << " buffers of " << _mtu << " bytes" << std::endl;
 }
@@ -116,6 +147,16 @@ RSPConnection::~RSPConnection()
         delete _buffers.back();
         _buffers.pop_back();
     }
+    for( RepairGroups::const_iterator i = _repairGroups.begin();
+         i != _repairGroups.end(); ++i )
+    {
+        delete *i;
+    }
+    for( RepairGroups::const_iterator i = _freeGroups.begin();
+         i != _freeGroups.end(); ++i )
+    {
+        delete *i;
+    }
 }
 
 void RSPConnection::_close()
@@ -261,6 +302,7 @@ bool RSPConnection::listen()
         _write->set_option( ip::multicast::outbound_interface( ifAddr.to_v4()));
 
         _write->connect( writeEndpoint );
+        _writeAddr = _write->local_endpoint();
 
         _read->set_option( ip::multicast::enable_loopback( false ));
         _write->set_option( ip::multicast::enable_loopback( false ));
@@ -280,6 +322,25 @@ bool RSPConnection::listen()
     _thread = new Thread( this );
     _bucketSize = 0;
     _sendRate = _description->bandwidth;
+    _lossSequence = _sequence;
+
+    // forward error correction: shrink the payload so that the parity of a
+    // full datagram fits into a repair datagram
+    _fecGroupSize = uint8_t( EQ_MIN( _description->fecGroupSize,
+                                     EQ_RSP_MAX_FEC_GROUP ));
+    _fecRepairs = uint8_t( EQ_MIN( EQ_MAX( _description->fecRepairs, 1 ),
+                                   _fecGroupSize ));
+    _fecCount = 0;
+    _fecSent = 0;
+    if( _fecGroupSize > 0 )
+    {
+        _payloadSize = _mtu - sizeof( DatagramRepair );
+        _fecParity.resize( _fecRepairs * _payloadSize );
+        _fecSizes.resize( _fecRepairs );
+        _fecMaxSizes.resize( _fecRepairs );
+        EQINFO << "Using FEC with " << int( _fecRepairs ) << " repairs for "
+               << int( _fecGroupSize ) << " datagrams" << std::endl;
+    }
 
     // waits until RSP protocol establishes connection to the multicast network
     if( !_thread->start( ) )
@@ -528,6 +589,8 @@ void RSPConnection::_processOutgoing()
     }
 #endif
 
+    const int64_t nackWait = _flushNacks();
+
     if( !_repeatQueue.empty( ))
         _repeatData();
     else
@@ -538,12 +601,18 @@ void RSPConnection::_processOutgoing()
         _setTimeout( 0 ); // call again to send remaining
         return;
     }
-    // no more data to write, check/send ack request, reset timeout
+    // no more data to write, protect the last datagrams, check/send ack
+    // request, reset timeout
+    if( !_writeBuffers.empty( ))
+        _sendRepairs();
 
     if( _writeBuffers.empty( )) // got all acks
     {
         _timeouts = 0;
-        _timeout.cancel();
+        if( nackWait < 0 )
+            _timeout.cancel();
+        else
+            _setTimeout( int32_t( nackWait ));
         return;
     }
 
@@ -553,7 +622,7 @@ void RSPConnection::_processOutgoing()
 
     if( left > 0 )
     {
-        _setTimeout( left );
+        _setTimeout( int32_t( nackWait < 0 ? left : EQ_MIN( left, nackWait )));
         return;
     }
 
@@ -561,7 +630,8 @@ void RSPConnection::_processOutgoing()
     _clock.reset();
     ++_timeouts;
     _sendAckRequest();
-    _setTimeout( timeout );
+    _setTimeout( int32_t( nackWait < 0 ? timeout :
+                          EQ_MIN( timeout, nackWait )));
 }
 
 void RSPConnection::_writeData()
@@ -621,6 +691,8 @@ void RSPConnection::_writeData()
     ++nDatagrams;
     nBytesWritten += header->size;
 #endif
+    if( _fecGroupSize > 0 )
+        _addParity( header );
 
     // save datagram for repeats (and self)
     _writeBuffers.push_back( buffer );
@@ -662,15 +734,6 @@ void RSPConnection::_waitWritable( const uint64_t bytes )
 #ifdef EQ_INSTRUMENT_RSP
     writeWaitTime += clock.getTimef();
 #endif
-
-    if( _sendRate < _description->bandwidth )
-    {
-        _sendRate += int64_t(
-            float( Global::getIAttribute( Global::IATTR_RSP_ERROR_UPSCALE )) *
-            float( _description->bandwidth ) * .001f );
-        EQLOG( LOG_RSP ) << "speeding up to " << _sendRate << " KB/s"
-                         << std::endl;
-    }
 }
 
 void RSPConnection::_repeatData()
@@ -715,6 +778,73 @@ void RSPConnection::_repeatData()
     }
 }
 
+uint16_t RSPConnection::_getGroupLength( const uint16_t start ) const
+{
+    // the last group before the sequence wraps around may be smaller
+    const uint32_t left = 65536u - start;
+    return uint16_t( EQ_MIN( uint32_t( _fecGroupSize ), left ));
+}
+
+void RSPConnection::_addParity( const DatagramData* datagram )
+{
+    const uint16_t sequence = datagram->sequence;
+    const uint16_t start = sequence - sequence % _fecGroupSize;
+    if( _fecCount == 0 || start != _fecStart ) // new group
+    {
+        _fecStart = start;
+        _fecCount = 0;
+        _fecSent = 0;
+        std::fill( _fecParity.begin(), _fecParity.end(), 0 );
+        std::fill( _fecSizes.begin(), _fecSizes.end(), 0 );
+        std::fill( _fecMaxSizes.begin(), _fecMaxSizes.end(), 0 );
+    }
+
+    if( uint16_t( sequence - start ) != _fecCount ) // did not see group start
+        return;
+
+    const size_t index = _fecCount % _fecRepairs;
+    _xor( &_fecParity[ index * _payloadSize ], datagram + 1, datagram->size );
+    _fecSizes[ index ] ^= datagram->size;
+    _fecMaxSizes[ index ] = EQ_MAX( _fecMaxSizes[ index ], datagram->size );
+    ++_fecCount;
+
+    if( _fecCount == _getGroupLength( start ))
+    {
+        _sendRepairs();
+        _fecCount = 0;
+    }
+}
+
+void RSPConnection::_sendRepairs()
+{
+    if( _fecCount == _fecSent )
+        return;
+
+    const uint8_t nRepairs = EQ_MIN( _fecRepairs, _fecCount );
+    for( uint8_t i = 0; i < nRepairs; ++i )
+    {
+        DatagramRepair* repair =
+            reinterpret_cast< DatagramRepair* >( _fecBuffer.getData( ));
+        repair->type = REPAIR;
+        repair->writerID = _id;
+        repair->start = _fecStart;
+        repair->sizes = _fecSizes[ i ];
+        repair->groupSize = _fecGroupSize;
+        repair->nRepairs = _fecRepairs;
+        repair->index = i;
+        repair->count = _fecCount;
+        memcpy( repair + 1, &_fecParity[ i * _payloadSize ], _fecMaxSizes[i] );
+
+        const uint32_t size = sizeof( DatagramRepair ) + _fecMaxSizes[ i ];
+        _waitWritable( size );
+        _write->send( boost::asio::buffer( repair, size ));
+#ifdef EQ_INSTRUMENT_RSP
+        ++nRepairsSend;
+#endif
+    }
+    _fecSent = _fecCount;
+}
+
 void RSPConnection::_finishWriteQueue( const uint16_t sequence )
 {
     EQASSERT( !_writeBuffers.empty( ));
@@ -734,6 +864,18 @@ void RSPConnection::_finishWriteQueue( const uint16_t sequence )
                      << _sequence << " advance " << _writeBuffers.size() - size
                      << " buffers" << std::endl;
 
+    // Speed up for each datagram received by all readers
+    if( _sendRate < _description->bandwidth )
+    {
+        const size_t nAcked = _writeBuffers.size() - size;
+        _sendRate += int64_t( float( nAcked ) *
+            float( Global::getIAttribute( Global::IATTR_RSP_ERROR_UPSCALE )) *
+            float( _description->bandwidth ) * .001f );
+        _sendRate = EQ_MIN( _sendRate, _description->bandwidth );
+        EQLOG( LOG_RSP ) << "speeding up to " << _sendRate << " KB/s"
+                         << std::endl;
+    }
+
     while( _writeBuffers.size() > size_t( size ))
     {
         Buffer* buffer = _writeBuffers.front();
@@ -798,9 +940,12 @@ void RSPConnection::_finishWriteQueue( const uint16_t sequence )
 void RSPConnection::_handlePacket( const boost::system::error_code& /* error */,
                                    const size_t /* bytes */ )
 {
-    if( _state == STATE_LISTENING )
+    if( _readAddr == _writeAddr ) // own datagram, looped back by the network
+        ;
+    else if( _state == STATE_LISTENING )
     {
-        _handleConnectedData( _recvBuffer.getData() );
+        if( !_drop( ))
+            _handleConnectedData( _recvBuffer.getData() );
 
         if( _state == STATE_LISTENING )
             _processOutgoing();
@@ -885,7 +1030,21 @@ void RSPConnection::_handleConnectedData( const void* data )
     switch( type )
     {
         case DATA:
+        {
+            // _handleData() swaps the buffer, keep the datagram identifiers
+            const DatagramData* datagram =
+                reinterpret_cast< const DatagramData* >( data );
+            const uint16_t writerID = datagram->writerID;
+            const uint16_t sequence = datagram->sequence;
+
             EQCHECK( _handleData( _recvBuffer ));
+            _recover( writerID, sequence );
+            break;
+        }
+
+        case REPAIR:
+            EQCHECK( _handleRepair(
+                      reinterpret_cast< const DatagramRepair* >( data )));
             break;
 
         case ACK:
@@ -983,6 +1142,9 @@ bool RSPConnection::_handleData( Buffer& buffer )
         if( !newBuffer ) // no more data buffers, drop packet
             return true;
 
+        connection->_addReceived(
+            reinterpret_cast< const DatagramData* >( newBuffer->getData( )));
+
         base::ScopedMutex<> mutex( connection->_mutexEvent );
         connection->_pushDataBuffer( newBuffer );
             
@@ -1034,6 +1196,8 @@ bool RSPConnection::_handleData( Buffer& buffer )
 
     EQASSERT( !connection->_recvBuffers[ i ] );
     connection->_recvBuffers[ i ] = newBuffer;
+    connection->_addReceived(
+        reinterpret_cast< const DatagramData* >( newBuffer->getData( )));
 
     // early nack: request missing packets before current
     --i;
@@ -1063,7 +1227,7 @@ bool RSPConnection::_handleData( Buffer& buffer )
         // OPT: don't drop nack 0..nack.end, but it doesn't happen often
         nack.end = std::numeric_limits< uint16_t >::max();
 
-    _sendNack( writerID, &nack, 1 );
+    _queueNack( connection, nack );
     return true;
 }
 
@@ -1166,8 +1330,14 @@ bool RSPConnection::_handleNack( const DatagramNack* nack )
     if( _id != nack->writerID )
     {
         EQLOG( LOG_RSP )
-            << "ignore " << nack->count << " nacks from " << nack->readerID
+            << "suppress " << nack->count << " nacks from " << nack->readerID
             << " for " << nack->writerID << " (not me)"<< std::endl;
+
+        // another reader requested these repeats, don't request them again
+        RSPConnectionPtr connection = _findConnection( nack->writerID );
+        if( connection )
+            connection->_addNacked( nack->nacks, nack->count,
+                                    _nackClock.getTime64( ));
         return true;
     }
 
@@ -1193,12 +1363,19 @@ void RSPConnection::_addRepeat( const Nack* nacks, uint16_t num )
     EQLOG( LOG_RSP ) << base::disableFlush << "Queue repeat requests ";
     size_t lost = 0;
 
+    // Slow down only once for all nacks caused by the same loss, i.e., for
+    // datagrams sent before the last slowdown
+    const uint16_t epoch = _sequence - _lossSequence;
+    bool newLoss = epoch > _numBuffers;
+
     for( size_t i = 0; i < num; ++i )
     {
         const Nack& nack = nacks[ i ];
         EQASSERT( nack.start <= nack.end );
 
         EQLOG( LOG_RSP ) << nack.start << ".." << nack.end << " ";
+        if( uint16_t( _sequence - nack.start ) <= epoch )
+            newLoss = true;
 
         bool merged = false;
         for( RepeatQueue::iterator j = _repeatQueue.begin();
@@ -1231,10 +1408,11 @@ void RSPConnection::_addRepeat( const Nack* nacks, uint16_t num )
         }
     }
 
-    if( _sendRate >
+    if( newLoss && _sendRate >
         ( _description->bandwidth >> 
           Global::getIAttribute( Global::IATTR_RSP_MIN_SENDRATE_SHIFT )))
     {
+        _lossSequence = _sequence;
         const float delta = float( lost ) * .001f *
                      Global::getIAttribute( Global::IATTR_RSP_ERROR_DOWNSCALE );
         const float maxDelta = .01f *
@@ -1250,6 +1428,377 @@ void RSPConnection::_addRepeat( const Nack* nacks, uint16_t num )
         EQLOG( LOG_RSP ) << std::endl << base::enableFlush;
 }
 
+void RSPConnection::_queueNack( RSPConnectionPtr connection, const Nack& nack )
+{
+    Nacks& nacks = connection->_pendingNacks;
+    for( Nacks::iterator i = nacks.begin(); i != nacks.end(); ++i )
+    {
+        Nack& pending = *i;
+        if( pending.start <= nack.end && pending.end >= nack.start )
+        {
+            pending.start = EQ_MIN( pending.start, nack.start );
+            pending.end = EQ_MAX( pending.end, nack.end );
+            return;
+        }
+    }
+
+    if( nacks.empty( ))
+    {
+        // Delay the first nack randomly, so that the readers loosing the same
+        // datagram suppress each other's nacks, and aggregate the nacks for
+        // further losses detected during the delay into one datagram.
+        const int32_t maxDelay =
+            Global::getIAttribute( Global::IATTR_RSP_NACK_DELAY );
+        base::RNG rng;
+        int64_t delay = maxDelay > 0 ?
+                        rng.get< uint16_t >() % ( maxDelay + 1 ) : 0;
+        if( connection->_fecGroupSize > 0 ) // give the repairs time to arrive
+            delay = EQ_MAX( delay, 1 );
+        connection->_nackTime = _nackClock.getTime64() + delay;
+    }
+    nacks.push_back( nack );
+}
+
+int64_t RSPConnection::_flushNacks()
+{
+    const int64_t time = _nackClock.getTime64();
+    int64_t wait = -1;
+
+    for( RSPConnectionsCIter i = _children.begin(); i != _children.end(); ++i )
+    {
+        RSPConnectionPtr child = *i;
+        if( child->_pendingNacks.empty( ))
+            continue;
+
+        const int64_t left = child->_nackTime - time;
+        if( left <= 0 )
+        {
+            Nacks nacks;
+            nacks.swap( child->_pendingNacks );
+            child->_removeReceived( nacks );
+            _sendNacks( child, nacks );
+        }
+        else if( wait < 0 || left < wait )
+            wait = left;
+    }
+    return wait;
+}
+
+void RSPConnection::_sendNacks( RSPConnectionPtr connection, Nacks& nacks )
+{
+    const int64_t time = _nackClock.getTime64();
+    connection->_suppressNacks( nacks, time );
+    if( nacks.empty( ))
+    {
+        EQLOG( LOG_RSP ) << "all nacks suppressed" << std::endl;
+        return;
+    }
+
+    for( size_t i = 0; i < nacks.size(); i += EQ_RSP_MAX_NACKS )
+    {
+        const uint16_t num = uint16_t( EQ_MIN( nacks.size() - i,
+                                               EQ_RSP_MAX_NACKS ));
+        _sendNack( connection->_id, &nacks[ i ], num );
+        connection->_addNacked( &nacks[ i ], num, time );
+    }
+}
+
+void RSPConnection::_addNacked( const Nack* nacks, const uint16_t num,
+                                const int64_t time )
+{
+    for( size_t i = 0; i < num; ++i )
+    {
+        const NackRequest request = { nacks[ i ], time };
+        _nacked.push_back( request );
+    }
+    while( _nacked.size() > EQ_RSP_MAX_NACKS )
+        _nacked.pop_front();
+}
+
+void RSPConnection::_suppressNacks( Nacks& nacks, const int64_t time )
+{
+    // A repeat is expected within half an ack timeout
+    const int64_t timeout = EQ_MAX( 1,
+        Global::getIAttribute( Global::IATTR_RSP_ACK_TIMEOUT ) >> 1 );
+    while( !_nacked.empty() && time - _nacked.front().time >= timeout )
+        _nacked.pop_front();
+
+    for( NackRequests::const_iterator i = _nacked.begin();
+         i != _nacked.end() && !nacks.empty(); ++i )
+    {
+        const Nack& old = i->nack;
+        Nacks remaining;
+        for( Nacks::const_iterator j = nacks.begin(); j != nacks.end(); ++j )
+        {
+            const Nack& nack = *j;
+            if( old.start > nack.end || old.end < nack.start ) // no overlap
+            {
+                remaining.push_back( nack );
+                continue;
+            }
+            if( nack.start < old.start )
+            {
+                const Nack head = { nack.start, uint16_t( old.start - 1 ) };
+                remaining.push_back( head );
+            }
+            if( nack.end > old.end )
+            {
+                const Nack tail = { uint16_t( old.end + 1 ), nack.end };
+                remaining.push_back( tail );
+            }
+        }
+        nacks.swap( remaining );
+    }
+}
+
+bool RSPConnection::_drop()
+{
+    const int32_t rate = Global::getIAttribute( Global::IATTR_RSP_DROP_RATE );
+    if( rate <= 0 )
+        return false;
+
+    const uint16_t type =
+        *reinterpret_cast< const uint16_t* >( _recvBuffer.getData( ));
+    if( type != DATA && type != REPAIR )
+        return false;
+
+    base::RNG rng;
+    return int32_t( rng.get< uint16_t >() % 1000 ) < rate;
+}
+
+void RSPConnection::_removeReceived( Nacks& nacks )
+{
+    Nacks missing;
+    for( Nacks::const_iterator i = nacks.begin(); i != nacks.end(); ++i )
+    {
+        bool open = false;
+        for( uint32_t j = i->start; j <= i->end; ++j )
+        {
+            const uint16_t sequence = uint16_t( j );
+            const uint16_t offset = sequence - _sequence;
+            // _recvBuffers starts at the datagram after _sequence
+            const bool received = offset > _numBuffers ||
+                                  ( offset > 0 && offset <= _recvBuffers.size()
+                                    && _recvBuffers[ offset - 1 ] );
+            if( received )
+                open = false;
+            else if( open )
+                missing.back().end = sequence;
+            else
+            {
+                const Nack nack = { sequence, sequence };
+                missing.push_back( nack );
+                open = true;
+            }
+        }
+    }
+    nacks.swap( missing );
+}
+
+bool RSPConnection::_handleRepair( const DatagramRepair* repair )
+{
+#ifdef EQ_INSTRUMENT_RSP
+    ++nRepairsRead;
+#endif
+    const uint16_t writerID = repair->writerID;
+    if( writerID == _id )
+        return true;
+
+    RSPConnectionPtr connection = _findConnection( writerID );
+    if( !connection )
+    {
+        EQASSERTINFO( false, "Can't find connection with id " << writerID );
+        return false;
+    }
+
+    if( repair->groupSize == 0 || repair->groupSize > EQ_RSP_MAX_FEC_GROUP ||
+        repair->index >= repair->nRepairs || repair->count == 0 ||
+        repair->count > repair->groupSize ||
+        repair->start % repair->groupSize != 0 )
+    {
+        EQASSERTINFO( false, "Invalid repair datagram" );
+        return false;
+    }
+
+    if( connection->_fecGroupSize != repair->groupSize ||
+        connection->_fecRepairs != repair->nRepairs )
+    {
+        // first repair, parity of the datagrams received so far is unknown
+        EQLOG( LOG_RSP ) << "Using FEC with " << int( repair->nRepairs )
+                         << " repairs for " << int( repair->groupSize )
+                         << " datagrams from " << writerID << std::endl;
+        connection->_fecGroupSize = repair->groupSize;
+        connection->_fecRepairs = repair->nRepairs;
+        connection->_freeGroups.insert( connection->_freeGroups.end(),
+                                        connection->_repairGroups.begin(),
+                                        connection->_repairGroups.end( ));
+        connection->_repairGroups.clear();
+        return true;
+    }
+
+    connection->_releaseRepairGroups();
+    RepairGroup* group = connection->_getRepairGroup( repair->start );
+    if( !group ) // all datagrams received
+        return true;
+
+    const uint8_t index = repair->index;
+    if( repair->count <= group->repairCounts[ index ] ) // got a better repair
+        return true;
+
+    const size_t stride = _mtu - sizeof( DatagramData );
+    group->repairCounts[ index ] = repair->count;
+    group->repairSizes[ index ] = repair->sizes;
+    memcpy( &group->repair[ index * stride ], repair + 1,
+            _mtu - sizeof( DatagramRepair ));
+
+    _recover( connection, group, index );
+    return true;
+}
+
+void RSPConnection::_addReceived( const DatagramData* datagram )
+{
+    if( _fecGroupSize == 0 )
+        return;
+
+    const uint16_t sequence = datagram->sequence;
+    RepairGroup* group = _getRepairGroup( sequence -
+                                          sequence % _fecGroupSize );
+    if( !group )
+        return;
+
+    const uint16_t position = sequence - group->start;
+    const uint64_t bit = 1ull << position;
+    if( group->received & bit )
+        return;
+
+    const size_t stride = _mtu - sizeof( DatagramData );
+    const size_t index = position % _fecRepairs;
+    group->received |= bit;
+    group->sizes[ index ] ^= datagram->size;
+    _xor( &group->parity[ index * stride ], datagram + 1, datagram->size );
+}
+
+RSPConnection::RepairGroup* RSPConnection::_getRepairGroup(
+    const uint16_t start )
+{
+    // not needed if all datagrams have been delivered to the application
+    const uint16_t length = _getGroupLength( start );
+    const uint32_t offset = uint16_t( start - _sequence );
+    if( offset > _numBuffers && offset + length <= 65536u )
+        return 0;
+
+    for( RepairGroups::const_iterator i = _repairGroups.begin();
+         i != _repairGroups.end(); ++i )
+    {
+        if( (*i)->start == start )
+            return *i;
+    }
+
+    RepairGroup* group = 0;
+    if( _freeGroups.empty( ))
+        group = new RepairGroup;
+    else
+    {
+        group = _freeGroups.back();
+        _freeGroups.pop_back();
+    }
+
+    const size_t stride = _mtu - sizeof( DatagramData );
+    group->start = start;
+    group->received = 0;
+    group->parity.assign( _fecRepairs * stride, 0 );
+    group->sizes.assign( _fecRepairs, 0 );
+    group->repair.resize( _fecRepairs * stride );
+    group->repairSizes.assign( _fecRepairs, 0 );
+    group->repairCounts.assign( _fecRepairs, 0 );
+    _repairGroups.push_back( group );
+    return group;
+}
+
+void RSPConnection::_releaseRepairGroups()
+{
+    for( size_t i = 0; i < _repairGroups.size(); )
+    {
+        RepairGroup* group = _repairGroups[ i ];
+        const uint16_t length = _getGroupLength( group->start );
+        const uint32_t offset = uint16_t( group->start - _sequence );
+
+        if( offset > _numBuffers && offset + length <= 65536u )
+        {
+            _freeGroups.push_back( group );
+            _repairGroups[ i ] = _repairGroups.back();
+            _repairGroups.pop_back();
+        }
+        else
+            ++i;
+    }
+}
+
+void RSPConnection::_recover( const uint16_t writerID, const uint16_t sequence )
+{
+    RSPConnectionPtr connection = _findConnection( writerID );
+    if( !connection || connection->_fecGroupSize == 0 )
+        return;
+
+    RepairGroup* group = connection->_getRepairGroup( sequence -
+                                     sequence % connection->_fecGroupSize );
+    if( group )
+        _recover( connection, group,
+                  uint16_t( sequence - group->start ) %
+                  connection->_fecRepairs );
+}
+
+void RSPConnection::_recover( RSPConnectionPtr connection, RepairGroup* group,
+                              const uint8_t index )
+{
+    const uint8_t count = group->repairCounts[ index ];
+    const uint8_t nRepairs = connection->_fecRepairs;
+    int32_t missing = -1;
+    for( uint8_t i = index; i < count; i += nRepairs )
+    {
+        if( group->received & ( 1ull << i ))
+            continue;
+        if( missing >= 0 ) // more than one datagram lost
+            return;
+        missing = i;
+    }
+    if( missing < 0 )
+        return;
+
+    // the parity includes received datagrams not covered by a partial repair
+    for( uint8_t i = index; i < connection->_fecGroupSize; i += nRepairs )
+    {
+        if( i >= count && ( group->received & ( 1ull << i )))
+            return;
+    }
+
+    const uint16_t sequence = group->start + missing;
+    const uint16_t size = group->repairSizes[ index ] ^ group->sizes[ index ];
+    const size_t stride = _mtu - sizeof( DatagramData );
+    if( size > _mtu - sizeof( DatagramRepair ))
+    {
+        EQASSERTINFO( false, "Invalid size " << size << " of FEC datagram " <<
+                      sequence );
+        return;
+    }
+
+    DatagramData* datagram =
+        reinterpret_cast< DatagramData* >( _fecBuffer.getData( ));
+    datagram->type = DATA;
+    datagram->size = size;
+    datagram->writerID = connection->_id;
+    datagram->sequence = sequence;
+    memcpy( datagram + 1, &group->repair[ index * stride ], size );
+    _xor( datagram + 1, &group->parity[ index * stride ], size );
+
+#ifdef EQ_INSTRUMENT_RSP
+    ++nRecovered;
+#endif
+    EQLOG( LOG_RSP ) << "recovered " << sequence << " from "
+                     << connection->_id << std::endl;
+    EQCHECK( _handleData( _fecBuffer ));
+}
+
 bool RSPConnection::_handleAckRequest( const DatagramAckRequest* ackRequest )
 {
     const uint16_t writerID = ackRequest->writerID;
@@ -1349,7 +1898,10 @@ bool RSPConnection::_handleAckRequest( const DatagramAckRequest* ackRequest )
                      << " nacks to " << connection->_id << std::endl;
 
     EQASSERT( i > 0 );
-    _sendNack( connection->_id, nacks, i );
+    // the complete list supersedes the pending early nacks
+    connection->_pendingNacks.clear();
+    Nacks requests( nacks, nacks + i );
+    _sendNacks( connection, requests );
     return true;
 }
 
@@ -1601,7 +2153,7 @@ std::ostream& operator << ( std::ostream& os,
        << float( nBytesRead ) / mbps << " / " << float( nBytesWritten ) / mbps
        <<  " MB/s r/w using " << nDatagrams << " dgrams " << nRepeated
        << " repeats " << nMergedDatagrams
-       << " merged"
+       << " merged " << nRepairsSend << " repairs"
        << std::endl;
 
     os.precision( prec );
@@ -1609,7 +2161,8 @@ std::ostream& operator << ( std::ostream& os,
        << nAcksRead << " acks " << nNAcksRead << " nacks, throttle "
        << writeWaitTime << " ms"
        << std::endl
-       << "receiver: " << nAcksSend << " acks " << nNAcksSend << " nacks"
+       << "receiver: " << nAcksSend << " acks " << nNAcksSend << " nacks "
+       << nRecovered << "/" << nRepairsRead << " repairs used"
        << base::exdent;
 
     nReadData = 0;
@@ -1624,6 +2177,9 @@ std::ostream& operator << ( std::ostream& os,
     nAcksAccepted = 0;
     nNAcksSend = 0;
     nNAcksRead = 0;
+    nRepairsSend = 0;
+    nRepairsRead = 0;
+    nRecovered = 0;
     writeWaitTime = 0.f;
 #endif
     os << std::endl << base::enableHeader << base::enableFlush;
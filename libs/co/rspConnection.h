@@ -47,6 +47,12 @@ namespace co
      * This connection implements a reliable stream protocol (RSP) over IP V4
      * UDP multicast. The <a href="http://www.equalizergraphics.com/documents/design/multicast.html#RSP">RSP
      * design document</a> describes the high-level protocol.
+     *
+     * If ConnectionDescription::fecGroupSize is set, the writer sends
+     * ConnectionDescription::fecRepairs XOR parity datagrams for each group of
+     * data datagrams. Repair datagram i covers the datagrams i, i+fecRepairs,
+     * ... of the group, which allows the readers to reconstruct one lost
+     * datagram per repair datagram without a nack round trip.
      */
     class RSPConnection : public Connection
     {
@@ -115,7 +121,8 @@ namespace co
             ID_DENY,   //!< deny the id, already used
             ID_CONFIRM,//!< a new node is connected
             ID_EXIT,   //!< a node is disconnected
-            COUNTNODE  //!< send to other the number of nodes which I have found
+            COUNTNODE, //!< send to other the number of nodes which I have found
+            REPAIR     //!< the datagram contains FEC parity data
         };
         
         /** ID_HELLO, ID_DENY, ID_CONFIRM or ID_EXIT packet */
@@ -148,6 +155,16 @@ namespace co
             uint16_t end;
         };
 
+        typedef std::vector< Nack > Nacks;
+
+        /** A repeat request seen at the given time, for nack suppression */
+        struct NackRequest
+        {
+            Nack    nack;
+            int64_t time;
+        };
+        typedef std::deque< NackRequest > NackRequests;
+
 #       define EQ_RSP_MAX_NACKS 300 // fits in a single IP frame
         /** Request resend of lost packets */
         struct DatagramNack
@@ -185,6 +202,33 @@ namespace co
             uint16_t    sequence;
         };
 
+        /** FEC parity of a group of data datagrams */
+        struct DatagramRepair
+        {
+            uint16_t    type;
+            uint16_t    writerID;
+            uint16_t    start;     //!< sequence of the first group datagram
+            uint16_t    sizes;     //!< XOR of the covered datagram sizes
+            uint8_t     groupSize; //!< number of datagrams in a full group
+            uint8_t     nRepairs;  //!< number of repair datagrams per group
+            uint8_t     index;     //!< first covered datagram in the group
+            uint8_t     count;     //!< number of group datagrams sent so far
+        };
+
+#       define EQ_RSP_MAX_FEC_GROUP 64 // bitmask of received datagrams
+        /** Receive state of a FEC group */
+        struct RepairGroup
+        {
+            uint16_t start;                 //!< first sequence of the group
+            uint64_t received;              //!< received group datagrams
+            std::vector< uint8_t > parity;  //!< XOR of received, per index
+            std::vector< uint16_t > sizes;  //!< XOR of received sizes
+            std::vector< uint8_t > repair;  //!< writer's parity, per index
+            std::vector< uint16_t > repairSizes; //!< writer's size XOR
+            std::vector< uint8_t > repairCounts; //!< covered count or 0
+        };
+        typedef std::vector< RepairGroup* > RepairGroups;
+
         typedef std::vector< RSPConnectionPtr > RSPConnections;
         typedef RSPConnections::const_iterator RSPConnectionsCIter;
 
@@ -208,6 +252,7 @@ namespace co
         boost::asio::ip::udp::socket*  _read;
         boost::asio::ip::udp::socket*  _write;
         boost::asio::ip::udp::endpoint _readAddr;
+        boost::asio::ip::udp::endpoint _writeAddr; //!< own sender address
         boost::asio::deadline_timer    _timeout;
         boost::asio::deadline_timer    _wakeup;
         
@@ -241,6 +286,25 @@ namespace co
 
         typedef std::deque< Nack > RepeatQueue;
         RepeatQueue _repeatQueue; //!< nacks to repeat
+        uint16_t _lossSequence;   //!< first sequence sent after last slowdown
+
+        base::Clock _nackClock;   //!< time base for nack aggregation
+        Nacks _pendingNacks;      //!< missing datagrams, not yet requested
+        int64_t _nackTime;        //!< send time of the pending nacks
+        NackRequests _nacked;     //!< recent repeat requests of all readers
+
+        uint8_t _fecGroupSize;    //!< data datagrams per FEC group, or 0
+        uint8_t _fecRepairs;      //!< repair datagrams per FEC group
+        uint8_t _fecCount;        //!< datagrams in the current (write) group
+        uint8_t _fecSent;         //!< datagrams covered by the sent repairs
+        uint16_t _fecStart;       //!< first sequence of the current group
+        std::vector< uint8_t > _fecParity; //!< parity of the current group
+        std::vector< uint16_t > _fecSizes; //!< size XOR of the current group
+        std::vector< uint16_t > _fecMaxSizes; //!< max size per repair index
+
+        RepairGroups _repairGroups; //!< FEC groups with missing datagrams
+        RepairGroups _freeGroups;   //!< FEC groups for reuse
+        Buffer _fecBuffer;          //!< reconstructed datagram
 
         void _close();
         uint16_t _buildNewID();
@@ -272,6 +336,8 @@ namespace co
         void _handlePacket( const boost::system::error_code& error,
                             const size_t bytes );
         void _handleConnectedData( const void* data );
+        /** @return true if the received datagram is to be dropped. */
+        bool _drop();
         void _handleInitData( const void* data );
         void _handleAcceptIDData( const void* data );
 
@@ -292,6 +358,53 @@ namespace co
 
         void _addRepeat( const Nack* nacks, const uint16_t num );
 
+        /** Queue a nack to be sent, aggregated, after a random delay. */
+        void _queueNack( RSPConnectionPtr connection, const Nack& nack );
+
+        /**
+         * Send all pending nacks which are due.
+         * @return the time in ms until the next nacks are due, or -1.
+         */
+        int64_t _flushNacks();
+
+        /** Send the nacks not requested recently by any reader. */
+        void _sendNacks( RSPConnectionPtr connection, Nacks& nacks );
+
+        /** Remember recently requested repeats. */
+        void _addNacked( const Nack* nacks, const uint16_t num,
+                         const int64_t time );
+
+        /** Remove recently requested repeats from the given nacks. */
+        void _suppressNacks( Nacks& nacks, const int64_t time );
+
+        /** Remove the received datagrams from the given nacks. */
+        void _removeReceived( Nacks& nacks );
+
+        /** @return the number of datagrams in the FEC group. */
+        uint16_t _getGroupLength( const uint16_t start ) const;
+
+        /** Add a written datagram to the parity of the current group. */
+        void _addParity( const DatagramData* datagram );
+
+        /** Send the repair datagrams for the current group. */
+        void _sendRepairs();
+
+        bool _handleRepair( const DatagramRepair* repair );
+
+        /** Add a received datagram to the parity of its group. */
+        void _addReceived( const DatagramData* datagram );
+
+        /** @return the receive state of the group, 0 if not needed. */
+        RepairGroup* _getRepairGroup( const uint16_t start );
+
+        /** Release the groups of datagrams which were all received. */
+        void _releaseRepairGroups();
+
+        /** Reconstruct a lost datagram if all others of the repair are here. */
+        void _recover( RSPConnectionPtr connection, RepairGroup* group,
+                       const uint8_t index );
+        void _recover( const uint16_t writerID, const uint16_t sequence );
+
         /** format and send an simple request which use only type and id field*/
         void _sendSimpleDatagram( DatagramType type, uint16_t id );
         
@@ -22,6 +22,8 @@
 #include <co/dataOStream.h>   // used inline
 #include <co/dataIStream.h>   // used inline
 
+#include <cstring>            // used inline
+
 namespace co
 {
     /**
@@ -94,6 +96,18 @@ namespace co
 
         virtual ChangeType getChangeType() const { return DELTA; }
 
+        /**
+         * @return true if the deltas are last-writer-wins per dirty bit.
+         *
+         * If true, slave instances skip queued versions whose dirty bits are
+         * all changed again by a newer version applied during the same sync,
+         * that is, deserialize() is not called for superseded versions. Only
+         * return true if deserialize() for a dirty bit does not depend on
+         * previously received data.
+         * @version 1.1.5
+         */
+        virtual bool isLastWriterWins() const { return false; }
+
         /** 
          * The changed parts of the serializable since the last pack().
          *
@@ -152,6 +166,22 @@ namespace co
                 deserialize( is, dirty );
             }
 
+        virtual bool getDeltaDirty( co::DataIStream& is, uint64_t& dirty )
+            {
+                if( !isLastWriterWins( ))
+                    return false;
+
+                if( !is.hasData( ))
+                {
+                    dirty = DIRTY_NONE;
+                    return true;
+                }
+
+                EQASSERT( is.getRemainingBufferSize() >= sizeof( dirty ));
+                memcpy( &dirty, is.getRemainingBuffer(), sizeof( dirty ));
+                return true;
+            }
+
         /** The current dirty bits. */
         uint64_t _dirty;
 
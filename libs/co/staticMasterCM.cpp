@@ -35,14 +35,9 @@ StaticMasterCM::StaticMasterCM( Object* object )
 
 StaticMasterCM::~StaticMasterCM(){}
 
-void StaticMasterCM::addSlave( Command& command,
+void StaticMasterCM::addSlave( NodePtr node, const NodeMapObjectPacket* packet,
                                NodeMapObjectReplyPacket& reply )
 {
-    EQASSERT( command->type == PACKETTYPE_CO_NODE );
-    EQASSERT( command->command == CMD_NODE_MAP_OBJECT );
-
-    NodePtr node = command.getNode();
-    const NodeMapObjectPacket* packet = command.get< NodeMapObjectPacket >();
     const uint32_t instanceID = packet->instanceID;
     const uint128_t version = packet->requestedVersion;
     EQASSERT( version == VERSION_OLDEST || version == VERSION_FIRST ||
@@ -55,7 +55,8 @@ namespace co
         virtual bool isMaster() const { return true; }
         virtual uint32_t getMasterInstanceID() const
             { EQDONTCALL; return EQ_INSTANCE_INVALID; }
-        virtual void addSlave( Command& command,
+        virtual void addSlave( NodePtr node,
+                               const NodeMapObjectPacket* packet,
                                NodeMapObjectReplyPacket& reply );
         virtual void removeSlaves( NodePtr ) {}
 
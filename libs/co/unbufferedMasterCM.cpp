@@ -43,16 +43,11 @@ UnbufferedMasterCM::UnbufferedMasterCM( Object* object )
 UnbufferedMasterCM::~UnbufferedMasterCM()
 {}
 
-void UnbufferedMasterCM::addSlave( Command& command, 
+void UnbufferedMasterCM::addSlave( NodePtr node,
+                                   const NodeMapObjectPacket* packet,
                                    NodeMapObjectReplyPacket& reply )
 {
     EQ_TS_THREAD( _cmdThread );
-    EQASSERT( command->type == PACKETTYPE_CO_NODE );
-    EQASSERT( command->command == CMD_NODE_MAP_OBJECT );
-
-    NodePtr node = command.getNode();
-    const NodeMapObjectPacket* packet = 
-        command.get<const NodeMapObjectPacket>();
     const uint128_t version = packet->requestedVersion;
     const uint32_t instanceID = packet->instanceID;
 
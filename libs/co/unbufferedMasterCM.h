@@ -42,7 +42,8 @@ namespace co
         virtual uint32_t getAutoObsolete() const { return 0; }
         //@}
 
-        virtual void addSlave( Command& command, 
+        virtual void addSlave( NodePtr node,
+                               const NodeMapObjectPacket* packet,
                                NodeMapObjectReplyPacket& reply );
 
     private:
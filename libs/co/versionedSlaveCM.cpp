@@ -33,6 +33,7 @@ typedef CommandFunc< VersionedSlaveCM > CmdFunc;
 VersionedSlaveCM::VersionedSlaveCM( Object* object, uint32_t masterInstanceID )
         : ObjectCM( object )
         , _version( VERSION_NONE )
+        , _skippedVersions( 0 )
         , _currentIStream( 0 )
         , _masterInstanceID( masterInstanceID )
 #pragma warning(push)
@@ -99,8 +100,14 @@ uint128_t VersionedSlaveCM::sync( const uint128_t& v )
                   base::className( _object ) << " " << _object->getID() <<
                   " (" << _version << ", " << version <<")" );
 
-    while( _version < version )
-        _unpackOneVersion( _queuedVersions.pop( ));
+    ObjectDataIStreams streams;
+    uint128_t head = _version;
+    while( head < version )
+    {
+        streams.push_back( _queuedVersions.pop( ));
+        head = streams.back()->getVersion();
+    }
+    _unpackVersions( streams );
 
     LocalNodePtr node = _object->getLocalNode();
     if( node.isValid( ))
@@ -114,9 +121,11 @@ void VersionedSlaveCM::_syncToHead()
     if( _queuedVersions.isEmpty( ))
         return;
 
+    ObjectDataIStreams streams;
     ObjectDataIStream* is = 0;
     while( _queuedVersions.tryPop( is ))
-        _unpackOneVersion( is );
+        streams.push_back( is );
+    _unpackVersions( streams );
 
     LocalNodePtr localNode = _object->getLocalNode();
     if( localNode.isValid( ))
@@ -144,6 +153,43 @@ uint128_t VersionedSlaveCM::getHeadVersion() const
     return _version;    
 }
 
+void VersionedSlaveCM::_unpackVersions( const ObjectDataIStreams& streams )
+{
+    // Walk backwards: a delta is superseded if newer deltas change all of its
+    // dirty bits. Instance data or non-coalescable deltas stop the search.
+    std::vector< bool > skip( streams.size(), false );
+    uint64_t covered = 0;
+    for( size_t i = streams.size(); i > 0; --i )
+    {
+        ObjectDataIStream* is = streams[ i - 1 ];
+        uint64_t dirty = 0;
+        if( is->hasInstanceData() || !_object->getDeltaDirty( *is, dirty ))
+            break;
+
+        if( ( dirty & ~covered ) == 0 )
+            skip[ i - 1 ] = true;
+        else
+            covered |= dirty;
+    }
+
+    for( size_t i = 0; i < streams.size(); ++i )
+    {
+        ObjectDataIStream* is = streams[ i ];
+        if( !skip[ i ] )
+        {
+            _unpackOneVersion( is );
+            continue;
+        }
+
+        EQASSERTINFO( _version == is->getVersion() - 1, "Expected version "
+                      << _version + 1 << ", got " << is->getVersion()
+                      << " for " << *_object );
+        _version = is->getVersion();
+        ++_skippedVersions;
+        _releaseStream( is );
+    }
+}
+
 void VersionedSlaveCM::_unpackOneVersion( ObjectDataIStream* is )
 {
     EQASSERT( is );
@@ -178,29 +224,8 @@ void VersionedSlaveCM::applyMapData( const uint128_t& version )
     while( true )
     {
         ObjectDataIStream* is = _queuedVersions.pop();
-        if( is->getVersion() == version )
-        {
-            EQASSERTINFO( is->hasInstanceData(), *_object );
-
-            if( is->hasData( )) // not VERSION_NONE
-                _object->applyInstanceData( *is );
-            _version = is->getVersion();
-
-            EQASSERT( _version != VERSION_INVALID );
-            EQASSERTINFO( !is->hasData(),
-                          base::className( _object ) <<
-                          " did not unpack all data, " <<
-                          is->getRemainingBufferSize() << " bytes, " <<
-                          is->nRemainingBuffers() << " buffer(s)" );
-
-            _releaseStream( is );
-#if 0
-            EQLOG( LOG_OBJECTS ) << "Mapped initial data of " << _object
-                                 << std::endl;
-#endif
-            return;
-        }
-        else
+        if( is->getVersion() > version ||
+            ( _version == VERSION_NONE && !is->hasInstanceData( )))
         {
             // Found the following case:
             // - p1, t1 calls commit
@@ -214,6 +239,37 @@ void VersionedSlaveCM::applyMapData( const uint128_t& version )
             EQASSERTINFO( is->getVersion() > version,
                           is->getVersion() << " <= " << version );
             _releaseStream( is );
+            continue;
+        }
+
+        if( is->hasInstanceData( ))
+        {
+            if( is->hasData( )) // not VERSION_NONE
+                _object->applyInstanceData( *is );
+        }
+        else // delta following the last full version of a lazy version
+        {
+            EQASSERTINFO( is->getVersion() == _version + 1,
+                          is->getVersion() << " != " << _version << " + 1" );
+            _object->unpack( *is );
+        }
+        _version = is->getVersion();
+
+        EQASSERT( _version != VERSION_INVALID );
+        EQASSERTINFO( !is->hasData(),
+                      base::className( _object ) <<
+                      " did not unpack all data, " <<
+                      is->getRemainingBufferSize() << " bytes, " <<
+                      is->nRemainingBuffers() << " buffer(s)" );
+
+        _releaseStream( is );
+        if( _version == version )
+        {
+#if 0
+            EQLOG( LOG_OBJECTS ) << "Mapped initial data of " << _object
+                                 << std::endl;
+#endif
+            return;
         }
     }
 }
@@ -50,6 +50,8 @@ namespace co
 
         virtual uint128_t getHeadVersion() const;
         virtual uint128_t getVersion() const { return _version; }
+        virtual uint64_t getSkippedVersions() const
+            { return _skippedVersions; }
         //@}
 
         virtual bool isMaster() const { return false; }
@@ -67,6 +69,9 @@ namespace co
         /** The current version. */
         uint128_t _version;
 
+        /** The number of versions skipped by coalescing. */
+        uint64_t _skippedVersions;
+
         /** istream for receiving the current version */
         ObjectDataIStream* _currentIStream;
 
@@ -88,6 +93,9 @@ namespace co
         void _syncToHead();
         void _releaseStream( ObjectDataIStream* stream );
 
+        /** Apply the given consecutive versions, skipping superseded ones. */
+        void _unpackVersions( const ObjectDataIStreams& streams );
+
         /** Apply the data in the input stream to the object */
         virtual void _unpackOneVersion( ObjectDataIStream* is );
 
@@ -29,6 +29,7 @@
 #include "frameData.h"
 #include "global.h"
 #include "image.h"
+#include "imageHistory.h"
 #include "jitter.h"
 #include "log.h"
 #include "node.h"
@@ -49,6 +50,7 @@
 #include <co/connectionDescription.h>
 #include <co/exception.h>
 #include <co/queueSlave.h>
+#include <co/base/monitor.h>
 #include <co/base/rng.h>
 #include <co/base/scopedMutex.h>
 
@@ -75,6 +77,13 @@ Channel::~Channel()
 {  
     _statistics->clear();
     EQASSERT( !_fbo );
+
+    for( ImageHistories::const_iterator i = _imageHistories.begin();
+         i != _imageHistories.end(); ++i )
+    {
+        delete i->second;
+    }
+    _imageHistories.clear();
 }
 
 /** @cond IGNORE */
@@ -387,12 +396,17 @@ void Channel::frameReadback( const uint128_t& )
 
     Window::ObjectManager* glObjects = getObjectManager();
     const DrawableConfig& drawableConfig = getDrawableConfig();
+    const bool async = getIAttribute( IATTR_HINT_ASYNC_READBACK ) == ON &&
+                       getPipe()->isThreaded();
 
     const Frames& frames = getOutputFrames();
     for( Frames::const_iterator i = frames.begin(); i != frames.end(); ++i)
     {
         Frame* frame = *i;
-        frame->readback( glObjects, drawableConfig );
+        if( async )
+            frame->startReadback( glObjects, drawableConfig );
+        else
+            frame->readback( glObjects, drawableConfig );
     }
 
     EQ_GL_CALL( resetAssemblyState( ));
@@ -838,9 +852,12 @@ void Channel::drawStatistics()
                   case Statistic::WINDOW_FPS:
                     continue;
 
+                  case Statistic::CHANNEL_READBACK_ROI:
+                  case Statistic::CHANNEL_READBACK_FINISH:
                   case Statistic::CHANNEL_FRAME_TRANSMIT:
                   case Statistic::CHANNEL_FRAME_COMPRESS:
                   case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
+                  case Statistic::CHANNEL_FRAME_SEND:
                     entities[ id ].doubleHeight = true;
                     break;
                   default:
@@ -918,9 +935,12 @@ void Channel::drawStatistics()
                   case Statistic::WINDOW_FPS:
                     continue;
 
+                  case Statistic::CHANNEL_READBACK_ROI:
+                  case Statistic::CHANNEL_READBACK_FINISH:
                   case Statistic::CHANNEL_FRAME_TRANSMIT:
                   case Statistic::CHANNEL_FRAME_COMPRESS:
                   case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
+                  case Statistic::CHANNEL_FRAME_SEND:
                     y = data.yPos - (HEIGHT + SPACE);
                     break;
                 default:
@@ -940,6 +960,7 @@ void Channel::drawStatistics()
                 float y2 = static_cast< float >( y - HEIGHT );
                 const float x1 = static_cast< float >( startTime - xStart );
                 const float x2 = static_cast< float >( endTime   - xStart );
+                float xText = x1 + 1;
                 std::stringstream text;
                 
                 switch( stat.type )
@@ -951,6 +972,12 @@ void Channel::drawStatistics()
                     y2 += SPACE;
                     break;
 
+                  case Statistic::CHANNEL_READBACK_ROI:
+                    y1 -= SPACE;
+                    y2 += SPACE;
+                    text << unsigned( 100.f * stat.ratio ) << '%';
+                    break;
+
                   case Statistic::CHANNEL_FRAME_COMPRESS:
                     y1 -= SPACE;
                     y2 += SPACE;
@@ -961,6 +988,27 @@ void Channel::drawStatistics()
                         data.compressors.insert( stat.plugins[1] );
                     break;
 
+                  case Statistic::CHANNEL_FRAME_SEND: // overlaps compress
+                    y1 -= HEIGHT / 2;
+                    y2 += SPACE;
+                    break;
+
+                  case Statistic::CHANNEL_FRAME_TRANSMIT:
+                    if( stat.ratio > 0.f ) // overlap of pipelined transmit
+                    {
+                        text << unsigned( 100.f * stat.ratio ) << '%';
+                        xText = x2 + 1;
+                    }
+                    break;
+
+                  case Statistic::CHANNEL_READBACK_FINISH:
+                    if( stat.ratio > 0.f ) // overlap of async readback
+                    {
+                        text << unsigned( 100.f * stat.ratio ) << '%';
+                        xText = x2 + 1;
+                    }
+                    break;
+
                   case Statistic::CHANNEL_READBACK:
                     text << unsigned( 100.f * stat.ratio ) << '%';
                     if( stat.plugins[ 0 ]  > EQ_COMPRESSOR_NONE )
@@ -986,7 +1034,7 @@ void Channel::drawStatistics()
                 if( !text.str().empty( ))
                 {
                     glColor3f( 1.f, 1.f, 1.f );
-                    glRasterPos3f( x1+1, y2, 0.f );
+                    glRasterPos3f( xText, y2, 0.f );
                     font->draw( text.str( ));
                 }
             }
@@ -1172,14 +1220,88 @@ void Channel::_unrefFrame( const uint32_t frameNumber, const uint32_t index )
     stats.data.clear();
 }
 
+namespace
+{
+/** The keyframe interval of temporal compression if the hint is ON. */
+static const uint32_t _keyframeInterval = 60;
+
+/** The progress of one output frame transmission. */
+struct TransmitState
+{
+    TransmitState() : nSent( 0 ), sendTime( 0 ) {}
+
+    co::base::Monitor< uint32_t > nSent; //!< number of images sent
+    int64_t sendTime; //!< accumulated send time, set before nSent
+};
+
+/** Sends one gathered output image, from the transmit sender if pipelined. */
+class ImageSendTask : public Node::TransmitSender::Task
+{
+public:
+    ImageSendTask( Channel* channel, const ChannelFrameTransmitPacket* command,
+                   co::NodePtr toNode, const bool useSendToken,
+                   TransmitState& state )
+            : _channel( channel )
+            , _statisticsIndex( command->statisticsIndex )
+            , _taskID( command->context.taskID )
+            , _toNode( toNode )
+            , _useSendToken( useSendToken )
+            , _state( state )
+        {}
+
+    virtual void send()
+        {
+            co::LocalNodePtr localNode = _channel->getLocalNode();
+            co::LocalNode::SendToken token;
+            if( _useSendToken )
+            {
+                ChannelStatistics waitEvent(
+                    Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN, _channel );
+                waitEvent.statisticsIndex = _statisticsIndex;
+                waitEvent.event.data.statistic.task = _taskID;
+                token = localNode->acquireSendToken( _toNode );
+            }
+
+            const int64_t startTime = _channel->getConfig()->getTime();
+            {
+                ChannelStatistics sendEvent( Statistic::CHANNEL_FRAME_SEND,
+                                             _channel );
+                sendEvent.statisticsIndex = _statisticsIndex;
+                sendEvent.event.data.statistic.task = _taskID;
+
+                co::ConnectionPtr connection = _toNode->getConnection();
+                connection->send( &buffers.front(), buffers.size( ));
+            }
+            localNode->releaseSendToken( token );
+
+            _state.sendTime += _channel->getConfig()->getTime() - startTime;
+            ++_state.nSent;
+        }
+
+    NodeFrameDataTransmitPacket packet;
+    std::vector< FrameData::ImageHeader > headers;
+    std::vector< uint64_t > chunkSizes; // buffers point into it, no realloc
+    std::vector< co::iovec > buffers;
+
+private:
+    Channel* const _channel;
+    const uint32_t _statisticsIndex;
+    const uint32_t _taskID;
+    co::NodePtr _toNode;
+    const bool _useSendToken;
+    TransmitState& _state;
+};
+}
+
 void Channel::_transmit( const ChannelFrameTransmitPacket* command )
 {
+    FrameData* frameData = getNode()->getFrameData( command->frameData ); 
+    EQASSERT( frameData );
+
     ChannelStatistics transmitEvent( Statistic::CHANNEL_FRAME_TRANSMIT, this );
     transmitEvent.statisticsIndex = command->statisticsIndex;
     transmitEvent.event.data.statistic.task = command->context.taskID;
-
-    FrameData* frameData = getNode()->getFrameData( command->frameData ); 
-    EQASSERT( frameData );
+    transmitEvent.event.data.statistic.ratio = 0.f;
 
     if( frameData->getBuffers() == 0 )
     {
@@ -1202,13 +1324,33 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
     // use compression on links up to 2 GBit/s
     const bool useCompression = ( description->bandwidth <= 262144 );
     const bool useSendToken = getIAttribute( IATTR_HINT_SENDTOKEN ) == ON;
+    // compress the next image while the sender thread sends the current one
+    const bool usePipeline = getIAttribute( IATTR_HINT_TRANSMIT_PIPELINE )==ON;
+    Node::TransmitSender& sender = getNode()->transmitSender;
+
+    // send images as difference to the images sent for the last frame
+    const int32_t temporal = getIAttribute( IATTR_HINT_TEMPORAL_COMPRESSION );
+    ImageHistory* history = 0;
+    bool keyframe = true;
+    if( useCompression && temporal > OFF )
+    {
+        const FrameDataNode key( frameData->getID(), command->netNodeID );
+        ImageHistory*& entry = _imageHistories[ key ];
+        if( !entry )
+            entry = new ImageHistory;
+
+        history = entry;
+        keyframe = history->startFrame( temporal == ON ? _keyframeInterval :
+                                                         uint32_t( temporal ));
+    }
 
-    NodeFrameDataTransmitPacket packet;
-    const uint64_t packetSize = sizeof( packet ) - 8 * sizeof( uint8_t );
-
-    packet.objectID    = command->clientNodeID;
-    packet.frameData   = frameData;
-    packet.frameNumber = command->frameNumber;
+    const uint64_t packetSize = sizeof( NodeFrameDataTransmitPacket ) -
+                                8 * sizeof( uint8_t );
+    const int64_t startTime = getConfig()->getTime();
+    int64_t compressTime = 0;
+    TransmitState state;
+    uint32_t nQueued = 0;
+    bool error = false;
 
     const Images& images = frameData->getImages();
     // send all images
@@ -1219,12 +1361,20 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
         {
             EQWARN << "Can't transmit image of type TEXTURE" << std::endl;
             EQUNIMPLEMENTED;
-            return;
+            error = true;
+            break;
         }
 
+        ImageSendTask* task = new ImageSendTask( this, command, toNode,
+                                                 useSendToken, state );
+        NodeFrameDataTransmitPacket& packet = task->packet;
         std::vector< const PixelData* > pixelDatas;
         std::vector< float > qualities;
+        std::vector< uint32_t > modes;
 
+        packet.objectID    = command->clientNodeID;
+        packet.frameData   = frameData;
+        packet.frameNumber = command->frameNumber;
         packet.size = packetSize;
         packet.buffers = Frame::BUFFER_NONE;
         packet.pvp = image->getPixelViewport();
@@ -1232,6 +1382,7 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
         EQASSERT( packet.pvp.isValid( ));
 
         {
+            const int64_t compressStart = getConfig()->getTime();
             uint64_t rawSize( 0 );
             ChannelStatistics compressEvent( Statistic::CHANNEL_FRAME_COMPRESS, 
                                              this );
@@ -1256,11 +1407,17 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
                     // format, type, nChunks, compressor name
                     packet.size += sizeof( FrameData::ImageHeader ); 
 
-                    const PixelData& data = useCompression ?
-                        image->compressPixelData( buffer ) : 
-                        image->getPixelData( buffer );
+                    // lossy compression would accumulate errors in deltas
+                    const float quality = image->getQuality( buffer );
+                    ImageHistory::Mode mode = ImageHistory::MODE_NONE;
+                    const PixelData& data = ( history && quality == 1.f ) ?
+                        history->compress( nQueued, image, buffer, keyframe,
+                                           mode ) :
+                        useCompression ? image->compressPixelData( buffer ) :
+                                         image->getPixelData( buffer );
                     pixelDatas.push_back( &data );
-                    qualities.push_back( image->getQuality( buffer ));
+                    qualities.push_back( quality );
+                    modes.push_back( mode );
 
                     if( data.isCompressed )
                     {
@@ -1289,29 +1446,39 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
                 compressEvent.event.data.statistic.ratio =
                     static_cast< float >( packet.size ) /
                     static_cast< float >( rawSize );
+            if( useCompression )
+                compressTime += getConfig()->getTime() - compressStart;
         }
 
         if( pixelDatas.empty( ))
+        {
+            delete task;
             continue;
+        }
 
-        // send image pixel data packet
-        co::LocalNode::SendToken token;
-        if( useSendToken )
+        // gather packet, image headers, chunk sizes and chunk data
+        const size_t nImages = pixelDatas.size();
+        size_t nChunks = 0;
+        for( uint32_t j=0; j < nImages; ++j )
         {
-            ChannelStatistics waitEvent(Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN,
-                                        this );
-            waitEvent.statisticsIndex = command->statisticsIndex;
-            waitEvent.event.data.statistic.task = command->context.taskID;
-            token = getLocalNode()->acquireSendToken( toNode );
+            const PixelData* data = pixelDatas[j];
+            nChunks += data->isCompressed ? data->compressedSize.size() : 1;
         }
 
-        connection->lockSend();
-        connection->send( &packet, packetSize, true );
+        std::vector< FrameData::ImageHeader >& headers = task->headers;
+        std::vector< uint64_t >& chunkSizes = task->chunkSizes;
+        std::vector< co::iovec >& buffers = task->buffers;
+        headers.resize( nImages );
+        chunkSizes.reserve( nChunks ); // no realloc, buffers point into it
+        buffers.reserve( 1 + nImages + 2 * nChunks );
+
+        const co::iovec packetBuffer = { &packet, size_t( packetSize ) };
+        buffers.push_back( packetBuffer );
 #ifndef NDEBUG
         size_t sentBytes = packetSize;
 #endif
 
-        for( uint32_t j=0; j < pixelDatas.size(); ++j )
+        for( uint32_t j=0; j < nImages; ++j )
         {
 #ifndef NDEBUG
             sentBytes += sizeof( FrameData::ImageHeader );
@@ -1323,32 +1490,40 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
                     useCompression ? data->compressorName : EQ_COMPRESSOR_NONE,
                     data->compressorFlags, 
                     data->isCompressed ? uint32_t(data->compressedSize.size()):1,
-                    qualities[ j ] };
+                    qualities[ j ], modes[ j ] };
+            headers[j] = header;
+
+            const co::iovec headerBuffer = { &headers[j],
+                                             sizeof( FrameData::ImageHeader ) };
+            buffers.push_back( headerBuffer );
 
-            connection->send( &header, sizeof( FrameData::ImageHeader ), true );
-            
             if( data->isCompressed )
             {
                 for( uint32_t k = 0 ; k < data->compressedSize.size(); ++k )
                 {
-                    const uint64_t dataSize = data->compressedSize[k];
-                    connection->send( &dataSize, sizeof( dataSize ), true );
-                    if( dataSize > 0 )
-                        connection->send( data->compressedData[k], 
-                                          dataSize, true );
+                    chunkSizes.push_back( data->compressedSize[k] );
+                    const co::iovec sizeBuffer = { &chunkSizes.back(),
+                                                   sizeof( uint64_t ) };
+                    const co::iovec dataBuffer = { data->compressedData[k], 
+                                            size_t( chunkSizes.back( )) };
+                    buffers.push_back( sizeBuffer );
+                    buffers.push_back( dataBuffer );
 #ifndef NDEBUG
-                    sentBytes += sizeof( dataSize ) + dataSize;
+                    sentBytes += sizeof( uint64_t ) + chunkSizes.back();
 #endif
                 }
             }
             else
             {
-                const uint64_t dataSize = data->pvp.getArea() * 
-                                          data->pixelSize;
-                connection->send( &dataSize, sizeof( dataSize ), true );
-                connection->send( data->pixels, dataSize, true );
+                chunkSizes.push_back( data->pvp.getArea() * data->pixelSize );
+                const co::iovec sizeBuffer = { &chunkSizes.back(),
+                                               sizeof( uint64_t ) };
+                const co::iovec dataBuffer = { data->pixels, 
+                                               size_t( chunkSizes.back( )) };
+                buffers.push_back( sizeBuffer );
+                buffers.push_back( dataBuffer );
 #ifndef NDEBUG
-                sentBytes += sizeof( dataSize ) + dataSize;
+                sentBytes += sizeof( uint64_t ) + chunkSizes.back();
 #endif
             }
         }
@@ -1357,10 +1532,30 @@ void Channel::_transmit( const ChannelFrameTransmitPacket* command )
                       sentBytes << " != " << packet.size );
 #endif
 
-        connection->unlockSend();
-        getLocalNode()->releaseSendToken( token );
+        // send image pixel data packet with as few writes as possible
+        ++nQueued;
+        if( usePipeline )
+            sender.push( task );
+        else
+        {
+            task->send();
+            delete task;
+        }
     }
 
+    // images and statistics have to stay valid until all images are sent
+    state.nSent.waitEQ( nQueued );
+    if( error )
+        return;
+
+    // overlap: time compression and sending happened in parallel
+    const int64_t transmitTime = getConfig()->getTime() - startTime;
+    const int64_t overlapTime = compressTime + state.sendTime - transmitTime;
+    if( overlapTime > 0 && transmitTime > 0 )
+        transmitEvent.event.data.statistic.ratio =
+            static_cast< float >( overlapTime ) /
+            static_cast< float >( transmitTime );
+
     // all data transmitted -> ready
     NodeFrameDataReadyPacket readyPacket( frameData );
     readyPacket.objectID = command->clientNodeID;
@@ -1419,6 +1614,7 @@ bool Channel::_cmdConfigExit( co::Command& command )
         command.get<ChannelConfigExitPacket>();
     EQLOG( LOG_INIT ) << "Exit channel " << packet << std::endl;
 
+    finishReadbacks();
     if( _state != STATE_STOPPED )
         _state = configExit() ? STATE_STOPPED : STATE_FAILED;
 
@@ -1456,6 +1652,7 @@ bool Channel::_cmdFrameFinish( co::Command& command )
     EQLOG( LOG_TASKS ) << "TASK frame finish " << getName() <<  " " << packet
                        << std::endl;
 
+    finishReadbacks();
     overrideContext( packet->context );
     frameFinish( packet->context.frameID, packet->frameNumber );
     resetRenderContext();
@@ -1516,6 +1713,7 @@ bool Channel::_cmdFrameAssemble( co::Command& command )
     EQLOG( LOG_TASKS | LOG_ASSEMBLY ) << "TASK assemble " << getName() <<  " " 
                                        << packet << std::endl;
 
+    getPipe()->finishReadbacks(); // input frames may be local output frames
     _setRenderContext( packet->context );
     ChannelStatistics event( Statistic::CHANNEL_ASSEMBLE, this );
 
@@ -1551,33 +1749,80 @@ bool Channel::_cmdFrameReadback( co::Command& command )
     _setRenderContext( packet->context );
     ChannelStatistics event( Statistic::CHANNEL_READBACK, this );
 
+    const bool useROI = getIAttribute( IATTR_HINT_ROI ) == ON;
     for( uint32_t i=0; i<packet->nFrames; ++i )
     {
         Pipe*  pipe  = getPipe();
         Frame* frame = pipe->getFrame( packet->frames[i], getEye(), true );
+        frame->getData()->setROIUsage( useROI );
         _outputFrames.push_back( frame );
     }
 
     frameReadback( packet->context.frameID );
 
+    ReadbackDatas datas;
+    PendingReadback pending;
+    for( Frames::const_iterator i = _outputFrames.begin(); 
+         i != _outputFrames.end(); ++i)
+    {
+        Frame* frame = *i;
+        ReadbackData data;
+        data.frameData = frame->getData();
+        data.hasROI = useROI && frame->getZoom() == Zoom::NONE &&
+                      ( frame->getBuffers() & Frame::BUFFER_DEPTH );
+
+        if( data.frameData->hasPendingReadback( ))
+            pending.datas.push_back( data ); // set ready by finishReadbacks
+        else
+        {
+            frame->setReady();
+            datas.push_back( data );
+        }
+    }
+
+    _setReadbackStatistics( datas, event );
+
+    if( !pending.datas.empty( ))
+    {
+        pending.frameNumber = getPipe()->getCurrentFrame();
+        pending.statisticsIndex = _statisticsIndex;
+        pending.taskID = getTaskID();
+        pending.startTime = event.event.data.statistic.startTime;
+        pending.endTime = getConfig()->getTime();
+        ++_statistics.data[ pending.statisticsIndex ].used;
+        _pendingReadbacks.push_back( pending );
+    }
+
+    _outputFrames.clear();
+    resetRenderContext();
+    return true;
+}
+
+void Channel::_setReadbackStatistics( const ReadbackDatas& datas,
+                                      ChannelStatistics& event )
+{
     size_t in = 0;
     size_t out = 0;
+    size_t framePixels = 0; // pixels of depth frames before ROI
+    size_t roiPixels = 0;   // pixels of depth frames after ROI
     const DrawableConfig& dc = getDrawableConfig();
     const size_t colorBytes = ( 3 * dc.colorBits + dc.alphaBits ) / 8;
 
     event.event.data.statistic.plugins[0] = EQ_COMPRESSOR_NONE;
     event.event.data.statistic.plugins[1] = EQ_COMPRESSOR_NONE;
 
-    for( Frames::const_iterator i = _outputFrames.begin(); 
-         i != _outputFrames.end(); ++i)
+    for( ReadbackDatas::const_iterator i = datas.begin(); i != datas.end(); ++i)
     {
-        Frame* frame = *i;
-        frame->setReady();
+        const ReadbackData& data = *i;
+        if( data.hasROI )
+            framePixels += data.frameData->getPixelViewport().getArea();
 
-        const Images& images = frame->getImages();
+        const Images& images = data.frameData->getImages();
         for( Images::const_iterator j = images.begin(); j != images.end(); ++j )
         {
             const Image* image = *j;
+            if( data.hasROI )
+                roiPixels += image->getPixelViewport().getArea();
             if( image->hasPixelData( Frame::BUFFER_COLOR ))
             {
                 in += colorBytes * image->getPixelViewport().getArea();
@@ -1600,9 +1845,71 @@ bool Channel::_cmdFrameReadback( co::Command& command )
     else
         event.event.data.statistic.ratio = 1.0f;
 
-    _outputFrames.clear();
-    resetRenderContext();
-    return true;
+    if( framePixels > roiPixels )
+    {
+        EQLOG( LOG_ASSEMBLY )
+            << "ROI saved " << framePixels - roiPixels << " of " << framePixels
+            << " pixels, " << ( framePixels - roiPixels ) * ( colorBytes + 4 )
+            << " bytes" << std::endl;
+
+        ChannelStatistics roiEvent( Statistic::CHANNEL_READBACK_ROI, this );
+        roiEvent.statisticsIndex = event.statisticsIndex;
+        roiEvent.event.data.statistic.frameNumber =
+            event.event.data.statistic.frameNumber;
+        roiEvent.event.data.statistic.task = event.event.data.statistic.task;
+        roiEvent.event.data.statistic.startTime =
+            event.event.data.statistic.startTime;
+        roiEvent.event.data.statistic.ratio = float( roiPixels ) /
+                                              float( framePixels );
+    }
+}
+
+void Channel::finishReadbacks()
+{
+    if( _pendingReadbacks.empty( ))
+        return;
+
+    getWindow()->makeCurrent();
+    Window::ObjectManager* glObjects = getObjectManager();
+    const DrawableConfig& drawableConfig = getDrawableConfig();
+
+    PendingReadbacks pendingReadbacks;
+    pendingReadbacks.swap( _pendingReadbacks );
+    for( PendingReadbacks::const_iterator i = pendingReadbacks.begin();
+         i != pendingReadbacks.end(); ++i )
+    {
+        const PendingReadback& pending = *i;
+        {
+            ChannelStatistics event( Statistic::CHANNEL_READBACK_FINISH, this);
+            event.statisticsIndex = pending.statisticsIndex;
+            event.event.data.statistic.frameNumber = pending.frameNumber;
+            event.event.data.statistic.task = pending.taskID;
+            const int64_t startTime = event.event.data.statistic.startTime;
+
+            for( ReadbackDatas::const_iterator j = pending.datas.begin();
+                 j != pending.datas.end(); ++j )
+            {
+                j->frameData->finishReadback( glObjects, drawableConfig );
+            }
+
+            _setReadbackStatistics( pending.datas, event );
+            // fraction of the transfer overlapped with other pipe operations
+            const int64_t endTime = getConfig()->getTime();
+            const int64_t total = endTime - pending.startTime;
+            const int64_t overlap = startTime - pending.endTime;
+            event.event.data.statistic.ratio = total > 0 && overlap > 0 ?
+                float( overlap ) / float( total ) : 0.f;
+        }
+
+        for( co::Commands::const_iterator j = pending.transmits.begin();
+             j != pending.transmits.end(); ++j )
+        {
+            co::Command* command = *j;
+            dispatchCommand( *command );
+            command->release();
+        }
+        _unrefFrame( pending.frameNumber, pending.statisticsIndex );
+    }
 }
 
 bool Channel::_cmdFrameTransmit( co::Command& command )
@@ -1617,6 +1924,29 @@ bool Channel::_cmdFrameTransmit( co::Command& command )
     packet->command = fabric::CMD_CHANNEL_FRAME_TRANSMIT_ASYNC;
     packet->statisticsIndex = _statisticsIndex;
     packet->frameNumber = getPipe()->getCurrentFrame();
+
+    // queue the transmission of an asynchronous readback until it is finished
+    FrameData* frameData = getNode()->getFrameData( packet->frameData );
+    if( frameData->hasPendingReadback( ))
+    {
+        for( PendingReadbacks::iterator i = _pendingReadbacks.begin();
+             i != _pendingReadbacks.end(); ++i )
+        {
+            PendingReadback& pending = *i;
+            for( ReadbackDatas::const_iterator j = pending.datas.begin();
+                 j != pending.datas.end(); ++j )
+            {
+                if( j->frameData != frameData )
+                    continue;
+
+                command.retain(); // released by finishReadbacks
+                pending.transmits.push_back( &command );
+                return true;
+            }
+        }
+        getPipe()->finishReadbacks(); // read back by another channel
+    }
+
     dispatchCommand( command );
     return true;
 }
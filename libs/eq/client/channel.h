@@ -26,8 +26,12 @@
 #include <eq/fabric/channel.h>        // base class
 #include <eq/fabric/drawableConfig.h> // member
 
+#include <map>
+
 namespace eq
 {
+    class ChannelStatistics;
+    class ImageHistory;
     struct ChannelFrameTransmitPacket;
 
     /**
@@ -308,6 +312,15 @@ namespace eq
           */
         void changeLatency( const uint32_t latency );
 
+        /**
+         * @internal
+         * Finish all readbacks started asynchronously by frameReadback().
+         *
+         * Makes the window current, finishes the downloads, sets the output
+         * frames ready and dispatches the transmit tasks waiting for them.
+         */
+        void finishReadbacks();
+
         /** @return a fixed unique color for this channel. @version 1.0 */
         const Vector3ub& getUniqueColor() const { return _color; }
 
@@ -553,6 +566,35 @@ namespace eq
         /** The initial channel size, used for view resize events. */
         Vector2i _initialSize;
 
+        typedef std::pair< uint128_t, uint128_t > FrameDataNode;
+        typedef std::map< FrameDataNode, ImageHistory* > ImageHistories;
+        /** Sent images for temporal compression, by frame data and node. */
+        ImageHistories _imageHistories;
+
+        /** An output frame data with a started asynchronous readback. */
+        struct ReadbackData
+        {
+            FrameData* frameData;
+            bool hasROI; //!< the ROI statistics apply
+        };
+        typedef std::vector< ReadbackData > ReadbackDatas;
+
+        /** The output frames of one asynchronous readback task. */
+        struct PendingReadback
+        {
+            ReadbackDatas datas;
+            co::Commands transmits; //!< transmit tasks waiting for the datas
+            uint32_t frameNumber;
+            uint32_t statisticsIndex;
+            uint32_t taskID;
+            int64_t startTime; //!< begin of the readback task
+            int64_t endTime;   //!< end of the readback task
+        };
+        typedef std::vector< PendingReadback > PendingReadbacks;
+
+        /** Readbacks to be finished by finishReadbacks(). */
+        PendingReadbacks _pendingReadbacks;
+
         struct Private;
         Private* _private; // placeholder for binary-compatible changes
 
@@ -569,6 +611,10 @@ namespace eq
         /** Check for and send frame finish reply. */
         void _unrefFrame( const uint32_t frameNumber, const uint32_t index );
 
+        /** Set the readback ratio and emit the ROI statistics. */
+        void _setReadbackStatistics( const ReadbackDatas& datas,
+                                     ChannelStatistics& event );
+
         /** Transmit the frame data to the nodeID. */
         void _transmit( const ChannelFrameTransmitPacket* packet );
 
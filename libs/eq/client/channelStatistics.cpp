@@ -55,7 +55,8 @@ ChannelStatistics::ChannelStatistics( const Statistic::Type type,
     if( _hint == NICEST &&
         type != Statistic::CHANNEL_FRAME_TRANSMIT &&
         type != Statistic::CHANNEL_FRAME_COMPRESS &&
-        type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN )
+        type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN &&
+        type != Statistic::CHANNEL_FRAME_SEND )
     {
         channel->getWindow()->finish();
     }
@@ -73,7 +74,8 @@ ChannelStatistics::~ChannelStatistics()
     if( _hint == NICEST &&
         type != Statistic::CHANNEL_FRAME_TRANSMIT &&
         type != Statistic::CHANNEL_FRAME_COMPRESS &&
-        type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN )
+        type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN &&
+        type != Statistic::CHANNEL_FRAME_SEND )
     {
         _owner->getWindow()->finish();
     }
@@ -47,6 +47,15 @@
 #  include <pcapi.h>
 #endif
 
+#if defined( __GNUC__ ) && defined( __SSE2__ )
+#  include <immintrin.h>
+#  define EQ_COMPOSITOR_SSE2
+#  if defined( __clang__ ) || __GNUC__ > 4 || \
+      ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 )
+#    define EQ_COMPOSITOR_AVX2
+#  endif
+#endif
+
 #ifdef _WIN32
 #  define bzero( ptr, size ) { memset( ptr, 0, size ); }
 #endif
@@ -69,6 +78,669 @@ static const char* depthDBKey  = shaderDBKey + 2;
 // Image used for CPU-based assembly
 static co::base::PerThread< Image > _resultImage;
 
+// Row kernels for CPU-based assembly. Each kernel merges n source pixels into
+// the destination row. The SIMD versions produce the same results as the
+// scalar versions, which also process the remainder of each row.
+
+// Depth-sorted merge of W 32-bit color words per pixel
+template< size_t W >
+void _mergeDBRow( uint32_t* destColor, uint32_t* destDepth,
+                  const uint32_t* color, const uint32_t* depth,
+                  const int32_t n )
+{
+    for( int32_t x = 0; x < n; ++x )
+    {
+        if( destDepth[x] > depth[x] )
+        {
+            destDepth[x] = depth[x];
+            for( size_t i = 0; i < W; ++i )
+                destColor[ x * W + i ] = color[ x * W + i ];
+        }
+    }
+}
+
+// Blending of two slices, none of which is on final image (i.e. result
+// could be blended on to something else) should be performed with:
+// glBlendFuncSeparate( GL_ONE, GL_SRC_ALPHA, GL_ZERO, GL_SRC_ALPHA )
+// which means:
+// dstColor = 1*srcColor + srcAlpha*dstColor
+// dstAlpha = 0*srcAlpha + srcAlpha*dstAlpha
+// because we accumulate light which is go through (= 1-Alpha) and we
+// already have colors as Alpha*Color
+static void _blendRGBA8Row( void* dest, const void* source, const int32_t n )
+{
+    uint8_t* dst = reinterpret_cast< uint8_t* >( dest );
+    const uint8_t* src = reinterpret_cast< const uint8_t* >( source );
+
+    for( int32_t x = 0; x < n; ++x )
+    {
+        dst[0] = EQ_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
+        dst[1] = EQ_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
+        dst[2] = EQ_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
+        dst[3] =                   src[3]*dst[3] >> 8;
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+static void _blendRGBA32FRow( void* dest, const void* source, const int32_t n )
+{
+    float* dst = reinterpret_cast< float* >( dest );
+    const float* src = reinterpret_cast< const float* >( source );
+
+    for( int32_t x = 0; x < n; ++x )
+    {
+        const float alpha = src[3];
+        dst[0] = src[0] + alpha * dst[0];
+        dst[1] = src[1] + alpha * dst[1];
+        dst[2] = src[2] + alpha * dst[2];
+        dst[3] =          alpha * dst[3];
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+static float _halfToFloat( const uint16_t value )
+{
+    const uint32_t sign = uint32_t( value & 0x8000u ) << 16;
+    int32_t exponent = ( value >> 10 ) & 0x1f;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits = sign;
+
+    if( exponent == 0x1f ) // inf, nan
+        bits |= 0x7f800000u | ( mantissa << 13 );
+    else if( exponent != 0 )
+        bits |= uint32_t( exponent + 112 ) << 23 | ( mantissa << 13 );
+    else if( mantissa != 0 ) // denormal
+    {
+        exponent = 113;
+        while( !( mantissa & 0x400u ))
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits |= uint32_t( exponent ) << 23 | (( mantissa & 0x3ffu ) << 13 );
+    }
+
+    float result;
+    memcpy( &result, &bits, sizeof( float ));
+    return result;
+}
+
+// rounds to nearest even, as the F16C conversion used by the SIMD kernel
+static uint16_t _floatToHalf( const float value )
+{
+    uint32_t bits;
+    memcpy( &bits, &value, sizeof( float ));
+
+    const uint16_t sign = uint16_t( bits >> 16 ) & 0x8000u;
+    const int32_t exponent = int32_t(( bits >> 23 ) & 0xff ) - 112;
+    uint32_t mantissa = bits & 0x7fffffu;
+
+    if( exponent == 0xff - 112 ) // inf, nan
+        return sign | 0x7c00u | ( mantissa ? 0x200u | ( mantissa >> 13 ) : 0 );
+    if( exponent >= 0x1f ) // overflow
+        return sign | 0x7c00u;
+
+    uint32_t shift = 13;
+    uint32_t half = uint32_t( exponent ) << 10;
+    if( exponent <= 0 ) // denormal
+    {
+        if( exponent < -10 )
+            return sign;
+        mantissa |= 0x800000u;
+        shift = 14 - exponent;
+        half = 0;
+    }
+
+    half |= mantissa >> shift;
+    const uint32_t rest = mantissa & (( 1u << shift ) - 1 );
+    const uint32_t halfway = 1u << ( shift - 1 );
+    if( rest > halfway || ( rest == halfway && ( half & 1 )))
+        ++half; // may carry into the exponent, up to inf
+    return sign | uint16_t( half );
+}
+
+static void _blendRGBA16FRow( void* dest, const void* source, const int32_t n )
+{
+    uint16_t* dst = reinterpret_cast< uint16_t* >( dest );
+    const uint16_t* src = reinterpret_cast< const uint16_t* >( source );
+
+    for( int32_t x = 0; x < n; ++x )
+    {
+        const float alpha = _halfToFloat( src[3] );
+        for( size_t i = 0; i < 3; ++i )
+            dst[i] = _floatToHalf( _halfToFloat( src[i] ) +
+                                   alpha * _halfToFloat( dst[i] ));
+        dst[3] = _floatToHalf( alpha * _halfToFloat( dst[3] ));
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+#ifdef EQ_COMPOSITOR_SSE2
+static inline __m128i _select( const __m128i mask, const __m128i a,
+                               const __m128i b )
+{
+    return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ));
+}
+
+// spread the depth test result of four pixels over the i-th color vector
+template< size_t W > __m128i _spreadSSE2( const __m128i mask, const size_t i );
+
+template<> inline __m128i _spreadSSE2< 1 >( const __m128i mask, const size_t )
+{
+    return mask;
+}
+
+template<> inline __m128i _spreadSSE2< 2 >( const __m128i mask, const size_t i )
+{
+    return i == 0 ? _mm_unpacklo_epi32( mask, mask ) :
+                    _mm_unpackhi_epi32( mask, mask );
+}
+
+template<> inline __m128i _spreadSSE2< 4 >( const __m128i mask, const size_t i )
+{
+    switch( i )
+    {
+        case 0:  return _mm_shuffle_epi32( mask, 0x00 );
+        case 1:  return _mm_shuffle_epi32( mask, 0x55 );
+        case 2:  return _mm_shuffle_epi32( mask, 0xaa );
+        default: return _mm_shuffle_epi32( mask, 0xff );
+    }
+}
+
+template< size_t W >
+void _mergeDBRowSSE2( uint32_t* destColor, uint32_t* destDepth,
+                      const uint32_t* color, const uint32_t* depth,
+                      const int32_t n )
+{
+    // SSE2 has no unsigned compare, flip the sign bits for a signed compare
+    const __m128i sign = _mm_set1_epi32( int( 0x80000000u ));
+
+    int32_t x = 0;
+    for( ; x + 4 <= n; x += 4 )
+    {
+        __m128i* destDepthIt = reinterpret_cast< __m128i* >( destDepth + x );
+        const __m128i dst = _mm_loadu_si128( destDepthIt );
+        const __m128i src = _mm_loadu_si128(
+                              reinterpret_cast< const __m128i* >( depth + x ));
+        const __m128i closer = _mm_cmpgt_epi32( _mm_xor_si128( dst, sign ),
+                                                _mm_xor_si128( src, sign ));
+        if( _mm_movemask_epi8( closer ) == 0 )
+            continue;
+
+        _mm_storeu_si128( destDepthIt, _select( closer, src, dst ));
+
+        __m128i* destColorIt =
+            reinterpret_cast< __m128i* >( destColor + x * W );
+        const __m128i* colorIt =
+            reinterpret_cast< const __m128i* >( color + x * W );
+        for( size_t i = 0; i < W; ++i )
+        {
+            const __m128i mask = _spreadSSE2< W >( closer, i );
+            _mm_storeu_si128( destColorIt + i,
+                              _select( mask, _mm_loadu_si128( colorIt + i ),
+                                       _mm_loadu_si128( destColorIt + i )));
+        }
+    }
+    _mergeDBRow< W >( destColor + x * W, destDepth + x, color + x * W,
+                      depth + x, n - x );
+}
+
+// premultiplied blend of two pixels in 16-bit lanes
+static inline __m128i _blend16( const __m128i src, const __m128i dst,
+                                const __m128i colorMask )
+{
+    const __m128i alpha = _mm_shufflehi_epi16(
+                              _mm_shufflelo_epi16( src, 0xff ), 0xff );
+    return _mm_add_epi16( _mm_and_si128( src, colorMask ),
+                          _mm_srli_epi16( _mm_mullo_epi16( alpha, dst ), 8 ));
+}
+
+static void _blendRGBA8RowSSE2( void* dest, const void* source,
+                                const int32_t n )
+{
+    uint8_t* dst = reinterpret_cast< uint8_t* >( dest );
+    const uint8_t* src = reinterpret_cast< const uint8_t* >( source );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colorMask = _mm_setr_epi16( -1, -1, -1, 0, -1, -1, -1, 0 );
+
+    int32_t x = 0;
+    for( ; x + 4 <= n; x += 4 )
+    {
+        __m128i* dstIt = reinterpret_cast< __m128i* >( dst + x * 4 );
+        const __m128i s = _mm_loadu_si128(
+                              reinterpret_cast< const __m128i* >( src + x*4 ));
+        const __m128i d = _mm_loadu_si128( dstIt );
+        const __m128i low = _blend16( _mm_unpacklo_epi8( s, zero ),
+                                      _mm_unpacklo_epi8( d, zero ), colorMask );
+        const __m128i high = _blend16( _mm_unpackhi_epi8( s, zero ),
+                                       _mm_unpackhi_epi8( d, zero ), colorMask);
+        // saturates the color channels to 255
+        _mm_storeu_si128( dstIt, _mm_packus_epi16( low, high ));
+    }
+    _blendRGBA8Row( dst + x * 4, src + x * 4, n - x );
+}
+
+static void _blendRGBA32FRowSSE2( void* dest, const void* source,
+                                  const int32_t n )
+{
+    float* dst = reinterpret_cast< float* >( dest );
+    const float* src = reinterpret_cast< const float* >( source );
+    const __m128 colorMask =
+        _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ));
+
+    for( int32_t x = 0; x < n; ++x )
+    {
+        const __m128 s = _mm_loadu_ps( src + x * 4 );
+        const __m128 d = _mm_loadu_ps( dst + x * 4 );
+        const __m128 alpha = _mm_shuffle_ps( s, s, 0xff );
+        _mm_storeu_ps( dst + x * 4, _mm_add_ps( _mm_and_ps( s, colorMask ),
+                                                _mm_mul_ps( alpha, d )));
+    }
+}
+#endif
+
+#ifdef EQ_COMPOSITOR_AVX2
+// spread the depth test result of eight pixels over the i-th color vector
+template< size_t W >
+__attribute__(( target( "avx2" )))
+inline __m256i _spreadAVX2( const __m256i mask, const size_t i )
+{
+    if( W == 1 )
+        return mask;
+
+    const int first = int( i * 8 );
+    const int w = int( W );
+    return _mm256_permutevar8x32_epi32( mask, _mm256_setr_epi32(
+        first / w, ( first + 1 ) / w, ( first + 2 ) / w, ( first + 3 ) / w,
+        ( first + 4 ) / w, ( first + 5 ) / w, ( first + 6 ) / w,
+        ( first + 7 ) / w ));
+}
+
+template< size_t W >
+__attribute__(( target( "avx2" )))
+void _mergeDBRowAVX2( uint32_t* destColor, uint32_t* destDepth,
+                      const uint32_t* color, const uint32_t* depth,
+                      const int32_t n )
+{
+    const __m256i sign = _mm256_set1_epi32( int( 0x80000000u ));
+
+    int32_t x = 0;
+    for( ; x + 8 <= n; x += 8 )
+    {
+        __m256i* destDepthIt = reinterpret_cast< __m256i* >( destDepth + x );
+        const __m256i dst = _mm256_loadu_si256( destDepthIt );
+        const __m256i src = _mm256_loadu_si256(
+                              reinterpret_cast< const __m256i* >( depth + x ));
+        const __m256i closer = _mm256_cmpgt_epi32(
+            _mm256_xor_si256( dst, sign ), _mm256_xor_si256( src, sign ));
+        if( _mm256_testz_si256( closer, closer ))
+            continue;
+
+        _mm256_storeu_si256( destDepthIt, _mm256_min_epu32( dst, src ));
+
+        __m256i* destColorIt =
+            reinterpret_cast< __m256i* >( destColor + x * W );
+        const __m256i* colorIt =
+            reinterpret_cast< const __m256i* >( color + x * W );
+        for( size_t i = 0; i < W; ++i )
+        {
+            const __m256i mask = _spreadAVX2< W >( closer, i );
+            _mm256_storeu_si256( destColorIt + i, _mm256_blendv_epi8(
+                                     _mm256_loadu_si256( destColorIt + i ),
+                                     _mm256_loadu_si256( colorIt + i ), mask ));
+        }
+    }
+    _mergeDBRow< W >( destColor + x * W, destDepth + x, color + x * W,
+                      depth + x, n - x );
+}
+
+__attribute__(( target( "avx2" )))
+static inline __m256i _blend16( const __m256i src, const __m256i dst,
+                                const __m256i colorMask )
+{
+    const __m256i alpha = _mm256_shufflehi_epi16(
+                              _mm256_shufflelo_epi16( src, 0xff ), 0xff );
+    return _mm256_add_epi16( _mm256_and_si256( src, colorMask ),
+                       _mm256_srli_epi16( _mm256_mullo_epi16( alpha, dst ), 8));
+}
+
+__attribute__(( target( "avx2" )))
+static void _blendRGBA8RowAVX2( void* dest, const void* source,
+                                const int32_t n )
+{
+    uint8_t* dst = reinterpret_cast< uint8_t* >( dest );
+    const uint8_t* src = reinterpret_cast< const uint8_t* >( source );
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i colorMask = _mm256_setr_epi16( -1, -1, -1, 0, -1, -1, -1, 0,
+                                                 -1, -1, -1, 0, -1, -1, -1, 0 );
+
+    int32_t x = 0;
+    for( ; x + 8 <= n; x += 8 )
+    {
+        __m256i* dstIt = reinterpret_cast< __m256i* >( dst + x * 4 );
+        const __m256i s = _mm256_loadu_si256(
+                              reinterpret_cast< const __m256i* >( src + x*4 ));
+        const __m256i d = _mm256_loadu_si256( dstIt );
+        // unpack and pack work per 128-bit lane, which keeps the pixel order
+        const __m256i low = _blend16( _mm256_unpacklo_epi8( s, zero ),
+                                      _mm256_unpacklo_epi8( d, zero ),
+                                      colorMask );
+        const __m256i high = _blend16( _mm256_unpackhi_epi8( s, zero ),
+                                       _mm256_unpackhi_epi8( d, zero ),
+                                       colorMask );
+        _mm256_storeu_si256( dstIt, _mm256_packus_epi16( low, high ));
+    }
+    _blendRGBA8Row( dst + x * 4, src + x * 4, n - x );
+}
+
+__attribute__(( target( "avx2" )))
+static inline __m256 _blendFloat( const __m256 src, const __m256 dst )
+{
+    const __m256 colorMask = _mm256_castsi256_ps(
+        _mm256_setr_epi32( -1, -1, -1, 0, -1, -1, -1, 0 ));
+    const __m256 alpha = _mm256_shuffle_ps( src, src, 0xff );
+    return _mm256_add_ps( _mm256_and_ps( src, colorMask ),
+                          _mm256_mul_ps( alpha, dst ));
+}
+
+__attribute__(( target( "avx2" )))
+static void _blendRGBA32FRowAVX2( void* dest, const void* source,
+                                  const int32_t n )
+{
+    float* dst = reinterpret_cast< float* >( dest );
+    const float* src = reinterpret_cast< const float* >( source );
+
+    int32_t x = 0;
+    for( ; x + 2 <= n; x += 2 )
+        _mm256_storeu_ps( dst + x * 4,
+                          _blendFloat( _mm256_loadu_ps( src + x * 4 ),
+                                       _mm256_loadu_ps( dst + x * 4 )));
+    _blendRGBA32FRow( dst + x * 4, src + x * 4, n - x );
+}
+
+// All AVX2 processors also implement the F16C conversion instructions
+__attribute__(( target( "avx2,f16c" )))
+static void _blendRGBA16FRowAVX2( void* dest, const void* source,
+                                  const int32_t n )
+{
+    uint16_t* dst = reinterpret_cast< uint16_t* >( dest );
+    const uint16_t* src = reinterpret_cast< const uint16_t* >( source );
+
+    int32_t x = 0;
+    for( ; x + 2 <= n; x += 2 )
+    {
+        __m128i* dstIt = reinterpret_cast< __m128i* >( dst + x * 4 );
+        const __m256 s = _mm256_cvtph_ps( _mm_loadu_si128(
+                             reinterpret_cast< const __m128i* >( src + x*4 )));
+        const __m256 d = _mm256_cvtph_ps( _mm_loadu_si128( dstIt ));
+        _mm_storeu_si128( dstIt, _mm256_cvtps_ph( _blendFloat( s, d ),
+                                                  _MM_FROUND_TO_NEAREST_INT ));
+    }
+    _blendRGBA16FRow( dst + x * 4, src + x * 4, n - x );
+}
+#endif
+
+typedef void (*MergeDBRow_t)( uint32_t*, uint32_t*, const uint32_t*,
+                              const uint32_t*, const int32_t );
+typedef void (*BlendRow_t)( void*, const void*, const int32_t );
+
+struct MergeKernels
+{
+    MergeDBRow_t mergeDB4;  //!< depth merge of 4-byte color pixels
+    MergeDBRow_t mergeDB8;  //!< depth merge of RGBA16F pixels
+    MergeDBRow_t mergeDB16; //!< depth merge of RGBA32F pixels
+    BlendRow_t blendRGBA8;
+    BlendRow_t blendRGBA16F;
+    BlendRow_t blendRGBA32F;
+};
+
+static MergeKernels _chooseMergeKernels()
+{
+    MergeKernels kernels = { _mergeDBRow< 1 >, _mergeDBRow< 2 >,
+                             _mergeDBRow< 4 >, _blendRGBA8Row,
+                             _blendRGBA16FRow, _blendRGBA32FRow };
+#ifdef EQ_COMPOSITOR_AVX2
+    __builtin_cpu_init(); // called during static initialization
+    if( __builtin_cpu_supports( "avx2" ))
+    {
+        const MergeKernels avx2 = { _mergeDBRowAVX2< 1 >, _mergeDBRowAVX2< 2 >,
+                                    _mergeDBRowAVX2< 4 >, _blendRGBA8RowAVX2,
+                                    _blendRGBA16FRowAVX2,
+                                    _blendRGBA32FRowAVX2 };
+        return avx2;
+    }
+#endif
+#ifdef EQ_COMPOSITOR_SSE2
+    kernels.mergeDB4 = _mergeDBRowSSE2< 1 >;
+    kernels.mergeDB8 = _mergeDBRowSSE2< 2 >;
+    kernels.mergeDB16 = _mergeDBRowSSE2< 4 >;
+    kernels.blendRGBA8 = _blendRGBA8RowSSE2;
+    kernels.blendRGBA32F = _blendRGBA32FRowSSE2;
+#endif
+    return kernels;
+}
+static const MergeKernels _kernels = _chooseMergeKernels();
+
+// Depth-sorted merge of run-length encoded images. The streams are decoded as
+// written by the byte RLE compressors in co/compressor/compressorRLE.ipp: each
+// group of four chunks holds the four byte streams of one contiguous pixel
+// range, a token equal to the marker is followed by the value and the run
+// length, any other token is a single value.
+static const uint8_t _rleMarker = 0x42;
+
+class RLEStream
+{
+public:
+    RLEStream() : _in( 0 ), _value( 0 ), _left( 0 ) {}
+    void reset( const void* data )
+        {
+            _in = reinterpret_cast< const uint8_t* >( data );
+            _left = 0;
+        }
+
+    /** @return the current value, fetching the next run if needed. */
+    uint8_t peek()
+        {
+            if( _left == 0 )
+            {
+                _value = *_in;
+                if( _value == _rleMarker )
+                {
+                    _value = _in[1];
+                    _left = _in[2];
+                    _in += 3;
+                }
+                else
+                {
+                    _left = 1;
+                    ++_in;
+                }
+            }
+            return _value;
+        }
+
+    uint8_t next() { const uint8_t value = peek(); --_left; return value; }
+
+    /** @return the values left in the current run, after a peek(). */
+    uint32_t getRun() const { return _left; }
+
+    /** Skip n values, crossing runs as needed. */
+    void skip( uint64_t n )
+        {
+            while( n > 0 )
+            {
+                peek();
+                const uint64_t nSkip = n < _left ? n : _left;
+                _left -= uint32_t( nSkip );
+                n -= nSkip;
+            }
+        }
+
+private:
+    const uint8_t* _in;
+    uint8_t _value;
+    uint32_t _left;
+};
+
+// Color deswizzle functions matching the RLE compressors
+struct RLENoSwizzle
+{
+    static uint32_t deswizzle( const uint8_t one, const uint8_t two,
+                               const uint8_t three, const uint8_t four )
+        { return one + (two<<8) + (three<<16) + (four<<24); }
+
+    static uint32_t deswizzle( const uint8_t one, const uint8_t two,
+                               const uint8_t three )
+        { return one + (two<<8) + (three<<16); }
+};
+
+struct RLESwizzle
+{
+    static uint32_t deswizzle( const uint8_t one, const uint8_t two,
+                               const uint8_t three, const uint8_t four )
+    {
+        const uint32_t input = one + (two<<8) + (three<<16) + (four<<24);
+        return ((  input & ( EQ_BIT32 | EQ_BIT31 | EQ_BIT22 | EQ_BIT21 |
+                             EQ_BIT11 | EQ_BIT12 | EQ_BIT2 | EQ_BIT1 ))        |
+                (( input & ( EQ_BIT26 | EQ_BIT25 )) >>18 )                     |
+                (( input & ( EQ_BIT30 | EQ_BIT29 | EQ_BIT20 | EQ_BIT19 ))>>6 ) |
+                (( input & ( EQ_BIT28 | EQ_BIT27 | EQ_BIT18 |
+                             EQ_BIT17 | EQ_BIT16 |EQ_BIT15 ))>>12 )            |
+                (( input & ( EQ_BIT10 | EQ_BIT9  | EQ_BIT8  | EQ_BIT7 ))<<18 ) |
+                (( input & ( EQ_BIT6  | EQ_BIT5 ))<<12 )                       |
+                (( input & ( EQ_BIT24 | EQ_BIT23 | EQ_BIT14 |
+                             EQ_BIT13 | EQ_BIT4  | EQ_BIT3 ))<<6 ));
+    }
+
+    static uint32_t deswizzle( const uint8_t one, const uint8_t two,
+                               const uint8_t three )
+    {
+        const uint32_t input = one + (two<<8) + (three<<16);
+        return ((  input & ( EQ_BIT24 | EQ_BIT23 | EQ_BIT22 | EQ_BIT13 |
+                             EQ_BIT12 | EQ_BIT3  | EQ_BIT2  | EQ_BIT1 )) |
+                (( input & ( EQ_BIT21 | EQ_BIT20 | EQ_BIT19 ))>>5 )      |
+                (( input & ( EQ_BIT6  | EQ_BIT5  | EQ_BIT4 ))<<5 )       |
+                (( input & ( EQ_BIT18 | EQ_BIT17 | EQ_BIT16 |
+                             EQ_BIT15 | EQ_BIT14 ))>>10 )                |
+                (( input & ( EQ_BIT11 | EQ_BIT10 | EQ_BIT9  |
+                             EQ_BIT8  | EQ_BIT7 ))<<10 ));
+    }
+};
+
+// Merges the pixels [start, end) of one chunk group. Runs of background depth
+// are skipped in all streams without decoding the pixels.
+template< typename swizzleFunc, bool useAlpha >
+void _mergeRLEChunk( const void* const* color, const void* const* depth,
+                     const uint64_t start, const uint64_t end,
+                     const int32_t width, uint32_t* destColor,
+                     uint32_t* destDepth, const int32_t destWidth )
+{
+    RLEStream c[4];
+    RLEStream d[4];
+    for( size_t i = 0; i < 4; ++i )
+    {
+        c[i].reset( color[i] );
+        d[i].reset( depth[i] );
+    }
+
+    int32_t x = int32_t( start % width );
+    int32_t y = int32_t( start / width );
+    uint64_t p = start;
+    while( p < end )
+    {
+        if( d[0].peek() == 0xff && d[1].peek() == 0xff &&
+            d[2].peek() == 0xff && d[3].peek() == 0xff )
+        {
+            uint64_t n = end - p;
+            for( size_t i = 0; i < 4; ++i )
+                n = std::min( n, uint64_t( d[i].getRun( )));
+            for( size_t i = 0; i < 4; ++i )
+                d[i].skip( n );
+            c[0].skip( n );
+            c[1].skip( n );
+            c[2].skip( n );
+            if( useAlpha )
+                c[3].skip( n );
+
+            p += n;
+            x += int32_t( n % width );
+            y += int32_t( n / width );
+            if( x >= width )
+            {
+                x -= width;
+                ++y;
+            }
+            continue;
+        }
+
+        const uint32_t pixelDepth = d[0].next() + (d[1].next() << 8) +
+                                    (d[2].next() << 16) + (d[3].next() << 24);
+        const uint8_t one = c[0].next();
+        const uint8_t two = c[1].next();
+        const uint8_t three = c[2].next();
+        const size_t index = size_t( y ) * destWidth + x;
+        if( destDepth[ index ] > pixelDepth )
+        {
+            destDepth[ index ] = pixelDepth;
+            destColor[ index ] = useAlpha ?
+                swizzleFunc::deswizzle( one, two, three, c[3].next( )) :
+                swizzleFunc::deswizzle( one, two, three );
+        }
+        else if( useAlpha )
+            c[3].next();
+
+        ++p;
+        if( ++x == width )
+        {
+            x = 0;
+            ++y;
+        }
+    }
+}
+
+template< typename swizzleFunc, bool useAlpha >
+void _mergeRLE( const PixelData& color, const PixelData& depth,
+                uint32_t* destColor, uint32_t* destDepth,
+                const int32_t destWidth )
+{
+    const int32_t width = color.pvp.w;
+    const uint64_t nPixels = uint64_t( color.pvp.w ) * color.pvp.h;
+    const ssize_t nChunks = color.compressedData.size();
+    // same chunk boundaries as the compressor
+    const float chunkWidth = static_cast< float >( nPixels * 4 ) /
+                             static_cast< float >( nChunks );
+
+#ifdef CO_USE_OPENMP
+#  pragma omp parallel for
+#endif
+    for( ssize_t i = 0; i < nChunks; i += 4 )
+    {
+        const uint64_t start = static_cast< uint64_t >( i/4 * chunkWidth );
+        const uint64_t end = static_cast< uint64_t >( (i/4 + 1) * chunkWidth );
+        if( start == end )
+            continue;
+
+        _mergeRLEChunk< swizzleFunc, useAlpha >(
+            &color.compressedData[ i ], &depth.compressedData[ i ], start, end,
+            width, destColor, destDepth, destWidth );
+    }
+}
+
+/** @return the pixel data of an image buffer, without decompressing it. */
+static const PixelData& _getPixelData( const Image* image,
+                                       const Frame::Buffer buffer )
+{
+    if( image->hasCompressedPixelData( buffer ))
+        return image->getCompressedPixelData( buffer );
+    return image->getPixelData( buffer );
+}
+
 static bool _useCPUAssembly( const Frames& frames, Channel* channel, 
                              const bool blendAlpha = false )
 {
@@ -158,6 +830,10 @@ static bool _useCPUAssembly( const Frames& frames, Channel* channel,
 
                     case EQ_COMPRESSOR_DATATYPE_RGBA:
                     case EQ_COMPRESSOR_DATATYPE_BGRA:
+                    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+                    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+                    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+                    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
                         break;
 
                     default:
@@ -613,13 +1289,13 @@ bool Compositor::_collectOutputData(
 
             destPVP.merge( image->getPixelViewport() + frame->getOffset( ));
 
-            _collectOutputData( image->getPixelData( Frame::BUFFER_COLOR ), 
+            _collectOutputData( _getPixelData( image, Frame::BUFFER_COLOR ),
                                 colorInternalFormat, colorPixelSize, 
                                 colorExternalFormat );
             
             if( image->hasPixelData( Frame::BUFFER_DEPTH ))
             {
-                _collectOutputData( image->getPixelData( Frame::BUFFER_DEPTH ), 
+                _collectOutputData( _getPixelData( image, Frame::BUFFER_DEPTH ),
                                     depthInternalFormat, 
                                     depthPixelSize, depthExternalFormat );
             }
@@ -680,26 +1356,7 @@ bool Compositor::mergeFramesCPU( const Frames& frames,
 
     // check output buffers
     const uint32_t area = outPVP.getArea();
-    uint32_t nChannels = 0;
-    
-    switch ( colorInternalFormat )
-    {
-        case EQ_COMPRESSOR_DATATYPE_RGBA:
-        case EQ_COMPRESSOR_DATATYPE_RGBA16F:
-        case EQ_COMPRESSOR_DATATYPE_RGBA32F:
-        case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
-            nChannels = 4;
-            break;
-        case EQ_COMPRESSOR_DATATYPE_RGB:
-        case EQ_COMPRESSOR_DATATYPE_RGB16F:
-        case EQ_COMPRESSOR_DATATYPE_RGB32F:
-            nChannels = 3;
-            break;
-        default:
-            EQASSERT( false );
-    }
-
-    if( colorBufferSize < area * nChannels )
+    if( colorBufferSize < area * colorPixelSize )
     {
         EQWARN << "Color output buffer to small" << std::endl;
         return false;
@@ -730,13 +1387,132 @@ bool Compositor::mergeFramesCPU( const Frames& frames,
     return true;
 }
 
+bool Compositor::mergeCompressedDB( Image* result, const PixelData& color,
+                                    const PixelData& depth,
+                                    const Vector2i& offset )
+{
+    EQASSERT( result );
+    if( !result->hasPixelData( Frame::BUFFER_COLOR ) ||
+        !result->hasPixelData( Frame::BUFFER_DEPTH ) ||
+        result->getPixelSize( Frame::BUFFER_COLOR ) != 4 ||
+        result->getExternalFormat( Frame::BUFFER_COLOR ) !=
+            color.externalFormat ||
+        result->getExternalFormat( Frame::BUFFER_DEPTH ) !=
+            EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+    {
+        return false;
+    }
+
+    return _mergeCompressedDB( result->getPixelPointer( Frame::BUFFER_COLOR ),
+                               result->getPixelPointer( Frame::BUFFER_DEPTH ),
+                               result->getPixelViewport(), color, depth,
+                               offset );
+}
+
+bool Compositor::_mergeCompressedDB( void* destColor, void* destDepth,
+                                     const PixelViewport& destPVP,
+                                     const PixelData& color,
+                                     const PixelData& depth,
+                                     const Vector2i& offset )
+{
+    if( color.pixelSize != 4 ||
+        depth.externalFormat != EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+    {
+        return false;
+    }
+
+    // All byte RLE compressors for 32 bit pixels use the same stream format
+    bool swizzled = false;
+    switch( color.compressorName )
+    {
+        case EQ_COMPRESSOR_RLE_RGBA:
+        case EQ_COMPRESSOR_RLE_BGRA:
+        case EQ_COMPRESSOR_RLE_RGBA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_BGRA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_RGB10_A2:
+        case EQ_COMPRESSOR_RLE_BGR10_A2:
+        case EQ_COMPRESSOR_RLE_SIMD_RGBA:
+        case EQ_COMPRESSOR_RLE_SIMD_BGRA:
+        case EQ_COMPRESSOR_RLE_SIMD_RGBA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_SIMD_BGRA_UINT_8_8_8_8_REV:
+            break;
+
+        case EQ_COMPRESSOR_RLE_DIFF_RGBA:
+        case EQ_COMPRESSOR_RLE_DIFF_BGRA:
+        case EQ_COMPRESSOR_RLE_DIFF_RGBA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_DIFF_BGRA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA:
+        case EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA:
+        case EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA_UINT_8_8_8_8_REV:
+        case EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA_UINT_8_8_8_8_REV:
+            swizzled = true;
+            break;
+
+        default:
+            return false;
+    }
+
+    if(( depth.compressorName != EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT &&
+         depth.compressorName != EQ_COMPRESSOR_RLE_SIMD_DEPTH_UNSIGNED_INT ) ||
+       ( depth.compressorFlags & EQ_COMPRESSOR_IGNORE_ALPHA ))
+    {
+        return false;
+    }
+
+    // both streams have to use the same chunk layout
+    const PixelViewport& pvp = color.pvp;
+    if( pvp != depth.pvp || !pvp.hasArea() ||
+        color.compressedData.empty() || ( color.compressedData.size() % 4 ) ||
+        color.compressedData.size() != depth.compressedData.size( ))
+    {
+        return false;
+    }
+
+    const int32_t destX = offset.x() + pvp.x - destPVP.x;
+    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    if( destX < 0 || destY < 0 || destX + pvp.w > destPVP.w ||
+        destY + pvp.h > destPVP.h )
+    {
+        EQWARN << "Compressed image " << pvp << " outside of result image "
+               << destPVP << std::endl;
+        return false;
+    }
+
+    EQVERB << "CPU-DB assembly of compressed image" << std::endl;
+
+    const size_t skip = size_t( destY ) * destPVP.w + destX;
+    uint32_t* destC = reinterpret_cast< uint32_t* >( destColor ) + skip;
+    uint32_t* destD = reinterpret_cast< uint32_t* >( destDepth ) + skip;
+
+    const bool useAlpha = !(color.compressorFlags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    if( swizzled )
+    {
+        if( useAlpha )
+            _mergeRLE< RLESwizzle, true >( color, depth, destC, destD,
+                                           destPVP.w );
+        else
+            _mergeRLE< RLESwizzle, false >( color, depth, destC, destD,
+                                            destPVP.w );
+    }
+    else if( useAlpha )
+        _mergeRLE< RLENoSwizzle, true >( color, depth, destC, destD,
+                                         destPVP.w );
+    else
+        _mergeRLE< RLENoSwizzle, false >( color, depth, destC, destD,
+                                          destPVP.w );
+    return true;
+}
+
 void Compositor::_mergeFrames( const Frames& frames, const bool blendAlpha, 
                                void* colorBuffer, void* depthBuffer,
                                const PixelViewport& destPVP )
 {
     for( Frames::const_iterator i = frames.begin(); i != frames.end(); ++i)
     {
-        const Frame* frame = *i;
+        Frame* frame = *i;
+        if( depthBuffer ) // receive the next images compressed for the merge
+            frame->getData()->setCompressedUsage( true );
+
         const Images& images = frame->getImages();        
         for( Images::const_iterator j = images.begin(); j != images.end(); ++j )
         {
@@ -745,6 +1521,21 @@ void Compositor::_mergeFrames( const Frames& frames, const bool blendAlpha,
             if( !image->hasPixelData( Frame::BUFFER_COLOR ))
                 continue;
 
+            if( image->hasCompressedPixelData( Frame::BUFFER_COLOR ) &&
+                image->hasCompressedPixelData( Frame::BUFFER_DEPTH ))
+            {
+                // merge received RLE images without decompressing them
+                const PixelData& color =
+                    image->getCompressedPixelData( Frame::BUFFER_COLOR );
+                const PixelData& depth =
+                    image->getCompressedPixelData( Frame::BUFFER_DEPTH );
+                if( _mergeCompressedDB( colorBuffer, depthBuffer, destPVP,
+                                        color, depth, frame->getOffset( )))
+                {
+                    continue;
+                }
+            }
+
             if( image->hasPixelData( Frame::BUFFER_DEPTH ))
                 _mergeDBImage( colorBuffer, depthBuffer, destPVP,
                                image, frame->getOffset( ));
@@ -791,30 +1582,28 @@ void Compositor::_mergeDBImage( void* destColor, void* destDepth,
     const uint32_t* depth = reinterpret_cast< const uint32_t* >
         ( image->getPixelPointer( Frame::BUFFER_DEPTH ));
 
+    // color words per pixel
+    const size_t nWords = image->getPixelSize( Frame::BUFFER_COLOR ) / 4;
+    MergeDBRow_t mergeRow = 0;
+    switch( nWords )
+    {
+        case 1: mergeRow = _kernels.mergeDB4; break;
+        case 2: mergeRow = _kernels.mergeDB8; break;
+        case 4: mergeRow = _kernels.mergeDB16; break;
+        default:
+            EQWARN << "CPU-DB assembly not implemented for color pixel size "
+                   << nWords * 4 << std::endl;
+            return;
+    }
+
 #ifdef CO_USE_OPENMP
 #  pragma omp parallel for
 #endif
     for( int32_t y = 0; y < pvp.h; ++y )
     {
         const uint32_t skip =  (destY + y) * destPVP.w + destX;
-        uint32_t* destColorIt = destC + skip;
-        uint32_t* destDepthIt = destD + skip;
-        const uint32_t* colorIt = color + y * pvp.w;
-        const uint32_t* depthIt = depth + y * pvp.w;
-
-        for( int32_t x = 0; x < pvp.w; ++x )
-        {
-            if( *destDepthIt > *depthIt )
-            {
-                *destColorIt = *colorIt;
-                *destDepthIt = *depthIt;
-            }
-            
-            ++destColorIt;
-            ++destDepthIt;
-            ++colorIt;
-            ++depthIt;
-        }
+        mergeRow( destC + skip * nWords, destD + skip,
+                  color + y * pvp.w * nWords, depth + y * pvp.w, pvp.w );
     }
 }
 
@@ -861,13 +1650,12 @@ void Compositor::_mergeBlendImage( void* dest, const eq::PixelViewport& destPVP,
 {
     EQVERB << "CPU-Blend assembly"<< std::endl;
 
-    int32_t* destColor = reinterpret_cast< int32_t* >( dest );
+    uint8_t* destColor = reinterpret_cast< uint8_t* >( dest );
 
     const PixelViewport&  pvp    = image->getPixelViewport();
     const int32_t         destX  = offset.x() + pvp.x - destPVP.x;
     const int32_t         destY  = offset.y() + pvp.y - destPVP.y;
 
-    EQASSERT( image->getPixelSize( Frame::BUFFER_COLOR ) == 4 );
     EQASSERT( image->hasPixelData( Frame::BUFFER_COLOR ));
     EQASSERT( image->hasAlpha( ));
     
@@ -883,42 +1671,36 @@ void Compositor::_mergeBlendImage( void* dest, const eq::PixelViewport& destPVP,
     }
 #endif
 
-    const int32_t* color = reinterpret_cast< const int32_t* >
-                               ( image->getPixelPointer( Frame::BUFFER_COLOR ));
+    const uint8_t* color = image->getPixelPointer( Frame::BUFFER_COLOR );
+    const size_t pixelSize = image->getPixelSize( Frame::BUFFER_COLOR );
 
-    // Blending of two slices, none of which is on final image (i.e. result
-    // could be blended on to something else) should be performed with:
-    // glBlendFuncSeparate( GL_ONE, GL_SRC_ALPHA, GL_ZERO, GL_SRC_ALPHA )
-    // which means:
-    // dstColor = 1*srcColor + srcAlpha*dstColor
-    // dstAlpha = 0*srcAlpha + srcAlpha*dstAlpha
-    // because we accumulate light which is go through (= 1-Alpha) and we
-    // already have colors as Alpha*Color
+    BlendRow_t blendRow = _kernels.blendRGBA8;
+    switch( image->getExternalFormat( Frame::BUFFER_COLOR ))
+    {
+        case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+        case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+            blendRow = _kernels.blendRGBA16F;
+            break;
 
-    int32_t* destColorStart = destColor + destY*destPVP.w + destX;
-    const uint32_t step = sizeof( int32_t );
+        case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+        case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+            blendRow = _kernels.blendRGBA32F;
+            break;
+
+        default:
+            EQASSERT( pixelSize == 4 );
+            break;
+    }
+
+    uint8_t* destColorStart =
+        destColor + ( destY * destPVP.w + destX ) * pixelSize;
 
 #ifdef CO_USE_OPENMP
 #  pragma omp parallel for
 #endif
     for( int32_t y = 0; y < pvp.h; ++y )
-    {
-        const unsigned char* src =
-            reinterpret_cast< const uint8_t* >( color + pvp.w * y );
-        unsigned char*       dst =
-            reinterpret_cast< uint8_t* >( destColorStart + destPVP.w * y );
-
-        for( int32_t x = 0; x < pvp.w; ++x )
-        {
-            dst[0] = EQ_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
-            dst[1] = EQ_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
-            dst[2] = EQ_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
-            dst[3] =                   src[3]*dst[3] >> 8;
-
-            src += step;
-            dst += step;
-        }
-    }
+        blendRow( destColorStart + destPVP.w * y * pixelSize,
+                  color + pvp.w * y * pixelSize, pvp.w );
 }
 
 #ifdef EQ_USE_PARACOMP
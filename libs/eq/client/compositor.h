@@ -134,6 +134,8 @@ namespace eq
          * The returned image does not have to be freed. The compositor
          * maintains one image per thread, that is, the returned image is valid
          * until the next usage of the compositor in the current thread.
+         * Received RLE-compressed depth images are merged using
+         * mergeCompressedDB(), without decompressing them.
          *
          * @version 1.0
          */
@@ -164,6 +166,29 @@ namespace eq
                                     const uint32_t depthBufferSize,
                                     PixelViewport& outPVP );
 
+        /**
+         * Merge a run-length encoded color and depth image into an image in
+         * main memory, without decompressing it.
+         *
+         * The result image has to have valid 32 bit color and depth pixel
+         * data, e.g., from a previous mergeFramesCPU() or a cleared image. The
+         * input has to be compressed using one of the byte RLE compressors,
+         * with the same number of chunks for color and depth. Runs of
+         * background depth are skipped without expanding them, all other
+         * pixels are depth-tested against the result image.
+         *
+         * @param result the destination image.
+         * @param color the compressed color data of the input image.
+         * @param depth the compressed depth data of the input image.
+         * @param offset the offset of the input image wrt its pixel viewport.
+         * @return true if the image was merged, false if the input is not
+         *         supported and has to be decompressed by the caller.
+         * @version 1.1.5
+         */
+        static bool mergeCompressedDB( Image* result, const PixelData& color,
+                                       const PixelData& depth,
+                                       const Vector2i& offset );
+
         /**
          * Assemble a frame into the frame buffer using the default algorithm.
          * @version 1.0
@@ -257,6 +282,12 @@ namespace eq
                                   void* colorBuffer, void* depthBuffer,
                                   const PixelViewport& destPVP );
                                   
+        static bool _mergeCompressedDB( void* destColor, void* destDepth,
+                                        const PixelViewport& destPVP,
+                                        const PixelData& color,
+                                        const PixelData& depth,
+                                        const Vector2i& offset );
+
         static void _mergeDBImage( void* destColor, void* destDepth,
                                    const PixelViewport& destPVP, 
                                    const Image* image, 
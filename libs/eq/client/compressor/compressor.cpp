@@ -200,6 +200,43 @@ void EqCompressorDownload( void* const        ptr,
 }
 
 
+void EqCompressorStartDownload( void* const        ptr,
+                                const unsigned     name,
+                                const GLEWContext* glewContext,
+                                const eq_uint64_t  inDims[4],
+                                const unsigned     source,
+                                const eq_uint64_t  flags )
+{
+    assert( ptr );
+    eq::plugin::Compressor* compressor = 
+        reinterpret_cast< eq::plugin::Compressor* >( ptr );
+    compressor->startDownload( glewContext, inDims, source, flags );
+}
+
+void EqCompressorFinishDownload( void* const        ptr,
+                                 const unsigned     name,
+                                 const GLEWContext* glewContext,
+                                 const eq_uint64_t  inDims[4],
+                                 const eq_uint64_t  flags,
+                                 eq_uint64_t        outDims[4],
+                                 void**             out )
+{
+    assert( ptr );
+    eq::plugin::Compressor* compressor = 
+        reinterpret_cast< eq::plugin::Compressor* >( ptr );
+    compressor->finishDownload( glewContext, inDims, flags, outDims, out );
+}
+
+void EqCompressorDeleteGLObjects( void* const        ptr,
+                                  const unsigned     name,
+                                  const GLEWContext* glewContext )
+{
+    assert( ptr );
+    eq::plugin::Compressor* compressor = 
+        reinterpret_cast< eq::plugin::Compressor* >( ptr );
+    compressor->deleteGLObjects( glewContext );
+}
+
 void EqCompressorUpload( void* const        ptr,
                          const unsigned     name,
                          const GLEWContext* glewContext, 
@@ -100,6 +100,46 @@ namespace plugin
                                eq_uint64_t        outDims[4],
                                void**             out ) { EQDONTCALL; }
 
+        /**
+         * Start transferring frame buffer data into main memory.
+         *
+         * @param glewContext the initialized GLEW context describing
+         *                    corresponding to the current OpenGL context.
+         * @param inDims the dimensions of the input data (x, w, y, h).
+         * @param source texture name to process.
+         * @param flags capability flags for the compression.
+         */
+        virtual void startDownload( const GLEWContext* glewContext,
+                                    const eq_uint64_t  inDims[4],
+                                    const unsigned     source,
+                                    const eq_uint64_t  flags )
+            { EQDONTCALL; }
+
+        /**
+         * Finish transferring frame buffer data into main memory.
+         *
+         * @param glewContext the initialized GLEW context describing
+         *                    corresponding to the current OpenGL context.
+         * @param inDims the dimensions of the input data (x, w, y, h).
+         * @param flags capability flags for the compression.
+         * @param outDims the dimensions of the output data.
+         * @param out the pointer to the output data.
+         */
+        virtual void finishDownload( const GLEWContext* glewContext,
+                                     const eq_uint64_t  inDims[4],
+                                     const eq_uint64_t  flags,
+                                     eq_uint64_t        outDims[4],
+                                     void**             out )
+            { EQDONTCALL; }
+
+        /**
+         * Delete the OpenGL objects kept by this transfer engine.
+         *
+         * @param glewContext the initialized GLEW context describing
+         *                    corresponding to the current OpenGL context.
+         */
+        virtual void deleteGLObjects( const GLEWContext* glewContext ) {}
+
         /**
          * Transfer data from main memory into GPU memory.
          *
@@ -40,7 +40,8 @@ static stde::hash_map< unsigned, unsigned > _depths;
                              EQ_COMPRESSOR_DATA_2D |                    \
                              EQ_COMPRESSOR_USE_TEXTURE_RECT |           \
                              EQ_COMPRESSOR_USE_TEXTURE_2D |             \
-                             EQ_COMPRESSOR_USE_FRAMEBUFFER;             \
+                             EQ_COMPRESSOR_USE_FRAMEBUFFER |            \
+                             EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD;          \
         if( alpha )                                                     \
             info->capabilities |= EQ_COMPRESSOR_IGNORE_ALPHA;           \
         info->quality = quality_ ## f;                                  \
@@ -111,6 +112,10 @@ CompressorReadDrawPixels::CompressorReadDrawPixels( const unsigned name )
         , _format( 0 )
         , _type( 0 )
         , _depth( _depths[ name ] )
+        , _pbo( 0 )
+        , _pboSize( 0 )
+        , _pboPending( false )
+        , _pboContext( 0 )
 {
     EQASSERT( _depth > 0 );
     switch( name )
@@ -268,6 +273,11 @@ CompressorReadDrawPixels::CompressorReadDrawPixels( const unsigned name )
 
 CompressorReadDrawPixels::~CompressorReadDrawPixels( )
 {
+    EQASSERTINFO( !_pboPending, "Async download was not finished" );
+    if( _pbo )
+        EQWARN << "OpenGL buffer object leaked, deleteGLObjects not called"
+               << std::endl;
+
     delete _texture;
     _texture = 0;
 }
@@ -346,6 +356,92 @@ void CompressorReadDrawPixels::download( const GLEWContext* glewContext,
     *out = _buffer.getData();
 }
 
+void CompressorReadDrawPixels::startDownload( const GLEWContext* glewContext,
+                                              const eq_uint64_t  inDims[4],
+                                              const unsigned     source,
+                                              const eq_uint64_t  flags )
+{
+    EQASSERT( !_pboPending );
+    // The buffer object of another context can't be deleted here
+    if( !( flags & EQ_COMPRESSOR_USE_FRAMEBUFFER ) ||
+        !GLEW_ARB_pixel_buffer_object || ( _pbo && _pboContext != glewContext ))
+    {
+        // no async path, download now and return the result at finish
+        eq_uint64_t outDims[4];
+        void* out;
+        download( glewContext, inDims, source, flags, outDims, &out );
+        return;
+    }
+
+    // Reuse the buffer object, reallocate it only when the image size changes.
+    if( !_pbo )
+    {
+        EQ_GL_CALL( glGenBuffersARB( 1, &_pbo ));
+        _pboSize = 0;
+        _pboContext = glewContext;
+    }
+
+    const size_t size = inDims[1] * inDims[3] * _depth;
+    EQ_GL_CALL( glBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, _pbo ));
+    if( size != _pboSize )
+    {
+        EQ_GL_CALL( glBufferDataARB( GL_PIXEL_PACK_BUFFER_ARB, size, 0,
+                                     GL_STREAM_READ_ARB ));
+        _pboSize = size;
+    }
+    EQ_GL_CALL( glReadPixels( inDims[0], inDims[2], inDims[1], inDims[3],
+                              _format, _type, 0 ));
+    EQ_GL_CALL( glBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, 0 ));
+    _pboPending = true;
+}
+
+void CompressorReadDrawPixels::finishDownload( const GLEWContext* glewContext,
+                                               const eq_uint64_t  inDims[4],
+                                               const eq_uint64_t  flags,
+                                                     eq_uint64_t  outDims[4],
+                                               void**             out )
+{
+    if( !_pboPending ) // synchronous fallback in startDownload
+    {
+        for( size_t i = 0; i < 4; ++i )
+            outDims[i] = inDims[i];
+        *out = _buffer.getData();
+        return;
+    }
+
+    _init( inDims, outDims );
+    _pboPending = false;
+
+    EQ_GL_CALL( glBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, _pbo ));
+    const void* data = glMapBufferARB( GL_PIXEL_PACK_BUFFER_ARB,
+                                       GL_READ_ONLY_ARB );
+    EQASSERT( data );
+    if( data )
+    {
+        memcpy( _buffer.getData(), data, _buffer.getSize( ));
+        glUnmapBufferARB( GL_PIXEL_PACK_BUFFER_ARB );
+    }
+    else
+        EQWARN << "Can't map pixel buffer object, glError 0x" << std::hex
+               << glGetError() << std::dec << std::endl;
+
+    EQ_GL_CALL( glBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, 0 ));
+    *out = _buffer.getData();
+}
+
+void CompressorReadDrawPixels::deleteGLObjects( const GLEWContext* glewContext )
+{
+    EQASSERT( !_pboPending );
+    if( !_pbo )
+        return;
+
+    EQASSERT( _pboContext == glewContext );
+    EQ_GL_CALL( glDeleteBuffersARB( 1, &_pbo ));
+    _pbo = 0;
+    _pboSize = 0;
+    _pboContext = 0;
+}
+
 void CompressorReadDrawPixels::upload( const GLEWContext* glewContext, 
                                        const void*        buffer,
                                        const eq_uint64_t  inDims[4],
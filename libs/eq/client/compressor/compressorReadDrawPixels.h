@@ -55,6 +55,19 @@ public:
                                  eq_uint64_t  outDims[4],
                            void**             out );
 
+    virtual void startDownload( const GLEWContext* glewContext,
+                                const eq_uint64_t  inDims[4],
+                                const unsigned     source,
+                                const eq_uint64_t  flags );
+
+    virtual void finishDownload( const GLEWContext* glewContext,
+                                 const eq_uint64_t  inDims[4],
+                                 const eq_uint64_t  flags,
+                                 eq_uint64_t        outDims[4],
+                                 void**             out );
+
+    virtual void deleteGLObjects( const GLEWContext* glewContext );
+
     virtual void upload( const GLEWContext* glewContext, 
                          const void*        buffer,
                          const eq_uint64_t  inDims[4],
@@ -69,6 +82,10 @@ protected:
     unsigned    _format;         //!< the GL format
     unsigned    _type;           //!< the GL type 
     const unsigned _depth;       //!< the size of one output token
+    unsigned    _pbo;            //!< pixel buffer for async downloads, or 0
+    size_t      _pboSize;        //!< the allocated size of _pbo in bytes
+    bool        _pboPending;     //!< an async download into _pbo is pending
+    const GLEWContext* _pboContext; //!< the GL context owning _pbo
     void _initTexture( const GLEWContext* glewContext, const eq_uint64_t flags );
     void _init( const eq_uint64_t  inDims[4], eq_uint64_t  outDims[4] );
 };
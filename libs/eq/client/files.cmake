@@ -115,6 +115,7 @@ set(CLIENT_SOURCES
   glWindow.cpp
   global.cpp
   image.cpp
+  imageHistory.cpp
   init.cpp
   jitter.cpp
   layout.cpp
@@ -210,6 +210,21 @@ namespace server
         EQ_API void readback( util::ObjectManager< const void* >* glObjects,
                                  const DrawableConfig& config );
 
+        /**
+         * Start reading back a set of images according to the current frame
+         * data.
+         *
+         * Uses asynchronous downloads where supported. Only to be used from
+         * Channel::frameReadback(), which finishes the readback and sets the
+         * frame ready later, when the pipe thread is idle or before it blocks.
+         *
+         * @param glObjects the GL object manager for the current GL context.
+         * @param config the configuration of the source frame buffer.
+         * @version 1.1.5
+         */
+        EQ_API void startReadback( util::ObjectManager< const void* >*
+                                   glObjects, const DrawableConfig& config );
+
         /**
          * Set the frame ready.
          * 
@@ -22,10 +22,12 @@
 #include "channelStatistics.h"
 #include "exception.h"
 #include "image.h"
+#include "imageHistory.h"
 #include "log.h"
 #include "nodePackets.h"
 #include "roiFinder.h"
 
+#include <eq/util/objectManager.h>
 #include <eq/fabric/drawableConfig.h>
 #include <co/command.h>
 #include <co/commandFunc.h>
@@ -45,8 +47,11 @@ namespace eq
 typedef co::CommandFunc<FrameData> CmdFunc;
 
 FrameData::FrameData() 
-        : _version( co::VERSION_NONE.low( ))
+        : _imageHistory( 0 )
+        , _version( co::VERSION_NONE.low( ))
         , _useAlpha( true )
+        , _useROI( false )
+        , _useCompressed( false )
         , _colorQuality( 1.f )
         , _depthQuality( 1.f )
         , _colorCompressor( EQ_COMPRESSOR_AUTO )
@@ -71,6 +76,8 @@ FrameData::~FrameData()
 
     delete _roiFinder;
     _roiFinder = 0;
+    delete _imageHistory;
+    _imageHistory = 0;
 }
 
 void FrameData::setQuality( Frame::Buffer buffer, float quality )
@@ -203,24 +210,72 @@ void FrameData::readback( const Frame& frame,
                           util::ObjectManager< const void* >* glObjects,
                           const DrawableConfig& config  )
 {
-    if( _data.buffers == Frame::BUFFER_NONE )
+    Images images;
+    if( !_startReadback( frame, glObjects, config, false, images ))
         return;
 
+    _finishReadback( images, glObjects->glewGetContext( ));
+    setReady();
+}
+
+void FrameData::startReadback( const Frame& frame,
+                               util::ObjectManager< const void* >* glObjects,
+                               const DrawableConfig& config  )
+{
+    EQASSERT( _readbackImages.empty( ));
+    _startReadback( frame, glObjects, config, true, _readbackImages );
+}
+
+void FrameData::finishReadback( util::ObjectManager< const void* >* glObjects,
+                                const DrawableConfig& config  )
+{
+    _finishReadback( _readbackImages, glObjects->glewGetContext( ));
+    _readbackImages.clear();
+    setReady();
+}
+
+void FrameData::deleteGLObjects( util::ObjectManager< const void* >* glObjects )
+{
+    const GLEWContext* glewContext = glObjects->glewGetContext();
+    for( Images::const_iterator i = _images.begin(); i != _images.end(); ++i )
+        (*i)->deleteGLObjects( glewContext );
+
+    _imageCacheLock.set();
+    for( Images::const_iterator i = _imageCache.begin();
+         i != _imageCache.end(); ++i )
+    {
+        (*i)->deleteGLObjects( glewContext );
+    }
+    _imageCacheLock.unset();
+}
+
+bool FrameData::_startReadback( const Frame& frame,
+                                util::ObjectManager< const void* >* glObjects,
+                                const DrawableConfig& config, const bool async,
+                                Images& images )
+{
+    if( _data.buffers == Frame::BUFFER_NONE )
+        return false;
+
     PixelViewport absPVP = _data.pvp + frame.getOffset();
     if( !absPVP.isValid( ))
-        return;
+        return false;
 
     const Zoom& zoom = frame.getZoom();
 
     if( !zoom.isValid( ))
     {
         EQWARN << "Invalid zoom factor, skipping frame" << std::endl;
-        return;
+        return false;
     }
 
     PixelViewports pvps;
-
-    if( _data.buffers & Frame::BUFFER_DEPTH && zoom == Zoom::NONE )
+    if( _useROI && _data.frameType == Frame::TYPE_MEMORY &&
+        ( _data.buffers & Frame::BUFFER_DEPTH ) && zoom == Zoom::NONE )
+    {
+        pvps = _findRegions( absPVP, glObjects, config );
+    }
+    else if( _data.buffers & Frame::BUFFER_DEPTH && zoom == Zoom::NONE )
         pvps = _roiFinder->findRegions( _data.buffers, absPVP, zoom,
 //                    frame.getAssemblyStage(), frame.getFrameID(), glObjects );
                     0, 0, glObjects );
@@ -233,8 +288,23 @@ void FrameData::readback( const Frame& frame,
         pvp.intersect( absPVP );
 
         Image* image = newImage( _data.frameType, config );
-        image->readback( _data.buffers, pvp, zoom, glObjects );
+        if( async )
+            image->startReadback( _data.buffers, pvp, zoom, glObjects );
+        else
+            image->readback( _data.buffers, pvp, zoom, glObjects );
         image->setOffset( pvp.x - absPVP.x, pvp.y - absPVP.y );
+        images.push_back( image );
+    }
+    return true;
+}
+
+void FrameData::_finishReadback( const Images& images,
+                                 const GLEWContext* glewContext )
+{
+    for( Images::const_iterator i = images.begin(); i != images.end(); ++i )
+    {
+        Image* image = *i;
+        image->finishReadback( glewContext );
 
 #ifndef NDEBUG
         if( getenv( "EQ_DUMP_IMAGES" ))
@@ -248,7 +318,31 @@ void FrameData::readback( const Frame& frame,
         }
 #endif
     }
-    setReady();
+}
+
+PixelViewports FrameData::_findRegions( const PixelViewport& absPVP,
+                                  util::ObjectManager< const void* >* glObjects,
+                                        const DrawableConfig& config )
+{
+    // The depth buffer is downloaded once to find the non-empty regions, which
+    // are then read back directly into their own images.
+    Image* image = _allocImage( Frame::TYPE_MEMORY, config, false );
+    image->readback( Frame::BUFFER_DEPTH, absPVP, Zoom::NONE, glObjects );
+
+    PixelViewports regions = _roiFinder->findRegions( *image );
+    for( PixelViewports::iterator i = regions.begin(); i != regions.end(); ++i )
+    {
+        i->x += absPVP.x;
+        i->y += absPVP.y;
+    }
+
+    _imageCacheLock.set();
+    _imageCache.push_back( image );
+    _imageCacheLock.unset();
+
+    EQLOG( LOG_ASSEMBLY ) << "Read back " << absPVP << " as " << regions.size()
+                          << " regions of interest" << std::endl;
+    return regions;
 }
 
 void FrameData::setVersion( const uint64_t version )
@@ -340,7 +434,8 @@ void FrameData::removeListener( co::base::Monitor<uint32_t>& listener )
     _listeners->erase( i );
 }
 
-bool FrameData::addImage( const NodeFrameDataTransmitPacket* packet )
+bool FrameData::addImage( const NodeFrameDataTransmitPacket* packet,
+                          co::base::Bufferb* payload )
 {
     Image* image = _allocImage( Frame::TYPE_MEMORY, DrawableConfig(),
                                 false /* set quality */ );
@@ -348,11 +443,21 @@ bool FrameData::addImage( const NodeFrameDataTransmitPacket* packet )
     // Note on the const_cast: since the PixelData structure stores non-const
     // pointers, we have to go non-const at some point, even though we do not
     // modify the data.
-    uint8_t* data  = const_cast< uint8_t* >( packet->data );
+    uint8_t* data = payload ? payload->getData() :
+                              const_cast< uint8_t* >( packet->data );
+    if( payload ) // image uses the received pixels in place
+        image->swapReceiveBuffer( *payload );
 
     image->setPixelViewport( packet->pvp );
     image->setAlphaUsage( packet->useAlpha );
 
+    // Depth images stay compressed if the CPU compositor merges them without
+    // decompression. All others are decompressed here, in parallel to the
+    // rendering of the pipe threads.
+    const bool keepCompressed = _useCompressed &&
+                                ( packet->buffers & Frame::BUFFER_DEPTH );
+
+    bool valid = true;
     Frame::Buffer buffers[] = { Frame::BUFFER_COLOR, Frame::BUFFER_DEPTH };
     for( unsigned i = 0; i < 2; ++i )
     {
@@ -399,11 +504,39 @@ bool FrameData::addImage( const NodeFrameDataTransmitPacket* packet )
             }
 
             image->setQuality( buffer, header->quality );
-            image->setPixelData( buffer, pixelData );
+            if( payload )
+            {
+                image->setReceivedPixelData( buffer, pixelData );
+                if( !keepCompressed )
+                    image->decompressPixelData( buffer );
+            }
+            else
+                image->setPixelData( buffer, pixelData );
+
+            const ImageHistory::Mode mode =
+                ImageHistory::Mode( header->temporal );
+            if( mode != ImageHistory::MODE_NONE )
+            {
+                if( !_imageHistory )
+                    _imageHistory = new ImageHistory;
+                if( !_imageHistory->decompress( _pendingImages.size(), image,
+                                                buffer, mode ))
+                {
+                    valid = false;
+                }
+            }
         }
     }
 
     EQASSERT( _readyVersion < packet->frameData.version.low( ));
+    if( !valid ) // delta without reference, don't composite it
+    {
+        _imageCacheLock.set();
+        _imageCache.push_back( image );
+        _imageCacheLock.unset();
+        return true;
+    }
+
     EQASSERT( _pendingImages.empty());
     _pendingImages.push_back( image );
     return true;
@@ -27,6 +27,7 @@
 #include <eq/fabric/subPixel.h>      // member
 
 #include <co/object.h>               // base class
+#include <co/base/buffer.h>          // Bufferb
 #include <co/base/monitor.h>         // member
 #include <co/base/spinLock.h>        // member
 
@@ -37,6 +38,7 @@ namespace server
 {
     class FrameData;
 }
+    class  ImageHistory;
     class  ROIFinder;
     struct NodeFrameDataTransmitPacket;
     struct NodeFrameDataReadyPacket;
@@ -70,6 +72,7 @@ namespace server
             uint32_t                compressorFlags;
             uint32_t                nChunks;
             float                   quality;
+            uint32_t                temporal; //!< ImageHistory::Mode
         };
 
         /** Construct a new frame data holder. @version 1.0 */
@@ -142,6 +145,9 @@ namespace server
          * @version 1.0
          */
         void setPixelViewport( const PixelViewport& pvp ) { _data.pvp = pvp; }
+
+        /** @internal @return the covered area for readbacks. */
+        const PixelViewport& getPixelViewport() const { return _data.pvp; }
         
         /**
          * Set alpha usage for newly allocated images.
@@ -152,6 +158,27 @@ namespace server
          */
         void setAlphaUsage( const bool useAlpha ) { _useAlpha = useAlpha; }
 
+        /**
+         * @internal
+         * Enable the readback of only the non-empty regions of depth images.
+         *
+         * The depth buffer is downloaded first to find the regions. Each
+         * non-empty region is then read back into a separate image, which is
+         * compressed, transmitted and composited individually.
+         */
+        void setROIUsage( const bool useROI ) { _useROI = useROI; }
+
+        /**
+         * @internal
+         * Keep received color and depth images compressed.
+         *
+         * Set by the CPU compositor, which merges RLE-compressed images without
+         * decompressing them. Otherwise received images are decompressed by
+         * the receiver thread, in parallel to the rendering of the pipes.
+         */
+        void setCompressedUsage( const bool useCompressed )
+            { _useCompressed = useCompressed; }
+
         /**
          * Set the minimum quality after download and compression.
          *
@@ -218,6 +245,47 @@ namespace server
                        util::ObjectManager< const void* >* glObjects,
                        const DrawableConfig& config );
 
+        /**
+         * Start reading back the images for this frame data.
+         *
+         * Like readback(), but the frame buffer download is only started if
+         * the downloaders support it. The frame data is not set ready until
+         * finishReadback() has been called.
+         *
+         * @param frame the corresponding output frame holder.
+         * @param glObjects the GL object manager for the current GL context.
+         * @param config the configuration of the source frame buffer.
+         * @version 1.1.5
+         */
+        void startReadback( const Frame& frame,
+                            util::ObjectManager< const void* >* glObjects,
+                            const DrawableConfig& config );
+
+        /**
+         * Finish the readback started by startReadback() and set the frame
+         * data ready.
+         *
+         * The OpenGL context used for startReadback() has to be current.
+         *
+         * @param glObjects the GL object manager for the current GL context.
+         * @param config the configuration of the source frame buffer.
+         * @version 1.1.5
+         */
+        void finishReadback( util::ObjectManager< const void* >* glObjects,
+                             const DrawableConfig& config );
+
+        /**
+         * @internal
+         * Delete the OpenGL objects of all images, e.g., the buffers of
+         * asynchronous readbacks.
+         *
+         * @param glObjects the GL object manager for the current GL context.
+         */
+        void deleteGLObjects( util::ObjectManager< const void* >* glObjects );
+
+        /** @return true if a readback needs to be finished. @version 1.1.5 */
+        bool hasPendingReadback() const { return !_readbackImages.empty(); }
+
         /**
          * Set the frame data ready.
          * 
@@ -265,8 +333,16 @@ namespace server
             { _data.buffers &= ~buffer; }
          //@}
 
-        /** @internal */
-        bool addImage( const NodeFrameDataTransmitPacket* packet );
+        /**
+         * @internal
+         * Add a received image.
+         *
+         * @param packet the received image header.
+         * @param payload the received pixel data, or 0 if it follows the
+         *                packet. The image takes over its memory.
+         */
+        bool addImage( const NodeFrameDataTransmitPacket* packet,
+                       co::base::Bufferb* payload );
         void setReady( const NodeFrameDataReadyPacket* packet ); //!< @internal
 
     protected:
@@ -302,6 +378,9 @@ namespace server
 
         Images _pendingImages;
 
+        /** Previous received images for temporal decompression. */
+        ImageHistory* _imageHistory;
+
         uint64_t _version; //!< The current version
 
         typedef co::base::Monitor< uint64_t > Monitor;
@@ -314,7 +393,12 @@ namespace server
         /** External monitors for readiness synchronization. */
         co::base::Lockable< Listeners, co::base::SpinLock > _listeners;
 
+        /** Images of a started readback, to be finished. */
+        Images _readbackImages;
+
         bool _useAlpha;
+        bool _useROI;
+        bool _useCompressed;
         float _colorQuality;
         float _depthQuality;
 
@@ -329,6 +413,21 @@ namespace server
                             const DrawableConfig& config,
                             const bool setQuality );
 
+        /** Read back or start the readback of new images. */
+        bool _startReadback( const Frame& frame,
+                             util::ObjectManager< const void* >* glObjects,
+                             const DrawableConfig& config, const bool async,
+                             Images& images );
+
+        /** Finish the readback of the given images. */
+        void _finishReadback( const Images& images,
+                              const GLEWContext* glewContext );
+
+        /** @return the non-empty regions of the frame buffer depth. */
+        PixelViewports _findRegions( const PixelViewport& absPVP,
+                                  util::ObjectManager< const void* >* glObjects,
+                                     const DrawableConfig& config );
+
         /** Apply all received images of the given version. */
         void _applyVersion( const uint128_t& version );
 
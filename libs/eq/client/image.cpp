@@ -30,6 +30,7 @@
 #include <co/base/memoryMap.h>
 #include <co/base/omp.h>
 #include <co/base/pluginRegistry.h>
+#include <co/base/scopedMutex.h>
 
 // Internal headers
 #include "../../co/base/plugin.h"
@@ -68,6 +69,7 @@ void Image::flush()
 {
     _color.flush();
     _depth.flush();
+    _receiveBuffer.clear();
 }
 
 Image::Attachment::Attachment()
@@ -99,6 +101,19 @@ void Image::Attachment::flush()
     lossyTransfer->reset();
 }
 
+void Image::Attachment::deleteGLObjects( const GLEWContext* glewContext )
+{
+    texture.flush();
+
+    util::GPUCompressor* transfers[] = { fullTransfer, lossyTransfer };
+    for( size_t i = 0; i < 2; ++i )
+    {
+        transfers[i]->setGLEWContext( glewContext );
+        transfers[i]->deleteGLObjects();
+        transfers[i]->setGLEWContext( 0 );
+    }
+}
+
 uint32_t Image::getPixelDataSize( const Frame::Buffer buffer ) const
 {
     const Memory& memory = _getMemory( buffer );
@@ -265,14 +280,13 @@ const util::Texture& Image::getTexture( const Frame::Buffer buffer ) const
 
 const uint8_t* Image::getPixelPointer( const Frame::Buffer buffer ) const
 {
-    EQASSERT( hasPixelData( buffer ));
-    return reinterpret_cast< const uint8_t* >
-          ( _getAttachment( buffer ).memory.pixels );
+    return reinterpret_cast< const uint8_t* >( getPixelData( buffer ).pixels );
 }
 
 uint8_t* Image::getPixelPointer( const Frame::Buffer buffer )
 {
     EQASSERT( hasPixelData( buffer ));
+    decompressPixelData( buffer );
     return  reinterpret_cast< uint8_t* >
           ( _getAttachment( buffer ).memory.pixels );
 }
@@ -280,6 +294,16 @@ uint8_t* Image::getPixelPointer( const Frame::Buffer buffer )
 const PixelData& Image::getPixelData( const Frame::Buffer buffer ) const
 {
     EQASSERT( hasPixelData( buffer ));
+    // Received pixels are decompressed lazily and under a lock, which does not
+    // change the logical content of the image.
+    const_cast< Image* >( this )->decompressPixelData( buffer );
+    return _getAttachment( buffer ).memory;
+}
+
+const PixelData& Image::getCompressedPixelData( const Frame::Buffer buffer )
+    const
+{
+    EQASSERT( hasCompressedPixelData( buffer ));
     return _getAttachment( buffer ).memory;
 }
 
@@ -342,20 +366,55 @@ bool Image::readback( const uint32_t buffers, const PixelViewport& pvp,
     return result;
 }
 
-bool Image::readback( const Frame::Buffer buffer, const util::Texture* texture,
-                      const GLEWContext* glewContext )
+bool Image::startReadback( const uint32_t buffers, const PixelViewport& pvp,
+                           const Zoom& zoom,
+                           util::ObjectManager< const void* >* glObjects )
+{
+    EQASSERT( glObjects );
+    EQLOG( LOG_ASSEMBLY ) << "startReadback async " << pvp << ", buffers "
+                          << buffers << std::endl;
+
+    _pvp = pvp;
+    _color.memory.state = Memory::INVALID;
+    _depth.memory.state = Memory::INVALID;
+
+    bool result = true;
+    if( (buffers & Frame::BUFFER_COLOR) &&
+        !_startReadback( Frame::BUFFER_COLOR, zoom, glObjects ))
+    {
+        result = false;
+    }
+
+    if( (buffers & Frame::BUFFER_DEPTH) &&
+        !_startReadback( Frame::BUFFER_DEPTH, zoom, glObjects ))
+    {
+        result = false;
+    }
+
+    _pvp.x = 0;
+    _pvp.y = 0;
+    return result;
+}
+
+void Image::finishReadback( const GLEWContext* glewContext )
+{
+    _finishReadback( Frame::BUFFER_COLOR, glewContext );
+    _finishReadback( Frame::BUFFER_DEPTH, glewContext );
+}
+
+void Image::deleteGLObjects( const GLEWContext* glewContext )
+{
+    _color.deleteGLObjects( glewContext );
+    _depth.deleteGLObjects( glewContext );
+}
+
+bool Image::_initDownloader( const Frame::Buffer buffer, uint32_t& flags )
 {
     Attachment& attachment = _getAttachment( buffer );
     util::GPUCompressor* downloader = attachment.transfer;
     Memory& memory = attachment.memory;    
     const uint32_t inputToken = memory.internalFormat;
 
-    downloader->setGLEWContext( glewContext );
-
-    uint32_t flags = EQ_COMPRESSOR_TRANSFER | EQ_COMPRESSOR_DATA_2D |
-                     ( texture ? texture->getCompressorTarget() :
-                                 EQ_COMPRESSOR_USE_FRAMEBUFFER );
-
     const bool alpha = _ignoreAlpha && buffer == Frame::BUFFER_COLOR;
     if( !downloader->isValidDownloader( inputToken, alpha, flags ) &&
         !downloader->initDownloader( inputToken, attachment.quality, alpha,
@@ -371,6 +430,24 @@ bool Image::readback( const Frame::Buffer buffer, const util::Texture* texture,
 
     if( !memory.hasAlpha )
         flags |= EQ_COMPRESSOR_IGNORE_ALPHA;
+    return true;
+}
+
+bool Image::readback( const Frame::Buffer buffer, const util::Texture* texture,
+                      const GLEWContext* glewContext )
+{
+    Attachment& attachment = _getAttachment( buffer );
+    util::GPUCompressor* downloader = attachment.transfer;
+    Memory& memory = attachment.memory;    
+
+    downloader->setGLEWContext( glewContext );
+
+    uint32_t flags = EQ_COMPRESSOR_TRANSFER | EQ_COMPRESSOR_DATA_2D |
+                     ( texture ? texture->getCompressorTarget() :
+                                 EQ_COMPRESSOR_USE_FRAMEBUFFER );
+
+    if( !_initDownloader( buffer, flags ))
+        return false;
 
     if( texture )
         downloader->download( PixelViewport( 0, 0, texture->getWidth(),
@@ -443,6 +520,66 @@ bool Image::_readback( const Frame::Buffer buffer, const Zoom& zoom,
     return _readbackZoom( buffer, zoom, glObjects );
 }
 
+bool Image::_startReadback( const Frame::Buffer buffer, const Zoom& zoom,
+                            util::ObjectManager< const void* >* glObjects )
+{
+    if( _type == Frame::TYPE_TEXTURE || zoom != Zoom::NONE )
+        return _readback( buffer, zoom, glObjects );
+
+    Attachment& attachment = _getAttachment( buffer );
+    util::GPUCompressor* downloader = attachment.transfer;
+    Memory& memory = attachment.memory;
+    memory.isCompressed = false;
+
+    downloader->setGLEWContext( glewGetContext( ));
+
+    uint32_t flags = EQ_COMPRESSOR_TRANSFER | EQ_COMPRESSOR_DATA_2D |
+                     EQ_COMPRESSOR_USE_FRAMEBUFFER;
+    if( !_initDownloader( buffer, flags ))
+    {
+        downloader->setGLEWContext( 0 );
+        return false;
+    }
+
+    if( downloader->hasAsyncDownload( ))
+    {
+        downloader->startDownload( _pvp, 0, flags );
+        memory.pvp = _pvp;
+        memory.state = Memory::DOWNLOADING;
+    }
+    else
+    {
+        downloader->download( _pvp, 0, flags, memory.pvp, &memory.pixels );
+        memory.state = Memory::VALID;
+    }
+
+    downloader->setGLEWContext( 0 );
+    return true;
+}
+
+void Image::_finishReadback( const Frame::Buffer buffer,
+                             const GLEWContext* glewContext )
+{
+    Attachment& attachment = _getAttachment( buffer );
+    Memory& memory = attachment.memory;
+    if( memory.state != Memory::DOWNLOADING )
+        return;
+
+    util::GPUCompressor* downloader = attachment.transfer;
+    downloader->setGLEWContext( glewContext );
+
+    uint32_t flags = EQ_COMPRESSOR_TRANSFER | EQ_COMPRESSOR_DATA_2D |
+                     EQ_COMPRESSOR_USE_FRAMEBUFFER;
+    if( !memory.hasAlpha )
+        flags |= EQ_COMPRESSOR_IGNORE_ALPHA;
+
+    const PixelViewport pvp = memory.pvp;
+    downloader->finishDownload( pvp, flags, memory.pvp, &memory.pixels );
+
+    downloader->setGLEWContext( 0 );
+    memory.state = Memory::VALID;
+}
+
 bool Image::_readbackZoom( const Frame::Buffer buffer, const Zoom& zoom,
                            util::ObjectManager< const void* >* glObjects )
 {
@@ -578,6 +715,34 @@ void Image::clearPixelData( const Frame::Buffer buffer )
 #endif
         break;
       }
+      case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+      case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+      {
+        uint16_t* data = reinterpret_cast< uint16_t* >( memory.pixels );
+        const ssize_t nValues = size / sizeof( uint16_t );
+        bzero( data, size );
+
+#ifdef CO_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for( ssize_t i = 3; i < nValues; i+=4 )
+            data[i] = 0x3c00; // 1.0 as half float
+        break;
+      }
+      case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+      case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+      {
+        float* data = reinterpret_cast< float* >( memory.pixels );
+        const ssize_t nValues = size / sizeof( float );
+        bzero( data, size );
+
+#ifdef CO_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for( ssize_t i = 3; i < nValues; i+=4 )
+            data[i] = 1.f;
+        break;
+      }
       default:
         EQWARN << "Unknown external format " << memory.externalFormat
                << ", initializing to 0" << std::endl;
@@ -595,6 +760,18 @@ void Image::validatePixelData( const Frame::Buffer buffer )
 }
 
 void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
+{
+    _setPixelData( buffer, pixels, true );
+}
+
+void Image::setReceivedPixelData( const Frame::Buffer buffer,
+                                  const PixelData& pixels )
+{
+    _setPixelData( buffer, pixels, false );
+}
+
+void Image::_setPixelData( const Frame::Buffer buffer, const PixelData& pixels,
+                           const bool copy )
 {
     Memory& memory = _getMemory( buffer );
     memory.externalFormat = pixels.externalFormat;
@@ -613,13 +790,13 @@ void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
     else
     {
         memory.hasAlpha =
-            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
+            !( transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA );
 #ifndef NDEBUG
         for( co::base::CompressorInfos::const_iterator i = transferrers.begin();
              i != transferrers.end(); ++i )
         {
             EQASSERTINFO( memory.hasAlpha == 
-                          bool( i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA ),
+                          !( i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA ),
                           "Uploaders don't agree on alpha state of external " <<
                           "format: " << transferrers.front() << " != " << *i );
         }
@@ -633,6 +810,16 @@ void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
 
     if( pixels.compressorName <= EQ_COMPRESSOR_NONE )
     {
+        if( pixels.pixels && !copy )
+        {
+            EQASSERT( pixels.pixels >= _receiveBuffer.getData() &&
+                      static_cast< uint8_t* >( pixels.pixels ) + size <=
+                      _receiveBuffer.getData() + _receiveBuffer.getSize( ));
+            memory.pixels = pixels.pixels;
+            memory.state = Memory::VALID;
+            return;
+        }
+
         validatePixelData( buffer ); // alloc memory for pixels
 
         if( pixels.pixels )
@@ -666,17 +853,53 @@ void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
         memory.externalFormat = info.outputTokenType;
         memory.pixelSize = info.outputTokenSize;
     }
+
+    memory.compressorName = pixels.compressorName;
+    memory.compressorFlags = pixels.compressorFlags;
+    memory.compressedData = pixels.compressedData;
+    memory.compressedSize = pixels.compressedSize;
+    memory.isCompressed = true;
+    memory.state = Memory::COMPRESSED;
+
+    if( copy ) // the compressed data is not owned by the image
+        decompressPixelData( buffer );
+    else
+    {
+        EQASSERT( pixels.compressedData.front() >= _receiveBuffer.getData() &&
+                  pixels.compressedData.front() <
+                      _receiveBuffer.getData() + _receiveBuffer.getSize( ));
+    }
+}
+
+void Image::decompressPixelData( const Frame::Buffer buffer )
+{
+    Attachment& attachment = _getAttachment( buffer );
+    Memory& memory = attachment.memory;
+
+    // received images are shared by the pipe threads of a node
+    co::base::ScopedMutex<> mutex( attachment.decompressLock );
+    if( memory.state != Memory::COMPRESSED )
+        return;
+
+    if( !_allocDecompressor( attachment, memory.compressorName ))
+    {
+        EQASSERTINFO( false,
+                      "Can't allocate decompressor " << memory.compressorName );
+        memory.state = Memory::INVALID;
+        return;
+    }
+
     validatePixelData( buffer ); // alloc memory for pixels
 
     uint64_t outDims[4] = { memory.pvp.x, memory.pvp.w,  
                             memory.pvp.y, memory.pvp.h }; 
-    const uint64_t nBlocks = pixels.compressedSize.size();
+    const uint64_t nBlocks = memory.compressedSize.size();
 
-    EQASSERT( nBlocks == pixels.compressedData.size( ));
-    attachment.compressor->decompress( &pixels.compressedData.front(),
-                                       &pixels.compressedSize.front(),
+    EQASSERT( nBlocks == memory.compressedData.size( ));
+    attachment.compressor->decompress( &memory.compressedData.front(),
+                                       &memory.compressedSize.front(),
                                        nBlocks, memory.pixels, outDims,
-                                       pixels.compressorFlags );
+                                       memory.compressorFlags );
 }
 
 Image::Attachment& Image::_getAttachment( const Frame::Buffer buffer )
@@ -954,7 +1177,7 @@ bool Image::writeImage( const std::string& filename,
     const PixelViewport& pvp = memory.pvp;
     const size_t nPixels = pvp.w * pvp.h;
 
-    if( nPixels == 0 || memory.state != Memory::VALID )
+    if( nPixels == 0 || !hasPixelData( buffer ))
         return false;
 
     std::ofstream image( filename.c_str(), std::ios::out | std::ios::binary );
@@ -29,6 +29,7 @@
 
 #include <co/plugins/compressor.h> // EqCompressorInfos typedef
 #include <co/base/buffer.h>          // member
+#include <co/base/lock.h>            // member
 
 
 namespace eq
@@ -181,7 +182,34 @@ namespace eq
          * @version 1.0
          */
         bool hasPixelData( const Frame::Buffer buffer ) const
-            { return _getAttachment( buffer ).memory.state == Memory::VALID; }
+            {
+                const Memory::State state = _getMemory( buffer ).state;
+                return state == Memory::VALID || state == Memory::COMPRESSED;
+            }
+
+        /**
+         * @internal
+         * @return true if the buffer holds received compressed pixel data,
+         *         which is decompressed on the first access to the pixels.
+         * @sa setReceivedPixelData()
+         */
+        bool hasCompressedPixelData( const Frame::Buffer buffer ) const
+            { return _getMemory( buffer ).state == Memory::COMPRESSED; }
+
+        /**
+         * @internal
+         * @return the received compressed pixel data, without decompressing it.
+         * @sa hasCompressedPixelData()
+         */
+        EQ_API const PixelData& getCompressedPixelData( const Frame::Buffer )
+            const;
+
+        /**
+         * @internal
+         * Decompress received pixel data kept compressed by
+         * setReceivedPixelData(). Does nothing if the buffer is not compressed.
+         */
+        EQ_API void decompressPixelData( const Frame::Buffer buffer );
 
         /**
          * Clear and validate an image buffer.
@@ -212,6 +240,30 @@ namespace eq
         EQ_API void setPixelData( const Frame::Buffer buffer,
                                      const PixelData& data );
 
+        /**
+         * @internal
+         * Exchange the memory holding received pixel data with the given
+         * buffer.
+         *
+         * The image keeps the received memory until the next exchange or
+         * flush(), so that setReceivedPixelData() can use it in place.
+         */
+        void swapReceiveBuffer( co::base::Bufferb& buffer )
+            { _receiveBuffer.swap( buffer ); }
+
+        /**
+         * @internal
+         * Set the pixel data of the given image buffer from received data.
+         *
+         * Same as setPixelData(), but uncompressed pixels in the receive
+         * buffer are used in place instead of being copied, and compressed
+         * pixels are kept compressed until they are accessed.
+         *
+         * @sa swapReceiveBuffer()
+         */
+        EQ_API void setReceivedPixelData( const Frame::Buffer buffer,
+                                          const PixelData& data );
+
         /**
          * Set alpha data preservation during download and compression.
          * @version 1.0
@@ -269,6 +321,45 @@ namespace eq
                               const Zoom& zoom,
                               util::ObjectManager< const void* >* glObjects );
 
+        /**
+         * Start reading back an image from the frame buffer.
+         *
+         * Frame buffer attachments are downloaded asynchronously if the
+         * selected downloader supports it, all other attachments are read back
+         * immediately. The pixel data is not valid until finishReadback() has
+         * been called using the same OpenGL context.
+         *
+         * @param buffers bit-wise combination of the Frame::Buffer components.
+         * @param pvp the area of the frame buffer wrt the drawable.
+         * @param zoom the scale factor to apply during readback.
+         * @param glObjects the GL object manager for the current GL context.
+         * @return true when the readback was started, false on error.
+         * @version 1.1.5
+         */
+        EQ_API bool startReadback( const uint32_t buffers,
+                                   const PixelViewport& pvp, const Zoom& zoom,
+                                   util::ObjectManager< const void* >* glObjects
+                                   );
+
+        /**
+         * Finish a readback started by startReadback().
+         *
+         * @param glewContext function table for the current GL context.
+         * @version 1.1.5
+         */
+        EQ_API void finishReadback( const GLEWContext* glewContext );
+
+        /**
+         * Delete the OpenGL objects kept by this image and its transfer
+         * plugins.
+         *
+         * The OpenGL context used for the last readback has to be current.
+         *
+         * @param glewContext function table for the current GL context.
+         * @version 1.1.5
+         */
+        EQ_API void deleteGLObjects( const GLEWContext* glewContext );
+
         /**
          * @internal
          * Read back an image from a given texture.
@@ -365,6 +456,8 @@ namespace eq
             enum State
             {
                 INVALID,
+                DOWNLOADING, //!< async download started, pvp is the source
+                COMPRESSED,  //!< received compressed data, not yet decompressed
                 VALID
             };
 
@@ -390,6 +483,8 @@ namespace eq
             ~Attachment();
 
             void flush();
+            void deleteGLObjects( const GLEWContext* glewContext );
+
             co::base::CPUCompressor* const fullCompressor;
             co::base::CPUCompressor* const lossyCompressor;
 
@@ -406,6 +501,9 @@ namespace eq
 
             /** Current pixel data (memory images). */
             Memory memory;
+
+            /** Serializes the lazy decompression of received pixels. */
+            co::base::Lock decompressLock;
         };
         
         Attachment _color;
@@ -414,6 +512,9 @@ namespace eq
         /** Alpha channel significance. */
         bool _ignoreAlpha;
 
+        /** Received pixel data, referenced by the memory of the attachments. */
+        co::base::Bufferb _receiveBuffer;
+
         struct Private;
         Private* _private; // placeholder for binary-compatible changes
 
@@ -428,6 +529,9 @@ namespace eq
         /** Find and activate a decompression engine */
         bool _allocDecompressor( Attachment& attachment, uint32_t name );
 
+        void _setPixelData( const Frame::Buffer buffer, const PixelData& data,
+                            const bool copy );
+
         void _findTransferers( const Frame::Buffer buffer,
                                const GLEWContext* glewContext,
                                co::base::CompressorInfos& result );
@@ -453,8 +557,15 @@ namespace eq
                                  const uint32_t pixelSize,
                                  const bool hasAlpha );
 
+        /** Select the downloader and update flags, false on error. */
+        bool _initDownloader( const Frame::Buffer buffer, uint32_t& flags );
+
         bool _readback( const Frame::Buffer buffer, const Zoom& zoom,
                         util::ObjectManager< const void* >* glObjects );
+        bool _startReadback( const Frame::Buffer buffer, const Zoom& zoom,
+                             util::ObjectManager< const void* >* glObjects );
+        void _finishReadback( const Frame::Buffer buffer,
+                              const GLEWContext* glewContext );
         bool _readbackZoom( const Frame::Buffer buffer, const Zoom& zoom,
                             util::ObjectManager< const void* >* glObjects );
     };
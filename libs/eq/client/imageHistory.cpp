@@ -0,0 +1,225 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "imageHistory.h"
+
+#include "log.h"
+#include "pixelData.h"
+
+namespace eq
+{
+
+ImageHistory::ImageHistory()
+        : _frame( 0 )
+{}
+
+ImageHistory::~ImageHistory()
+{
+    for( std::vector< Reference* >::const_iterator i = _references.begin();
+         i != _references.end(); ++i )
+    {
+        delete *i;
+    }
+    _references.clear();
+}
+
+bool ImageHistory::startFrame( const uint32_t keyframeInterval )
+{
+    EQASSERT( keyframeInterval > 0 );
+    const bool keyframe = ( _frame == 0 );
+    _frame = ( _frame + 1 ) % keyframeInterval;
+    return keyframe;
+}
+
+const PixelData& ImageHistory::compress( const size_t index, Image* image,
+                                         const Frame::Buffer buffer,
+                                         const bool keyframe, Mode& mode )
+{
+    Reference& reference = _getReference( index, buffer );
+    const PixelData& data = image->getPixelData( buffer );
+    const uint64_t size = image->getPixelDataSize( buffer );
+
+    if( keyframe || !_matches( reference, data ))
+    {
+        _update( reference, data, size );
+        mode = MODE_KEY;
+        return image->compressPixelData( buffer );
+    }
+
+    // The difference is compressed by a separate image, the image itself
+    // might be sent to other nodes using a different history.
+    if( !reference.delta )
+        reference.delta = new Image;
+    Image* delta = reference.delta;
+
+    PixelData pixels;
+    pixels.internalFormat  = data.internalFormat;
+    pixels.externalFormat  = data.externalFormat;
+    pixels.pixelSize       = data.pixelSize;
+    pixels.pvp             = data.pvp;
+    pixels.pixels          = data.pixels;
+    pixels.compressorName  = EQ_COMPRESSOR_NONE;
+
+    delta->setPixelViewport( image->getPixelViewport( ));
+    delta->setAlphaUsage( image->getAlphaUsage( ));
+    delta->setQuality( buffer, image->getQuality( buffer ));
+    delta->useCompressor( buffer, data.compressorName );
+    delta->setPixelData( buffer, pixels );
+    EQASSERT( delta->getPixelDataSize( buffer ) == size );
+
+    _xor( delta->getPixelPointer( buffer ), reference.pixels.getData(), size );
+    _update( reference, data, size );
+
+    mode = MODE_DELTA;
+    return delta->compressPixelData( buffer );
+}
+
+bool ImageHistory::decompress( const size_t index, Image* image,
+                               const Frame::Buffer buffer, const Mode mode )
+{
+    EQASSERT( mode != MODE_NONE );
+    Reference& reference = _getReference( index, buffer );
+    if( mode == MODE_KEY && image->hasCompressedPixelData( buffer ))
+    {
+        _setKeyframe( reference, image->getCompressedPixelData( buffer ));
+        return true;
+    }
+
+    const PixelData& data = image->getPixelData( buffer );
+    const uint64_t size = image->getPixelDataSize( buffer );
+
+    if( mode == MODE_DELTA )
+    {
+        if( !_matches( reference, data ) || !_restore( reference ))
+        {
+            EQWARN << "No reference for temporal image " << index
+                   << ", image is invalid until the next keyframe"
+                   << std::endl;
+            // later deltas are based on this image, don't restore them either
+            reference.pixels.setSize( 0 );
+            reference.keyframeSizes.clear();
+            return false;
+        }
+        _xor( image->getPixelPointer( buffer ), reference.pixels.getData(),
+              size );
+    }
+
+    _update( reference, data, size );
+    return true;
+}
+
+ImageHistory::Reference& ImageHistory::_getReference( const size_t index,
+                                                      const Frame::Buffer
+                                                          buffer )
+{
+    const size_t i = ( index << 1 ) + ( buffer == Frame::BUFFER_DEPTH ? 1 : 0 );
+    while( _references.size() <= i )
+        _references.push_back( new Reference );
+    return *_references[ i ];
+}
+
+bool ImageHistory::_matches( const Reference& reference,
+                             const PixelData& data )
+{
+    return reference.pvp == data.pvp &&
+           reference.externalFormat == data.externalFormat &&
+           reference.pixelSize == data.pixelSize &&
+           ( reference.pixels.getSize() > 0 ||
+             !reference.keyframeSizes.empty( ));
+}
+
+void ImageHistory::_update( Reference& reference, const PixelData& data,
+                            const uint64_t size )
+{
+    reference.pvp = data.pvp;
+    reference.externalFormat = data.externalFormat;
+    reference.pixelSize = data.pixelSize;
+    reference.pixels.replace( data.pixels, size );
+    reference.keyframeSizes.clear();
+}
+
+void ImageHistory::_setKeyframe( Reference& reference, const PixelData& data )
+{
+    EQASSERT( data.isCompressed );
+    reference.pvp = data.pvp;
+    reference.externalFormat = data.externalFormat;
+    reference.pixelSize = data.pixelSize;
+    reference.pixels.setSize( 0 );
+    reference.compressorName = data.compressorName;
+    reference.compressorFlags = data.compressorFlags;
+    reference.keyframeSizes = data.compressedSize;
+
+    uint64_t size = 0;
+    for( size_t i = 0; i < data.compressedSize.size(); ++i )
+        size += data.compressedSize[i];
+
+    uint8_t* keyframe = reference.keyframe.reset( size );
+    for( size_t i = 0; i < data.compressedSize.size(); ++i )
+    {
+        memcpy( keyframe, data.compressedData[i], data.compressedSize[i] );
+        keyframe += data.compressedSize[i];
+    }
+}
+
+bool ImageHistory::_restore( Reference& reference )
+{
+    if( reference.keyframeSizes.empty( ))
+        return true;
+
+    co::base::CPUCompressor& decompressor = reference.decompressor;
+    if( !decompressor.isValid( reference.compressorName ) &&
+        !decompressor.initDecompressor( reference.compressorName ))
+    {
+        EQWARN << "Can't allocate decompressor " << reference.compressorName
+               << std::endl;
+        return false;
+    }
+
+    const std::vector< uint64_t >& sizes = reference.keyframeSizes;
+    std::vector< const void* > chunks( sizes.size( ));
+    const uint8_t* keyframe = reference.keyframe.getData();
+    for( size_t i = 0; i < sizes.size(); ++i )
+    {
+        chunks[i] = keyframe;
+        keyframe += sizes[i];
+    }
+
+    const PixelViewport& pvp = reference.pvp;
+    uint64_t outDims[4] = { pvp.x, pvp.w, pvp.y, pvp.h };
+    reference.pixels.reset( pvp.getArea() * reference.pixelSize );
+    decompressor.decompress( &chunks.front(), &sizes.front(),
+                             unsigned( sizes.size( )),
+                             reference.pixels.getData(), outDims,
+                             reference.compressorFlags );
+    reference.keyframeSizes.clear();
+    return true;
+}
+
+void ImageHistory::_xor( uint8_t* pixels, const uint8_t* reference,
+                         const uint64_t size )
+{
+    const uint64_t nWords = size / sizeof( uint64_t );
+    uint64_t* words = reinterpret_cast< uint64_t* >( pixels );
+    const uint64_t* referenceWords =
+        reinterpret_cast< const uint64_t* >( reference );
+
+    for( uint64_t i = 0; i < nWords; ++i )
+        words[i] ^= referenceWords[i];
+    for( uint64_t i = nWords * sizeof( uint64_t ); i < size; ++i )
+        pixels[i] ^= reference[i];
+}
+
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_IMAGE_HISTORY_H
+#define EQ_IMAGE_HISTORY_H
+
+#include "image.h"   // member
+
+#include <co/base/buffer.h>
+#include <co/base/cpuCompressor.h> // member
+#include <vector>
+
+namespace eq
+{
+    /**
+     * @internal
+     * Keeps the pixels of the previous images of an output frame for temporal
+     * compression.
+     *
+     * The sender transmits the difference (XOR) of each image to the image
+     * with the same index transmitted for the previous frame. The difference
+     * is mostly zero for slow camera motion and compresses very well. The
+     * receiver restores the image from its copy of the previous image. Images
+     * are sent completely for keyframes and when the image layout changed.
+     * Received keyframes stay compressed for compositing, the receiver copies
+     * the compressed data and restores its reference from it for the next
+     * difference.
+     */
+    class ImageHistory
+    {
+    public:
+        /** The temporal encoding of a transmitted image. */
+        enum Mode
+        {
+            MODE_NONE,  //!< not temporally encoded
+            MODE_KEY,   //!< complete image, new reference for deltas
+            MODE_DELTA  //!< difference to the reference image
+        };
+
+        EQ_API ImageHistory();
+        EQ_API ~ImageHistory();
+
+        /**
+         * Start sending the images of a new frame.
+         *
+         * @param keyframeInterval the number of frames between keyframes.
+         * @return true if the images of this frame are sent completely.
+         */
+        bool startFrame( const uint32_t keyframeInterval );
+
+        /**
+         * Compress the given image buffer for sending.
+         *
+         * @param index the index of the image in the frame.
+         * @param image the image to send.
+         * @param buffer the image buffer.
+         * @param keyframe true to send the complete image.
+         * @param mode returns the temporal encoding of the returned data.
+         * @return the compressed pixel data.
+         */
+        const PixelData& compress( const size_t index, Image* image,
+                                   const Frame::Buffer buffer,
+                                   const bool keyframe, Mode& mode );
+
+        /**
+         * Restore a received image buffer.
+         *
+         * @param index the index of the image in the frame.
+         * @param image the decompressed image.
+         * @param buffer the image buffer.
+         * @param mode the temporal encoding of the received data.
+         * @return false if the image could not be restored.
+         */
+        EQ_API bool decompress( const size_t index, Image* image,
+                                const Frame::Buffer buffer, const Mode mode );
+
+    private:
+        struct Reference
+        {
+            Reference() : externalFormat( 0 ), pixelSize( 0 ), delta( 0 )
+                        , compressorName( EQ_COMPRESSOR_NONE )
+                        , compressorFlags( 0 ) {}
+            ~Reference() { delete delta; }
+
+            PixelViewport pvp;
+            uint32_t externalFormat;
+            uint32_t pixelSize;
+            co::base::Bufferb pixels;
+            Image* delta; //!< Sender: compresses the image difference
+
+            /** Receiver: compressed keyframe, not yet restored into pixels */
+            co::base::Bufferb keyframe;
+            std::vector< uint64_t > keyframeSizes;
+            uint32_t compressorName;
+            uint64_t compressorFlags;
+            co::base::CPUCompressor decompressor;
+        };
+        std::vector< Reference* > _references;
+
+        uint32_t _frame; //!< frames sent since the last keyframe
+
+        Reference& _getReference( const size_t index,
+                                  const Frame::Buffer buffer );
+        static bool _matches( const Reference& reference,
+                              const PixelData& data );
+        static void _update( Reference& reference, const PixelData& data,
+                             const uint64_t size );
+        static void _setKeyframe( Reference& reference,
+                                  const PixelData& data );
+        static bool _restore( Reference& reference );
+        static void _xor( uint8_t* pixels, const uint8_t* reference,
+                          const uint64_t size );
+    };
+}
+
+#endif // EQ_IMAGE_HISTORY_H
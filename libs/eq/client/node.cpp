@@ -53,10 +53,12 @@ Node::Node( Config* parent )
 #pragma warning(push)
 #pragma warning(disable: 4355)
         , transmitter( this )
-#pragma warning(pop)
+        , transmitSender( this )
         , _state( STATE_STOPPED )
         , _finishedFrame( 0 )
         , _unlockedFrame( 0 )
+        , _frameDataReceiver( this )
+#pragma warning(pop)
 {
 }
 
@@ -394,6 +396,21 @@ void Node::TransmitThread::run()
     }
 }
 
+void Node::TransmitSender::run()
+{
+    co::base::Thread::setName( std::string( "Snd " ) +
+                               co::base::className( _node ));
+    while( true )
+    {
+        Task* task = _queue.pop();
+        if( !task )
+            return; // exit thread
+
+        task->send();
+        delete task;
+    }
+}
+
 void Node::dirtyClientExit()
 {
     const Pipes& pipes = getPipes();
@@ -404,6 +421,8 @@ void Node::dirtyClientExit()
     }
     transmitter.getQueue().wakeup();
     transmitter.join();
+    transmitSender.exit();
+    transmitSender.join();
 }
 
 //---------------------------------------------------------------------------
@@ -465,6 +484,10 @@ bool Node::_cmdConfigInit( co::Command& command )
     _finishedFrame = packet->frameNumber;
 
     transmitter.start();
+    transmitSender.start();
+    getLocalNode()->registerPayloadReceiver(
+        co::PACKETTYPE_CO_OBJECT, fabric::CMD_NODE_FRAMEDATA_TRANSMIT,
+        &_frameDataReceiver );
     setError( ERROR_NONE );
     NodeConfigInitReplyPacket reply;
     reply.result = configInit( packet->initID );
@@ -495,6 +518,11 @@ bool Node::_cmdConfigExit( co::Command& command )
     _state = configExit() ? STATE_STOPPED : STATE_FAILED;
     transmitter.getQueue().wakeup();
     transmitter.join();
+    transmitSender.exit();
+    transmitSender.join();
+    getLocalNode()->registerPayloadReceiver(
+        co::PACKETTYPE_CO_OBJECT, fabric::CMD_NODE_FRAMEDATA_TRANSMIT,
+        0 );
     _flushObjects();
 
     ConfigDestroyNodePacket destroyPacket( getID( ));
@@ -589,10 +617,56 @@ bool Node::_cmdFrameDataTransmit( co::Command& command )
 
     NodeStatistics event( Statistic::NODE_FRAME_DECOMPRESS, this,
                           packet->frameNumber );
-    EQCHECK( frameData->addImage( packet ));
+    EQCHECK( frameData->addImage( packet, command.getPayload( )));
     return true;
 }
 
+uint64_t Node::FrameDataReceiver::getHeaderSize() const
+{
+    return sizeof( NodeFrameDataTransmitPacket ) - 8 * sizeof( uint8_t );
+}
+
+Node::FrameDataReceiver::~FrameDataReceiver()
+{
+    co::base::ScopedMutex< co::base::SpinLock > mutex( _buffers );
+    for( Buffers::const_iterator i = _buffers->begin();
+         i != _buffers->end(); ++i )
+    {
+        delete *i;
+    }
+    _buffers->clear();
+}
+
+co::base::Bufferb* Node::FrameDataReceiver::allocPayload(
+    const co::Packet* packet, const uint64_t size )
+{
+    const NodeFrameDataTransmitPacket* transmitPacket =
+        static_cast< const NodeFrameDataTransmitPacket* >( packet );
+    if( transmitPacket->objectID != _node->getID( ))
+        return 0; // same command of another object
+
+    co::base::Bufferb* buffer = 0;
+    {
+        co::base::ScopedMutex< co::base::SpinLock > mutex( _buffers );
+        if( !_buffers->empty( ))
+        {
+            buffer = _buffers->back();
+            _buffers->pop_back();
+        }
+    }
+
+    if( !buffer )
+        buffer = new co::base::Bufferb;
+    buffer->reset( size );
+    return buffer;
+}
+
+void Node::FrameDataReceiver::releasePayload( co::base::Bufferb* payload )
+{
+    co::base::ScopedMutex< co::base::SpinLock > mutex( _buffers );
+    _buffers->push_back( payload );
+}
+
 bool Node::_cmdFrameDataReady( co::Command& command )
 {
     const NodeFrameDataReadyPacket* packet =
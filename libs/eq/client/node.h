@@ -24,6 +24,7 @@
 #include <eq/client/visitorResult.h>  // enum
 #include <eq/fabric/node.h>           // base class
 
+#include <co/payloadReceiver.h>       // member base class
 #include <co/types.h>
 #include <co/base/mtQueue.h>          // member
 
@@ -127,6 +128,43 @@ namespace eq
             Node* const           _node;
         } transmitter;
 
+        /**
+         * @internal
+         * Sends output frame images prepared by the transmitter.
+         *
+         * Used by the pipelined frame transmission to overlap the compression
+         * of the next image with sending the previous image.
+         */
+        class TransmitSender : public co::base::Thread
+        {
+        public:
+            /** A send operation queued by the transmitter. */
+            class Task
+            {
+            public:
+                virtual ~Task() {}
+
+                /** Send the data. The task is deleted afterwards. */
+                virtual void send() = 0;
+            };
+
+            TransmitSender( Node* parent ) : _node( parent ) {}
+            virtual ~TransmitSender() {}
+
+            /** Queue a task, blocks while another task is pending. */
+            void push( Task* task ) { EQASSERT( task ); _queue.push( task ); }
+
+            /** Exit the thread after all pending tasks have been sent. */
+            void exit() { _queue.push( 0 ); }
+
+        protected:
+            virtual void run();
+
+        private:
+            co::base::MTQueue< Task*, 1 > _queue;
+            Node* const _node;
+        } transmitSender;
+
         /** @internal @sa Serializable::setDirty() */
         EQ_API virtual void setDirty( const uint64_t bits );
 
@@ -277,6 +315,26 @@ namespace eq
         /** All frame datas used by the node during rendering. */
         co::base::Lockable< FrameDataHash > _frameDatas;
 
+        /** Receives frame pixel data into pooled memory used by the images. */
+        class FrameDataReceiver : public co::PayloadReceiver
+        {
+        public:
+            FrameDataReceiver( Node* parent ) : _node( parent ) {}
+            virtual ~FrameDataReceiver();
+
+            virtual uint64_t getHeaderSize() const;
+            virtual co::base::Bufferb* allocPayload( const co::Packet* packet,
+                                                     const uint64_t size );
+            virtual void releasePayload( co::base::Bufferb* payload );
+
+        private:
+            Node* const _node;
+
+            typedef std::vector< co::base::Bufferb* > Buffers;
+            /** Unused memory for received pixel data. */
+            co::base::Lockable< Buffers, co::base::SpinLock > _buffers;
+        } _frameDataReceiver;
+
         struct Private;
         Private* _private; // placeholder for binary-compatible changes
 
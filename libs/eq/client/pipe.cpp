@@ -18,6 +18,7 @@
 
 #include "pipe.h"
 
+#include "channel.h"
 #include "client.h"
 #include "config.h"
 #include "exception.h"
@@ -71,6 +72,12 @@ public:
 protected:
     virtual void run();
     virtual bool stopRunning() { return !_pipe; }
+    virtual bool notifyIdle()
+        {
+            if( _pipe )
+                _pipe->finishReadbacks();
+            return false;
+        }
 
 private:
     Pipe* _pipe;
@@ -218,6 +225,21 @@ MessagePump* Pipe::getMessagePump()
     return queue->getMessagePump();
 }
 
+void Pipe::finishReadbacks()
+{
+    EQ_TS_THREAD( _pipeThread );
+    const Windows& windows = getWindows();
+    for( Windows::const_iterator i = windows.begin(); i != windows.end(); ++i )
+    {
+        const Channels& channels = (*i)->getChannels();
+        for( Channels::const_iterator j = channels.begin();
+             j != channels.end(); ++j )
+        {
+            (*j)->finishReadbacks();
+        }
+    }
+}
+
 void Pipe::Thread::run()
 {
     EQ_TS_THREAD( _pipe->_pipeThread );
@@ -292,7 +314,7 @@ Frame* Pipe::getFrame( const co::ObjectVersion& frameVersion, const Eye eye,
     return frame;
 }
 
-void Pipe::flushFrames()
+void Pipe::flushFrames( util::ObjectManager< const void* >* glObjects )
 {
     EQ_TS_THREAD( _pipeThread );
     ClientPtr client = getClient();
@@ -311,6 +333,8 @@ void Pipe::flushFrames()
          i != _outputFrameDatas.end(); ++i)
     {
         FrameData* data = i->second;
+        if( glObjects )
+            data->deleteGLObjects( glObjects );
         data->flush();
     }
     _outputFrameDatas.clear();
@@ -834,6 +858,7 @@ bool Pipe::_cmdFrameStart( co::Command& command )
         command.get<PipeFrameStartPacket>();
     EQVERB << "handle pipe frame start " << packet << std::endl;
     EQLOG( LOG_TASKS ) << "---- TASK start frame ---- " << packet << std::endl;
+    finishReadbacks();
     sync( packet->version );
     const int64_t lastFrameTime = _frameTime;
 
@@ -871,6 +896,7 @@ bool Pipe::_cmdFrameFinish( co::Command& command )
     EQASSERTINFO( _currentFrame >= frameNumber, 
                   "current " << _currentFrame << " finish " << frameNumber );
 
+    finishReadbacks();
     frameFinish( packet->frameID, frameNumber );
     
     EQASSERTINFO( _finishedFrame >= frameNumber, 
@@ -910,6 +936,7 @@ bool Pipe::_cmdFrameDrawFinish( co::Command& command )
     EQLOG( LOG_TASKS ) << "TASK draw finish " << getName() <<  " " << packet
                        << std::endl;
 
+    finishReadbacks();
     frameDrawFinish( packet->frameID, packet->frameNumber );
     return true;
 }
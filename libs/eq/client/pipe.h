@@ -124,8 +124,13 @@ namespace eq
         /** @internal @return the queue for the given identifier and version. */
         co::QueueSlave* getQueue( const co::ObjectVersion& queueVersion );
 
-        /** @internal Clear the frame cache and delete all frames. */
-        void flushFrames();
+        /**
+         * @internal
+         * Clear the frame cache and delete all frames.
+         *
+         * @param glObjects the GL object manager for the current GL context.
+         */
+        void flushFrames( util::ObjectManager< const void* >* glObjects );
 
         /** @internal @return if the window is made current */
         bool isCurrent( const Window* window ) const;
@@ -168,6 +173,17 @@ namespace eq
         /** @internal Start the pipe thread. */
         void startThread();
 
+        /** @internal @return true if the pipe uses its own pipe thread. */
+        bool isThreaded() const { return _thread != 0; }
+
+        /**
+         * @internal
+         * Finish the asynchronous readbacks of all channels.
+         *
+         * Called when the pipe thread is idle or before it blocks.
+         */
+        void finishReadbacks();
+
         /** @internal Trigger pipe thread exit and wait for completion. */
         void exitThread();
 
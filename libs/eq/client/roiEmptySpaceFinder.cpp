@@ -45,7 +45,7 @@ void ROIEmptySpaceFinder::update( const uint8_t* mask,
 
     _mask = mask;
     const uint8_t*  s = mask + _w*(_h-1);
-          uint16_t* d = &_data[_w*(_h-1)];
+          int32_t*  d = &_data[_w*(_h-1)];
 
     // First element
     d[_w-1] = s[_w-1] > 0 ? 1 : 0;
@@ -57,10 +57,10 @@ void ROIEmptySpaceFinder::update( const uint8_t* mask,
     // All other raws
     for( int32_t y = 1; y < _h; y++ )
     {
-        const uint16_t* dp = d; // previous calculated raw
+        const int32_t* dp = d; // previous calculated raw
         s -= _w;
         d -= _w;
-        uint16_t rawSum = 0;
+        int32_t rawSum = 0;
         for( int32_t x = _w-1; x >= 0; x-- )
         {
             rawSum += s[x] > 0 ? 1 : 0;
@@ -70,22 +70,22 @@ void ROIEmptySpaceFinder::update( const uint8_t* mask,
 }
 
 
-inline uint16_t ROIEmptySpaceFinder::getArea(
+inline int32_t ROIEmptySpaceFinder::getArea(
                                     const int32_t x, const int32_t y,
                                     const int32_t w, const int32_t h ) const
 {
     return  getArea( x, y, w, h, &_data[0] + y * _w + x );
 }
 
-inline uint16_t ROIEmptySpaceFinder::getArea(
+inline int32_t ROIEmptySpaceFinder::getArea(
                                     const int32_t x, const int32_t y,
                                     const int32_t w, const int32_t h,
-                                    const uint16_t* data ) const
+                                    const int32_t* data ) const
 {
     EQASSERT( x >= 0 && w > 0 && x+w < _w );
     EQASSERT( y >= 0 && h > 0 && y+h < _h );
 
-    const uint16_t* data_ = data + h*_w;
+    const int32_t* data_ = data + h*_w;
     return  *data - data[ w ] - *data_ + data_[ w ];
 }
 
@@ -94,9 +94,9 @@ bool ROIEmptySpaceFinder::_updateMaximalEmptyRegion(
                                     const int32_t x, const int32_t y,
                                     const int32_t w, const int32_t h,
                                     PixelViewport& pvp,
-                                    const uint16_t* data ) const
+                                    const int32_t* data ) const
 {
-    uint16_t maxArea = pvp.w * pvp.h;
+    int32_t maxArea = pvp.w * pvp.h;
     bool updated = false;
     int32_t maxW = 0;
     int32_t maxH = 0;
@@ -183,8 +183,8 @@ const
 
     PixelViewport res( pvp.x, pvp.y, 0, 0 );
 
-          uint16_t maxArea = getArea( pvp.x, pvp.y, pvp.w, pvp.h );
-    const uint16_t minRel  = static_cast<uint16_t>( pvp.w * pvp.h * _limRel );
+          int32_t maxArea = getArea( pvp.x, pvp.y, pvp.w, pvp.h );
+    const int32_t minRel  = static_cast<int32_t>( pvp.w * pvp.h * _limRel );
 
     // totally empty
     if( maxArea == 0 )
@@ -199,7 +199,7 @@ const
         return res;
 
     // search for biggest empty pvp
-    const uint16_t* data    = &_data[0] + pvp.y * _w;
+    const int32_t*  data    = &_data[0] + pvp.y * _w;
     const uint8_t*  m       = _mask     + pvp.y * _w;
 
     maxArea = 0;
@@ -230,7 +230,7 @@ const
         data += _w;
     }
 
-    const uint16_t curArea = res.w * res.h;
+    const int32_t curArea = res.w * res.h;
     if( curArea < _limAbs || curArea < minRel )
         return PixelViewport( pvp.x, pvp.y, 0, 0 );
 
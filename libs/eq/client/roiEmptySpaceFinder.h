@@ -39,14 +39,14 @@ namespace eq
             Uses mask data from update to check if single block is empty! */
         PixelViewport getLargestEmptyArea( const PixelViewport& pvp ) const;
 
-        inline uint16_t getArea( const int32_t x, const int32_t y,
-                                 const int32_t w, const int32_t h ) const;
+        inline int32_t getArea( const int32_t x, const int32_t y,
+                                const int32_t w, const int32_t h ) const;
 
-        inline uint16_t getArea( const int32_t x, const int32_t y,
-                                 const int32_t w, const int32_t h,
-                                 const uint16_t* data ) const;
+        inline int32_t getArea( const int32_t x, const int32_t y,
+                                const int32_t w, const int32_t h,
+                                const int32_t* data ) const;
 
-        void setLimits( const int16_t absolute, const float relative )
+        void setLimits( const int32_t absolute, const float relative )
         {
             _limAbs = absolute;
             _limRel = relative;
@@ -61,15 +61,15 @@ namespace eq
         bool _updateMaximalEmptyRegion( const int32_t x, const int32_t y,
                                         const int32_t w, const int32_t h,
                                         PixelViewport& pvp,
-                                        const uint16_t* data ) const;
+                                        const int32_t* data ) const;
 
         int32_t _w;
         int32_t _h;
 
-        int16_t _limAbs;
+        int32_t _limAbs;
         float   _limRel;
 
-        Vectorus _data;
+        std::vector< int32_t > _data;
         const uint8_t* _mask;
     };
 }
@@ -37,6 +37,8 @@
 #include <co/base/os.h>
 #include <co/plugins/compressor.h>
 
+#include <algorithm>
+
 
 namespace eq
 {
@@ -100,8 +102,8 @@ PixelViewport ROIFinder::_getObjectPVP( const PixelViewport& pvp,
     // Calculate per-pixel histograms
     const uint8_t* s = src + pvp.y*_wb + pvp.x;
 
-    memset( _histX, 0, pvp.w );
-    memset( _histY, 0, pvp.h );
+    std::fill( _histX.begin(), _histX.begin() + pvp.w, 0 );
+    std::fill( _histY.begin(), _histY.begin() + pvp.h, 0 );
     for( int32_t y = 0; y < pvp.h; y++ )
     {
         for( int32_t x = 0; x < pvp.w; x++ )
@@ -171,10 +173,16 @@ void ROIFinder::_resize( const PixelViewport& pvp )
     {
         _mask.resize( _wbhb );
         _tmpMask.resize( _wbhb );
+    }
+
+    if( static_cast<int32_t>(_histX.size()) < _wb )
+        _histX.resize( _wb );
+    if( static_cast<int32_t>(_histY.size()) < _hb )
+        _histY.resize( _hb );
 
-        // w * h * sizeof( GL_FLOAT ) * RGBA
+    // w * h * sizeof( GL_FLOAT ) * RGBA
+    if( static_cast<int32_t>(_perBlockInfo.size()) < _wh * 4 )
         _perBlockInfo.resize( _wh * 4 );
-    }
 }
 
 
@@ -520,10 +528,10 @@ void ROIFinder::_findAreas( PixelViewports& resultPVPs )
 #endif
 
         PixelViewport& pvp = resultPVPs[i];
-        pvp.x += _pvp.x;
-        pvp.y += _pvp.y;
-
-        pvp.apply( Zoom( GRID_SIZE, GRID_SIZE ));
+        pvp.x = ( pvp.x + _pvp.x ) * GRID_SIZE;
+        pvp.y = ( pvp.y + _pvp.y ) * GRID_SIZE;
+        pvp.w *= GRID_SIZE;
+        pvp.h *= GRID_SIZE;
     }
 
 }
@@ -762,6 +770,75 @@ for( int i = 0; i < 100; i++ ) {
     return result;
 }
 
+PixelViewports ROIFinder::findRegions( const Image& image )
+{
+    const PixelViewport& imagePVP = image.getPixelViewport();
+    const PixelViewport pvp( 0, 0, imagePVP.w, imagePVP.h );
+
+    PixelViewports result;
+    result.push_back( pvp );
+
+    if( !image.hasPixelData( Frame::BUFFER_DEPTH ) || pvp.getArea() < 100 )
+        return result;
+
+    const PixelData& data = image.getPixelData( Frame::BUFFER_DEPTH );
+    if( data.externalFormat != EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT ||
+        data.pvp.w != pvp.w || data.pvp.h != pvp.h )
+    {
+        return result; // not a plain depth buffer
+    }
+
+    _pvpOriginal = pvp;
+    _resize( _getBoundingPVP( pvp ));
+
+    // a block is empty if all its depth values are on the far plane
+    const uint32_t* depth = reinterpret_cast< const uint32_t* >( data.pixels );
+    for( int32_t by = 0; by < _h; ++by )
+    {
+        float* info = &_perBlockInfo[ by * _w * 4 ];
+        for( int32_t bx = 0; bx < _w; ++bx )
+            info[ bx * 4 ] = 1.f;
+
+        const int32_t yEnd = EQ_MIN( ( by + 1 ) * GRID_SIZE, pvp.h );
+        for( int32_t y = by * GRID_SIZE; y < yEnd; ++y )
+        {
+            const uint32_t* row = depth + y * pvp.w;
+            for( int32_t bx = 0; bx < _w; ++bx )
+            {
+                if( info[ bx * 4 ] < 1.f ) // already known to be occupied
+                    continue;
+
+                const int32_t xEnd = EQ_MIN( ( bx + 1 ) * GRID_SIZE, pvp.w );
+                for( int32_t x = bx * GRID_SIZE; x < xEnd; ++x )
+                {
+                    if( row[ x ] != 0xffffffffu )
+                    {
+                        info[ bx * 4 ] = 0.f;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    _init( );
+    _emptyFinder.update( &_mask[0], _wb, _hb );
+    _emptyFinder.setLimits( 200, 0.002f );
+
+    PixelViewports areas;
+    _findAreas( areas );
+
+    result.clear();
+    for( PixelViewports::iterator i = areas.begin(); i != areas.end(); ++i )
+    {
+        PixelViewport& area = *i;
+        area.intersect( pvp );
+        if( area.hasArea( ))
+            result.push_back( area );
+    }
+    return result;
+}
+
 const GLEWContext* ROIFinder::glewGetContext() const
 {
     EQASSERT( _glObjects );
@@ -37,7 +37,7 @@ namespace eq
     class ROIFinder
     {
     public:
-        ROIFinder();
+        EQ_API ROIFinder();
         virtual ~ROIFinder() {}
 
         /**
@@ -59,6 +59,17 @@ namespace eq
                                     const uint128_t&       frameID,
                                     ObjectManager*         glObjects );
 
+        /**
+         * Selects the non-empty areas of a read-back image.
+         *
+         * The areas are found using the depth buffer of the image in main
+         * memory, where empty pixels have the far plane depth value.
+         *
+         * @param image the image with its depth buffer in main memory.
+         * @return Areas with pixel data, relative to the image data.
+         */
+        EQ_API PixelViewports findRegions( const Image& image );
+
         /** @return the GL function table, valid during findRegions(). */
         const GLEWContext* glewGetContext() const;
 
@@ -107,10 +118,10 @@ namespace eq
             to estimate optimal split */
         struct Dims
         {
-            uint8_t x1, x2, x3;
-            uint8_t y1, y2, y3;
-            uint8_t w1, w2, w3, w4, w5, w6, w7, w8;
-            uint8_t h1, h2, h3, h4, h5, h6, h7, h8;
+            int32_t x1, x2, x3;
+            int32_t y1, y2, y3;
+            int32_t w1, w2, w3, w4, w5, w6, w7, w8;
+            int32_t h1, h2, h3, h4, h5, h6, h7, h8;
         } _dim;
 
         /** Describes region that is used to search holes withing */
@@ -148,8 +159,8 @@ namespace eq
 
         std::vector<float> _perBlockInfo; //!< buffer for data from GPU
 
-        uint8_t _histX[256]; //!< histogram to find BB along X axis
-        uint8_t _histY[256]; //!< histogram to find BB along Y axis
+        std::vector< int32_t > _histX; //!< histogram to find BB along X axis
+        std::vector< int32_t > _histY; //!< histogram to find BB along Y axis
 
         Image _tmpImg;   //!< used for dumping debug info
 
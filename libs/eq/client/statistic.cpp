@@ -51,6 +51,10 @@ static StatisticData _statisticData[] =
    "wait frame",   Vector3f( 1.0f, 0.f, 0.f ) }, 
  { Statistic::CHANNEL_READBACK,
    "readback",     Vector3f( 1.0f, .5f, .5f ) }, 
+ { Statistic::CHANNEL_READBACK_ROI,
+   "ROI",          Vector3f( 1.0f, .7f, .7f ) }, 
+ { Statistic::CHANNEL_READBACK_FINISH,
+   "finish readback", Vector3f( .8f, .3f, .3f ) }, 
  { Statistic::CHANNEL_VIEW_FINISH,
    "view finish",  Vector3f( 1.f, 0.f, 1.0f ) }, 
  { Statistic::CHANNEL_FRAME_TRANSMIT,
@@ -59,6 +63,8 @@ static StatisticData _statisticData[] =
    "compress",     Vector3f( 0.f, .7f, 1.f ) }, 
  { Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN,
    "wait send token", Vector3f( 1.f, 0.f, 0.f ) }, 
+ { Statistic::CHANNEL_FRAME_SEND,
+   "send",         Vector3f( .5f, .5f, 1.f ) }, 
  { Statistic::WINDOW_FINISH,
    "finish",       Vector3f( 1.0f, 1.0f, 0.f ) },
  { Statistic::WINDOW_THROTTLE_FRAMERATE,
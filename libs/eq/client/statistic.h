@@ -45,11 +45,16 @@ namespace eq
             CHANNEL_ASSEMBLE, //!< Sampling of Channel::frameAssemble
             CHANNEL_FRAME_WAIT_READY, //!< Sampling of Frame::waitReady
             CHANNEL_READBACK, //!< Sampling of Channel::frameReadback
+            /** Pixels kept by region of interest detection during readback */
+            CHANNEL_READBACK_ROI,
+            /** Sampling of finishing an asynchronous readback */
+            CHANNEL_READBACK_FINISH,
             CHANNEL_VIEW_FINISH, //!< Sampling of Channel::frameViewFinish
             CHANNEL_FRAME_TRANSMIT, //!< Sampling of frame transmission
             CHANNEL_FRAME_COMPRESS, //!< Sampling of frame compression
             /** Sampling of waiting for a send token from the receiver */
             CHANNEL_FRAME_WAIT_SENDTOKEN,
+            CHANNEL_FRAME_SEND, //!< Sampling of sending one output image
             WINDOW_FINISH, //!< Sampling of Window::finish before a swap barrier
             /** Sampling of throttling of framerate_equalizer */
             WINDOW_THROTTLE_FRAMERATE,
@@ -69,7 +74,7 @@ namespace eq
         uint32_t frameNumber; //!< The frame during when the sampling happened
         uint32_t task; //!< @internal
         uint32_t plugins[2]; //!< color,depth plugins (readback, compression)
-        float ratio; //!< compression ratio (transfer, compression)
+        float ratio; //!< compression ratio (transfer, compression, ROI)
         
         union
         {
@@ -728,7 +728,7 @@ bool Window::_cmdConfigExit( co::Command& command )
         if( getPipe()->isRunning( ) && _systemWindow )
         {
             makeCurrent();
-            getPipe()->flushFrames();
+            getPipe()->flushFrames( _objectManager );
         }
         // else emergency exit, no context available.
 
@@ -811,6 +811,7 @@ bool Window::_cmdBarrier( co::Command& command )
     EQVERB << "handle barrier " << packet << std::endl;
     EQLOG( LOG_TASKS ) << "TASK swap barrier  " << getName() << std::endl;
     
+    getPipe()->finishReadbacks();
     _enterBarrier( packet->barrier );
     return true;
 }
@@ -824,6 +825,7 @@ bool Window::_cmdNVBarrier( co::Command& command )
     makeCurrent();
     _systemWindow->joinNVSwapBarrier( packet->group, packet->barrier );
 
+    getPipe()->finishReadbacks();
     _enterBarrier( packet->netBarrier );
     return true;
 }
@@ -312,6 +312,14 @@ namespace fabric
             IATTR_HINT_STATISTICS,
             /** Use a send token for output frames (OFF, ON) */
             IATTR_HINT_SENDTOKEN,
+            /** Overlap compression and sending of output frames (OFF, ON) */
+            IATTR_HINT_TRANSMIT_PIPELINE,
+            /** Send output frames as delta to the last frame (OFF, ON, N) */
+            IATTR_HINT_TEMPORAL_COMPRESSION,
+            /** Read back only non-empty regions of depth frames (OFF, ON) */
+            IATTR_HINT_ROI,
+            /** Finish frame buffer downloads asynchronously (OFF, ON) */
+            IATTR_HINT_ASYNC_READBACK,
             IATTR_LAST,
             IATTR_ALL = IATTR_LAST + 5
         };
@@ -34,6 +34,10 @@ namespace
 static std::string _iAttributeStrings[] = {
     MAKE_ATTR_STRING( IATTR_HINT_STATISTICS ),
     MAKE_ATTR_STRING( IATTR_HINT_SENDTOKEN ),
+    MAKE_ATTR_STRING( IATTR_HINT_TRANSMIT_PIPELINE ),
+    MAKE_ATTR_STRING( IATTR_HINT_TEMPORAL_COMPRESSION ),
+    MAKE_ATTR_STRING( IATTR_HINT_ROI ),
+    MAKE_ATTR_STRING( IATTR_HINT_ASYNC_READBACK ),
 };
 }
 
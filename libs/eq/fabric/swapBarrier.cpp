@@ -24,18 +24,20 @@ namespace fabric
 
 std::ostream& operator << ( std::ostream& os, const SwapBarrier& swapBarrier )
 {
-    if( swapBarrier.isNvSwapBarrier( ))
-        return os << co::base::disableFlush << "swapbarrier" << std::endl 
-                  << "{"<< std::endl 
-                  << "    name \"" << swapBarrier.getName() << "\"" << std::endl
-                  << "    NV_group " << swapBarrier.getNVSwapGroup() <<std::endl
-                  << "    NV_barrier " << swapBarrier.getNVSwapBarrier()
-                  << std::endl
-                  << "}"  << co::base::enableFlush << std::endl; 
+    if( !swapBarrier.isNvSwapBarrier() && !swapBarrier.getFanOut( ))
+        return os << co::base::disableFlush << "swapbarrier { name \""
+                  << swapBarrier.getName() << "\" }" << co::base::enableFlush
+                  << std::endl;
 
-    return os << co::base::disableFlush << "swapbarrier { name \"" 
-              << swapBarrier.getName() << "\" }" << co::base::enableFlush
-              << std::endl;
+    os << co::base::disableFlush << "swapbarrier" << std::endl
+       << "{"<< std::endl
+       << "    name \"" << swapBarrier.getName() << "\"" << std::endl;
+    if( swapBarrier.isNvSwapBarrier( ))
+        os << "    NV_group " << swapBarrier.getNVSwapGroup() << std::endl
+           << "    NV_barrier " << swapBarrier.getNVSwapBarrier() << std::endl;
+    if( swapBarrier.getFanOut( ))
+        os << "    fanout " << swapBarrier.getFanOut() << std::endl;
+    return os << "}"  << co::base::enableFlush << std::endl;
 }
 
 }
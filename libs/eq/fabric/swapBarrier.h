@@ -40,7 +40,7 @@ namespace fabric
         /** 
          * Constructs a new SwapBarrier.
          */
-        SwapBarrier() : _nvSwapGroup( 0 ), _nvSwapBarrier( 0 ) {}
+        SwapBarrier() : _nvSwapGroup( 0 ), _nvSwapBarrier( 0 ), _fanOut( 0 ) {}
 
         /** @name Data Access. */
         //@{
@@ -56,6 +56,18 @@ namespace fabric
 
         bool isNvSwapBarrier() const
             { return ( _nvSwapBarrier || _nvSwapGroup ); }
+
+        /**
+         * Set the fan-out of the network barrier tree.
+         *
+         * A non-zero fan-out arranges the nodes entering the barrier in a
+         * tree, which scales better to many nodes than notifying the barrier
+         * master from all nodes.
+         */
+        void setFanOut( const uint32_t fanOut ) { _fanOut = fanOut; }
+
+        /** @return the fan-out of the barrier tree, 0 for a flat barrier. */
+        uint32_t getFanOut() const { return _fanOut; }
         //@}
 
     private:
@@ -63,6 +75,7 @@ namespace fabric
 
         uint32_t _nvSwapGroup;
         uint32_t _nvSwapBarrier;
+        uint32_t _fanOut;
     };
 
     EQFABRIC_API std::ostream& operator << ( std::ostream&, const SwapBarrier& );
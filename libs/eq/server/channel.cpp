@@ -518,7 +518,15 @@ void Channel::output( std::ostream& os ) const
         os << ( i==IATTR_HINT_STATISTICS ?
                 "hint_statistics   " :
                 i==IATTR_HINT_SENDTOKEN ?
-                    "hint_sendtoken    " : "ERROR" )
+                    "hint_sendtoken    " :
+                i==IATTR_HINT_TRANSMIT_PIPELINE ?
+                    "hint_transmit_pipeline " :
+                i==IATTR_HINT_TEMPORAL_COMPRESSION ?
+                    "hint_temporal_compression " :
+                i==IATTR_HINT_ROI ?
+                    "hint_roi          " :
+                i==IATTR_HINT_ASYNC_READBACK ?
+                    "hint_async_readback " : "ERROR" )
            << static_cast< fabric::IAttribute >( value ) << std::endl;
     }
     
@@ -27,6 +27,8 @@
 #include <eq/client/log.h>
 #include <eq/fabric/iAttribute.h>
 
+#include <co/barrier.h>
+
 namespace eq
 {
 namespace server
@@ -266,7 +268,14 @@ void CompoundUpdateOutputVisitor::_updateSwapBarriers( Compound* compound )
     else
     {
         const std::string& name = swapBarrier->getName();
-        _swapBarriers[name] = window->joinSwapBarrier( _swapBarriers[name] );
+        co::Barrier* barrier = window->joinSwapBarrier( _swapBarriers[name] );
+        const uint32_t fanOut = swapBarrier->getFanOut();
+
+        if( fanOut > 0 )
+            barrier->setTopology( co::Barrier::TOPOLOGY_TREE, fanOut );
+        else
+            barrier->setTopology( co::Barrier::TOPOLOGY_FLAT );
+        _swapBarriers[name] = barrier;
     }
 }
 
@@ -18,6 +18,7 @@
 #ifndef EQSERVER_CONFIG_DISPLAY_H
 #define EQSERVER_CONFIG_DISPLAY_H
 
+#include "../api.h"
 #include "../types.h"
 
 namespace eq
@@ -30,7 +31,7 @@ namespace config
 class Display
 {
 public:
-    static void discoverLocal( Config* config );
+    static EQSERVER_API void discoverLocal( Config* config );
 };
 
 }
@@ -225,12 +225,17 @@ void Resources::configure( const Compounds& compounds, const Channels& channels)
             Compound* stereo =_addEyeCompound( segmentCompound, channels );
             stereo->setEyes( EYE_LEFT | EYE_RIGHT );
         }
-        else if( name == "Static DB" || name == "Dynamic DB" )
+        else if( name == "Static DB" )
         {
+            Compound* db = _addParallelDBCompound( segmentCompound, channels );
+            db->setName( name );
+        }
+        else if( name == "Dynamic DB" )
+        {
+            // The load equalizer needs the rendering compounds as children
             Compound* db = _addDBCompound( segmentCompound, channels );
             db->setName( name );
-            if( name == "Dynamic DB" )
-                db->addEqualizer( new LoadEqualizer( LoadEqualizer::MODE_DB ));
+            db->addEqualizer( new LoadEqualizer( LoadEqualizer::MODE_DB ));
         }
         else if( name == "Simple" )
             /* nop */ ;
@@ -250,15 +255,10 @@ Compound* Resources::_add2DCompound( Compound* root, const Channels& channels )
     return compound;
 }
 
-Compound* Resources::_addDBCompound( Compound* root, const Channels& channels )
+namespace
+{
+static void _setRanges( const Compounds& children )
 {
-    Compound* compound = new Compound( root );
-    compound->setName( "DB" );
-    if( channels.size() > 1 )
-        compound->setBuffers( eq::Frame::BUFFER_COLOR|eq::Frame::BUFFER_DEPTH );
-    _addSources( compound, channels );
-
-    const Compounds& children = compound->getChildren();\
     const size_t step = size_t( 100000.0f / float( children.size( )));
     size_t start = 0;
     for( CompoundsCIter i = children.begin(); i != children.end(); ++i )
@@ -271,6 +271,178 @@ Compound* Resources::_addDBCompound( Compound* root, const Channels& channels )
                                     float( start + step ) / 100000.f ));
         start += step;
     }
+}
+
+/**
+ * @return the number of participants exchanging tiles in each compositing
+ *         round, whose product is nParticipants.
+ */
+static std::vector< size_t > _getRadices( size_t nParticipants )
+{
+    std::vector< size_t > radices;
+    if( ( nParticipants & ( nParticipants - 1 )) == 0 ) // binary-swap
+    {
+        for( ; nParticipants > 1; nParticipants >>= 1 )
+            radices.push_back( 2 );
+        return radices;
+    }
+
+    // radix-k: combine prime factors to groups of up to eight participants.
+    // A prime number of participants results in a single direct-send round.
+    static const size_t maxRadix = 8;
+    std::vector< size_t > factors;
+    for( size_t factor = 2; nParticipants > 1; )
+    {
+        if( nParticipants % factor == 0 )
+        {
+            factors.push_back( factor );
+            nParticipants /= factor;
+        }
+        else
+            ++factor;
+    }
+
+    for( std::vector< size_t >::const_iterator i = factors.begin();
+         i != factors.end(); ++i )
+    {
+        if( !radices.empty() && radices.back() * *i <= maxRadix )
+            radices.back() *= *i;
+        else
+            radices.push_back( *i );
+    }
+    return radices;
+}
+
+/** @return the i-th of n horizontal stripes of the given viewport. */
+static Viewport _getTile( const Viewport& vp, const size_t i, const size_t n )
+{
+    Viewport tile = vp;
+    tile.y = vp.y + vp.h * float( i ) / float( n );
+    if( i + 1 == n ) // last - correct rounding 'error'
+        tile.h = vp.getYEnd() - tile.y;
+    else
+        tile.h = vp.h / float( n );
+    return tile;
+}
+
+static void _addFrame( Compound* sender, Compound* receiver,
+                       const std::string& name, const Viewport& vp,
+                       const uint32_t buffers )
+{
+    std::stringstream frameName;
+    frameName << "Frame." << name << '.' << ++_frameCounter;
+
+    Frame* outFrame = new Frame;
+    outFrame->setName( frameName.str( ));
+    outFrame->setViewport( vp );
+    if( buffers != eq::Frame::BUFFER_UNDEFINED )
+        outFrame->setBuffers( buffers );
+    sender->addOutputFrame( outFrame );
+
+    Frame* inFrame = new Frame;
+    inFrame->setName( frameName.str( ));
+    receiver->addInputFrame( inFrame );
+}
+}
+
+Compound* Resources::_addDBCompound( Compound* root, const Channels& channels )
+{
+    Compound* compound = new Compound( root );
+    compound->setName( "DB" );
+    if( channels.size() > 1 )
+        compound->setBuffers( eq::Frame::BUFFER_COLOR|eq::Frame::BUFFER_DEPTH );
+    _addSources( compound, channels );
+    _setRanges( compound->getChildren( ));
+    return compound;
+}
+
+Compound* Resources::_addParallelDBCompound( Compound* root,
+                                             const Channels& channels )
+{
+    if( channels.size() < 2 )
+        return _addDBCompound( root, channels );
+
+    Compound* compound = new Compound( root );
+    compound->setName( "DB" );
+    compound->setBuffers( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+
+    const Channel* rootChannel = compound->getChannel();
+    const Segment* segment = rootChannel->getSegment();
+    const Channel* outputChannel = segment ? segment->getChannel() : 0;
+    EQASSERT( outputChannel );
+
+    // Each participant renders one range and composites one tile of the
+    // final image, exchanging tiles within groups of participants in one or
+    // more rounds (see _getRadices).
+    const size_t nParticipants = channels.size();
+    std::vector< bool > isDestination( nParticipants, false );
+    Compounds senders; // produce the output frames of the current round
+    for( size_t i = 0; i < nParticipants; ++i )
+    {
+        Compound* participant = new Compound( compound );
+        if( channels[i] == outputChannel )
+            isDestination[i] = true;
+        else
+            participant->setChannel( channels[i] );
+
+        senders.push_back( new Compound( participant )); // draw
+    }
+    const Compounds& participants = compound->getChildren();
+    _setRanges( participants );
+
+    const std::vector< size_t > radices = _getRadices( nParticipants );
+    std::vector< Viewport > tiles( nParticipants );
+    size_t stride = 1;
+
+    for( size_t i = 0; i < radices.size(); ++i )
+    {
+        const size_t radix = radices[i];
+        const bool isLast = ( i + 1 == radices.size( ));
+
+        // the last round is assembled by the participant itself
+        Compounds receivers;
+        for( size_t j = 0; j < nParticipants; ++j )
+        {
+            if( isLast )
+            {
+                receivers.push_back( participants[j] );
+                continue;
+            }
+            Compound* child = new Compound( participants[j] );
+            child->setTasks( fabric::TASK_ASSEMBLE | fabric::TASK_READBACK );
+            receivers.push_back( child );
+        }
+
+        // participant j keeps tile 'digit' and sends all other tiles of its
+        // current tile to the members of its group
+        std::vector< Viewport > next( nParticipants );
+        for( size_t j = 0; j < nParticipants; ++j )
+        {
+            const size_t digit = ( j / stride ) % radix;
+            const size_t first = j - digit * stride;
+            for( size_t k = 0; k < radix; ++k )
+            {
+                const Viewport tile = _getTile( tiles[j], k, radix );
+                if( k == digit )
+                    next[j] = tile;
+                else
+                    _addFrame( senders[j], receivers[ first + k * stride ],
+                               compound->getName(), tile,
+                               eq::Frame::BUFFER_UNDEFINED );
+            }
+        }
+
+        tiles.swap( next );
+        senders.swap( receivers );
+        stride *= radix;
+    }
+
+    for( size_t i = 0; i < nParticipants; ++i )
+    {
+        if( !isDestination[i] )
+            _addFrame( participants[i], compound, compound->getName(),
+                       tiles[i], eq::Frame::BUFFER_COLOR );
+    }
     return compound;
 }
 
@@ -18,6 +18,7 @@
 #ifndef EQSERVER_CONFIG_RESOURCES_H
 #define EQSERVER_CONFIG_RESOURCES_H
 
+#include "../api.h"
 #include "../types.h"
 
 namespace eq
@@ -31,13 +32,16 @@ class Resources
 {
 public:
     static bool discover( Config* config, const std::string& session );
-    static Channels configureSourceChannels( Config* config );
-    static void configure( const Compounds& compounds, const Channels& sources);
+    static EQSERVER_API Channels configureSourceChannels( Config* config );
+    static EQSERVER_API void configure( const Compounds& compounds,
+                                        const Channels& sources );
 
 private:
     static Compound* _add2DCompound( Compound* root, const Channels& channels );
     static Compound* _addEyeCompound( Compound* root, const Channels& channels);
     static Compound* _addDBCompound( Compound* root, const Channels& channels );
+    static Compound* _addParallelDBCompound( Compound* root,
+                                             const Channels& channels );
     static void _addSources( Compound* compound, const Channels& channels );
 };
 
@@ -118,6 +118,10 @@ void Global::_setupDefaults()
     _channelIAttributes[Channel::IATTR_HINT_STATISTICS] = fabric::NICEST;
 #endif
     _channelIAttributes[Channel::IATTR_HINT_SENDTOKEN] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_TRANSMIT_PIPELINE] = fabric::ON;
+    _channelIAttributes[Channel::IATTR_HINT_TEMPORAL_COMPRESSION] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_ROI] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_ASYNC_READBACK] = fabric::OFF;
 
     // compound
     for( uint32_t i=0; i<Compound::IATTR_ALL; ++i )
@@ -99,6 +99,10 @@
 %token EQTOKEN_GLOBAL
 %token EQTOKEN_CHANNEL_IATTR_HINT_STATISTICS
 %token EQTOKEN_CHANNEL_IATTR_HINT_SENDTOKEN
+%token EQTOKEN_CHANNEL_IATTR_HINT_TRANSMIT_PIPELINE
+%token EQTOKEN_CHANNEL_IATTR_HINT_TEMPORAL_COMPRESSION
+%token EQTOKEN_CHANNEL_IATTR_HINT_ROI
+%token EQTOKEN_CHANNEL_IATTR_HINT_ASYNC_READBACK
 %token EQTOKEN_COMPOUND_IATTR_STEREO_MODE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_LEFT_MASK
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_RIGHT_MASK
@@ -147,6 +151,10 @@
 %token EQTOKEN_HINT_DECORATION
 %token EQTOKEN_HINT_STATISTICS
 %token EQTOKEN_HINT_SENDTOKEN
+%token EQTOKEN_HINT_TRANSMIT_PIPELINE
+%token EQTOKEN_HINT_TEMPORAL_COMPRESSION
+%token EQTOKEN_HINT_ROI
+%token EQTOKEN_HINT_ASYNC_READBACK
 %token EQTOKEN_HINT_SWAPSYNC
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
@@ -246,6 +254,8 @@
 %token EQTOKEN_PIXEL
 %token EQTOKEN_SUBPIXEL
 %token EQTOKEN_BANDWIDTH
+%token EQTOKEN_FEC_GROUP_SIZE
+%token EQTOKEN_FEC_REPAIRS
 %token EQTOKEN_DEVICE
 %token EQTOKEN_WALL
 %token EQTOKEN_BOTTOM_LEFT
@@ -260,6 +270,7 @@
 %token EQTOKEN_SWAPBARRIER
 %token EQTOKEN_NVGROUP 
 %token EQTOKEN_NVBARRIER
+%token EQTOKEN_FANOUT
 %token EQTOKEN_OUTPUTFRAME
 %token EQTOKEN_INPUTFRAME
 %token EQTOKEN_OUTPUTTILES
@@ -481,6 +492,26 @@ global:
          eq::server::Global::instance()->setChannelIAttribute(
              eq::server::Channel::IATTR_HINT_SENDTOKEN, $2 );
      }
+     | EQTOKEN_CHANNEL_IATTR_HINT_TRANSMIT_PIPELINE IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_TRANSMIT_PIPELINE, $2 );
+     }
+     | EQTOKEN_CHANNEL_IATTR_HINT_TEMPORAL_COMPRESSION IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_TEMPORAL_COMPRESSION, $2 );
+     }
+     | EQTOKEN_CHANNEL_IATTR_HINT_ROI IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_ROI, $2 );
+     }
+     | EQTOKEN_CHANNEL_IATTR_HINT_ASYNC_READBACK IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_ASYNC_READBACK, $2 );
+     }
      | EQTOKEN_COMPOUND_IATTR_STEREO_MODE IATTR 
      { 
          eq::server::Global::instance()->setCompoundIAttribute( 
@@ -590,6 +621,10 @@ connectionField:
     | EQTOKEN_INTERFACE STRING    { connectionDescription->setInterface($2); }
     | EQTOKEN_PORT UNSIGNED       { connectionDescription->port = $2; }
     | EQTOKEN_BANDWIDTH UNSIGNED  { connectionDescription->bandwidth = $2; }
+    | EQTOKEN_FEC_GROUP_SIZE UNSIGNED
+        { connectionDescription->fecGroupSize = $2; }
+    | EQTOKEN_FEC_REPAIRS UNSIGNED
+        { connectionDescription->fecRepairs = $2; }
     | EQTOKEN_FILENAME STRING     { connectionDescription->setFilename($2); }
 
 nodeAttributes: /*null*/ | nodeAttributes nodeAttribute
@@ -719,6 +754,18 @@ channelAttribute:
     | EQTOKEN_HINT_SENDTOKEN IATTR
         { channel->setIAttribute( eq::server::Channel::IATTR_HINT_SENDTOKEN,
                                   $2 ); }
+    | EQTOKEN_HINT_TRANSMIT_PIPELINE IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_TRANSMIT_PIPELINE, $2 ); }
+    | EQTOKEN_HINT_TEMPORAL_COMPRESSION IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_TEMPORAL_COMPRESSION, $2 ); }
+    | EQTOKEN_HINT_ROI IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_ROI, $2 ); }
+    | EQTOKEN_HINT_ASYNC_READBACK IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_ASYNC_READBACK, $2 ); }
 
 
 observer: EQTOKEN_OBSERVER '{' { observer = new eq::server::Observer( config );}
@@ -1204,6 +1251,7 @@ swapBarrierFields: /*null*/ | swapBarrierFields swapBarrierField
 swapBarrierField: EQTOKEN_NAME STRING { swapBarrier->setName( $2 ); }
     | EQTOKEN_NVGROUP IATTR { swapBarrier->setNVSwapGroup( $2 ); }
     | EQTOKEN_NVBARRIER IATTR { swapBarrier->setNVSwapBarrier( $2 ); }
+    | EQTOKEN_FANOUT UNSIGNED { swapBarrier->setFanOut( $2 ); }
     
 
 
@@ -216,7 +216,7 @@ co::Barrier* Window::joinSwapBarrier( co::Barrier* barrier )
     {
         Node* node = getNode();
         barrier = node->getBarrier();
-        barrier->increase();
+        barrier->increase( node->getNode()->getNodeID( ));
 
         _masterSwapBarriers.push_back( barrier );
         _swapBarriers.push_back( barrier );
@@ -256,7 +256,7 @@ co::Barrier* Window::joinSwapBarrier( co::Barrier* barrier )
     }
 
     // No other window on this pipe does the barrier yet
-    barrier->increase();
+    barrier->increase( getNode()->getNode()->getNodeID( ));
     _swapBarriers.push_back( barrier );
     return barrier;
 }
@@ -278,7 +278,7 @@ co::Barrier* Window::joinNVSwapBarrier( SwapBarrierConstPtr swapBarrier,
         _masterSwapBarriers.push_back( _nvNetBarrier );
     }
 
-    _nvNetBarrier->increase();
+    _nvNetBarrier->increase( getNode()->getNode()->getNodeID( ));
     _swapBarriers.push_back( _nvNetBarrier );
     return _nvNetBarrier;
 }
@@ -79,17 +79,19 @@ bool GPUCompressor::initDownloader( const uint32_t internalFormat,
 
     if( name == EQ_COMPRESSOR_NONE )
     {
+        deleteGLObjects();
         reset();
         return false;
     }
     if( name != _name )
-        return initCompressor( name );
+        return initDownloader( name );
     return true;
 }
 
 bool GPUCompressor::initDownloader( const uint32_t name )
 {
     EQASSERT( name > EQ_COMPRESSOR_NONE );
+    deleteGLObjects();
     return initCompressor( name );
 }
 
@@ -159,6 +161,50 @@ void GPUCompressor::download( const fabric::PixelViewport& pvpIn,
     pvpOut.h = outDims[3];
 }
 
+bool GPUCompressor::hasAsyncDownload() const
+{
+    return _info &&
+           ( _info->capabilities & EQ_COMPRESSOR_USE_ASYNC_DOWNLOAD );
+}
+
+void GPUCompressor::startDownload( const fabric::PixelViewport& pvpIn,
+                                   const unsigned source,
+                                   const uint64_t flags )
+{
+    EQASSERT( _plugin );
+    EQASSERT( _glewContext );
+    EQASSERT( hasAsyncDownload( ));
+
+    const uint64_t inDims[4] = { pvpIn.x, pvpIn.w, pvpIn.y, pvpIn.h }; 
+    _plugin->startDownload( _instance, _name, _glewContext, inDims, source,
+                            flags );
+}
+
+void GPUCompressor::finishDownload( const fabric::PixelViewport& pvpIn,
+                                    const uint64_t flags,
+                                    fabric::PixelViewport& pvpOut,
+                                    void** out )
+{
+    EQASSERT( _plugin );
+    EQASSERT( _glewContext );
+    EQASSERT( hasAsyncDownload( ));
+
+    const uint64_t inDims[4] = { pvpIn.x, pvpIn.w, pvpIn.y, pvpIn.h }; 
+    uint64_t outDims[4] = { 0, 0, 0, 0 };
+    _plugin->finishDownload( _instance, _name, _glewContext, inDims, flags,
+                             outDims, out );
+    pvpOut.x = outDims[0];
+    pvpOut.w = outDims[1];
+    pvpOut.y = outDims[2];
+    pvpOut.h = outDims[3];
+}
+
+void GPUCompressor::deleteGLObjects()
+{
+    if( _plugin && _instance && _glewContext && _plugin->deleteGLObjects )
+        _plugin->deleteGLObjects( _instance, _name, _glewContext );
+}
+
 void GPUCompressor::upload( const void*                  buffer,
                             const fabric::PixelViewport& pvpIn,
                             const uint64_t               flags,
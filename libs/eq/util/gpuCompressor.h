@@ -116,6 +116,44 @@ namespace util
                        fabric::PixelViewport&       pvpOut,
                        void**                       out );
 
+        /** @return true if the current downloader can download async. */
+        bool hasAsyncDownload() const;
+
+        /**
+         * Start an asynchronous download from the frame buffer or texture.
+         *
+         * Has to be followed by a call to finishDownload() with the same
+         * parameters, using the same OpenGL context.
+         *
+         * @param pvpIn the dimensions of the input data
+         * @param source texture name to process.
+         * @param flags capability flags for the compression
+         */
+        void startDownload( const fabric::PixelViewport& pvpIn,
+                            const unsigned               source,
+                            const uint64_t               flags );
+
+        /**
+         * Finish an asynchronous download started by startDownload().
+         *
+         * @param pvpIn the dimensions of the input data
+         * @param flags capability flags for the compression
+         * @param pvpOut the dimensions of the output data
+         * @param out the pointer to the output data
+         */
+        void finishDownload( const fabric::PixelViewport& pvpIn,
+                             const uint64_t               flags,
+                             fabric::PixelViewport&       pvpOut,
+                             void**                       out );
+
+        /**
+         * Delete the OpenGL objects kept by the current transfer plugin.
+         *
+         * Has to be called before the plugin instance is reset, using the
+         * OpenGL context of the last download.
+         */
+        void deleteGLObjects();
+
         /**
          * Upload data from cpu to the frame buffer or texture 
          *
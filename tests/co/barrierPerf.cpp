@@ -0,0 +1,145 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the barrier latency of the flat and tree topologies for an
+// increasing number of nodes.
+// Usage: ./barrierPerf
+
+#include <pthread.h> // must come first!
+
+#include <test.h>
+
+#include <co/barrier.h>
+#include <co/base/clock.h>
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/node.h>
+
+#include <iostream>
+
+#define MAXNODES 16
+#define NENTER 100
+
+namespace
+{
+typedef std::vector< co::LocalNodePtr > LocalNodes;
+typedef LocalNodes::const_iterator LocalNodesCIter;
+
+class NodeThread : public co::base::Thread
+{
+public:
+    NodeThread( co::LocalNodePtr node, const co::base::UUID& barrierID )
+            : _node( node ), _barrierID( barrierID ) {}
+
+    virtual void run()
+        {
+            co::Barrier barrier;
+            TEST( _node->mapObject( &barrier, _barrierID ));
+
+            for( size_t i = 0; i < NENTER; ++i )
+                barrier.enter();
+
+            _node->unmapObject( &barrier );
+        }
+
+private:
+    co::LocalNodePtr _node;
+    const co::base::UUID _barrierID;
+};
+
+co::LocalNodePtr _newNode()
+{
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr node = new co::LocalNode;
+    node->addConnectionDescription( connDesc );
+    TEST( node->listen( ));
+    return node;
+}
+
+float _testBarrier( co::LocalNodePtr master, const LocalNodes& nodes,
+                    const co::Barrier::Topology topology )
+{
+    co::Barrier barrier( master );
+    barrier.setTopology( topology );
+    barrier.increase( master->getNodeID( ));
+    for( LocalNodesCIter i = nodes.begin(); i != nodes.end(); ++i )
+        barrier.increase( (*i)->getNodeID( ));
+    TEST( master->registerObject( &barrier ));
+
+    std::vector< NodeThread* > threads;
+    for( LocalNodesCIter i = nodes.begin(); i != nodes.end(); ++i )
+    {
+        threads.push_back( new NodeThread( *i, barrier.getID( )));
+        threads.back()->start();
+    }
+
+    barrier.enter(); // warm up connections
+    co::base::Clock clock;
+    for( size_t i = 1; i < NENTER; ++i )
+        barrier.enter();
+    const float time = clock.getTimef() / ( NENTER - 1 );
+
+    for( std::vector< NodeThread* >::const_iterator i = threads.begin();
+         i != threads.end(); ++i )
+    {
+        TEST( (*i)->join( ));
+        delete *i;
+    }
+
+    master->deregisterObject( &barrier );
+    return time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::LocalNodePtr master = _newNode();
+    LocalNodes nodes;
+
+    std::cout << "nodes, flat ms, tree ms" << std::endl;
+    for( size_t nNodes = 2; nNodes <= MAXNODES; nNodes <<= 1 )
+    {
+        while( nodes.size() + 1 < nNodes )
+        {
+            co::LocalNodePtr node = _newNode();
+            co::NodePtr masterProxy = new co::Node;
+            masterProxy->addConnectionDescription(
+                master->getConnectionDescriptions().front( ));
+            TEST( node->connect( masterProxy ));
+            nodes.push_back( node );
+        }
+
+        const float flat = _testBarrier( master, nodes,
+                                         co::Barrier::TOPOLOGY_FLAT );
+        const float tree = _testBarrier( master, nodes,
+                                         co::Barrier::TOPOLOGY_TREE );
+        std::cout << nNodes << ", " << flat << ", " << tree << std::endl;
+    }
+
+    for( LocalNodesCIter i = nodes.begin(); i != nodes.end(); ++i )
+        TEST( (*i)->close( ));
+    nodes.clear();
+    TEST( master->close( ));
+    master = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *  
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that no participant leaves a barrier before all participants have
+// entered, while the topology and fan-out change with each version.
+// Usage: ./barrierTree
+
+#include <pthread.h> // must come first!
+
+#include <test.h>
+
+#include <co/barrier.h>
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/base/atomic.h>
+
+#define NNODES 8
+#define NROUNDS 50
+
+namespace
+{
+co::base::a_int32_t _entered;
+
+void _enter( co::Barrier& barrier, const size_t round )
+{
+    ++_entered;
+    barrier.enter();
+    TESTINFO( _entered >= int32_t(( round + 1 ) * NNODES ),
+              "Left barrier in round " << round << " after " << _entered <<
+              " participants entered" );
+}
+
+void _update( co::Barrier& barrier, const size_t round )
+{
+    if( round % 5 == 4 )
+        barrier.setTopology( co::Barrier::TOPOLOGY_FLAT );
+    else
+        barrier.setTopology( co::Barrier::TOPOLOGY_TREE,
+                             uint32_t( round % 4 + 1 ));
+}
+
+class NodeThread : public co::base::Thread
+{
+public:
+    NodeThread( co::LocalNodePtr node, const co::base::UUID& barrierID,
+                const co::base::uint128_t& version )
+            : _node( node ), _barrierID( barrierID ), _version( version ) {}
+
+    virtual void run()
+        {
+            co::Barrier barrier;
+            TEST( _node->mapObject( &barrier, _barrierID ));
+
+            for( size_t i = 0; i < NROUNDS; ++i )
+            {
+                barrier.sync( _version + i + 1 );
+                _enter( barrier, i );
+            }
+
+            _node->unmapObject( &barrier );
+        }
+
+private:
+    co::LocalNodePtr _node;
+    const co::base::UUID _barrierID;
+    const co::base::uint128_t _version;
+};
+
+co::LocalNodePtr _newNode()
+{
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr node = new co::LocalNode;
+    node->addConnectionDescription( connDesc );
+    TEST( node->listen( ));
+    return node;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::LocalNodePtr master = _newNode();
+    std::vector< co::LocalNodePtr > nodes;
+    for( size_t i = 1; i < NNODES; ++i )
+    {
+        co::LocalNodePtr node = _newNode();
+        co::NodePtr masterProxy = new co::Node;
+        masterProxy->addConnectionDescription(
+            master->getConnectionDescriptions().front( ));
+        TEST( node->connect( masterProxy ));
+        nodes.push_back( node );
+    }
+
+    co::Barrier barrier( master );
+    barrier.increase( master->getNodeID( ));
+    for( size_t i = 0; i < nodes.size(); ++i )
+        barrier.increase( nodes[i]->getNodeID( ));
+    TEST( master->registerObject( &barrier ));
+
+    std::vector< NodeThread* > threads;
+    for( size_t i = 0; i < nodes.size(); ++i )
+    {
+        threads.push_back( new NodeThread( nodes[i], barrier.getID(),
+                                           barrier.getVersion( )));
+        threads.back()->start();
+    }
+
+    for( size_t i = 0; i < NROUNDS; ++i )
+    {
+        _update( barrier, i );
+        barrier.commit();
+        _enter( barrier, i );
+    }
+    TEST( _entered == NROUNDS * NNODES );
+
+    for( size_t i = 0; i < threads.size(); ++i )
+    {
+        TEST( threads[i]->join( ));
+        delete threads[i];
+    }
+    master->deregisterObject( &barrier );
+
+    for( size_t i = 0; i < nodes.size(); ++i )
+        TEST( nodes[i]->close( ));
+    nodes.clear();
+    TEST( master->close( ));
+    master = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
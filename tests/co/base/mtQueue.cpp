@@ -19,11 +19,13 @@
 #include <test.h>
 #include <co/base/clock.h>
 #include <co/base/compiler.h>
+#include <co/base/mpmcQueue.h>
 #include <co/base/mtQueue.h>
 #include <co/base/thread.h>
 #include <iostream>
 
 #define NOPS 100000
+#define MAXPRODUCERS 16
 
 co::base::MTQueue< uint64_t > queue;
 
@@ -53,6 +55,64 @@ public:
         }
 };
 
+// Contention benchmark: n producers push NOPS items into one queue, read by a
+// single consumer, which checks the per-producer ordering.
+template< class Q > class Producer : public co::base::Thread
+{
+public:
+    Producer() : queue( 0 ), id( 0 ), nOps( 0 ) {}
+    virtual ~Producer() {}
+    virtual void run()
+        {
+            for( uint64_t i = 0 ; i < nOps; ++i )
+                queue->push( (id << 32) | i );
+        }
+
+    Q* queue;
+    uint64_t id;
+    uint64_t nOps;
+};
+
+template< class Q > float _testContention( const size_t nProducers )
+{
+    Q queue( NOPS );
+    Producer< Q > producers[ MAXPRODUCERS ];
+    uint64_t next[ MAXPRODUCERS ] = { 0 };
+    const uint64_t nOps = NOPS / nProducers;
+
+    co::base::Clock clock;
+    for( size_t i = 0 ; i < nProducers; ++i )
+    {
+        producers[i].queue = &queue;
+        producers[i].id = i;
+        producers[i].nOps = nOps;
+        TEST( producers[i].start( ));
+    }
+
+    for( uint64_t i = 0 ; i < nOps * nProducers; ++i )
+    {
+        const uint64_t item = queue.pop();
+        const size_t id = size_t( item >> 32 );
+        TESTINFO( id < nProducers, id );
+        TESTINFO( (item & 0xffffffffu) == next[ id ],
+                  (item & 0xffffffffu) << " != " << next[ id ] );
+        ++next[ id ];
+    }
+    const float time = clock.getTimef();
+
+    for( size_t i = 0 ; i < nProducers; ++i )
+        TEST( producers[i].join( ));
+    TEST( queue.isEmpty( ));
+    return nOps * nProducers / time;
+}
+
+// MTQueue has no capacity parameter
+class UnboundedQueue : public co::base::MTQueue< uint64_t >
+{
+public:
+    UnboundedQueue( const size_t ) {}
+};
+
 int main( int argc, char **argv )
 {
     ReadThread reader;
@@ -67,6 +127,15 @@ int main( int argc, char **argv )
 
     TEST( reader.join( ));
     std::cout << NOPS/time << " writes/ms" << std::endl;
+
+    std::cout << "producers, MTQueue ops/ms, MPMCQueue ops/ms" << std::endl;
+    for( size_t i = 1; i <= MAXPRODUCERS; i <<= 1 )
+    {
+        const float mtRate = _testContention< UnboundedQueue >( i );
+        const float mpmcRate =
+            _testContention< co::base::MPMCQueue< uint64_t > >( i );
+        std::cout << i << ", " << mtRate << ", " << mpmcRate << std::endl;
+    }
     return EXIT_SUCCESS;
 }
 
@@ -29,6 +29,9 @@
 
 #define N_READER 13
 #define RUNTIME 5000
+#define MAX_BACKLOG 10000 // commands not yet processed by the readers
+
+static co::base::a_int32_t _nProcessed;
 
 struct Packet : public co::Packet
 {
@@ -43,7 +46,7 @@ struct Packet : public co::Packet
 class Reader : public co::Dispatcher, public co::base::Thread
 {
 public:
-    bool _cmd( co::Command& command ) { return true; }
+    bool _cmd( co::Command& command ) { ++_nProcessed; return true; }
     bool _cmdStop( co::Command& command ) { _running = false; return true; }
 
     Reader() : _running( false )
@@ -76,9 +79,105 @@ private:
     bool _running;
 };
 
+// Queues more commands than fit into the lock-free ring of a CommandQueue,
+// without a reader. push() may not block, and the order has to be kept.
+static void _testOverflow( co::LocalNodePtr node )
+{
+    static const uint32_t nCommands = 40000;
+
+    co::CommandCache cache;
+    co::CommandQueue queue;
+    for( uint32_t i = 0; i < nCommands; ++i )
+    {
+        co::Command& command = cache.alloc( node, node, sizeof( Packet ));
+        Packet* packet = command.getModifiable< Packet >();
+        *packet = Packet();
+        packet->command = i;
+        queue.push( command );
+    }
+    TESTINFO( queue.getSize() == nCommands, queue.getSize( ));
+
+    for( uint32_t i = 0; i < nCommands; ++i )
+    {
+        co::Command* command = queue.tryPop();
+        TEST( command );
+        TESTINFO( (*command)->command == i, (*command)->command << " != " << i);
+        command->release();
+    }
+    TEST( queue.isEmpty( ));
+    TEST( !queue.tryPop( ));
+}
+
+// Releases commands from another thread
+class Releaser : public co::base::Thread
+{
+public:
+    Releaser( std::vector< co::Command* >& commands ) : _commands( commands ){}
+    virtual ~Releaser(){}
+
+protected:
+    virtual void run()
+        {
+            for( std::vector< co::Command* >::const_iterator i =
+                     _commands.begin(); i != _commands.end(); ++i )
+            {
+                (*i)->release();
+            }
+        }
+
+private:
+    std::vector< co::Command* >& _commands;
+};
+
+// Holds more than 16384 small and big commands at once. alloc() may not
+// block, and all held packets have to stay intact.
+static void _testHold( co::LocalNodePtr node )
+{
+    static const uint32_t nCommands = 40000;
+    static const uint64_t bigSize = co::Packet::minSize * 2;
+
+    co::CommandCache cache;
+    std::vector< co::Command* > commands;
+    for( uint32_t i = 0; i < nCommands; ++i )
+    {
+        const uint64_t size = ( i & 1 ) ? bigSize : sizeof( Packet );
+        co::Command& command = cache.alloc( node, node, size );
+        Packet* packet = command.getModifiable< Packet >();
+        *packet = Packet();
+        packet->size = size;
+        packet->command = i;
+        command.retain();
+        commands.push_back( &command );
+    }
+    TEST( cache.getMisses() > 0 );
+
+    for( uint32_t i = 0; i < nCommands; ++i )
+    {
+        const co::Command& command = *commands[i];
+        TESTINFO( command->command == i, command->command << " != " << i );
+        TEST( command->size == (( i & 1 ) ? bigSize : sizeof( Packet )));
+    }
+
+    Releaser releaser( commands );
+    TEST( releaser.start( ));
+    TEST( releaser.join( ));
+    commands.clear();
+
+    // released commands are reused
+    const uint64_t misses = cache.getMisses();
+    for( uint32_t i = 0; i < nCommands; ++i )
+        cache.alloc( node, node, sizeof( Packet ));
+    TESTINFO( cache.getMisses() == misses, cache.getMisses() << " != " << misses);
+}
+
 int main( int argc, char **argv )
 {
     co::init( argc, argv );
+    {
+        co::LocalNodePtr node = new co::LocalNode;
+        _testOverflow( node );
+        _testHold( node );
+    }
     {
         Reader readers[ N_READER ];
         for( size_t i = 0; i < N_READER; ++i )
@@ -103,6 +202,10 @@ int main( int argc, char **argv )
                 readers[i].dispatchCommand( clone );
             }
             ++nOps;
+
+            // The cache grows instead of blocking, throttle the writer
+            while( int32_t( nOps * N_READER ) - _nProcessed > MAX_BACKLOG )
+                co::base::Thread::yield();
         }
 
         const uint64_t wTime = clock.getTime64();
@@ -121,6 +224,11 @@ int main( int argc, char **argv )
         const uint64_t rTime = clock.getTime64();
         std::cout << nOps / wTime << " write, " << N_READER * nOps / rTime
                   << " read ops/ms" << std::endl;
+        std::cout << cache.getHits() << " hits, " << cache.getMisses()
+                  << " misses, " << cache.getAllocatedBytes() << " bytes"
+                  << std::endl;
+        TEST( cache.getHits() > cache.getMisses( ));
+        TEST( cache.getAllocatedBytes() > 0 );
     }
 
     TEST( co::exit( ));
@@ -41,6 +41,8 @@
 
 void _testFile();
 void _testRandom();
+void _testStructured();
+void _testImage();
 void _testData( const uint32_t nameCompressor, const std::string& name,
                 const uint8_t* data, const uint64_t size );
 
@@ -61,6 +63,8 @@ int main( int argc, char **argv )
     co::init( argc, argv );
     _testFile();
     _testRandom();
+    _testStructured();
+    _testImage();
     co::exit();
 
     return EXIT_SUCCESS;
@@ -231,6 +235,151 @@ void _testRandom()
     delete [] data;
 } 
 
+void _testStructured()
+{
+    // Typical object data: vertices, triangle indices and transformations
+    std::vector< float > data;
+    co::base::RNG rng;
+    for( size_t i = 0; i < 65536; ++i )
+    {
+        data.push_back( float( i % 256 ) * .25f );
+        data.push_back( float( i / 256 ) * .25f );
+        data.push_back( float( rng.get< uint8_t >( )) * .01f );
+        data.push_back( 1.f );
+    }
+    for( uint32_t i = 0; i < 65536; ++i )
+    {
+        const uint32_t index[3] = { i, i + 1, i + 256 };
+        data.insert( data.end(), reinterpret_cast< const float* >( index ),
+                     reinterpret_cast< const float* >( index ) + 3 );
+    }
+    for( size_t i = 0; i < 4096; ++i )
+    {
+        const float matrix[16] = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                                   0.f, 0.f, 1.f, 0.f, float( i ), 0.f, 0.f,
+                                   1.f };
+        data.insert( data.end(), matrix, matrix + 16 );
+    }
+
+    const uint8_t* bytes = reinterpret_cast< const uint8_t* >( &data[0] );
+    const uint64_t size = data.size() * sizeof( float );
+    uint64_t rleSize = 0;
+    uint64_t lzSize = 0;
+
+    std::vector< uint32_t >compressorNames =
+        getCompressorNames( EQ_COMPRESSOR_DATATYPE_BYTE );
+    for( std::vector<uint32_t>::const_iterator i = compressorNames.begin();
+         i != compressorNames.end(); ++i )
+    {
+        _result = 0;
+        _testData( *i, "Structured data", bytes, size );
+        if( *i == EQ_COMPRESSOR_RLE_BYTE )
+            rleSize = _result;
+        else if( *i == EQ_COMPRESSOR_LZ_BYTE )
+            lzSize = _result;
+    }
+
+    TESTINFO( lzSize > 0 && lzSize < rleSize, lzSize << " >= " << rleSize );
+    TEST( co::base::CPUCompressor::chooseCompressor(
+              EQ_COMPRESSOR_DATATYPE_BYTE ) == EQ_COMPRESSOR_LZ_BYTE );
+    std::cout << std::endl;
+}
+
+float _compressImage( const uint32_t compressorName, const uint32_t* data,
+                      const uint64_t nPixels, const uint64_t flags,
+                      std::vector< uint8_t >& output )
+{
+    co::base::CPUCompressor compressor;
+    compressor.co::base::Compressor::initCompressor( compressorName );
+
+    uint64_t inDims[4]  = { 0, nPixels, 0, 1 };
+    compressor.compress( const_cast< uint32_t* >( data ), inDims, flags );
+    co::base::Clock clock;
+    compressor.compress( const_cast< uint32_t* >( data ), inDims, flags );
+    const float time = clock.getTimef();
+
+    output.clear();
+    const unsigned numResults = compressor.getNumResults();
+    std::vector< void* > results( numResults );
+    std::vector< uint64_t > sizes( numResults );
+    for( unsigned i = 0; i < numResults; ++i )
+    {
+        compressor.getResult( i, &results[i], &sizes[i] );
+        const uint8_t* bytes = reinterpret_cast< const uint8_t* >(results[i]);
+        output.insert( output.end(), bytes, bytes + sizes[i] );
+    }
+
+    co::base::CPUCompressor decompressor;
+    decompressor.co::base::Compressor::initDecompressor( compressorName );
+    std::vector< uint32_t > outData( nPixels );
+    decompressor.decompress( &results.front(), &sizes.front(), numResults,
+                             &outData.front(), inDims, flags );
+
+    const uint32_t mask = ( flags & EQ_COMPRESSOR_IGNORE_ALPHA ) ?
+                              0x00ffffffu : 0xffffffffu;
+    for( uint64_t i = 0; i < nPixels; ++i )
+        TESTINFO( ( outData[i] & mask ) == ( data[i] & mask ),
+                  std::hex << outData[i] << " != " << data[i] << std::dec
+                  << " @ " << i );
+    return time;
+}
+
+void _testImage()
+{
+    // A synthetic rendering: background, flat shapes and a noisy object
+    const uint64_t width = 1920;
+    const uint64_t height = 1200;
+    std::vector< uint32_t > data( width * height, 0xff202020u );
+    co::base::RNG rng;
+    for( uint64_t y = 100; y < 1100; ++y )
+    {
+        for( uint64_t x = 200; x < 700; ++x )
+            data[ y * width + x ] = 0xff000000u | uint32_t( y / 4 ) << 8;
+        for( uint64_t x = 1000; x < 1400; ++x )
+            data[ y * width + x ] = rng.get< uint32_t >() | 0xff000000u;
+    }
+
+    // same stream as the scalar engine, plain and differential
+    const uint32_t names[][2] = {
+        { EQ_COMPRESSOR_RLE_RGBA, EQ_COMPRESSOR_RLE_SIMD_RGBA },
+        { EQ_COMPRESSOR_RLE_DIFF_RGBA, EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA },
+        { EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT,
+          EQ_COMPRESSOR_RLE_SIMD_DEPTH_UNSIGNED_INT }};
+    const uint64_t flags[] = { EQ_COMPRESSOR_DATA_1D,
+                               EQ_COMPRESSOR_DATA_1D |
+                               EQ_COMPRESSOR_IGNORE_ALPHA };
+
+    std::cout << "          Compressor,  SIMD, A,       SIZE, Compressed, "
+              << "    t_comp, t_comp_SIMD" << std::endl;
+    for( size_t i = 0; i < sizeof( names ) / sizeof( names[0] ); ++i )
+    {
+        for( size_t j = 0; j < 2; ++j )
+        {
+            if( j == 1 && i == 2 ) // depth has no alpha to ignore
+                continue;
+
+            std::vector< uint8_t > scalar;
+            std::vector< uint8_t > simd;
+            const float scalarTime = _compressImage( names[i][0], &data[0],
+                                                     data.size(), flags[j],
+                                                     scalar );
+            const float simdTime = _compressImage( names[i][1], &data[0],
+                                                   data.size(), flags[j],
+                                                   simd );
+            TESTINFO( scalar == simd, std::hex << names[i][1] << std::dec );
+
+            std::cout << std::setw(12) << "0x" << std::setw(8)
+                      << std::setfill( '0' ) << std::hex << names[i][0]
+                      << ", 0x" << std::setw(3) << names[i][1] << std::dec
+                      << std::setfill(' ') << ", " << ( j == 0 ) << ", "
+                      << std::setw(10) << data.size() * 4 << ", "
+                      << std::setw(10) << simd.size() << ", " << std::setw(10)
+                      << scalarTime << ", " << std::setw(10) << simdTime
+                      << std::endl;
+        }
+    }
+}
+
 void compare( const uint8_t *dst, const uint8_t *src, const uint32_t nbytes )
 {
     for( uint64_t i = 0; i < nbytes; ++i )
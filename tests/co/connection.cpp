@@ -98,8 +98,24 @@ int main( int argc, char **argv )
         reader->recvNB( in, PACKETSIZE );
 
         uint8_t out[ PACKETSIZE ];
+        for( size_t j = 0; j < PACKETSIZE; ++j )
+            out[j] = uint8_t( j );
         TEST( writer->send( out, PACKETSIZE ));
         TEST( reader->recvSync( 0, 0 ));
+        TEST( memcmp( in, out, PACKETSIZE ) == 0 );
+
+        // vectored send, including an empty buffer
+        const uint64_t header = 42;
+        const co::iovec buffers[] = { { (void*)&header, sizeof( header ) },
+                                      { out, 0 },
+                                      { out, PACKETSIZE - 16 },
+                                      { (void*)&header, sizeof( header ) }};
+        reader->recvNB( in, PACKETSIZE );
+        TEST( writer->send( buffers, 4 ));
+        TEST( reader->recvSync( 0, 0 ));
+        TEST( memcmp( in, &header, sizeof( header )) == 0 );
+        TEST( memcmp( in + 8, out, PACKETSIZE - 16 ) == 0 );
+        TEST( memcmp( in + PACKETSIZE - 8, &header, sizeof( header )) == 0 );
 
         writer->close();
         reader->recvNB( in, PACKETSIZE );
@@ -0,0 +1,159 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests ConnectionSet event delivery and compares the select() throughput of
+// the poll and epoll backends for different numbers of connections.
+// Usage: ./connectionSet
+
+#include <test.h>
+#include <co/base/clock.h>
+#include <co/connectionSet.h>
+#include <co/global.h>
+#include <co/init.h>
+
+#include <co/pipeConnection.h> // private header
+
+#include <iostream>
+#ifndef _WIN32
+#  include <sys/resource.h>
+#endif
+
+#define NPACKETS 50000
+
+namespace
+{
+typedef std::vector< co::PipeConnectionPtr > PipeConnections;
+
+class Sender : public co::base::Thread
+{
+public:
+    Sender( const co::Connections& connections )
+            : _connections( connections )
+        {}
+
+protected:
+    virtual void run()
+        {
+            const size_t nConnections = _connections.size();
+            for( uint64_t i = 0; i < NPACKETS; ++i )
+            {
+                co::ConnectionPtr connection = _connections[ i % nConnections ];
+                TEST( connection->send( &i, sizeof( i )));
+            }
+        }
+
+private:
+    const co::Connections _connections;
+};
+
+bool _canOpen( const size_t nConnections )
+{
+#ifdef _WIN32
+    return nConnections < MAXIMUM_WAIT_OBJECTS * MAXIMUM_WAIT_OBJECTS;
+#else
+    rlimit limit;
+    if( getrlimit( RLIMIT_NOFILE, &limit ) != 0 )
+        return false;
+    return nConnections * 4 + 64 < limit.rlim_cur; // two pipes per connection
+#endif
+}
+
+float _run( const size_t nConnections, const bool useEpoll )
+{
+    co::Global::setIAttribute( co::Global::IATTR_CONNECTIONSET_EPOLL,
+                               useEpoll );
+    co::ConnectionSet set;
+    PipeConnections connections;
+    co::Connections senders;
+    uint64_t buffer = 0;
+
+    for( size_t i = 0; i < nConnections; ++i )
+    {
+        co::PipeConnectionPtr connection = new co::PipeConnection;
+        TEST( connection->connect( ));
+        connection->recvNB( &buffer, sizeof( buffer ));
+
+        connections.push_back( connection );
+        senders.push_back( connection->acceptSync( ));
+        set.addConnection( connection );
+    }
+
+    Sender sender( senders );
+    co::base::Clock clock;
+    TEST( sender.start( ));
+
+    uint64_t sum = 0;
+    for( size_t i = 0; i < NPACKETS; ++i )
+    {
+        co::ConnectionSet::Event event = set.select();
+        if( event == co::ConnectionSet::EVENT_INTERRUPT )
+            event = set.select(); // set modified during setup
+
+        TESTINFO( event == co::ConnectionSet::EVENT_DATA, event );
+        co::ConnectionPtr connection = set.getConnection();
+        TEST( connection->recvSync( 0, 0 ));
+        sum += buffer;
+        connection->recvNB( &buffer, sizeof( buffer ));
+    }
+    const float time = clock.getTimef();
+
+    TEST( sender.join( ));
+    TESTINFO( sum == uint64_t( NPACKETS ) * ( NPACKETS - 1 ) / 2, sum );
+
+    for( PipeConnections::const_iterator i = connections.begin();
+         i != connections.end(); ++i )
+    {
+        co::PipeConnectionPtr connection = *i;
+        set.removeConnection( connection );
+        connection->close();
+    }
+    return NPACKETS / time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+    const int32_t useEpoll =
+        co::Global::getIAttribute( co::Global::IATTR_CONNECTIONSET_EPOLL );
+
+    static const size_t sizes[] = { 8, 64, 512 };
+    for( size_t i = 0; i < sizeof( sizes ) / sizeof( size_t ); ++i )
+    {
+        const size_t nConnections = sizes[i];
+        if( !_canOpen( nConnections ))
+        {
+            std::cerr << "Skipping " << nConnections << " connections, not "
+                      << "enough file descriptors" << std::endl;
+            continue;
+        }
+
+        const float pollRate = _run( nConnections, false );
+#ifdef Linux
+        const float epollRate = _run( nConnections, true );
+        std::cerr << nConnections << " connections: " << pollRate
+                  << " p/ms poll, " << epollRate << " p/ms epoll" << std::endl;
+#else
+        std::cerr << nConnections << " connections: " << pollRate << " p/ms"
+                  << std::endl;
+#endif
+    }
+
+    co::Global::setIAttribute( co::Global::IATTR_CONNECTIONSET_EPOLL,
+                               useEpoll );
+    co::exit();
+    return EXIT_SUCCESS;
+}
@@ -20,12 +20,14 @@
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
 
+#include <co/base/clock.h>
 #include <co/base/thread.h>
 #include <co/connectionDescription.h>
 #include <co/command.h>
 #include <co/commandCache.h>
 #include <co/commandQueue.h>
 #include <co/connection.h>
+#include <co/global.h>
 #include <co/init.h>
 #include <co/packets.h>
 #include <co/types.h>
@@ -33,7 +35,9 @@
 #include <co/dataOStream.ipp>      // private impl
 #include <co/base/cpuCompressor.h> // private header
 
-// Tests the functionality of the DataOStream and DataIStream
+// Tests the functionality of the DataOStream and DataIStream, and benchmarks
+// the throughput for 1 KB, 1 MB and 64 MB objects with and without copying
+// large writes into the stream buffer.
 
 #define CONTAINER_SIZE EQ_64KB
 
@@ -112,9 +116,12 @@ namespace DataStreamTest
 class Sender : public co::base::Thread
 {
 public:
-    Sender( co::base::RefPtr< co::Connection > connection )
+    Sender( co::base::RefPtr< co::Connection > connection,
+            const size_t objectSize = 0, const size_t nObjects = 0 )
             : Thread(),
               _connection( connection )
+            , _objectSize( objectSize )
+            , _nObjects( nObjects )
         {}
     virtual ~Sender(){}
 
@@ -123,6 +130,19 @@ protected:
         {
             ::DataOStream stream;
 
+            if( _objectSize > 0 )
+            {
+                const std::vector< uint8_t > data( _objectSize, 42 );
+                for( size_t i = 0; i < _nObjects; ++i )
+                {
+                    stream._connections.push_back( _connection );
+                    stream._enable();
+                    stream << data;
+                    stream.disable();
+                }
+                return;
+            }
+
             stream._connections.push_back( _connection );
             stream._enable();
 
@@ -143,23 +163,17 @@ protected:
 
 private:
     co::base::RefPtr< co::Connection > _connection;
+    const size_t _objectSize;
+    const size_t _nObjects;
 };
 }
 }
 
-int main( int argc, char **argv )
+namespace
+{
+void _receive( co::ConnectionPtr connection, ::DataIStream& stream,
+               co::CommandCache& commandCache )
 {
-    co::init( argc, argv );
-    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
-    desc->type = co::CONNECTIONTYPE_PIPE;
-    co::ConnectionPtr connection = co::Connection::create( desc );
-
-    TEST( connection->connect( ));
-    co::DataStreamTest::Sender sender( connection->acceptSync( ));
-    TEST( sender.start( ));
-
-    ::DataIStream stream;
-    co::CommandCache commandCache;
     bool receiving = true;
 
     while( receiving )
@@ -189,6 +203,48 @@ int main( int argc, char **argv )
                 TEST( false );
         }
     }
+}
+
+float _benchmark( co::ConnectionPtr connection, co::ConnectionPtr sendConn,
+                  const size_t objectSize, const size_t nObjects )
+{
+    co::DataStreamTest::Sender sender( sendConn, objectSize, nObjects );
+    co::CommandCache commandCache;
+    std::vector< uint8_t > data;
+
+    co::base::Clock clock;
+    TEST( sender.start( ));
+    for( size_t i = 0; i < nObjects; ++i )
+    {
+        ::DataIStream stream;
+        _receive( connection, stream, commandCache );
+        stream >> data;
+        TEST( data.size() == objectSize );
+        TEST( data.back() == 42 );
+        TEST( stream.getRemainingBufferSize() == 0 );
+    }
+    TEST( sender.join( ));
+
+    const float time = clock.getTimef();
+    return float( objectSize * nObjects ) / 1048.576f / time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+    desc->type = co::CONNECTIONTYPE_PIPE;
+    co::ConnectionPtr connection = co::Connection::create( desc );
+
+    TEST( connection->connect( ));
+    co::ConnectionPtr sendConn = connection->acceptSync();
+    co::DataStreamTest::Sender sender( sendConn );
+    TEST( sender.start( ));
+
+    ::DataIStream stream;
+    co::CommandCache commandCache;
+    _receive( connection, stream, commandCache );
 
     int foo;
     stream >> foo;
@@ -214,6 +270,27 @@ int main( int argc, char **argv )
               '\'' <<  message << "' != '" << _message << '\'' );
 
     TEST( sender.join( ));
+
+    static const size_t sizes[] = { EQ_1KB, EQ_1MB, 64 * EQ_1MB };
+    static const size_t nObjects[] = { 8192, 128, 4 };
+    const int32_t referenceSize =
+        co::Global::getIAttribute( co::Global::IATTR_OBJECT_REFERENCE_SIZE );
+
+    std::cout << "Object size, copied MB/s, referenced MB/s" << std::endl;
+    for( size_t i = 0; i < sizeof( sizes ) / sizeof( size_t ); ++i )
+    {
+        co::Global::setIAttribute( co::Global::IATTR_OBJECT_REFERENCE_SIZE,
+                                   0 );
+        const float copied = _benchmark( connection, sendConn, sizes[i],
+                                         nObjects[i] );
+        co::Global::setIAttribute( co::Global::IATTR_OBJECT_REFERENCE_SIZE,
+                                   referenceSize );
+        const float referenced = _benchmark( connection, sendConn, sizes[i],
+                                             nObjects[i] );
+        std::cout << sizes[i] << ", " << copied << ", " << referenced
+                  << std::endl;
+    }
+
     connection->close();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,208 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compares the commit latency of a big object with small changes for the DELTA
+// and LAZY_DELTA change types, and tests mapping a lazy object after commits
+// to the head and to an older version. Tests that the versions retained by an
+// auto-obsoleted lazy object stay bounded over many rebases.
+// Usage: ./deltaCommit
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/connectionDescription.h>
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/object.h>
+
+#include <iostream>
+
+#define OBJECTSIZE (10 * EQ_1MB)
+#define DELTASIZE EQ_1KB
+#define NCOMMITS 50
+
+namespace
+{
+class Object : public co::Object
+{
+public:
+    Object( const ChangeType type, const size_t size = OBJECTSIZE )
+            : data( size ), _type( type ), _offset( 0 ) {}
+
+    void change( const uint8_t value )
+        {
+            _offset = ( _offset + DELTASIZE ) % data.size();
+            memset( &data[ _offset ], value, DELTASIZE );
+        }
+
+    std::vector< uint8_t > data;
+
+protected:
+    virtual ChangeType getChangeType() const { return _type; }
+    virtual void getInstanceData( co::DataOStream& os ) { os << data; }
+    virtual void applyInstanceData( co::DataIStream& is ) { is >> data; }
+
+    virtual void pack( co::DataOStream& os )
+        {
+            os << _offset;
+            os.write( &data[ _offset ], DELTASIZE );
+        }
+
+    virtual void unpack( co::DataIStream& is )
+        {
+            is >> _offset;
+            TEST( _offset + DELTASIZE <= data.size( ));
+            memcpy( &data[ _offset ], is.getRemainingBuffer(), DELTASIZE );
+            is.advanceBuffer( DELTASIZE );
+        }
+
+private:
+    const ChangeType _type;
+    uint64_t _offset;
+};
+
+float _testCommit( co::LocalNodePtr master, co::LocalNodePtr slave,
+                   const co::Object::ChangeType type )
+{
+    Object object( type );
+    Object mapped( type );
+    TEST( master->registerObject( &object ));
+    TEST( slave->mapObject( &mapped, object.getID( )));
+
+    std::vector< uint8_t > middleData;
+    co::base::uint128_t middleVersion;
+
+    co::base::Clock clock;
+    for( size_t i = 0; i < NCOMMITS; ++i )
+    {
+        object.change( uint8_t( i ));
+        object.commit();
+        if( i == NCOMMITS / 2 )
+        {
+            middleData = object.data;
+            middleVersion = object.getVersion();
+        }
+    }
+    const float time = clock.getTimef() / NCOMMITS;
+
+    // map new instances using the saved versions, they have the requested
+    // version without a sync
+    Object late( type );
+    TEST( slave->mapObject( &late, object.getID(), object.getVersion( )));
+    TESTINFO( late.getVersion() == object.getVersion(),
+              late.getVersion() << " != " << object.getVersion( ));
+    TEST( late.data == object.data );
+
+    if( type == co::Object::LAZY_DELTA ) // all deltas are retained
+    {
+        Object middle( type );
+        TEST( slave->mapObject( &middle, object.getID(), middleVersion ));
+        TESTINFO( middle.getVersion() == middleVersion,
+                  middle.getVersion() << " != " << middleVersion );
+        TEST( middle.data == middleData );
+
+        middle.sync( object.getVersion( ));
+        TEST( middle.data == object.data );
+        slave->unmapObject( &middle );
+    }
+
+    mapped.sync( object.getVersion( ));
+    TEST( mapped.data == object.data );
+
+    slave->unmapObject( &late );
+    slave->unmapObject( &mapped );
+    master->deregisterObject( &object );
+    return time;
+}
+
+void _testObsolete( co::LocalNodePtr master, co::LocalNodePtr slave )
+{
+    // about 16 deltas until each rebase
+    Object object( co::Object::LAZY_DELTA, 16 * DELTASIZE );
+    Object mapped( co::Object::LAZY_DELTA, 16 * DELTASIZE );
+    TEST( master->registerObject( &object ));
+    TEST( slave->mapObject( &mapped, object.getID( )));
+    object.setAutoObsolete( 5 );
+
+    for( size_t i = 0; i < 20 * NCOMMITS; ++i )
+    {
+        object.change( uint8_t( i ));
+        mapped.sync( object.commit( ));
+    }
+
+    // retained: the obsolete window and at most one run of lazy versions
+    Object oldest( co::Object::LAZY_DELTA, 16 * DELTASIZE );
+    TEST( slave->mapObject( &oldest, object.getID( )));
+    const uint64_t retained = object.getVersion().low() -
+                              oldest.getVersion().low();
+    TESTINFO( retained < 5 + 20, retained << " versions retained" );
+
+    oldest.sync( object.getVersion( ));
+    TEST( oldest.data == object.data );
+    TEST( mapped.data == object.data );
+
+    slave->unmapObject( &oldest );
+    slave->unmapObject( &mapped );
+    master->deregisterObject( &object );
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr server = new co::LocalNode;
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    const float deltaTime = _testCommit( server, client, co::Object::DELTA );
+    const float lazyTime = _testCommit( server, client,
+                                        co::Object::LAZY_DELTA );
+    _testObsolete( server, client );
+    std::cout << "Commit of " << OBJECTSIZE / EQ_1MB << " MB object: delta "
+              << deltaTime << " ms, lazy delta " << lazyTime << " ms"
+              << std::endl;
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that a restarted node maps objects using the persistent instance
+// cache, that corrupted cache files are detected, and that the least recently
+// used files are evicted when the cache outgrows its maximum size.
+// Usage: ./instanceStore
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/base/file.h>
+#include <co/base/rng.h>
+#include <co/base/sleep.h>
+#include <co/connectionDescription.h>
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+#include <co/global.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/object.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#define OBJECTSIZE (8 * EQ_1MB)
+
+namespace
+{
+class Object : public co::Object
+{
+public:
+    Object() : nSerialized( 0 ) {}
+
+    std::vector< uint8_t > data;
+    co::base::a_int32_t nSerialized;
+
+protected:
+    virtual ChangeType getChangeType() const { return STATIC; }
+    virtual void getInstanceData( co::DataOStream& os )
+        { ++nSerialized; os << data; }
+    virtual void applyInstanceData( co::DataIStream& is ) { is >> data; }
+};
+
+co::LocalNodePtr _newNode()
+{
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr node = new co::LocalNode;
+    node->addConnectionDescription( connDesc );
+    TEST( node->listen( ));
+    return node;
+}
+
+/** Start a new client node, map the object and stop the node again. */
+float _map( co::LocalNodePtr server, const Object& master )
+{
+    co::LocalNodePtr client = _newNode();
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    Object object;
+    co::base::Clock clock;
+    TEST( client->mapObject( &object, master.getID( )));
+    const float time = clock.getTimef();
+    TEST( object.data == master.data );
+    client->unmapObject( &object );
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    return time;
+}
+
+/** Start a new client node, map all objects at once and stop the node. */
+void _mapObjects( co::LocalNodePtr server, const std::vector< Object* >& masters )
+{
+    co::LocalNodePtr client = _newNode();
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    co::Objects objects;
+    co::ObjectVersions versions;
+    for( size_t i = 0; i < masters.size(); ++i )
+    {
+        objects.push_back( new Object );
+        versions.push_back( co::ObjectVersion( masters[i] ));
+    }
+
+    TEST( client->mapObjects( objects, versions ));
+    for( size_t i = 0; i < masters.size(); ++i )
+    {
+        Object* object = static_cast< Object* >( objects[i] );
+        TEST( object->data == masters[i]->data );
+        client->unmapObject( object );
+        delete object;
+    }
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+}
+
+const std::string _path( "." );
+
+co::base::Strings _getFiles()
+{
+    return co::base::searchDirectory( _path, "co.*.instance" );
+}
+
+void _removeFiles()
+{
+    const co::base::Strings files = _getFiles();
+    for( co::base::StringsCIter i = files.begin(); i != files.end(); ++i )
+        ::remove( ( _path + "/" + *i ).c_str( ));
+}
+
+/** Fill an object with incompressible data. */
+void _fill( Object& object )
+{
+    co::base::RNG rng;
+    object.data.resize( OBJECTSIZE );
+    for( size_t i = 0; i < OBJECTSIZE; ++i )
+        object.data[i] = rng.get< uint8_t >();
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+    co::Global::setInstanceCachePath( _path );
+    _removeFiles();
+
+    co::LocalNodePtr server = _newNode();
+    Object master;
+    _fill( master );
+    TEST( server->registerObject( &master ));
+
+    // first start: data is transferred from the master and saved
+    const int32_t nSerialized = master.nSerialized;
+    const float missTime = _map( server, master );
+    TEST( master.nSerialized == nSerialized + 1 );
+    TEST( _getFiles().size() == 1 );
+
+    // restart: data is restored from disk
+    const float hitTime = _map( server, master );
+    TEST( master.nSerialized == nSerialized + 1 );
+
+    // corrupted file: detected, data is transferred again
+    const std::string filename = _path + "/" + _getFiles().front();
+    {
+        std::fstream file( filename.c_str(),
+                           std::ios::in | std::ios::out | std::ios::binary );
+        file.seekp( OBJECTSIZE / 2 );
+        file.put( 42 );
+    }
+    _map( server, master );
+    TEST( master.nSerialized == nSerialized + 2 );
+
+    // restarted master: same object and instance ID and version, but the data
+    // of the old master node is not used
+    {
+        co::LocalNodePtr restarted = _newNode();
+        Object object;
+        _fill( object );
+        object.setID( master.getID( ));
+        TEST( restarted->registerObject( &object ));
+        TEST( object.getInstanceID() == master.getInstanceID( ));
+
+        _map( restarted, object ); // tests data
+        TEST( object.nSerialized == 1 );
+
+        restarted->deregisterObject( &object );
+        TEST( restarted->close( ));
+    }
+
+    std::cout << "Mapping " << OBJECTSIZE / EQ_1MB << " MB object: from master "
+              << missTime << " ms, from persistent cache " << hitTime << " ms"
+              << std::endl;
+    TEST( _getFiles().size() == 1 );
+
+    // Files of earlier runs are evicted in the order they were written. Wait,
+    // since the file times have a resolution of one second.
+    co::base::sleep( 1100 );
+
+    // limit the store to two objects, the least recently used one is evicted
+    co::Global::setIAttribute( co::Global::IATTR_INSTANCE_CACHE_STORE_SIZE,
+                               2 * OBJECTSIZE / EQ_1MB + 1 );
+    Object second;
+    Object third;
+    _fill( second );
+    _fill( third );
+    TEST( server->registerObject( &second ));
+    TEST( server->registerObject( &third ));
+    const int32_t nSecond = second.nSerialized;
+    const int32_t nThird = third.nSerialized;
+
+    _map( server, second );
+    TEST( _getFiles().size() == 2 );
+    co::base::sleep( 1100 );
+    _map( server, third ); // evicts master
+    TEST( _getFiles().size() == 2 );
+    TEST( second.nSerialized == nSecond + 1 );
+    TEST( third.nSerialized == nThird + 1 );
+
+    // restart: both objects are restored in one batch
+    std::vector< Object* > masters;
+    masters.push_back( &second );
+    masters.push_back( &third );
+    _mapObjects( server, masters );
+    TEST( second.nSerialized == nSecond + 1 );
+    TEST( third.nSerialized == nThird + 1 );
+
+    // the evicted object is transferred from the master, evicting second
+    _map( server, master );
+    TEST( master.nSerialized == nSerialized + 3 );
+    TEST( _getFiles().size() == 2 );
+    _map( server, third );
+    TEST( third.nSerialized == nThird + 1 );
+
+    TEST( _getFiles().size() == 2 );
+    _removeFiles();
+
+    server->deregisterObject( &third );
+    server->deregisterObject( &second );
+    server->deregisterObject( &master );
+    TEST( server->close( ));
+    server = 0;
+
+    co::Global::setInstanceCachePath( std::string( ));
+    co::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compares mapping many small objects one by one with batched mapping.
+// Usage: ./mapObjects
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/connectionDescription.h>
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/object.h>
+#include <co/objectVersion.h>
+
+#include <iostream>
+
+#define NOBJECTS 1000
+
+namespace
+{
+class Object : public co::Object
+{
+public:
+    Object( const uint32_t value_ = 0 ) : value( value_ ) {}
+
+    uint32_t value;
+
+protected:
+    virtual ChangeType getChangeType() const { return INSTANCE; }
+    virtual void getInstanceData( co::DataOStream& os ) { os << value; }
+    virtual void applyInstanceData( co::DataIStream& is ) { is >> value; }
+};
+
+typedef std::vector< Object* > Objects;
+
+void _unmap( co::LocalNodePtr node, Objects& objects )
+{
+    for( Objects::const_iterator i = objects.begin(); i != objects.end(); ++i )
+    {
+        node->unmapObject( *i );
+        delete *i;
+    }
+    objects.clear();
+}
+
+float _mapSingle( co::LocalNodePtr node, const Objects& masters )
+{
+    Objects objects;
+    std::vector< uint32_t > requests;
+
+    co::base::Clock clock;
+    for( Objects::const_iterator i = masters.begin(); i != masters.end(); ++i)
+    {
+        objects.push_back( new Object );
+        requests.push_back( node->mapObjectNB( objects.back(),
+                                               (*i)->getID( )));
+    }
+    for( size_t i = 0; i < requests.size(); ++i )
+        TEST( node->mapObjectSync( requests[i] ));
+    const float time = clock.getTimef();
+
+    for( size_t i = 0; i < objects.size(); ++i )
+        TEST( objects[i]->value == masters[i]->value );
+    _unmap( node, objects );
+    return time;
+}
+
+float _mapBatched( co::LocalNodePtr node, const Objects& masters )
+{
+    Objects objects;
+    co::Objects coObjects;
+    co::ObjectVersions versions;
+
+    co::base::Clock clock;
+    for( Objects::const_iterator i = masters.begin(); i != masters.end(); ++i)
+    {
+        objects.push_back( new Object );
+        coObjects.push_back( objects.back( ));
+        versions.push_back( co::ObjectVersion( (*i)->getID(),
+                                               co::VERSION_OLDEST ));
+    }
+    TEST( node->mapObjects( coObjects, versions ));
+    const float time = clock.getTimef();
+
+    for( size_t i = 0; i < objects.size(); ++i )
+        TEST( objects[i]->value == masters[i]->value );
+    _unmap( node, objects );
+    return time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr server = new co::LocalNode;
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    Objects masters;
+    for( uint32_t i = 0; i < NOBJECTS; ++i )
+    {
+        masters.push_back( new Object( i ));
+        TEST( server->registerObject( masters.back( )));
+    }
+
+    const float singleTime = _mapSingle( client, masters );
+    const float batchedTime = _mapBatched( client, masters );
+    std::cout << "Mapping " << NOBJECTS << " objects: single " << singleTime
+              << " ms, batched " << batchedTime << " ms" << std::endl;
+
+    // mapping unknown objects fails
+    Object object;
+    co::Objects objects( 1, &object );
+    co::ObjectVersions versions( 1, co::ObjectVersion(
+                                     co::base::UUID( true ),
+                                     co::VERSION_OLDEST ));
+    TEST( !client->mapObjects( objects, versions ));
+
+    for( Objects::const_iterator i = masters.begin(); i != masters.end(); ++i)
+    {
+        server->deregisterObject( *i );
+        delete *i;
+    }
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
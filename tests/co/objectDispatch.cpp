@@ -0,0 +1,223 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the object command dispatch throughput, with and without objects
+// being mapped and unmapped concurrently.
+// Usage: ./objectDispatch
+
+#include <pthread.h> // must come first!
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/base/monitor.h>
+#include <co/command.h>
+#include <co/commands.h>
+#include <co/connectionDescription.h>
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/object.h>
+#include <co/packets.h>
+
+#include <iostream>
+
+#define NOBJECTS 64
+#define NPACKETS 50000
+
+namespace
+{
+co::base::a_int32_t _received;
+
+struct DataPacket : public co::ObjectPacket
+{
+    DataPacket()
+        {
+            command = co::CMD_OBJECT_CUSTOM;
+            size    = sizeof( DataPacket );
+        }
+};
+
+class Object : public co::Object
+{
+protected:
+    virtual ChangeType getChangeType() const { return STATIC; }
+    virtual void getInstanceData( co::DataOStream& os ) { os << getID(); }
+    virtual void applyInstanceData( co::DataIStream& is )
+        {
+            co::base::UUID id;
+            is >> id;
+            TEST( id == getID( ));
+        }
+
+    virtual void attach( const co::base::UUID& id, const uint32_t instanceID )
+        {
+            co::Object::attach( id, instanceID );
+            registerCommand( co::CMD_OBJECT_CUSTOM,
+                             co::CommandFunc< Object >( this, &Object::_cmd ),
+                             0 );
+        }
+
+private:
+    bool _cmd( co::Command& ) { ++_received; return true; }
+};
+
+typedef std::vector< Object* > Objects;
+
+class MapThread : public co::base::Thread
+{
+public:
+    MapThread( co::LocalNodePtr node, const Objects& masters )
+            : running( true ), nMapped( 0 ), _node( node ), _masters( masters )
+        {}
+
+    virtual void run()
+        {
+            while( running )
+            {
+                Objects objects;
+                for( Objects::const_iterator i = _masters.begin();
+                     i != _masters.end(); ++i )
+                {
+                    objects.push_back( new Object );
+                    TEST( _node->mapObject( objects.back(), (*i)->getID( )));
+                }
+                for( Objects::const_iterator i = objects.begin();
+                     i != objects.end(); ++i )
+                {
+                    _node->unmapObject( *i );
+                    delete *i;
+                }
+                nMapped += int32_t( objects.size( ));
+            }
+        }
+
+    co::base::a_int32_t running;
+    co::base::a_int32_t nMapped;
+
+private:
+    co::LocalNodePtr _node;
+    const Objects& _masters;
+};
+
+float _dispatch( co::NodePtr client, const Objects& masters )
+{
+    _received = 0;
+    DataPacket packet;
+
+    co::base::Clock clock;
+    for( size_t i = 0; i < NPACKETS; ++i )
+        TEST( masters[ i % NOBJECTS ]->send( client, packet ));
+
+    while( _received < NPACKETS )
+        co::base::Thread::yield();
+    return NPACKETS / clock.getTimef();
+}
+
+void _register( co::LocalNodePtr node, Objects& objects )
+{
+    for( size_t i = 0; i < NOBJECTS; ++i )
+    {
+        objects.push_back( new Object );
+        TEST( node->registerObject( objects.back( )));
+    }
+}
+
+void _deregister( co::LocalNodePtr node, Objects& objects )
+{
+    for( Objects::const_iterator i = objects.begin(); i != objects.end(); ++i)
+    {
+        node->deregisterObject( *i );
+        delete *i;
+    }
+    objects.clear();
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr server = new co::LocalNode;
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+    co::NodePtr clientProxy = server->getNode( client->getNodeID( ));
+    TEST( clientProxy.isValid( ));
+
+    Objects masters;
+    Objects mapMasters;
+    _register( server, masters );
+    _register( server, mapMasters );
+
+    Objects slaves;
+    for( Objects::const_iterator i = masters.begin(); i != masters.end(); ++i)
+    {
+        slaves.push_back( new Object );
+        TEST( client->mapObject( slaves.back(), (*i)->getID( )));
+    }
+
+    const float idleRate = _dispatch( clientProxy, masters );
+
+    MapThread mapThread( client, mapMasters );
+    TEST( mapThread.start( ));
+    while( mapThread.nMapped == 0 )
+        co::base::Thread::yield();
+    const float mapRate = _dispatch( clientProxy, masters );
+    mapThread.running = false;
+    TEST( mapThread.join( ));
+
+    std::cout << "Dispatch " << idleRate << " packets/ms, with concurrent "
+              << "mapping " << mapRate << " packets/ms (" << mapThread.nMapped
+              << " objects mapped)" << std::endl;
+
+    for( Objects::const_iterator i = slaves.begin(); i != slaves.end(); ++i)
+    {
+        client->unmapObject( *i );
+        delete *i;
+    }
+    _deregister( server, masters );
+    _deregister( server, mapMasters );
+
+    clientProxy = 0;
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
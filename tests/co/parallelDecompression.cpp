@@ -0,0 +1,130 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Maps an object with large, compressed instance data, with sequential and with
+// parallel decompression of the data packets.
+// Usage: ./parallelDecompression
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/connectionDescription.h>
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+#include <co/global.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/object.h>
+
+#include <iostream>
+
+#define NBLOCKS 2048
+#define BLOCKSIZE 8192 // uint32_t, below the object reference size
+
+namespace
+{
+class Object : public co::Object
+{
+public:
+    Object() {}
+
+    void setup()
+        {
+            blocks.resize( NBLOCKS );
+            for( size_t i = 0; i < NBLOCKS; ++i )
+            {
+                blocks[i].resize( BLOCKSIZE );
+                for( size_t j = 0; j < BLOCKSIZE; ++j )
+                    blocks[i][j] = uint32_t( i + j / 16 ); // compressible
+            }
+        }
+
+    std::vector< std::vector< uint32_t > > blocks;
+
+protected:
+    virtual ChangeType getChangeType() const { return INSTANCE; }
+    virtual void getInstanceData( co::DataOStream& os ) { os << blocks; }
+    virtual void applyInstanceData( co::DataIStream& is ) { is >> blocks; }
+};
+
+float _map( co::LocalNodePtr node, const Object& master )
+{
+    Object object;
+    co::base::Clock clock;
+    TEST( node->mapObject( &object, master.getID( )));
+    const float time = clock.getTimef();
+
+    TEST( object.blocks == master.blocks );
+    node->unmapObject( &object );
+    return time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr server = new co::LocalNode;
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    Object master;
+    master.setup();
+    TEST( server->registerObject( &master ));
+
+    const int32_t nThreads = co::Global::getIAttribute(
+        co::Global::IATTR_OBJECT_DECOMPRESSOR_THREADS );
+    co::Global::setIAttribute( co::Global::IATTR_OBJECT_DECOMPRESSOR_THREADS,
+                               0 );
+    const float sequential = _map( client, master );
+    co::Global::setIAttribute( co::Global::IATTR_OBJECT_DECOMPRESSOR_THREADS,
+                               nThreads );
+    const float parallel = _map( client, master );
+
+    std::cout << "Mapping " << NBLOCKS * BLOCKSIZE * sizeof( uint32_t )
+              << " bytes: sequential " << sequential << " ms, " << nThreads
+              << " decompressor threads " << parallel << " ms" << std::endl;
+
+    server->deregisterObject( &master );
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
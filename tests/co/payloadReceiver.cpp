@@ -0,0 +1,198 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests receiving big packet payloads directly into application memory using a
+// co::PayloadReceiver, and compares it with receiving into the command.
+// Usage: ./payloadReceiver
+
+#include <test.h>
+
+#include <co/base/atomic.h>
+#include <co/base/clock.h>
+#include <co/base/monitor.h>
+#include <co/command.h>
+#include <co/connectionDescription.h>
+#include <co/global.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/packets.h>
+#include <co/payloadReceiver.h>
+
+#include <iostream>
+
+#define NPACKETS 100
+#define PACKETSIZE EQ_1MB
+#define SMALLSIZE EQ_1KB
+
+namespace
+{
+co::base::Monitor< uint32_t > _received( 0 );
+co::base::a_int32_t _payloads;
+
+struct DataPacket : public co::NodePacket
+{
+    DataPacket( const uint32_t index_, const bool direct_ )
+            : index( index_ ), direct( direct_ )
+        {
+            command = co::CMD_NODE_CUSTOM;
+            size    = sizeof( DataPacket );
+        }
+
+    uint32_t index;
+    uint32_t direct;  // receiver provides memory
+    EQ_ALIGN8( uint8_t data[8] );
+};
+
+class Receiver : public co::PayloadReceiver
+{
+public:
+    virtual uint64_t getHeaderSize() const { return sizeof( DataPacket ) - 8; }
+
+    virtual co::base::Bufferb* allocPayload( const co::Packet* packet,
+                                             const uint64_t size )
+        {
+            const DataPacket* dataPacket =
+                static_cast< const DataPacket* >( packet );
+            TESTINFO( size == PACKETSIZE, size );
+            if( !dataPacket->direct )
+                return 0;
+
+            ++_payloads;
+            co::base::Bufferb* payload = new co::base::Bufferb;
+            payload->reset( size );
+            return payload;
+        }
+
+    virtual void releasePayload( co::base::Bufferb* payload )
+        {
+            --_payloads;
+            delete payload;
+        }
+};
+
+class Server : public co::LocalNode
+{
+public:
+    virtual bool listen()
+        {
+            if( !co::LocalNode::listen( ))
+                return false;
+
+            registerCommand( co::CMD_NODE_CUSTOM,
+                             co::CommandFunc<Server>( this, &Server::_cmdData ),
+                             getCommandThreadQueue( ));
+            return true;
+        }
+
+private:
+    bool _cmdData( co::Command& command )
+        {
+            const DataPacket* packet = command.get< DataPacket >();
+            const uint64_t size = packet->size - sizeof( DataPacket ) + 8;
+            const uint8_t value = uint8_t( packet->index );
+            co::base::Bufferb* payload = command.getPayload();
+            const uint8_t* data = payload ? payload->getData() : packet->data;
+
+            TESTINFO( size == SMALLSIZE || size == PACKETSIZE, size );
+            if( size == PACKETSIZE && packet->direct )
+            {
+                TEST( payload );
+                TEST( payload->getSize() == PACKETSIZE );
+                TEST( command.getAllocationSize() < PACKETSIZE );
+            }
+            else
+                TEST( !payload );
+
+            TESTINFO( data[0] == value,
+                      int( data[0] ) << " != " << int( value ));
+            TEST( memcmp( data, data + 1, size - 1 ) == 0 ); // all equal
+
+            ++_received;
+            return true;
+        }
+};
+
+float _send( co::NodePtr server, const bool direct )
+{
+    std::vector< uint8_t > data( PACKETSIZE );
+    _received = 0;
+
+    co::base::Clock clock;
+    for( uint32_t i = 0; i < NPACKETS; ++i )
+    {
+        const uint64_t size = ( i % 4 ) ? PACKETSIZE : SMALLSIZE;
+        DataPacket packet( i, direct );
+        memset( &data.front(), uint8_t( i ), size );
+        TEST( server->send( packet, &data.front(), size ));
+    }
+    _received.waitEQ( NPACKETS );
+    const float time = clock.getTimef();
+    return NPACKETS * ( PACKETSIZE / float( EQ_1MB )) * 1000.f / time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+    TEST( co::Global::getIAttribute(
+              co::Global::IATTR_NODE_PAYLOAD_RECEIVE_SIZE ) > SMALLSIZE );
+
+    Receiver receiver;
+    co::base::RefPtr< Server > server = new Server;
+    server->registerPayloadReceiver( co::PACKETTYPE_CO_NODE,
+                                     co::CMD_NODE_CUSTOM, &receiver );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    const float commandRate = _send( serverProxy, false );
+    const float directRate = _send( serverProxy, true );
+    std::cout << "Receive into command " << commandRate << " MB/s, direct "
+              << directRate << " MB/s" << std::endl;
+
+    server->registerPayloadReceiver( co::PACKETTYPE_CO_NODE,
+                                     co::CMD_NODE_CUSTOM, 0 );
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    // all payloads are released with their commands
+    TESTINFO( _payloads == 0, _payloads );
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
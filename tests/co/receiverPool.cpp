@@ -0,0 +1,193 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the throughput of many peers sending to one node, using different
+// receiver pool sizes (Global::IATTR_NODE_RECEIVER_THREADS).
+// Usage: ./receiverPool
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/base/monitor.h>
+#include <co/command.h>
+#include <co/connectionDescription.h>
+#include <co/global.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/packets.h>
+
+#include <iostream>
+
+#define NCLIENTS 8
+#define NPACKETS 100
+#define PACKETSIZE EQ_128KB
+
+namespace
+{
+co::base::Monitor< uint32_t > _received( 0 );
+
+struct DataPacket : public co::NodePacket
+{
+    DataPacket( const uint32_t client_ )
+        {
+            command = co::CMD_NODE_CUSTOM;
+            size    = sizeof( DataPacket );
+            client  = client_;
+            index   = 0;
+        }
+
+    uint32_t client;
+    uint32_t index;
+    uint8_t  data[8];
+};
+
+class Server : public co::LocalNode
+{
+public:
+    Server()
+        {
+            for( size_t i = 0; i < NCLIENTS; ++i )
+                _next[i] = 0;
+        }
+
+    virtual bool listen()
+        {
+            if( !co::LocalNode::listen( ))
+                return false;
+
+            registerCommand( co::CMD_NODE_CUSTOM,
+                             co::CommandFunc<Server>( this, &Server::_cmdData ),
+                             0 );
+            return true;
+        }
+
+private:
+    uint32_t _next[ NCLIENTS ];
+
+    bool _cmdData( co::Command& command )
+        {
+            const DataPacket* packet = command.get< DataPacket >();
+            TEST( packet->client < NCLIENTS );
+            TESTINFO( packet->size == sizeof( DataPacket ) + PACKETSIZE - 8,
+                      packet->size );
+
+            // packets of one peer have to arrive in order
+            TESTINFO( packet->index == _next[ packet->client ],
+                      packet->index << " != " << _next[ packet->client ] );
+            ++_next[ packet->client ];
+            ++_received;
+            return true;
+        }
+};
+
+class Client : public co::base::Thread
+{
+public:
+    Client( const uint32_t index, co::NodePtr server )
+            : _index( index ), _server( server ) {}
+
+protected:
+    virtual void run()
+        {
+            std::vector< uint8_t > data( PACKETSIZE, uint8_t( _index ));
+            for( uint32_t i = 0; i < NPACKETS; ++i )
+            {
+                DataPacket packet( _index ); // send() modifies packet size
+                packet.index = i;
+                TEST( _server->send( packet, &data.front(), PACKETSIZE ));
+            }
+        }
+
+private:
+    const uint32_t _index;
+    co::NodePtr _server;
+};
+
+float _run( const int32_t nThreads )
+{
+    co::Global::setIAttribute( co::Global::IATTR_NODE_RECEIVER_THREADS,
+                               nThreads );
+    co::base::RefPtr< Server > server = new Server;
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+    co::Global::setIAttribute( co::Global::IATTR_NODE_RECEIVER_THREADS, 0 );
+
+    co::LocalNodePtr clients[ NCLIENTS ];
+    co::NodePtr proxies[ NCLIENTS ];
+    Client* threads[ NCLIENTS ];
+
+    for( uint32_t i = 0; i < NCLIENTS; ++i )
+    {
+        connDesc = new co::ConnectionDescription;
+        connDesc->type = co::CONNECTIONTYPE_TCPIP;
+        connDesc->setHostname( "localhost" );
+
+        clients[i] = new co::LocalNode;
+        clients[i]->addConnectionDescription( connDesc );
+        TEST( clients[i]->listen( ));
+
+        proxies[i] = new co::Node;
+        proxies[i]->addConnectionDescription(
+            server->getConnectionDescriptions().front( ));
+        TEST( clients[i]->connect( proxies[i] ));
+        threads[i] = new Client( i, proxies[i] );
+    }
+
+    _received = 0;
+    co::base::Clock clock;
+    for( uint32_t i = 0; i < NCLIENTS; ++i )
+        TEST( threads[i]->start( ));
+
+    _received.waitEQ( NCLIENTS * NPACKETS );
+    const float time = clock.getTimef();
+
+    for( uint32_t i = 0; i < NCLIENTS; ++i )
+    {
+        TEST( threads[i]->join( ));
+        delete threads[i];
+
+        TEST( clients[i]->disconnect( proxies[i] ));
+        TEST( clients[i]->close( ));
+        proxies[i] = 0;
+        clients[i] = 0;
+    }
+    TEST( server->close( ));
+    TESTINFO( server->getRefCount() == 1, server->getRefCount( ));
+
+    return NCLIENTS * NPACKETS * ( PACKETSIZE / float( EQ_1MB )) * 1000.f /
+           time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    static const int32_t nThreads[] = { 0, 1, 2, 4 };
+    for( size_t i = 0; i < sizeof( nThreads ) / sizeof( int32_t ); ++i )
+    {
+        const float rate = _run( nThreads[i] );
+        std::cout << NCLIENTS << " peers, " << nThreads[i]
+                  << " pool threads: " << rate << " MB/s" << std::endl;
+    }
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the RSP throughput from one writer to multiple readers in one
+// process over the loopback interface, with an increasing injected loss rate,
+// without and with forward error correction. Tests that all data arrives
+// intact at each loss rate.
+// Usage: ./rspLoss
+
+#include <pthread.h> // must come first!
+
+#include <test.h>
+
+#include <co/base/clock.h>
+#include <co/connection.h>
+#include <co/connectionDescription.h>
+#include <co/connectionSet.h>
+#include <co/global.h>
+#include <co/init.h>
+
+#ifdef CO_USE_BOOST
+#include <co/rspConnection.h>
+
+#include <iostream>
+
+#define NLISTENERS 4
+#define PACKETSIZE 65536
+#define NPACKETS 1024
+#define FECGROUPSIZE 16
+#define FECREPAIRS 2
+
+namespace
+{
+typedef std::vector< co::ConnectionPtr > Connections;
+typedef Connections::const_iterator ConnectionsCIter;
+
+/** Fill a packet with data unique to its position in the stream. */
+void _fill( std::vector< uint8_t >& data, const size_t packet )
+{
+    for( size_t i = 0; i < PACKETSIZE; ++i )
+        data[i] = uint8_t(( packet * 7 + i ) ^ ( i >> 8 ));
+}
+
+class Reader : public co::base::Thread
+{
+public:
+    Reader( co::ConnectionPtr connection ) : _connection( connection ) {}
+
+    virtual void run()
+        {
+            std::vector< uint8_t > data( PACKETSIZE );
+            std::vector< uint8_t > expected( PACKETSIZE );
+            for( size_t i = 0; i < NPACKETS; ++i )
+            {
+                _connection->recvNB( &data.front(), PACKETSIZE );
+                TEST( _connection->recvSync( 0, 0 ));
+
+                _fill( expected, i );
+                TESTINFO( data == expected, "packet " << i << " corrupted" );
+            }
+        }
+
+private:
+    co::ConnectionPtr _connection;
+};
+
+uint16_t _getID( co::ConnectionPtr connection )
+    { return static_cast< co::RSPConnection* >( connection.get( ))->getID(); }
+
+float _testLoss( co::ConnectionPtr writer, const Connections& readers,
+                 const int32_t dropRate )
+{
+    co::Global::setIAttribute( co::Global::IATTR_RSP_DROP_RATE, dropRate );
+
+    std::vector< Reader* > threads;
+    for( ConnectionsCIter i = readers.begin(); i != readers.end(); ++i )
+    {
+        threads.push_back( new Reader( *i ));
+        TEST( threads.back()->start( ));
+    }
+
+    std::vector< uint8_t > data( PACKETSIZE );
+    co::base::Clock clock;
+    for( size_t i = 0; i < NPACKETS; ++i )
+    {
+        _fill( data, i );
+        TEST( writer->send( &data.front(), PACKETSIZE ));
+    }
+    writer->finish();
+
+    for( std::vector< Reader* >::const_iterator i = threads.begin();
+         i != threads.end(); ++i )
+    {
+        TEST( (*i)->join( ));
+        delete *i;
+    }
+    const float time = clock.getTimef();
+
+    co::Global::setIAttribute( co::Global::IATTR_RSP_DROP_RATE, 0 );
+    return float( NPACKETS * PACKETSIZE ) / 1048.576f / time;
+}
+
+std::vector< float > _testGroup( const uint16_t fecGroupSize )
+{
+    Connections listeners;
+    co::ConnectionSet set;
+    for( size_t i = 0; i < NLISTENERS; ++i )
+    {
+        co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+        desc->type = co::CONNECTIONTYPE_RSP;
+        desc->setHostname( "239.255.12.35" );
+        desc->setInterface( "127.0.0.1" );
+        desc->bandwidth = 1048576; // KB/s
+        desc->fecGroupSize = fecGroupSize;
+        desc->fecRepairs = FECREPAIRS;
+
+        co::ConnectionPtr listener = co::Connection::create( desc );
+        TESTINFO( listener->listen(), desc );
+        listener->acceptNB();
+        set.addConnection( listener );
+        listeners.push_back( listener );
+    }
+
+    // each listener has one connection per member, including itself
+    co::ConnectionPtr writer = listeners.front();
+    Connections connections;
+    Connections readers;
+    while( connections.size() < NLISTENERS * NLISTENERS )
+    {
+        const co::ConnectionSet::Event event = set.select( 10000 );
+        TESTINFO( event == co::ConnectionSet::EVENT_CONNECT, event );
+
+        co::ConnectionPtr listener = set.getConnection();
+        co::ConnectionPtr connection = listener->acceptSync();
+        TEST( connection.isValid( ));
+        connections.push_back( connection );
+
+        // the writer receives its own data, which has to be read as well
+        if( _getID( connection ) == _getID( writer ))
+            readers.push_back( connection );
+    }
+    TEST( readers.size() == NLISTENERS );
+
+    std::vector< float > results;
+    for( int32_t dropRate = 0; dropRate <= 80; dropRate = dropRate * 2 + 10 )
+        results.push_back( _testLoss( writer, readers, dropRate ));
+
+    for( size_t i = 0; i < connections.size(); ++i )
+        connections[i]->close();
+    for( size_t i = 0; i < listeners.size(); ++i )
+        listeners[i]->close();
+    return results;
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    const std::vector< float > plain = _testGroup( 0 );
+    const std::vector< float > fec = _testGroup( FECGROUPSIZE );
+
+    std::cout << "Loss permille, MB/s, MB/s with " << FECREPAIRS
+              << " repairs per " << FECGROUPSIZE << " datagrams, "
+              << NLISTENERS - 1 << " remote readers" << std::endl;
+    int32_t dropRate = 0;
+    for( size_t i = 0; i < plain.size(); ++i, dropRate = dropRate * 2 + 10 )
+        std::cout << dropRate << ", " << plain[i] << ", " << fec[i]
+                  << std::endl;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
+#else
+int main( int, char** )
+{
+    return EXIT_SUCCESS;
+}
+#endif
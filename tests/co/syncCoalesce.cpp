@@ -0,0 +1,172 @@
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that a lagging slave skips superseded versions of a last-writer-wins
+// serializable, and applies all versions otherwise.
+// Usage: ./syncCoalesce
+
+#include <test.h>
+
+#include <co/base/thread.h>
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <co/serializable.h>
+
+#include <iostream>
+
+#define NFIRST 10
+#define NSECOND 5
+
+namespace
+{
+class Serializable : public co::Serializable
+{
+public:
+    Serializable( const bool lastWriterWins )
+            : a( 0 ), b( 0 ), nDeserialized( 0 )
+            , _lastWriterWins( lastWriterWins ) {}
+
+    void setA( const uint32_t value ) { a = value; setDirty( DIRTY_A ); }
+    void setB( const uint32_t value ) { b = value; setDirty( DIRTY_B ); }
+
+    uint32_t a;
+    uint32_t b;
+    uint32_t nDeserialized;
+
+protected:
+    enum DirtyBits
+    {
+        DIRTY_A = co::Serializable::DIRTY_CUSTOM << 0,
+        DIRTY_B = co::Serializable::DIRTY_CUSTOM << 1
+    };
+
+    virtual void serialize( co::DataOStream& os, const uint64_t dirtyBits )
+        {
+            if( dirtyBits & DIRTY_A )
+                os << a;
+            if( dirtyBits & DIRTY_B )
+                os << b;
+        }
+
+    virtual void deserialize( co::DataIStream& is, const uint64_t dirtyBits )
+        {
+            ++nDeserialized;
+            if( dirtyBits & DIRTY_A )
+                is >> a;
+            if( dirtyBits & DIRTY_B )
+                is >> b;
+        }
+
+    virtual bool isLastWriterWins() const { return _lastWriterWins; }
+
+private:
+    const bool _lastWriterWins;
+};
+
+void _testSync( co::LocalNodePtr master, co::LocalNodePtr slave,
+                const bool lastWriterWins )
+{
+    Serializable object( lastWriterWins );
+    Serializable mapped( lastWriterWins );
+    TEST( master->registerObject( &object ));
+    TEST( slave->mapObject( &mapped, object.getID( )));
+    mapped.nDeserialized = 0;
+
+    // NFIRST versions changing a, one changing b, NSECOND changing a
+    for( uint32_t i = 0; i < NFIRST; ++i )
+    {
+        object.setA( i );
+        object.commit();
+    }
+    object.setB( 42 );
+    object.commit();
+    for( uint32_t i = 0; i < NSECOND; ++i )
+    {
+        object.setA( i + NFIRST );
+        object.commit();
+    }
+
+    while( mapped.getHeadVersion() < object.getVersion( ))
+        co::base::Thread::yield();
+    mapped.sync();
+
+    TEST( mapped.getVersion() == object.getVersion( ));
+    TEST( mapped.a == object.a );
+    TEST( mapped.b == object.b );
+
+    const uint32_t nVersions = NFIRST + 1 + NSECOND;
+    if( lastWriterWins )
+    {
+        // only the b change and the last a change are applied
+        TESTINFO( mapped.nDeserialized == 2, mapped.nDeserialized );
+        TESTINFO( mapped.getSkippedVersions() == nVersions - 2,
+                  mapped.getSkippedVersions( ));
+    }
+    else
+    {
+        TESTINFO( mapped.nDeserialized == nVersions, mapped.nDeserialized );
+        TEST( mapped.getSkippedVersions() == 0 );
+    }
+    std::cout << (lastWriterWins ? "Coalesced" : "Regular") << " sync of "
+              << nVersions << " versions: " << mapped.nDeserialized
+              << " applied, " << mapped.getSkippedVersions() << " skipped"
+              << std::endl;
+
+    slave->unmapObject( &mapped );
+    master->deregisterObject( &object );
+}
+}
+
+int main( int argc, char **argv )
+{
+    co::init( argc, argv );
+
+    co::ConnectionDescriptionPtr connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr server = new co::LocalNode;
+    server->addConnectionDescription( connDesc );
+    TEST( server->listen( ));
+
+    connDesc = new co::ConnectionDescription;
+    connDesc->type = co::CONNECTIONTYPE_TCPIP;
+    connDesc->setHostname( "localhost" );
+
+    co::LocalNodePtr client = new co::LocalNode;
+    client->addConnectionDescription( connDesc );
+    TEST( client->listen( ));
+
+    co::NodePtr serverProxy = new co::Node;
+    serverProxy->addConnectionDescription(
+        server->getConnectionDescriptions().front( ));
+    TEST( client->connect( serverProxy ));
+
+    _testSync( server, client, false );
+    _testSync( server, client, true );
+
+    TEST( client->disconnect( serverProxy ));
+    TEST( client->close( ));
+    TEST( server->close( ));
+
+    serverProxy = 0;
+    client = 0;
+    server = 0;
+
+    co::exit();
+    return EXIT_SUCCESS;
+}
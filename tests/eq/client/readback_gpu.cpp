@@ -0,0 +1,184 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that the asynchronous readback of color and depth using
+// Image::startReadback and Image::finishReadback produces the same pixels as
+// the synchronous Image::readback, using an offscreen EGL PBuffer context.
+
+#include <test.h>
+
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/util/objectManager.h>
+#include <co/plugins/compressor.h>
+
+#include <EGL/egl.h>
+
+namespace
+{
+GLEWContext _glewContext;
+
+const GLEWContext* glewGetContext() { return &_glewContext; }
+
+/** A minimal EGL PBuffer context. */
+class Context
+{
+public:
+    Context( const int32_t width, const int32_t height )
+            : _display( EGL_NO_DISPLAY )
+            , _pbuffer( EGL_NO_SURFACE )
+            , _context( EGL_NO_CONTEXT )
+        {
+            if( !getenv( "DISPLAY" )) // use Mesa without a window system
+                setenv( "EGL_PLATFORM", "surfaceless", 0 );
+
+            _display = eglGetDisplay( EGL_DEFAULT_DISPLAY );
+            TESTINFO( _display != EGL_NO_DISPLAY, "Can't open EGL display" );
+            TEST( eglInitialize( _display, 0, 0 ));
+
+            const EGLint attributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                          EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                          EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8,
+                                          EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+                                          EGL_DEPTH_SIZE, 24, EGL_NONE };
+            EGLConfig config;
+            EGLint nConfigs = 0;
+            TEST( eglChooseConfig( _display, attributes, &config, 1,
+                                   &nConfigs ));
+            TESTINFO( nConfigs > 0, "No PBuffer config" );
+
+            const EGLint pbAttributes[] = { EGL_WIDTH, width,
+                                            EGL_HEIGHT, height, EGL_NONE };
+            _pbuffer = eglCreatePbufferSurface( _display, config,
+                                                pbAttributes );
+            TEST( eglBindAPI( EGL_OPENGL_API ));
+            _context = eglCreateContext( _display, config, EGL_NO_CONTEXT, 0 );
+            TESTINFO( _pbuffer != EGL_NO_SURFACE &&
+                      _context != EGL_NO_CONTEXT,
+                      "Can't create PBuffer context" );
+
+            TEST( eglMakeCurrent( _display, _pbuffer, _pbuffer, _context ));
+            TEST( glewContextInit( &_glewContext ) == GLEW_OK );
+        }
+
+    ~Context()
+        {
+            eglMakeCurrent( _display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                            EGL_NO_CONTEXT );
+            eglDestroyContext( _display, _context );
+            eglDestroySurface( _display, _pbuffer );
+            eglTerminate( _display );
+        }
+
+private:
+    EGLDisplay _display;
+    EGLSurface _pbuffer;
+    EGLContext _context;
+};
+
+/** Clear the frame buffer to a background with a differing rectangle. */
+void _draw()
+{
+    glClearColor( .2f, .4f, .6f, .8f );
+    glClearDepth( .5 );
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    glEnable( GL_SCISSOR_TEST );
+    glScissor( 10, 60, 20, 20 );
+    glClearColor( 1.f, 0.f, 0.f, 1.f );
+    glClearDepth( .25 );
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    glDisable( GL_SCISSOR_TEST );
+}
+
+void _initImage( eq::Image& image )
+{
+    image.setInternalFormat( eq::Frame::BUFFER_COLOR,
+                             EQ_COMPRESSOR_DATATYPE_RGBA );
+    image.setInternalFormat( eq::Frame::BUFFER_DEPTH,
+                             EQ_COMPRESSOR_DATATYPE_DEPTH );
+}
+
+void _compare( const eq::Image& async, const eq::Image& sync,
+               const eq::Frame::Buffer buffer )
+{
+    TEST( async.hasPixelData( buffer ));
+    TEST( sync.hasPixelData( buffer ));
+
+    const eq::PixelData& asyncData = async.getPixelData( buffer );
+    const eq::PixelData& syncData = sync.getPixelData( buffer );
+    TESTINFO( asyncData.pvp == syncData.pvp,
+              asyncData.pvp << " != " << syncData.pvp );
+    TEST( asyncData.externalFormat == syncData.externalFormat );
+
+    const uint32_t size = sync.getPixelDataSize( buffer );
+    TESTINFO( async.getPixelDataSize( buffer ) == size,
+              async.getPixelDataSize( buffer ) << " != " << size );
+    TESTINFO( memcmp( asyncData.pixels, syncData.pixels, size ) == 0,
+              "Pixel data of buffer " << buffer << " differs" );
+}
+
+void _testReadback( eq::Image& async,
+                    eq::util::ObjectManager< const void* >& glObjects,
+                    const eq::PixelViewport& pvp )
+{
+    const uint32_t buffers = eq::Frame::BUFFER_COLOR |
+                             eq::Frame::BUFFER_DEPTH;
+    eq::Image sync;
+    _initImage( sync );
+
+    _draw();
+    TEST( sync.readback( buffers, pvp, eq::Zoom::NONE, &glObjects ));
+    TEST( async.startReadback( buffers, pvp, eq::Zoom::NONE, &glObjects ));
+    TESTINFO( !async.hasPixelData( eq::Frame::BUFFER_COLOR ),
+              "Color readback was not asynchronous" );
+
+    // must not change the pending readback
+    glClearColor( 0.f, 0.f, 0.f, 0.f );
+    glClearDepth( 1. );
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    async.finishReadback( glObjects.glewGetContext( ));
+    _compare( async, sync, eq::Frame::BUFFER_COLOR );
+    _compare( async, sync, eq::Frame::BUFFER_DEPTH );
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    {
+        Context context( 128, 128 );
+        eq::util::ObjectManager< const void* > glObjects( glewGetContext( ));
+        {
+            // reuse the image and its downloaders for differently sized reads
+            eq::Image image;
+            _initImage( image );
+            _testReadback( image, glObjects, eq::PixelViewport( 3, 5, 61, 47 ));
+            _testReadback( image, glObjects, eq::PixelViewport( 3, 5, 61, 47 ));
+            _testReadback( image, glObjects, eq::PixelViewport( 0, 2, 100, 90));
+            image.deleteGLObjects( glObjects.glewGetContext( ));
+        }
+        glObjects.deleteAll();
+    }
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the regions of interest found in synthetic depth images, including
+// frames wider than 4080 pixels.
+
+#include <test.h>
+
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/roiFinder.h>
+#include <co/plugins/compressor.h>
+
+#define FAR 0xffffffffu
+
+namespace
+{
+typedef std::vector< uint32_t > Depth;
+
+void _fill( Depth& depth, const int32_t w, const eq::PixelViewport& pvp )
+{
+    for( int32_t y = pvp.y; y < pvp.y + pvp.h; ++y )
+        for( int32_t x = pvp.x; x < pvp.x + pvp.w; ++x )
+            depth[ y * w + x ] = uint32_t( x + y );
+}
+
+eq::PixelViewports _findRegions( eq::ROIFinder& finder, const Depth& depth,
+                                 const int32_t w, const int32_t h )
+{
+    const eq::PixelViewport pvp( 0, 0, w, h );
+    eq::PixelData data;
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    data.pixelSize = sizeof( uint32_t );
+    data.pvp = pvp;
+    data.pixels = const_cast< uint32_t* >( &depth[0] );
+
+    eq::Image image;
+    image.setPixelViewport( pvp );
+    image.setPixelData( eq::Frame::BUFFER_DEPTH, data );
+    data.pixels = 0;
+
+    return finder.findRegions( image );
+}
+
+/** Test that the regions are disjoint and cover all non-empty pixels. */
+void _testCoverage( const eq::PixelViewports& regions, const Depth& depth,
+                    const int32_t w, const int32_t h )
+{
+    const eq::PixelViewport pvp( 0, 0, w, h );
+    std::vector< uint8_t > covered( w * h, 0 );
+    for( eq::PixelViewports::const_iterator i = regions.begin();
+         i != regions.end(); ++i )
+    {
+        const eq::PixelViewport& region = *i;
+        TESTINFO( region.hasArea(), region );
+        TESTINFO( region.x >= 0 && region.y >= 0 &&
+                  region.x + region.w <= w && region.y + region.h <= h,
+                  region << " outside of " << pvp );
+
+        for( int32_t y = region.y; y < region.y + region.h; ++y )
+            for( int32_t x = region.x; x < region.x + region.w; ++x )
+            {
+                TESTINFO( !covered[ y * w + x ],
+                          "Pixel " << x << ", " << y << " in two regions" );
+                covered[ y * w + x ] = 1;
+            }
+    }
+
+    for( int32_t i = 0; i < w * h; ++i )
+        TESTINFO( depth[i] == FAR || covered[i],
+                  "Pixel " << i % w << ", " << i / w << " not covered" );
+}
+
+size_t _getArea( const eq::PixelViewports& regions )
+{
+    size_t area = 0;
+    for( eq::PixelViewports::const_iterator i = regions.begin();
+         i != regions.end(); ++i )
+    {
+        area += i->getArea();
+    }
+    return area;
+}
+
+void _testEmptyAndFull( eq::ROIFinder& finder )
+{
+    const int32_t w = 640;
+    const int32_t h = 480;
+    Depth depth( w * h, FAR );
+
+    eq::PixelViewports regions = _findRegions( finder, depth, w, h );
+    TESTINFO( regions.empty(), regions.size( ));
+
+    _fill( depth, w, eq::PixelViewport( 0, 0, w, h ));
+    regions = _findRegions( finder, depth, w, h );
+    TESTINFO( regions.size() == 1, regions.size( ));
+    TESTINFO( regions.front() == eq::PixelViewport( 0, 0, w, h ),
+              regions.front( ));
+}
+
+void _testObjects( eq::ROIFinder& finder )
+{
+    // not a multiple of the block size, one object touching the border
+    const int32_t w = 1000;
+    const int32_t h = 700;
+    Depth depth( w * h, FAR );
+    _fill( depth, w, eq::PixelViewport( 40, 50, 150, 120 ));
+    _fill( depth, w, eq::PixelViewport( 700, 500, 300, 200 ));
+
+    const eq::PixelViewports regions = _findRegions( finder, depth, w, h );
+    _testCoverage( regions, depth, w, h );
+
+    const size_t area = _getArea( regions );
+    TESTINFO( area < size_t( w * h / 4 ), area << " of " << w * h );
+}
+
+void _testWide( eq::ROIFinder& finder )
+{
+    // more than 255 blocks wide, objects beyond 4080 pixels
+    const int32_t w = 4800;
+    const int32_t h = 400;
+    Depth depth( w * h, FAR );
+    _fill( depth, w, eq::PixelViewport( 100, 100, 200, 100 ));
+    _fill( depth, w, eq::PixelViewport( 4500, 250, 250, 120 ));
+
+    const eq::PixelViewports regions = _findRegions( finder, depth, w, h );
+    TESTINFO( !regions.empty(), "No regions found" );
+    _testCoverage( regions, depth, w, h );
+
+    const size_t area = _getArea( regions );
+    TESTINFO( area < size_t( w * h / 10 ), area << " of " << w * h );
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::ROIFinder finder;
+    _testEmptyAndFull( finder );
+    _testObjects( finder );
+    _testWide( finder );
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
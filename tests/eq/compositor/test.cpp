@@ -21,25 +21,530 @@
 #include <eq/client/frame.h>
 #include <eq/client/frameData.h>
 #include <eq/client/image.h>
+#include <eq/client/imageHistory.h>
 #include <eq/client/init.h>
 #include <eq/client/nodeFactory.h>
 #include <eq/fabric/drawableConfig.h>
 #include <co/base/clock.h>
+#include <co/plugins/compressor.h>
 
 // Tests the functionality of the compositor and computes the performance.
 
+namespace
+{
+struct Format
+{
+    const char* name;
+    uint32_t    format;
+    uint32_t    pixelSize;
+};
+
+static const Format _formats[] = {
+    { "RGBA8",   EQ_COMPRESSOR_DATATYPE_RGBA,    4 },
+    { "RGBA16F", EQ_COMPRESSOR_DATATYPE_RGBA16F, 8 },
+    { "RGBA32F", EQ_COMPRESSOR_DATATYPE_RGBA32F, 16 }
+};
+
+static const eq::PixelViewport _resolutions[] = {
+    eq::PixelViewport( 0, 0, 1920, 1080 ),
+    eq::PixelViewport( 0, 0, 3840, 2160 )
+};
+
+static uint32_t _hash( uint32_t value )
+{
+    value = ( value ^ 61 ) ^ ( value >> 16 );
+    value += value << 3;
+    value ^= value >> 4;
+    value *= 0x27d4eb2d;
+    return value ^ ( value >> 15 );
+}
+
+// Fills the color and optionally depth buffer with synthetic, premultiplied
+// pixel data.
+static void _setupImage( eq::Image* image, const eq::PixelViewport& pvp,
+                         const Format& format, const bool hasDepth,
+                         const uint32_t seed )
+{
+    static const uint16_t halfs[] = { 0x0000, 0x3000, 0x3400, 0x3800, 0x3c00 };
+    const size_t nPixels = pvp.getArea();
+    std::vector< uint8_t > color( nPixels * format.pixelSize );
+
+    for( size_t i = 0; i < nPixels; ++i )
+    {
+        const uint32_t random = _hash( uint32_t( i ) + seed );
+        const uint8_t alpha = uint8_t( random );
+        for( size_t j = 0; j < 4; ++j )
+        {
+            const uint8_t value = j == 3 ? alpha :
+                                  EQ_MIN( alpha, uint8_t( random >> 8*j ));
+            switch( format.pixelSize )
+            {
+              case 4:
+                color[ i*4 + j ] = value;
+                break;
+              case 8:
+                reinterpret_cast< uint16_t* >( &color[0] )[ i*4 + j ] =
+                    halfs[ value % 5 ];
+                break;
+              case 16:
+                reinterpret_cast< float* >( &color[0] )[ i*4 + j ] =
+                    float( value ) / 255.f;
+                break;
+            }
+        }
+    }
+
+    image->setPixelViewport( pvp );
+
+    eq::PixelData pixels;
+    pixels.internalFormat = format.format;
+    pixels.externalFormat = format.format;
+    pixels.pixelSize = format.pixelSize;
+    pixels.pvp = pvp;
+    pixels.pixels = &color[0];
+    image->setPixelData( eq::Frame::BUFFER_COLOR, pixels );
+    TEST( image->hasPixelData( eq::Frame::BUFFER_COLOR ));
+
+    if( !hasDepth )
+        return;
+
+    std::vector< uint32_t > depth( nPixels );
+    for( size_t i = 0; i < nPixels; ++i )
+        depth[i] = _hash( uint32_t( i ) * 7 + seed );
+
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.pixelSize = 4;
+    pixels.pixels = &depth[0];
+    image->setPixelData( eq::Frame::BUFFER_DEPTH, pixels );
+    TEST( image->hasPixelData( eq::Frame::BUFFER_DEPTH ));
+}
+
+// Checks the CPU compositing result against a straightforward implementation
+static void _checkResult( const eq::Image* result, const eq::Images& images,
+                          const bool blendAlpha )
+{
+    const size_t nPixels = result->getPixelViewport().getArea();
+    const uint8_t* color = result->getPixelPointer( eq::Frame::BUFFER_COLOR );
+
+    if( !blendAlpha )
+    {
+        const uint32_t* depth = reinterpret_cast< const uint32_t* >(
+            result->getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+        const size_t pixelSize = result->getPixelSize( eq::Frame::BUFFER_COLOR);
+
+        for( size_t i = 0; i < nPixels; ++i )
+        {
+            const eq::Image* front = 0;
+            uint32_t frontDepth = 0xffffffffu;
+            for( eq::Images::const_iterator j = images.begin();
+                 j != images.end(); ++j )
+            {
+                const uint32_t value = reinterpret_cast< const uint32_t* >(
+                    (*j)->getPixelPointer( eq::Frame::BUFFER_DEPTH ))[i];
+                if( value < frontDepth )
+                {
+                    front = *j;
+                    frontDepth = value;
+                }
+            }
+            TEST( depth[i] == frontDepth );
+            if( front ) // else the cleared background remains
+                TEST( memcmp( color + i * pixelSize,
+                              front->getPixelPointer( eq::Frame::BUFFER_COLOR )
+                              + i * pixelSize, pixelSize ) == 0 );
+        }
+        return;
+    }
+
+    if( result->getExternalFormat( eq::Frame::BUFFER_COLOR ) !=
+        EQ_COMPRESSOR_DATATYPE_RGBA )
+    {
+        return;
+    }
+
+    for( size_t i = 0; i < nPixels; ++i )
+    {
+        int expected[4] = { 0, 0, 0, 255 };
+        for( eq::Images::const_iterator j = images.begin();
+             j != images.end(); ++j )
+        {
+            const uint8_t* src =
+                (*j)->getPixelPointer( eq::Frame::BUFFER_COLOR ) + i * 4;
+            for( size_t k = 0; k < 3; ++k )
+                expected[k] = EQ_MIN( src[k] + (src[3]*expected[k] >> 8), 255);
+            expected[3] = src[3] * expected[3] >> 8;
+        }
+        for( size_t k = 0; k < 4; ++k )
+            TEST( color[ i*4 + k ] == expected[k] );
+    }
+}
+
+// Composites two full-screen images per format and resolution
+static void _benchmark( const char* program, const bool blendAlpha )
+{
+    eq::Frame      frame;
+    eq::FrameData* frameData = new eq::FrameData;
+    frame.setData( frameData );
+
+    eq::Frames frames;
+    frames.push_back( &frame );
+
+    for( size_t i = 0; i < sizeof( _resolutions ) / sizeof( _resolutions[0] );
+         ++i )
+    {
+        const eq::PixelViewport& pvp = _resolutions[i];
+        for( size_t j = 0; j < sizeof( _formats ) / sizeof( _formats[0] ); ++j)
+        {
+            const Format& format = _formats[j];
+            frameData->clear();
+            frameData->setBuffers( blendAlpha ? eq::Frame::BUFFER_COLOR :
+                                                eq::Frame::BUFFER_COLOR |
+                                                eq::Frame::BUFFER_DEPTH );
+            for( uint32_t k = 0; k < 2; ++k )
+            {
+                eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                                        eq::DrawableConfig( ));
+                _setupImage( image, pvp, format, !blendAlpha, k * 4711 );
+                TEST( !blendAlpha || image->hasAlpha( ));
+            }
+
+            const eq::Image* result = eq::Compositor::mergeFramesCPU( frames,
+                                                                   blendAlpha );
+            TEST( result );
+            _checkResult( result, frameData->getImages(), blendAlpha );
+
+            const size_t nLoops = 5;
+            co::base::Clock clock;
+            for( size_t k = 0; k < nLoops; ++k )
+                TEST( eq::Compositor::mergeFramesCPU( frames, blendAlpha ));
+            const float time = clock.getTimef() / float( nLoops );
+            const float pixels = 2.f * float( pvp.getArea( ));
+
+            std::cout << program << ": " << ( blendAlpha ? "Alpha " : "DB " )
+                      << format.name << " " << pvp.w << "x" << pvp.h << ": "
+                      << time << " ms (" << pixels / time / 1000.f
+                      << " MPixel/s)" << std::endl;
+        }
+    }
+    frameData->clear();
+}
+
+// Clears all pixels outside of a box to the background, leaving a sparse
+// image as produced by sort-last rendering
+static void _makeSparse( eq::Image* image, const uint32_t seed )
+{
+    const eq::PixelViewport& pvp = image->getPixelViewport();
+    uint32_t* color = reinterpret_cast< uint32_t* >(
+        image->getPixelPointer( eq::Frame::BUFFER_COLOR ));
+    uint32_t* depth = reinterpret_cast< uint32_t* >(
+        image->getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+    const int32_t x0 = pvp.w / 8 + seed % ( pvp.w / 4 );
+    const int32_t y0 = pvp.h / 8 + seed % ( pvp.h / 4 );
+
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < pvp.w; ++x )
+        {
+            const size_t i = y * pvp.w + x;
+            if( x < x0 || x >= x0 + pvp.w / 2 || y < y0 || y >= y0 + pvp.h / 2 )
+            {
+                color[i] = 0;
+                depth[i] = 0xffffffffu;
+            }
+            else // compressible object surface
+                color[i] &= 0xf0f0f0f0u;
+        }
+    }
+}
+
+// Merges two RLE-compressed sparse images, once decompressing them first and
+// once directly in their compressed form
+static void _benchmarkCompressed( const char* program, const uint32_t name )
+{
+    eq::Frame      frame;
+    eq::FrameData* frameData = new eq::FrameData;
+    frame.setData( frameData );
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+
+    eq::Frames frames;
+    frames.push_back( &frame );
+
+    for( size_t i = 0; i < sizeof( _resolutions ) / sizeof( _resolutions[0] );
+         ++i )
+    {
+        const eq::PixelViewport& pvp = _resolutions[i];
+        eq::Image sources[2];
+        for( uint32_t j = 0; j < 2; ++j )
+        {
+            eq::Image& source = sources[j];
+            _setupImage( &source, pvp, _formats[0], true, j * 4711 );
+            _makeSparse( &source, j * 4711 );
+            source.useCompressor( eq::Frame::BUFFER_COLOR, name );
+            source.useCompressor( eq::Frame::BUFFER_DEPTH,
+                                  EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT );
+            source.compressPixelData( eq::Frame::BUFFER_COLOR );
+            source.compressPixelData( eq::Frame::BUFFER_DEPTH );
+        }
+
+        // decompress-then-merge
+        const size_t nLoops = 5;
+        const eq::Image* result = 0;
+        co::base::Clock clock;
+        for( size_t k = 0; k < nLoops; ++k )
+        {
+            frameData->clear();
+            for( uint32_t j = 0; j < 2; ++j )
+            {
+                eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                                        eq::DrawableConfig( ));
+                image->setPixelViewport( pvp );
+                image->setPixelData( eq::Frame::BUFFER_COLOR, sources[j].
+                                 compressPixelData( eq::Frame::BUFFER_COLOR ));
+                image->setPixelData( eq::Frame::BUFFER_DEPTH, sources[j].
+                                 compressPixelData( eq::Frame::BUFFER_DEPTH ));
+            }
+            result = eq::Compositor::mergeFramesCPU( frames );
+            TEST( result );
+        }
+        const float decompressTime = clock.getTimef() / float( nLoops );
+
+        // merge on compressed data
+        eq::Image merged;
+        clock.reset();
+        for( size_t k = 0; k < nLoops; ++k )
+        {
+            merged.setPixelViewport( pvp );
+            eq::PixelData pixels;
+            pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+            pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+            pixels.pixelSize = 4;
+            pixels.pvp = pvp;
+            merged.setPixelData( eq::Frame::BUFFER_COLOR, pixels );
+            pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+            pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+            merged.setPixelData( eq::Frame::BUFFER_DEPTH, pixels );
+
+            for( uint32_t j = 0; j < 2; ++j )
+                TEST( eq::Compositor::mergeCompressedDB( &merged,
+                       sources[j].compressPixelData( eq::Frame::BUFFER_COLOR ),
+                       sources[j].compressPixelData( eq::Frame::BUFFER_DEPTH ),
+                       eq::Vector2i::ZERO ));
+        }
+        const float compressedTime = clock.getTimef() / float( nLoops );
+
+        TEST( result->getPixelViewport() == merged.getPixelViewport( ));
+        TEST( memcmp( result->getPixelPointer( eq::Frame::BUFFER_COLOR ),
+                      merged.getPixelPointer( eq::Frame::BUFFER_COLOR ),
+                      merged.getPixelDataSize( eq::Frame::BUFFER_COLOR )) == 0);
+        TEST( memcmp( result->getPixelPointer( eq::Frame::BUFFER_DEPTH ),
+                      merged.getPixelPointer( eq::Frame::BUFFER_DEPTH ),
+                      merged.getPixelDataSize( eq::Frame::BUFFER_DEPTH )) == 0);
+
+        std::cout << program << ": RLE 0x" << std::hex << name << std::dec
+                  << " " << pvp.w << "x" << pvp.h << ": decompress and merge "
+                  << decompressTime << " ms, merge compressed "
+                  << compressedTime << " ms" << std::endl;
+    }
+    frameData->clear();
+}
+
+// Sets up an image like FrameData::addImage with the compressed pixels of the
+// source image received in one payload
+static void _receive( eq::Image* image, eq::Image& source,
+                      const eq::PixelViewport& pvp )
+{
+    static const eq::Frame::Buffer buffers[] = { eq::Frame::BUFFER_COLOR,
+                                                 eq::Frame::BUFFER_DEPTH };
+    co::base::Bufferb payload;
+    for( size_t i = 0; i < 2; ++i )
+    {
+        const eq::PixelData& data = source.compressPixelData( buffers[i] );
+        TEST( data.isCompressed );
+        for( size_t j = 0; j < data.compressedData.size(); ++j )
+            payload.append( static_cast< const uint8_t* >(
+                                data.compressedData[j] ),
+                            data.compressedSize[j] );
+    }
+
+    // the image takes over the payload memory
+    const uint8_t* received = payload.getData();
+    image->setPixelViewport( pvp );
+    image->swapReceiveBuffer( payload );
+    for( size_t i = 0; i < 2; ++i )
+    {
+        const eq::PixelData& data = source.compressPixelData( buffers[i] );
+        eq::PixelData pixels;
+        pixels.internalFormat  = data.internalFormat;
+        pixels.externalFormat  = data.externalFormat;
+        pixels.pixelSize       = data.pixelSize;
+        pixels.pvp             = data.pvp;
+        pixels.compressorName  = data.compressorName;
+        pixels.compressorFlags = data.compressorFlags;
+        pixels.isCompressed    = true;
+        pixels.compressedSize  = data.compressedSize;
+        for( size_t j = 0; j < data.compressedData.size(); ++j )
+        {
+            pixels.compressedData.push_back(
+                const_cast< uint8_t* >( received ));
+            received += data.compressedSize[j];
+        }
+        image->setReceivedPixelData( buffers[i], pixels );
+        TEST( image->hasCompressedPixelData( buffers[i] ));
+    }
+}
+
+// Merges received RLE images, which are kept compressed for keyframes and
+// restored for temporal differences, and compares the result with the merge of
+// the decompressed images
+static void _testReceivedCompressed( const uint32_t name )
+{
+    static const eq::Frame::Buffer buffers[] = { eq::Frame::BUFFER_COLOR,
+                                                 eq::Frame::BUFFER_DEPTH };
+    eq::Frame      frame;
+    eq::FrameData* frameData = new eq::FrameData;
+    frame.setData( frameData );
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+
+    eq::Frames frames;
+    frames.push_back( &frame );
+
+    const eq::PixelViewport pvp( 0, 0, 640, 480 );
+    eq::ImageHistory history;
+    eq::Image sources[2][2]; // keyframe and next frame of two images
+
+    for( uint32_t k = 0; k < 2; ++k )
+    {
+        for( uint32_t j = 0; j < 2; ++j )
+        {
+            eq::Image& source = sources[k][j];
+            const uint32_t seed = ( k * 2 + j ) * 4711;
+            _setupImage( &source, pvp, _formats[0], true, seed );
+            _makeSparse( &source, seed );
+            source.useCompressor( eq::Frame::BUFFER_COLOR, name );
+            source.useCompressor( eq::Frame::BUFFER_DEPTH,
+                                  EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT );
+        }
+
+        // expected result from the decompressed images
+        frameData->clear();
+        for( uint32_t j = 0; j < 2; ++j )
+        {
+            eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                                    eq::DrawableConfig( ));
+            image->setPixelViewport( pvp );
+            for( size_t i = 0; i < 2; ++i )
+                image->setPixelData( buffers[i],
+                                 sources[k][j].compressPixelData( buffers[i] ));
+        }
+        const eq::Image* result = eq::Compositor::mergeFramesCPU( frames );
+        TEST( result );
+        const size_t size = result->getPixelDataSize( eq::Frame::BUFFER_COLOR );
+        const std::vector< uint8_t > color(
+            result->getPixelPointer( eq::Frame::BUFFER_COLOR ),
+            result->getPixelPointer( eq::Frame::BUFFER_COLOR ) + size );
+        const std::vector< uint8_t > depth(
+            result->getPixelPointer( eq::Frame::BUFFER_DEPTH ),
+            result->getPixelPointer( eq::Frame::BUFFER_DEPTH ) + size );
+
+        // received keyframe or temporal difference
+        frameData->clear();
+        for( uint32_t j = 0; j < 2; ++j )
+        {
+            eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                                    eq::DrawableConfig( ));
+            if( k == 0 )
+            {
+                _receive( image, sources[k][j], pvp );
+                for( size_t i = 0; i < 2; ++i )
+                {
+                    TEST( history.decompress( j, image, buffers[i],
+                                              eq::ImageHistory::MODE_KEY ));
+                    TEST( image->hasCompressedPixelData( buffers[i] ));
+                }
+                continue;
+            }
+
+            eq::Image delta;
+            _setupImage( &delta, pvp, _formats[0], true, ( 2 + j ) * 4711 );
+            _makeSparse( &delta, ( 2 + j ) * 4711 );
+            for( size_t i = 0; i < 2; ++i )
+            {
+                uint8_t* pixels = delta.getPixelPointer( buffers[i] );
+                const uint8_t* previous =
+                    sources[0][j].getPixelPointer( buffers[i] );
+                for( size_t l = 0; l < size; ++l )
+                    pixels[l] ^= previous[l];
+            }
+            delta.useCompressor( eq::Frame::BUFFER_COLOR, name );
+            delta.useCompressor( eq::Frame::BUFFER_DEPTH,
+                                 EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT );
+
+            _receive( image, delta, pvp );
+            for( size_t i = 0; i < 2; ++i )
+            {
+                TEST( history.decompress( j, image, buffers[i],
+                                          eq::ImageHistory::MODE_DELTA ));
+                TEST( !image->hasCompressedPixelData( buffers[i] ));
+                TEST( memcmp( image->getPixelPointer( buffers[i] ),
+                              sources[k][j].getPixelPointer( buffers[i] ),
+                              size ) == 0 );
+            }
+        }
+
+        result = eq::Compositor::mergeFramesCPU( frames );
+        TEST( result );
+        TEST( memcmp( result->getPixelPointer( eq::Frame::BUFFER_COLOR ),
+                      &color[0], size ) == 0 );
+        TEST( memcmp( result->getPixelPointer( eq::Frame::BUFFER_DEPTH ),
+                      &depth[0], size ) == 0 );
+
+        // keyframes were merged without decompression
+        const eq::Images& images = frameData->getImages();
+        for( eq::Images::const_iterator i = images.begin();
+             i != images.end(); ++i )
+        {
+            TEST( (*i)->hasCompressedPixelData( eq::Frame::BUFFER_COLOR ) ==
+                  ( k == 0 ));
+        }
+    }
+    frameData->clear();
+
+    // a delta without reference and all deltas based on it are rejected
+    for( size_t i = 0; i < 2; ++i )
+    {
+        eq::Image image;
+        _receive( &image, sources[1][0], pvp );
+        TEST( !history.decompress( 2, &image, eq::Frame::BUFFER_COLOR,
+                                   eq::ImageHistory::MODE_DELTA ));
+    }
+}
+}
+
 int main( int argc, char **argv )
 {
     eq::NodeFactory nodeFactory;
     TEST( eq::init( 0, 0, &nodeFactory ));
 
+    // 1) throughput of synthetic 1080p and 4K images
+    _benchmark( argv[0], false );
+    _benchmark( argv[0], true );
+
+    // 2) sort-last compositing of RLE-compressed sparse images
+    _benchmarkCompressed( argv[0], EQ_COMPRESSOR_RLE_RGBA );
+    _benchmarkCompressed( argv[0], EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA );
+
+    // 3) CPU assembly of received compressed and temporal images
+    _testReceivedCompressed( EQ_COMPRESSOR_RLE_RGBA );
+    _testReceivedCompressed( EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA );
+
     eq::Frame      frame;
     eq::FrameData* frameData = new eq::FrameData;
 
     frameData->setBuffers( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
     frame.setData( frameData );
 
-    // 1) 2D assembly test
+    // 4) 2D assembly test
     eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
                                             eq::DrawableConfig( ));
     TEST( image->readImage( "Image_1_color.rgb", eq::Frame::BUFFER_COLOR ));
@@ -88,7 +593,7 @@ int main( int argc, char **argv )
     std::cout << argv[0] << ": 2D 15 images: " << time << " ms (" 
          << 5000.0f * size / time / 1024.0f / 1024.0f << " MB/s)" << std::endl;
 
-    // 2) DB assembly test
+    // 5) DB assembly test
 #ifdef EQ_USE_PARACOMP_DEPTH
     std::cout << "Using Paracomp PC compositing (depth)" << std::endl;
 #endif
@@ -146,7 +651,7 @@ int main( int argc, char **argv )
               << 5000.0f * size * 2.f / time / 1024.0f / 1024.0f << " MB/s)"
               << std::endl;
 
-    // 3) alpha-blend assembly test
+    // 6) alpha-blend assembly test
 #ifdef EQ_USE_PARACOMP_BLEND
      std::cout << "Using Paracomp PC compositing (blend)" << std::endl;
 #endif
@@ -192,7 +697,7 @@ int main( int argc, char **argv )
 
     std::cout << argv[0] << ": Alpha 15 images: " << time << " ms (" 
          << 5000.0f * size / time / 1024.0f / 1024.0f << " MB/s)" << std::endl;
-    
+
     TEST( eq::exit( ));
 
     return EXIT_SUCCESS;
@@ -31,6 +31,7 @@
 #include <co/base/pluginRegistry.h>
 
 
+#include <map>
 #include <numeric>
 #include <fstream>
 
@@ -162,6 +163,9 @@ int main( int argc, char **argv )
     std::cout << "COMPRESSOR,                            IMAGE,       SIZE, A,"
               << " COMPRESSED,     t_comp,   t_decomp" << std::endl;
 
+    // total compression time per compressor and alpha usage
+    std::map< std::pair< uint32_t, bool >, float > compressTimes;
+
     // For each compressor...
     std::vector< uint32_t > names( _getCompressorNames( ));
     TESTINFO( names.size() > 23, names.size( ));
@@ -345,6 +349,10 @@ int main( int argc, char **argv )
 #endif
             }
 
+            if( totalSize > 0 )
+                compressTimes[ std::make_pair( name, image.getAlphaUsage( )) ]
+                    = totalCompressTime;
+
             if( totalSize > 0 )
                 std::cout
                     << "0x" << std::setw(3) << std::setfill( '0' ) << std::hex
@@ -363,6 +371,48 @@ int main( int argc, char **argv )
         }
     }
 
+    // SIMD engines side-by-side with the equivalent scalar engines
+    static const uint32_t simdNames[][2] = {
+        { EQ_COMPRESSOR_RLE_RGBA, EQ_COMPRESSOR_RLE_SIMD_RGBA },
+        { EQ_COMPRESSOR_RLE_BGRA, EQ_COMPRESSOR_RLE_SIMD_BGRA },
+        { EQ_COMPRESSOR_RLE_RGBA_UINT_8_8_8_8_REV,
+          EQ_COMPRESSOR_RLE_SIMD_RGBA_UINT_8_8_8_8_REV },
+        { EQ_COMPRESSOR_RLE_BGRA_UINT_8_8_8_8_REV,
+          EQ_COMPRESSOR_RLE_SIMD_BGRA_UINT_8_8_8_8_REV },
+        { EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT,
+          EQ_COMPRESSOR_RLE_SIMD_DEPTH_UNSIGNED_INT },
+        { EQ_COMPRESSOR_RLE_DIFF_RGBA, EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA },
+        { EQ_COMPRESSOR_RLE_DIFF_BGRA, EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA },
+        { EQ_COMPRESSOR_RLE_DIFF_RGBA_UINT_8_8_8_8_REV,
+          EQ_COMPRESSOR_RLE_SIMD_DIFF_RGBA_UINT_8_8_8_8_REV },
+        { EQ_COMPRESSOR_RLE_DIFF_BGRA_UINT_8_8_8_8_REV,
+          EQ_COMPRESSOR_RLE_SIMD_DIFF_BGRA_UINT_8_8_8_8_REV }};
+
+    std::cout << "COMPRESSOR,  SIMD, A,     t_comp, t_comp_SIMD" << std::endl;
+    for( size_t i = 0; i < sizeof( simdNames ) / sizeof( simdNames[0] ); ++i )
+    {
+        for( unsigned j = 0; j < 2; ++j )
+        {
+            const bool useAlpha = ( j == 0 );
+            const std::pair< uint32_t, bool > scalar( simdNames[i][0],
+                                                      useAlpha );
+            const std::pair< uint32_t, bool > simd( simdNames[i][1],
+                                                    useAlpha );
+            if( compressTimes.find( scalar ) == compressTimes.end() ||
+                compressTimes.find( simd ) == compressTimes.end( ))
+            {
+                continue;
+            }
+
+            std::cout << "     0x" << std::setw(3) << std::setfill( '0' )
+                      << std::hex << simdNames[i][0] << ", 0x" << std::setw(3)
+                      << simdNames[i][1] << std::dec << std::setfill(' ')
+                      << ", " << useAlpha << ", " << std::setw(10)
+                      << compressTimes[ scalar ] << ", " << std::setw(10)
+                      << compressTimes[ simd ] << std::endl;
+        }
+    }
+
     image.flush();
     destImage.flush();
     eq::exit();
@@ -0,0 +1,254 @@
+
+/* Copyright (c) 2011, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Auto-configures a local node with 2, 3, 4, 6 and 8 GPUs and simulates the
+// compositing of the 'Static DB' compound. Tests that all frame links are
+// complete, that no range is composited twice into any tile and that the
+// destination image contains all ranges.
+
+#include <test.h>
+
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/config.h>
+#include <eq/server/frame.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/node.h>
+#include <eq/server/pipe.h>
+#include <eq/server/server.h>
+#include <eq/server/config/display.h>
+#include <eq/server/config/resources.h>
+
+#include <co/base/init.h>
+
+#include <map>
+#include <set>
+
+#define NROWS 840 // divisible by all tile counts of the tested GPU counts
+
+namespace
+{
+/** The ranges composited into each image row, one bit per range. */
+typedef std::vector< uint32_t > Rows;
+typedef std::map< std::string, Rows > FrameData;
+
+struct State
+{
+    FrameData frames;               //!< output frame contents by name
+    std::set< std::string > inputs; //!< consumed output frames
+};
+
+bool _isInside( const eq::Viewport& vp, const size_t row )
+{
+    const float y = ( float( row ) + .5f ) / float( NROWS );
+    return y >= vp.y && y < vp.getYEnd();
+}
+
+const Rows& _getInput( const eq::server::Frame* frame, State& state )
+{
+    const std::string& name = frame->getName();
+    FrameData::const_iterator i = state.frames.find( name );
+    TESTINFO( i != state.frames.end(), "No output frame for " << name );
+    TESTINFO( state.inputs.insert( name ).second,
+              "Frame " << name << " used twice" );
+    return i->second;
+}
+
+/** Draw, assemble and read back one compound into the channel's rows. */
+void _execute( const eq::server::Compound* compound, const uint32_t range,
+               Rows& channel, State& state )
+{
+    const uint32_t tasks = compound->getTasks();
+    if( compound->isLeaf() && ( tasks == eq::fabric::TASK_DEFAULT ||
+                                ( tasks & eq::fabric::TASK_DRAW )))
+    {
+        for( size_t i = 0; i < NROWS; ++i )
+            channel[i] |= range;
+    }
+
+    const eq::server::Frames& inputs = compound->getInputFrames();
+    for( eq::server::FramesCIter i = inputs.begin(); i != inputs.end(); ++i )
+    {
+        const Rows& data = _getInput( *i, state );
+        for( size_t j = 0; j < NROWS; ++j )
+        {
+            TESTINFO( ( channel[j] & data[j] ) == 0,
+                      "Row " << j << " of " << (*i)->getName() <<
+                      " composited twice" );
+            channel[j] |= data[j];
+        }
+    }
+
+    const eq::server::Frames& outputs = compound->getOutputFrames();
+    for( eq::server::FramesCIter i = outputs.begin(); i != outputs.end(); ++i )
+    {
+        const eq::server::Frame* frame = *i;
+        Rows data( NROWS, 0 );
+        for( size_t j = 0; j < NROWS; ++j )
+            if( _isInside( frame->getViewport(), j ))
+                data[j] = channel[j];
+
+        TESTINFO( state.frames.insert( std::make_pair( frame->getName(),
+                                                       data )).second,
+                  "Frame " << frame->getName() << " used twice" );
+    }
+}
+
+void _testDB( const eq::server::Compound* db, const size_t nGPUs )
+{
+    const eq::server::Compounds& participants = db->getChildren();
+    TESTINFO( participants.size() == nGPUs, participants.size( ));
+
+    // the ranges tile [0, 1]
+    float end = 0.f;
+    for( size_t i = 0; i < nGPUs; ++i )
+    {
+        const eq::Range& range = participants[i]->getRange();
+        TESTINFO( range.start == end, range << " after " << end );
+        end = range.end;
+    }
+    TESTINFO( std::abs( end - 1.f ) < .001f, end );
+
+    // execute all participants round by round, the last round being the
+    // assembly and readback of the participant itself
+    const size_t nRounds = participants.front()->getChildren().size() + 1;
+    std::vector< Rows > channels( nGPUs, Rows( NROWS, 0 ));
+    State state;
+    for( size_t round = 0; round < nRounds; ++round )
+    {
+        for( size_t i = 0; i < nGPUs; ++i )
+        {
+            const eq::server::Compound* participant = participants[i];
+            const eq::server::Compounds& children = participant->getChildren();
+            TESTINFO( children.size() + 1 == nRounds, children.size( ));
+
+            const uint32_t range = 1u << i;
+            if( round + 1 == nRounds )
+                _execute( participant, range, channels[i], state );
+            else
+                _execute( children[ round ], range, channels[i], state );
+        }
+    }
+
+    // the destination participant renders on the output channel, where the
+    // final stripes of all other participants are assembled
+    size_t destination = nGPUs;
+    for( size_t i = 0; i < nGPUs; ++i )
+        if( participants[i]->getChannel() == db->getChannel( ))
+            destination = i;
+    TEST( destination < nGPUs );
+
+    Rows image = channels[ destination ];
+    std::vector< size_t > writes( NROWS, 0 );
+    const eq::server::Frames& inputs = db->getInputFrames();
+    TESTINFO( inputs.size() == nGPUs - 1, inputs.size( ));
+    for( eq::server::FramesCIter i = inputs.begin(); i != inputs.end(); ++i )
+    {
+        const Rows& data = _getInput( *i, state );
+        for( size_t j = 0; j < NROWS; ++j )
+        {
+            if( data[j] == 0 )
+                continue;
+            image[j] = data[j];
+            ++writes[j];
+        }
+    }
+
+    const uint32_t all = ( 1u << nGPUs ) - 1;
+    for( size_t i = 0; i < NROWS; ++i )
+    {
+        TESTINFO( writes[i] <= 1, "Row " << i << " assembled " << writes[i] <<
+                  " times" );
+        TESTINFO( image[i] == all, "Row " << i << " has ranges " << std::hex <<
+                  image[i] << std::dec << " of " << all );
+    }
+
+    TESTINFO( state.inputs.size() == state.frames.size(),
+              state.frames.size() - state.inputs.size() <<
+              " output frames not used" );
+}
+
+const eq::server::Compound* _findCompound( const eq::server::Compounds& roots,
+                                           const std::string& name )
+{
+    for( eq::server::CompoundsCIter i = roots.begin(); i != roots.end(); ++i )
+    {
+        const eq::server::Compounds& segments = (*i)->getChildren();
+        for( eq::server::CompoundsCIter j = segments.begin();
+             j != segments.end(); ++j )
+        {
+            const eq::server::Compounds& children = (*j)->getChildren();
+            for( eq::server::CompoundsCIter k = children.begin();
+                 k != children.end(); ++k )
+            {
+                if( (*k)->getName() == name )
+                    return *k;
+            }
+        }
+    }
+    return 0;
+}
+
+void _testAutoconfig( const size_t nGPUs )
+{
+    // same as config::Server::configure, with nGPUs local GPUs
+    eq::server::ServerPtr server = new eq::server::Server;
+    eq::server::Config* config = new eq::server::Config( server );
+
+    eq::server::Node* node = new eq::server::Node( config );
+    node->setApplicationNode( true );
+    for( size_t i = 0; i < nGPUs; ++i )
+    {
+        eq::server::Pipe* pipe = new eq::server::Pipe( node );
+        std::stringstream name;
+        name << "GPU" << i + 1;
+        pipe->setName( name.str( ));
+        pipe->setDevice( uint32_t( i ));
+        pipe->setPixelViewport( eq::PixelViewport( 0, 0, 1920, 1200 ));
+    }
+
+    eq::server::config::Display::discoverLocal( config );
+    const eq::server::Compounds compounds =
+        eq::server::Loader::addOutputCompounds( server );
+    TEST( !compounds.empty( ));
+
+    const eq::server::Channels channels =
+        eq::server::config::Resources::configureSourceChannels( config );
+    TESTINFO( channels.size() == nGPUs, channels.size( ));
+    eq::server::config::Resources::configure( compounds, channels );
+
+    const eq::server::Compound* db = _findCompound( compounds, "Static DB" );
+    TESTINFO( db, "No DB compound for " << nGPUs << " GPUs" );
+    _testDB( db, nGPUs );
+
+    eq::server::Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+}
+}
+
+int main( int argc, char **argv )
+{
+    TEST( co::base::init( argc, argv ));
+
+    static const size_t nGPUs[] = { 2, 3, 4, 6, 8 };
+    for( size_t i = 0; i < sizeof( nGPUs ) / sizeof( size_t ); ++i )
+        _testAutoconfig( nGPUs[i] );
+
+    TEST( co::base::exit( ));
+    return EXIT_SUCCESS;
+}